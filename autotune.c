@@ -0,0 +1,733 @@
+/*******************************************************************************
+* File Name: autotune.c
+*
+* Description:
+* Relay feedback auto-tuning of the BUCK1 voltage loop compensator.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <math.h>
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "current_share.h"
+#include "phase_shed.h"
+#include "gain_sched.h"
+#include "uart_tx.h"
+#include "autotune.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define AUTOTUNE_PI                 (3.14159265f)
+#define AUTOTUNE_DEG_PER_RAD        (180.0f / AUTOTUNE_PI)
+#define AUTOTUNE_PERIODS(ms)        (((ms) * AUTOTUNE_CTRL_FREQ_HZ) / 1000U)
+
+/* Largest boost of the compensator zero/pole pair, degrees */
+#define AUTOTUNE_BOOST_MAX          (85.0f)
+
+/* Load current below which the load resistance is taken as open, A */
+#define AUTOTUNE_IOUT_MIN           (0.05f)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+autotune_t autotune =
+{
+    .phase     = AUTOTUNE_PHASE_OFF,
+    .requested = false,
+    .result    = AUTOTUNE_RESULT_NONE,
+    .reason    = NULL,
+    .report    = false
+};
+
+/* Sets designed by autotune_process(), loaded by the control ISR */
+static gain_sched_coef_t autotune_sets[BUCK_CONV_PHASES_MAX];
+
+static const char *const autotune_result_names[AUTOTUNE_RESULTS] =
+{
+    [AUTOTUNE_RESULT_NONE]        = "none",
+    [AUTOTUNE_RESULT_APPLIED]     = "applied",
+    [AUTOTUNE_RESULT_REJECTED]    = "rejected",
+    [AUTOTUNE_RESULT_ROLLED_BACK] = "rolled_back",
+    [AUTOTUNE_RESULT_ABORTED]     = "aborted",
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: autotune_finish
+*********************************************************************************
+* Summary:
+* Ends the auto-tuning with a result, which the main loop then reports.
+*
+* Parameters:
+*  result: result of the experiment
+*  reason: cause of a rejection, rollback or abort, or NULL
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+static void autotune_finish(autotune_result_t result, const char *reason)
+{
+    autotune.result = result;
+    autotune.reason = reason;
+    autotune.runs++;
+    autotune.report = true;
+    autotune.phase  = AUTOTUNE_PHASE_OFF;
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: autotune_rollback
+*********************************************************************************
+* Summary:
+* Restores the tuned sets that were in use before the experiment, or returns
+* to the sets of the gain scheduling when there were none; the gain
+* scheduling loads them in the next control ISR.
+*
+* Parameters:
+*  reason: cause of the rollback
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+static void autotune_rollback(const char *reason)
+{
+    uint32_t ph;
+
+    for (ph = 0U; ph < BUCK_CONV_PHASES_MAX; ph++)
+    {
+        gain_sched.tuned[ph] = autotune.prev[ph];
+    }
+    gain_sched.tuned_active = autotune.prev_active;
+    if (autotune.prev_active)
+    {
+        gain_sched_transfer(gain_sched.active);
+    }
+    autotune_finish(AUTOTUNE_RESULT_ROLLED_BACK, reason);
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: autotune_request
+*********************************************************************************
+* Summary:
+* Requests an experiment with the next start of the converters, called in the
+* IDLE state before the start is posted to the state machine.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: false while an experiment or its verification is running
+*
+*******************************************************************************/
+bool autotune_request(void)
+{
+    if (autotune_busy())
+    {
+        return false;
+    }
+    autotune.requested = true;
+    return true;
+}
+
+/*******************************************************************************
+* Function name: autotune_discard
+*********************************************************************************
+* Summary:
+* Stops using the tuned sets; the gain scheduling returns to its own sets with
+* the next control ISR.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: false while an experiment or its verification is running
+*
+*******************************************************************************/
+bool autotune_discard(void)
+{
+    if (autotune_busy())
+    {
+        return false;
+    }
+    gain_sched.tuned_active = false;
+    return true;
+}
+
+/*******************************************************************************
+* Function name: autotune_begin
+*********************************************************************************
+* Summary:
+* Starts a requested experiment when the primary converter enters RUN. The
+* relay starts once the converter has settled. Can be called from an
+* interrupt handler with a lower priority than the control ISR.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void autotune_begin(void)
+{
+    autotune.requested = false;
+    if (autotune_busy())
+    {
+        return;
+    }
+    autotune.result = AUTOTUNE_RESULT_NONE;
+    autotune.reason = NULL;
+    autotune.report = false;
+    autotune.count  = AUTOTUNE_PERIODS(AUTOTUNE_START_DELAY_MS);
+    autotune.phase  = AUTOTUNE_PHASE_WAIT;
+}
+
+/*******************************************************************************
+* Function name: autotune_abort
+*********************************************************************************
+* Summary:
+* Called from the scheduled ADC callback when the converter leaves the states
+* the auto-tuning needs: RUN for the experiment, RUN or TEST for the
+* verification. The experiment ends without a result, the verification rolls
+* the tuned sets back. During the relay the compensator history always holds
+* the settled output, so the compensator continues from it.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void autotune_abort(void)
+{
+    if (autotune.phase == AUTOTUNE_PHASE_VERIFY)
+    {
+        autotune_rollback("state");
+    }
+    else
+    {
+        autotune_finish(AUTOTUNE_RESULT_ABORTED, "state");
+    }
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: autotune_step
+*********************************************************************************
+* Summary:
+* Auto-tuning engine, called from the control ISR after the compensator while
+* the auto-tuning is busy.
+*  - WAIT: counts down the settling of the converter, then takes the reference
+*    and the compensator output as the operating point of the relay.
+*  - RELAY: switches the relay output s when the output voltage error leaves
+*    the hysteresis band, writes the settled output plus s times the amplitude
+*    to the CSG DACs and holds the compensator history at the settled output.
+*    After the settling, the change of the output voltage result and the new
+*    relay output, each times the previous relay outputs, are added to the
+*    sums; with s = +-1 these are additions only. Ends with the settled
+*    output written back.
+*  - APPLY: loads the designed sets into the gain scheduling.
+*  - VERIFY: tracks the peak and the sum of the squared output voltage errors
+*    and rolls back when they exceed their limits.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void autotune_step(void)
+{
+    mtb_stc_pwrconv_ctrl_2p2z_t *ctrl = &BUCK1_ctx.ctrl;
+    int32_t res = (int32_t)BUCK1_ctx.res;
+    int32_t v;
+    int32_t dv;
+    int32_t s;
+    float32_t u;
+    uint32_t l;
+    uint32_t ph;
+
+    switch (autotune.phase)
+    {
+    case AUTOTUNE_PHASE_WAIT:
+        if (--autotune.count == 0U)
+        {
+            autotune.ref      = (int32_t)BUCK1_ctx.ref;
+            autotune.u0       = ctrl->y1;
+            autotune.phases   = phase_shed.phases;
+            autotune.s        = (res > autotune.ref) ? -1 : 1;
+            autotune.hist     = 0U;
+            autotune.switches = 0U;
+            autotune.res_prev = res;
+            autotune.acc      = (autotune_sums_t){ 0 };
+            autotune.count    = AUTOTUNE_PERIODS(AUTOTUNE_SETTLE_MS + AUTOTUNE_MEASURE_MS);
+            autotune.phase    = AUTOTUNE_PHASE_RELAY;
+        }
+        break;
+
+    case AUTOTUNE_PHASE_RELAY:
+        v = res - autotune.ref;
+        if ((v > AUTOTUNE_WINDOW) || (v < -AUTOTUNE_WINDOW))
+        {
+            autotune_finish(AUTOTUNE_RESULT_ABORTED, "window");
+            break;
+        }
+
+        s = (v > AUTOTUNE_HYSTERESIS) ? -1 : ((v < -AUTOTUNE_HYSTERESIS) ? 1 : autotune.s);
+        if (autotune.count <= AUTOTUNE_PERIODS(AUTOTUNE_MEASURE_MS))
+        {
+            dv = res - autotune.res_prev;
+            for (l = 0U; l < AUTOTUNE_LAGS; l++)
+            {
+                uint32_t neg = (autotune.hist >> l) & 1U;
+
+                autotune.acc.dv_s[l] += (0U != neg) ? -dv : dv;
+                autotune.acc.s_s[l]  += ((s < 0) == (0U != neg)) ? 1 : -1;
+            }
+            autotune.acc.dv  += dv;
+            autotune.acc.dv2 += (int64_t)dv * dv;
+            autotune.acc.s   += s;
+            autotune.acc.n++;
+            autotune.switches += (s != autotune.s) ? 1U : 0U;
+        }
+        autotune.hist     = (autotune.hist << 1) | ((s < 0) ? 1U : 0U);
+        autotune.s        = s;
+        autotune.res_prev = res;
+
+        if (--autotune.count == 0U)
+        {
+            u = autotune.u0;
+            autotune.phase = AUTOTUNE_PHASE_DONE;
+        }
+        else
+        {
+            u = autotune.u0 + (float32_t)(s * AUTOTUNE_AMPLITUDE);
+            u = (u > ctrl->max) ? ctrl->max : ((u < ctrl->min) ? ctrl->min : u);
+        }
+        ctrl->x1 = 0.0f;
+        ctrl->x2 = 0.0f;
+        ctrl->y1 = autotune.u0;
+        ctrl->y2 = autotune.u0;
+        BUCK1_ctx.out = (uint32_t)u;
+        Cy_HPPASS_DAC_SetValue(CURRENT_SHARE_CSG_SLICE_1, (uint16_t)BUCK1_ctx.out);
+#if (BUCK_CONV_PHASES > 1U)
+        Cy_HPPASS_DAC_SetValue(CURRENT_SHARE_CSG_SLICE_2, (uint16_t)BUCK1_ctx.out);
+#endif
+        break;
+
+    case AUTOTUNE_PHASE_APPLY:
+        for (ph = 0U; ph < BUCK_CONV_PHASES_MAX; ph++)
+        {
+            autotune.prev[ph] = gain_sched.tuned[ph];
+            gain_sched.tuned[ph] = autotune_sets[ph];
+        }
+        autotune.prev_active = gain_sched.tuned_active;
+        gain_sched.tuned_active = true;
+        gain_sched_transfer((uint8_t)(GAIN_SCHED_SET_TUNED + phase_shed.phases - 1U));
+
+        autotune.verify_peak = 0;
+        autotune.verify_sum2 = 0U;
+        autotune.count = AUTOTUNE_PERIODS(AUTOTUNE_VERIFY_MS);
+        autotune.phase = AUTOTUNE_PHASE_VERIFY;
+        break;
+
+    case AUTOTUNE_PHASE_VERIFY:
+        v = res - (int32_t)BUCK1_ctx.ref;
+        v = (v < 0) ? -v : v;
+        autotune.verify_peak = (v > autotune.verify_peak) ? v : autotune.verify_peak;
+        autotune.verify_sum2 += (uint64_t)((int64_t)v * v);
+        if (v > AUTOTUNE_VERIFY_PEAK)
+        {
+            autotune_rollback("peak");
+        }
+        else if (--autotune.count == 0U)
+        {
+            if ((float32_t)autotune.verify_sum2 >
+                (AUTOTUNE_VERIFY_RMS * AUTOTUNE_VERIFY_RMS * (float32_t)AUTOTUNE_PERIODS(AUTOTUNE_VERIFY_MS)))
+            {
+                autotune_rollback("rms");
+            }
+            else
+            {
+                autotune_finish(AUTOTUNE_RESULT_APPLIED, NULL);
+            }
+        }
+        else
+        {
+            /* Verification continues. */
+        }
+        break;
+
+    default:
+        /* DONE: evaluated by the main loop, the compensator regulates. */
+        break;
+    }
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: autotune_identify
+*********************************************************************************
+* Summary:
+* Fits dv(k) = g1 * s(k - 1) + ... + gN * s(k - N) + c to the sums of the
+* experiment by least squares. The normal equations are divided by the number
+* of periods; the sums of s(k - i) * s(k - j) and of s(k - i) differ from
+* those of s(k) * s(k - |i - j|) and s(k) by at most N terms and are taken
+* from these. With the relay amplitude A, the plant gain K from the peak
+* current of all phases to the output voltage result and the control period
+* T, the taps describe
+*  P(z) = (g1 z^-1 + ... + gN z^-N) / (1 - z^-1),
+* which well below the ESR zero equals the plant
+*  A * K * (ESR + 1 / (s C)) * exp(-s Td) = A * K / (s C) * exp(-s (Td - C ESR)),
+* with the half period that the discrete integrator leads. So
+*  C = A * K * T / sum(g), Td - C * ESR = (sum(i * g) / sum(g) - 0.5) * T.
+* The ESR follows with the loop delay of the design; a larger effective delay
+* is taken as the loop delay with no ESR. The load resistance follows from the
+* averages of the output current.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  const char *: NULL, or the cause of a rejection
+*
+*******************************************************************************/
+static const char *autotune_identify(void)
+{
+    const autotune_sums_t *a = &autotune.acc;
+    const buck_conv_t *conv = &buck_conv[BUCK_CONV_PRIMARY];
+    float32_t m[AUTOTUNE_LAGS + 1U][AUTOTUNE_LAGS + 2U];
+    float32_t n = (float32_t)a->n;
+    float32_t k = ((float32_t)autotune.phases * AUTOTUNE_COUNTS_PER_V) / AUTOTUNE_DAC_PER_A;
+    float32_t mean = (float32_t)a->dv / n;
+    float32_t var = ((float32_t)a->dv2 / n) - (mean * mean);
+    float32_t sse = (float32_t)a->dv2 / n;
+    float32_t sum = 0.0f;
+    float32_t moment = 0.0f;
+    float32_t iout = 0.0f;
+    float32_t f;
+    uint32_t i;
+    uint32_t j;
+    uint32_t r;
+
+    if ((autotune.switches < AUTOTUNE_SWITCHES_MIN) || (var <= 0.0f))
+    {
+        return "oscillation";
+    }
+
+    /* Normal equations of the taps and the constant, augmented by the right
+     * hand side. */
+    for (i = 0U; i < AUTOTUNE_LAGS; i++)
+    {
+        for (j = 0U; j < AUTOTUNE_LAGS; j++)
+        {
+            m[i][j] = (i == j) ? 1.0f : ((float32_t)a->s_s[((i > j) ? (i - j) : (j - i)) - 1U] / n);
+        }
+        m[i][AUTOTUNE_LAGS] = (float32_t)a->s / n;
+        m[AUTOTUNE_LAGS][i] = (float32_t)a->s / n;
+        m[i][AUTOTUNE_LAGS + 1U] = (float32_t)a->dv_s[i] / n;
+    }
+    m[AUTOTUNE_LAGS][AUTOTUNE_LAGS] = 1.0f;
+    m[AUTOTUNE_LAGS][AUTOTUNE_LAGS + 1U] = mean;
+
+    /* Gaussian elimination, the matrix is symmetric positive definite. */
+    for (i = 0U; i <= AUTOTUNE_LAGS; i++)
+    {
+        if (m[i][i] < 1.0e-4f)
+        {
+            return "oscillation";
+        }
+        for (r = i + 1U; r <= AUTOTUNE_LAGS; r++)
+        {
+            f = m[r][i] / m[i][i];
+            for (j = i; j <= (AUTOTUNE_LAGS + 1U); j++)
+            {
+                m[r][j] -= f * m[i][j];
+            }
+        }
+    }
+    for (i = AUTOTUNE_LAGS + 1U; i-- > 0U;)
+    {
+        f = m[i][AUTOTUNE_LAGS + 1U];
+        for (j = i + 1U; j <= AUTOTUNE_LAGS; j++)
+        {
+            f -= m[i][j] * m[j][AUTOTUNE_LAGS + 1U];
+        }
+        m[i][AUTOTUNE_LAGS + 1U] = f / m[i][i];
+    }
+
+    /* The back substitution leaves the solution in the last column, the
+     * residual is sum(dv^2) less the solution times the right hand side. */
+    for (i = 0U; i < AUTOTUNE_LAGS; i++)
+    {
+        autotune.taps[i] = m[i][AUTOTUNE_LAGS + 1U];
+        sum    += autotune.taps[i];
+        moment += (float32_t)(i + 1U) * autotune.taps[i];
+        sse    -= autotune.taps[i] * ((float32_t)a->dv_s[i] / n);
+    }
+    sse -= m[AUTOTUNE_LAGS][AUTOTUNE_LAGS + 1U] * mean;
+
+    for (i = 0U; i < BUCK_CONV_PHASES; i++)
+    {
+        iout += (float32_t)PROT_AVG_Q15(conv->iout_avg[i]) / (32768.0f * AUTOTUNE_IOUT_COUNTS_PER_A);
+    }
+    iout = (iout > AUTOTUNE_IOUT_MIN) ? iout : AUTOTUNE_IOUT_MIN;
+
+    autotune.plant.fit    = 1.0f - (sse / var);
+    autotune.plant.r_load = ((float32_t)autotune.ref / AUTOTUNE_COUNTS_PER_V) / iout;
+    if (sum <= 0.0f)
+    {
+        return "fit";
+    }
+    autotune.plant.c_uf      = (1.0e6f * (float32_t)AUTOTUNE_AMPLITUDE * k) / ((float32_t)AUTOTUNE_CTRL_FREQ_HZ * sum);
+    autotune.plant.delay_eff = (moment / sum) - 0.5f;
+    autotune.plant.delay     = (autotune.plant.delay_eff > AUTOTUNE_NOM_DELAY) ? autotune.plant.delay_eff :
+                               AUTOTUNE_NOM_DELAY;
+    autotune.plant.esr_mohm  = ((autotune.plant.delay - autotune.plant.delay_eff) * 1.0e9f) /
+                               ((float32_t)AUTOTUNE_CTRL_FREQ_HZ * autotune.plant.c_uf);
+
+    if (autotune.plant.fit < AUTOTUNE_FIT_MIN)
+    {
+        return "fit";
+    }
+    if ((autotune.plant.c_uf < AUTOTUNE_C_MIN_UF) || (autotune.plant.c_uf > AUTOTUNE_C_MAX_UF))
+    {
+        return "capacitance";
+    }
+    if (autotune.plant.esr_mohm > AUTOTUNE_ESR_MAX_MOHM)
+    {
+        return "esr";
+    }
+    if (autotune.plant.delay > AUTOTUNE_DELAY_MAX)
+    {
+        return "delay";
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+* Function name: autotune_design
+*********************************************************************************
+* Summary:
+* Designs the integrator plus zero/pole pair (K-factor method) that places the
+* crossover at AUTOTUNE_CROSSOVER_HZ with AUTOTUNE_PHASE_MARGIN for a plant,
+* and discretizes it with the bilinear transform. Single precision version of
+* comp_design_2p2z() in sim/comp_design.c; the compensator gain uses
+* |(1 + jw/wz) / (jw (1 + jw/wp))| = kf / w at the crossover.
+*
+* Parameters:
+*  plant:  identified plant
+*  phases: active phases the set is designed for
+*  coef:   resulting coefficients
+*
+* Return:
+*  bool: false when the phase margin needs more boost than the zero/pole pair
+*        gives or the coefficients are not finite
+*
+*******************************************************************************/
+bool autotune_design(const autotune_plant_t *plant, uint8_t phases, gain_sched_coef_t *coef)
+{
+    const float32_t w = 2.0f * AUTOTUNE_PI * AUTOTUNE_CROSSOVER_HZ;
+    const float32_t k = 2.0f * (float32_t)AUTOTUNE_CTRL_FREQ_HZ;
+    float32_t xc = 1.0e6f / (w * plant->c_uf);
+    float32_t esr = plant->esr_mohm / 1000.0f;
+    float32_t r = plant->r_load;
+    float32_t den;
+    float32_t zr;
+    float32_t zi;
+    float32_t mag;
+    float32_t deg;
+    float32_t boost;
+    float32_t kf;
+    float32_t wp;
+    float32_t gain;
+    float32_t n1;
+    float32_t n0;
+    float32_t a0;
+
+    /* Zout = r * (esr - j xc) / (r + esr - j xc) */
+    den = ((r + esr) * (r + esr)) + (xc * xc);
+    zr  = (((r * esr) * (r + esr)) + ((r * xc) * xc)) / den;
+    zi  = ((-(r * xc) * (r + esr)) + ((r * esr) * xc)) / den;
+    mag = (((float32_t)phases * AUTOTUNE_COUNTS_PER_V) / AUTOTUNE_DAC_PER_A) * sqrtf((zr * zr) + (zi * zi));
+    deg = (atan2f(zi, zr) - ((w * plant->delay) / (float32_t)AUTOTUNE_CTRL_FREQ_HZ)) * AUTOTUNE_DEG_PER_RAD;
+
+    /* Phase the compensator must add on top of the -90 degree integrator. */
+    boost = (-180.0f + AUTOTUNE_PHASE_MARGIN) - deg + 90.0f;
+    if (boost > AUTOTUNE_BOOST_MAX)
+    {
+        return false;
+    }
+    boost = (boost < 1.0f) ? 1.0f : boost;
+    kf = tanf((45.0f + (boost / 2.0f)) / AUTOTUNE_DEG_PER_RAD);
+    wp = w * kf;
+
+    /* C(s) = gain * (1 + s/wz) / (s * (1 + s/wp)), gain sets |L(jw)| = 1. */
+    gain = w / (kf * mag);
+    n1 = gain * kf * kf;
+    n0 = gain * wp;
+    a0 = (k * k) + (wp * k);
+
+    coef->b0 = ((n1 * k) + n0) / a0;
+    coef->b1 = (2.0f * n0) / a0;
+    coef->b2 = (n0 - (n1 * k)) / a0;
+    coef->a1 = (2.0f * k * k) / a0;
+    coef->a2 = -((k * k) - (wp * k)) / a0;
+    coef->inv_b2 = 1.0f / coef->b2;
+
+    return isfinite(coef->b0) && isfinite(coef->b1) && isfinite(coef->b2) && isfinite(coef->inv_b2);
+}
+
+/*******************************************************************************
+* Function name: autotune_ready
+*********************************************************************************
+* Summary:
+* Returns true when the sums of an experiment wait for the evaluation or a
+* result has not been reported yet.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool autotune_ready(void)
+{
+    return (autotune.phase == AUTOTUNE_PHASE_DONE) || autotune.report;
+}
+
+/*******************************************************************************
+* Function name: autotune_process
+*********************************************************************************
+* Summary:
+* Called from the main loop when autotune_ready() is true. Identifies the
+* plant from the sums of the experiment and designs the sets of one and two
+* active phases, which the control ISR then loads and verifies; the
+* experiment is rejected when the identification or the design is out of the
+* limits. A result is printed in text mode, in binary telemetry mode it is
+* kept in autotune for the debugger.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void autotune_process(void)
+{
+    const char *reason;
+    uint8_t ph;
+
+    if (autotune.phase == AUTOTUNE_PHASE_DONE)
+    {
+        reason = autotune_identify();
+        for (ph = 1U; (reason == NULL) && (ph <= BUCK_CONV_PHASES); ph++)
+        {
+            if (!autotune_design(&autotune.plant, ph, &autotune_sets[ph - 1U]))
+            {
+                reason = "design";
+            }
+        }
+        if (reason != NULL)
+        {
+            autotune_finish(AUTOTUNE_RESULT_REJECTED, reason);
+        }
+        else
+        {
+            autotune.phase = AUTOTUNE_PHASE_APPLY;
+        }
+        return;
+    }
+
+    autotune.report = false;
+#if !TELEMETRY_BINARY
+    uart_tx_printf("\r\n\nAuto-tuning %s%s%s\r\n", autotune_result_names[autotune.result],
+                   (autotune.reason != NULL) ? ": " : "", (autotune.reason != NULL) ? autotune.reason : "");
+    if ((autotune.result != AUTOTUNE_RESULT_ABORTED) && (autotune.acc.n > 0U))
+    {
+        uart_tx_printf("C %.0f uF (design %.0f uF), ESR %.1f mOhm (design %.1f mOhm), delay %.1f (design %.1f), "
+                       "load %.2f Ohm, fit %.3f\r\n",
+                       (float64_t)autotune.plant.c_uf, (float64_t)AUTOTUNE_NOM_C_UF,
+                       (float64_t)autotune.plant.esr_mohm, (float64_t)AUTOTUNE_NOM_ESR_MOHM,
+                       (float64_t)autotune.plant.delay, (float64_t)AUTOTUNE_NOM_DELAY,
+                       (float64_t)autotune.plant.r_load, (float64_t)autotune.plant.fit);
+    }
+    if ((autotune.result == AUTOTUNE_RESULT_APPLIED) || (autotune.result == AUTOTUNE_RESULT_ROLLED_BACK))
+    {
+        uart_tx_printf("Verification peak %ld counts (limit %d)\r\n", (long)autotune.verify_peak,
+                       AUTOTUNE_VERIFY_PEAK);
+    }
+#endif
+}
+
+/*******************************************************************************
+* Function name: autotune_result_name
+*********************************************************************************
+* Summary:
+* Returns the name of a result.
+*
+* Parameters:
+*  result: result
+*
+* Return:
+*  const char *
+*
+*******************************************************************************/
+const char *autotune_result_name(autotune_result_t result)
+{
+    return (result < AUTOTUNE_RESULTS) ? autotune_result_names[result] : "";
+}
+
+/* [] END OF FILE */
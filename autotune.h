@@ -0,0 +1,262 @@
+/*******************************************************************************
+* File Name: autotune.h
+*
+* Description:
+* Relay feedback auto-tuning of the BUCK1 voltage loop compensator. Started
+* from the IDLE state, the converter soft starts and settles in RUN; the
+* compensator output is then replaced by a relay with hysteresis around the
+* settled peak current reference, which makes the output voltage oscillate in
+* a small band around the reference. During the oscillation the control ISR
+* correlates the change of the output voltage result with the relay outputs
+* of the previous periods, so no waveform is stored. The main loop fits the
+* response dv(k) = g1 * s(k - 1) + ... + gN * s(k - N) + c by least squares.
+* The sum of the taps gives the output capacitance, their centroid the
+* effective delay of the plant, which is the loop delay less the phase lead
+* of the ESR zero: well below the ESR zero the two cannot be told apart, so
+* the ESR is taken from the difference to the loop delay of the digital
+* control (TimeDelay), which does not change with the components. In peak
+* current mode the inductor is inside the current loop and does not appear in
+* the voltage loop plant, so it is not identified. The 2P2Z coefficients for
+* the design crossover and phase margin are computed for the identified plant
+* (the K-factor method of sim/comp_design.c) and applied as the tuned sets of
+* the gain scheduling. The result is rejected when the identified values or
+* the design are out of the safety limits, and rolled back when the output
+* voltage error exceeds its limits in the verification window that follows.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "gain_sched.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Design targets of the BUCK1 solution in design.modus (CrossoverFreq,
+ * PhaseMargin), the same as for the PCC tool coefficients. */
+#define AUTOTUNE_CROSSOVER_HZ       (5000.0f)
+#define AUTOTUNE_PHASE_MARGIN       (50.0f)
+
+/* Plant of design.modus (C0Capacitance, C0Esr, TimeDelay), the limits of the
+ * identified values are relative to it. */
+#define AUTOTUNE_NOM_C_UF           (236.0f)
+#define AUTOTUNE_NOM_ESR_MOHM       (12.5f)
+#define AUTOTUNE_NOM_DELAY          (2.0f)
+
+/* Safety limits of the identification: output capacitance, ESR, loop delay in
+ * control periods and the minimum coefficient of determination of the fit,
+ * which the quantization of the output voltage result limits for a large
+ * capacitance. */
+#define AUTOTUNE_C_MIN_UF           (AUTOTUNE_NOM_C_UF * 0.5f)
+#define AUTOTUNE_C_MAX_UF           (AUTOTUNE_NOM_C_UF * 4.0f)
+#define AUTOTUNE_ESR_MAX_MOHM       (AUTOTUNE_NOM_ESR_MOHM * 4.0f)
+#define AUTOTUNE_DELAY_MAX          (4.0f)
+#define AUTOTUNE_FIT_MIN            (0.5f)
+
+/* Relay: amplitude around the settled compensator output, CSG DAC counts per
+ * phase (3.36 mA per count), and hysteresis around the reference, ADC counts
+ * (3.37 mV per count). */
+#define AUTOTUNE_AMPLITUDE          (100)
+#define AUTOTUNE_HYSTERESIS         (8)
+
+/* The relay starts AUTOTUNE_START_DELAY_MS after the end of the soft start,
+ * runs AUTOTUNE_SETTLE_MS until the oscillation is established and is then
+ * measured over AUTOTUNE_MEASURE_MS. The experiment is aborted when the
+ * output voltage leaves the reference by more than AUTOTUNE_WINDOW ADC counts,
+ * and rejected with less than AUTOTUNE_SWITCHES_MIN relay switches. */
+#define AUTOTUNE_START_DELAY_MS     (200U)
+#define AUTOTUNE_SETTLE_MS          (2U)
+#define AUTOTUNE_MEASURE_MS         (20U)
+#define AUTOTUNE_WINDOW             (60)
+#define AUTOTUNE_SWITCHES_MIN       (40U)
+
+/* Taps of the fitted response, control periods after the relay output */
+#define AUTOTUNE_LAGS               (5U)
+
+/* Verification of the tuned coefficients over AUTOTUNE_VERIFY_MS: rolled back
+ * when the output voltage error exceeds AUTOTUNE_VERIFY_PEAK ADC counts or its
+ * RMS value exceeds AUTOTUNE_VERIFY_RMS ADC counts. */
+#define AUTOTUNE_VERIFY_MS          (50U)
+#define AUTOTUNE_VERIFY_PEAK        (30)
+#define AUTOTUNE_VERIFY_RMS         (3.0f)
+
+/* Control ISR frequency (SwitchingFreq, control loop divider 1). */
+#define AUTOTUNE_CTRL_FREQ_HZ       (300000U)
+
+/* Output voltage sense: ADC counts per V (exGain0). CSG DAC counts per A of
+ * peak current and phase (CurSenseGain). Output current sense: ADC counts per
+ * A (exGain1). */
+#define AUTOTUNE_COUNTS_PER_V       (4095.0f * 0.239f / 3.3f)
+#define AUTOTUNE_DAC_PER_A          (1023.0f / 3.3f * 0.960f)
+#define AUTOTUNE_IOUT_COUNTS_PER_A  (4095.0f / 3.3f * 0.5f)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    AUTOTUNE_PHASE_OFF,             /* No experiment */
+    AUTOTUNE_PHASE_WAIT,            /* Waiting for the converter to settle in RUN */
+    AUTOTUNE_PHASE_RELAY,           /* Relay running, measured after the settling */
+    AUTOTUNE_PHASE_DONE,            /* Sums complete, evaluated by autotune_process() */
+    AUTOTUNE_PHASE_APPLY,           /* Tuned sets computed, loaded by the next control ISR */
+    AUTOTUNE_PHASE_VERIFY           /* Tuned sets in use, output voltage error checked */
+} autotune_phase_t;
+
+typedef enum
+{
+    AUTOTUNE_RESULT_NONE,
+    AUTOTUNE_RESULT_APPLIED,        /* Tuned sets verified and in use */
+    AUTOTUNE_RESULT_REJECTED,       /* Identification or design out of the limits */
+    AUTOTUNE_RESULT_ROLLED_BACK,    /* Verification failed, previous sets restored */
+    AUTOTUNE_RESULT_ABORTED,        /* Experiment stopped, output voltage window or state change */
+    AUTOTUNE_RESULTS
+} autotune_result_t;
+
+/* Sums of the relay experiment. s is +1 or -1, dv the change of the output
+ * voltage result from the previous period in ADC counts. */
+typedef struct
+{
+    int64_t  dv_s[AUTOTUNE_LAGS];       /* dv(k) * s(k - 1 - l) */
+    int32_t  s_s[AUTOTUNE_LAGS];        /* s(k) * s(k - 1 - l) */
+    int64_t  dv;                        /* dv(k) */
+    int64_t  dv2;                       /* dv(k)^2 */
+    int32_t  s;                         /* s(k) */
+    uint32_t n;                         /* Periods */
+} autotune_sums_t;
+
+/* Identified plant */
+typedef struct
+{
+    float32_t c_uf;                 /* Output capacitance */
+    float32_t esr_mohm;             /* ESR */
+    float32_t delay;                /* Loop delay, control periods */
+    float32_t delay_eff;            /* Effective delay of the plant, control periods */
+    float32_t r_load;               /* Load resistance at the experiment, Ohm */
+    float32_t fit;                  /* Coefficient of determination of the fit */
+} autotune_plant_t;
+
+typedef struct
+{
+    volatile autotune_phase_t phase;
+    bool              requested;    /* Experiment starts with the next RUN state */
+    autotune_result_t result;       /* Result of the last experiment */
+    const char       *reason;       /* Cause of a rejection, rollback or abort */
+    bool              report;       /* Result not yet reported */
+    uint32_t          count;        /* Control periods left in the phase */
+    int32_t           ref;          /* Reference of the experiment, ADC counts */
+    int32_t           res_prev;     /* Output voltage result of the previous period */
+    float32_t         u0;           /* Settled compensator output, DAC counts */
+    int32_t           s;            /* Relay output, +1 or -1 */
+    uint32_t          hist;         /* Relay outputs of the previous periods, bit l set for s(k - 1 - l) = -1 */
+    uint32_t          switches;     /* Relay switches in the measurement */
+    uint8_t           phases;       /* Active phases during the experiment */
+    autotune_sums_t   acc;
+    autotune_plant_t  plant;
+    float32_t         taps[AUTOTUNE_LAGS];  /* Fitted response to s(k - 1) ... s(k - N), ADC counts */
+    gain_sched_coef_t prev[BUCK_CONV_PHASES_MAX];   /* Tuned sets before the experiment */
+    bool              prev_active;
+    int32_t           verify_peak;  /* Largest output voltage error of the verification */
+    uint64_t          verify_sum2;  /* Sum of the squared errors */
+    uint32_t          runs;         /* Completed experiments */
+} autotune_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern autotune_t autotune;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+bool autotune_request(void);
+bool autotune_discard(void);
+void autotune_begin(void);
+void autotune_abort(void);
+void autotune_step(void);
+bool autotune_ready(void);
+void autotune_process(void);
+bool autotune_design(const autotune_plant_t *plant, uint8_t phases, gain_sched_coef_t *coef);
+const char *autotune_result_name(autotune_result_t result);
+
+/*******************************************************************************
+* Function Name: autotune_busy
+*********************************************************************************
+* Summary:
+* Returns true from the start of the settling until the end of the
+* verification. The load dependent functions hold the operating point while
+* it is true.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+__STATIC_INLINE bool autotune_busy(void)
+{
+    return (autotune.phase != AUTOTUNE_PHASE_OFF);
+}
+
+/*******************************************************************************
+* Function Name: autotune_control
+*********************************************************************************
+* Summary:
+* Called from the post-process callback of the control ISR after the frequency
+* response analyzer, before the current sharing writes the DAC values. Runs
+* the experiment and the verification while the auto-tuning is busy.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void autotune_control(void)
+{
+    if (autotune.phase != AUTOTUNE_PHASE_OFF)
+    {
+        autotune_step();
+    }
+}
+
+#endif  /* AUTOTUNE_H */
+/* [] END OF FILE */
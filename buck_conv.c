@@ -0,0 +1,415 @@
+/*******************************************************************************
+* File Name: buck_conv.c
+*
+* Description:
+* Descriptors of the converter instances and the start and stop sequences
+* shared by all of them.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_protection.h"
+#include "buck_conv.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Descriptor fields common to all configurations of a solution */
+#define BUCK_CONV_SOLUTION(pcc, cb)                     \
+    .name             = #pcc,                           \
+    .ctx              = &pcc##_ctx,                     \
+    .enable           = pcc##_enable,                   \
+    .disable          = pcc##_disable,                  \
+    .start            = pcc##_start,                    \
+    .ramp             = pcc##_ramp,                     \
+    .get_state        = pcc##_get_state,                \
+    .vout_prot_enable = pcc##_Vout_prot_enable,         \
+    .sched_prot       = cb##_sched_prot,                \
+    .sched_trigger    = pcc##_scheduled_adc_trigger,    \
+    .vin_result       = pcc##_Vin_get_result,           \
+    .temp_result      = pcc##_Temp_get_result,          \
+    .vout_min         = pcc##_Vout_MIN,                 \
+    .vout_max         = pcc##_Vout_MAX,                 \
+    .vin_min          = pcc##_Vin_MIN,                  \
+    .vin_max          = pcc##_Vin_MAX,                  \
+    .iout_max         = pcc##_Iout1_MAX,                \
+    .temp_max         = pcc##_Temp_MAX
+
+/* PWM of a phase from its Device Configurator name */
+#define BUCK_CONV_PWM(pwm)  { .hw = pwm##_HW, .num = pwm##_NUM, .config = &pwm##_config }
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Range of an averaged protection limit, ADC counts. The limits can be
+ * tightened at run time but not set beyond the defaults of buck_protection.h. */
+typedef struct
+{
+    uint16_t def;
+    uint16_t min;
+    uint16_t max;
+} buck_conv_limit_range_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+buck_conv_t buck_conv[BUCK_CONV_NUM];
+
+static const buck_conv_limit_range_t buck_conv_limit_range[BUCK_CONV_LIMITS] =
+{
+    [BUCK_CONV_LIMIT_VIN_MIN]  = { VIN_MIN_COUNT,  VIN_MIN_COUNT, VIN_COUNT },
+    [BUCK_CONV_LIMIT_VIN_MAX]  = { VIN_MAX_COUNT,  VIN_COUNT,     VIN_MAX_COUNT },
+    [BUCK_CONV_LIMIT_IOUT_MAX] = { IOUT_MAX_COUNT, 0U,            IOUT_MAX_COUNT },
+    [BUCK_CONV_LIMIT_TEMP_MAX] = { TEMP_MAX_COUNT, 0U,            TEMP_MAX_COUNT },
+};
+
+CONTROL_RAMCONST buck_conv_hw_t buck_conv_hw[BUCK_CONV_NUM] =
+{
+#if (BUCK_CONV_CONFIG == BUCK_CONV_MULTI_PHASE)
+    {
+        BUCK_CONV_SOLUTION(BUCK1, buck1),
+        .iout_result = { BUCK1_Iout1_get_result, BUCK1_Iout2_get_result },
+        .pwm         = { BUCK_CONV_PWM(PWM_BUCK_1), BUCK_CONV_PWM(PWM_BUCK_2) }
+    }
+#elif (BUCK_CONV_CONFIG == BUCK_CONV_SINGLE_PHASE)
+    {
+        BUCK_CONV_SOLUTION(BUCK1, buck1),
+        .iout_result = { BUCK1_Iout1_get_result },
+        .pwm         = { BUCK_CONV_PWM(PWM_BUCK_1) }
+    }
+#else
+    {
+        BUCK_CONV_SOLUTION(BUCK1, buck1),
+        .iout_result = { BUCK1_Iout1_get_result },
+        .pwm         = { BUCK_CONV_PWM(PWM_BUCK_1) }
+    },
+    {
+        BUCK_CONV_SOLUTION(BUCK2, buck2),
+        .iout_result = { BUCK2_Iout1_get_result },
+        .pwm         = { BUCK_CONV_PWM(PWM_BUCK_2) }
+    }
+#endif
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: buck_conv_init
+*********************************************************************************
+* Summary:
+* Sets the averaged protection limits of a converter to their defaults and
+* resets its protection variables. Called once at start up.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void buck_conv_init(uint8_t conv)
+{
+    uint32_t limit;
+
+    for (limit = 0U; limit < (uint32_t)BUCK_CONV_LIMITS; limit++)
+    {
+        buck_conv[conv].limit[limit] = PROT_AVG(buck_conv_limit_range[limit].def);
+    }
+    buck_conv_reset(conv);
+}
+
+/*******************************************************************************
+* Function name: buck_conv_reset
+*********************************************************************************
+* Summary:
+* Resets the scheduled ADC results, the protection averages and their filters
+* of a converter. The input voltage average starts at the nominal input voltage.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void buck_conv_reset(uint8_t conv)
+{
+    buck_conv_t *c = &buck_conv[conv];
+    uint32_t phase;
+
+    c->vin_res  = (prot_value_t)0;
+    c->temp_res = (prot_value_t)0;
+    c->vin_avg  = PROT_AVG(VIN_COUNT);
+    c->temp_avg = (prot_value_t)0;
+    for (phase = 0U; phase < BUCK_CONV_PHASES_MAX; phase++)
+    {
+        c->iout_res[phase] = (prot_value_t)0;
+        c->iout_avg[phase] = (prot_value_t)0;
+    }
+    prot_filter_reset(conv, VIN_COUNT);
+}
+
+/*******************************************************************************
+* Function name: buck_conv_set_limit
+*********************************************************************************
+* Summary:
+* Sets a limit of the averaged protection of a converter. The protection
+* callback reads each limit with a single access, so a limit can be changed
+* while the converter is running. The fast trip thresholds of the hardware
+* limit detection are not changed.
+*
+* Parameters:
+*  conv: converter index
+*  limit: limit
+*  counts: limit in ADC counts
+*
+* Return:
+*  bool: false when the limit is outside its range, it is not changed then
+*
+*******************************************************************************/
+bool buck_conv_set_limit(uint8_t conv, buck_conv_limit_t limit, uint16_t counts)
+{
+    const buck_conv_limit_range_t *range = &buck_conv_limit_range[limit];
+
+    if ((counts < range->min) || (counts > range->max))
+    {
+        return false;
+    }
+    buck_conv[conv].limit[limit] = PROT_AVG(counts);
+    return true;
+}
+
+/*******************************************************************************
+* Function name: buck_conv_get_limit
+*********************************************************************************
+* Summary:
+* Returns a limit of the averaged protection of a converter.
+*
+* Parameters:
+*  conv: converter index
+*  limit: limit
+*
+* Return:
+*  uint16_t: limit in ADC counts
+*
+*******************************************************************************/
+uint16_t buck_conv_get_limit(uint8_t conv, buck_conv_limit_t limit)
+{
+    return (uint16_t)(PROT_AVG_Q15(buck_conv[conv].limit[limit]) >> 15);
+}
+
+/*******************************************************************************
+* Function name: buck_conv_start
+*********************************************************************************
+* Summary:
+* Starts a converter from the idle state. The PWM compare values start at zero
+* and are ramped by the soft start from the control ISR together with the
+* reference. Called by the state machine on the change to the ramp state.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void buck_conv_start(uint8_t conv)
+{
+    const buck_conv_hw_t *hw = &buck_conv_hw[conv];
+    cy_rslt_t result;
+    uint32_t phase;
+
+    /* Resets variables used for protection */
+    buck_conv_reset(conv);
+
+    for (phase = 0U; phase < BUCK_CONV_PHASES; phase++)
+    {
+        Cy_TCPWM_PWM_SetCompare0Val(hw->pwm[phase].hw, hw->pwm[phase].num, 0U);
+    }
+
+    /* Enables the converter. */
+    result = hw->enable();
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Starts the converter. */
+    result = hw->start();
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    soft_start_begin(conv);
+
+    /* Enables the fast protection tier. */
+    fast_prot_arm(conv);
+}
+
+/*******************************************************************************
+* Function name: buck_conv_stop
+*********************************************************************************
+* Summary:
+* Stops a running converter. Called by the state machine on the change from
+* the test to the idle state.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void buck_conv_stop(uint8_t conv)
+{
+    cy_rslt_t result;
+
+    fast_prot_disarm(conv);
+
+    result = buck_conv_hw[conv].disable();
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+}
+
+/*******************************************************************************
+* Function name: buck_conv_ramp_done
+*********************************************************************************
+* Summary:
+* Called from the soft start timer ISR. Checks whether the generated ramp of a
+* converter in the ramp state has finished.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  bool: true when the converter can change to the run state
+*
+*******************************************************************************/
+bool buck_conv_ramp_done(uint8_t conv)
+{
+    const buck_conv_hw_t *hw = &buck_conv_hw[conv];
+
+    return (buck_conv[conv].state == Ifx_BUCK_STATE_RAMP) &&
+           (hw->get_state(MTB_PWRCONV_STATE_RUN) != 0U) && (hw->get_state(MTB_PWRCONV_STATE_RAMP) == 0U);
+}
+
+/*******************************************************************************
+* Function name: buck_conv_run
+*********************************************************************************
+* Summary:
+* Enables the output voltage protection of a converter after its soft start
+* and sets the final maximum duty cycle. Called by the state machine on the
+* change from the ramp to the run state.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void buck_conv_run(uint8_t conv)
+{
+    const buck_conv_hw_t *hw = &buck_conv_hw[conv];
+    uint32_t phase;
+
+    /* Enables the output voltage protection after soft start. */
+    hw->vout_prot_enable();
+
+    /* The soft start limits the duty cycle, the end of the ramp restores
+     * the configured maximum. */
+    for (phase = 0U; phase < BUCK_CONV_PHASES; phase++)
+    {
+        Cy_TCPWM_PWM_SetCompare0Val(hw->pwm[phase].hw, hw->pwm[phase].num, hw->pwm[phase].config->compare0);
+    }
+}
+
+/*******************************************************************************
+* Function name: buck_conv_any
+*********************************************************************************
+* Summary:
+* Checks the state of all converters.
+*
+* Parameters:
+*  state: state to look for
+*
+* Return:
+*  bool: true when at least one converter is in the state
+*
+*******************************************************************************/
+bool buck_conv_any(Ifx_buck_states state)
+{
+    uint8_t conv;
+
+    for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        if (buck_conv[conv].state == state)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*******************************************************************************
+* Function name: buck_conv_active
+*********************************************************************************
+* Summary:
+* Checks whether any converter is enabled.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: true when at least one converter is ramping, running or testing
+*
+*******************************************************************************/
+bool buck_conv_active(void)
+{
+    return buck_conv_any(Ifx_BUCK_STATE_RAMP) || buck_conv_any(Ifx_BUCK_STATE_RUN) ||
+           buck_conv_any(Ifx_BUCK_STATE_TEST);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,240 @@
+/*******************************************************************************
+* File Name: buck_conv.h
+*
+* Description:
+* Converter instances. Each converter is one PCC tool solution (BUCK1, BUCK2)
+* with a descriptor of its generated interface and PWMs in buck_conv_hw[] and
+* its state, scheduled ADC results and protection averages in buck_conv[].
+* The state machine (buck_sm.h), the averaged protection, the soft start and
+* the fast protection tier work on an instance index, and the PCC callbacks of
+* each solution are instantiated from buck_conv_callbacks.h. BUCK_CONV_CONFIG
+* selects the board configuration the same sources are built for.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef BUCK_CONV_H
+#define BUCK_CONV_H
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Board configurations:
+ * BUCK_CONV_MULTI_PHASE  - BUCK1 switches both phases into the common output
+ *                          (J14 mounted), default
+ * BUCK_CONV_SINGLE_PHASE - BUCK1 switches phase 1 only (J14 mounted)
+ * BUCK_CONV_DUAL         - BUCK1 on phase 1 and BUCK2 on phase 2, two
+ *                          independent outputs (J14 removed). Needs a BUCK2
+ *                          solution in design.modus with the same channel
+ *                          and callback names as BUCK1.
+ * Set with BUCK_CONV_CONFIG in the Makefile. The BUCK1 solution must have the
+ * matching number of phases. */
+#define BUCK_CONV_MULTI_PHASE       (0)
+#define BUCK_CONV_SINGLE_PHASE      (1)
+#define BUCK_CONV_DUAL              (2)
+
+#ifndef BUCK_CONV_CONFIG
+#define BUCK_CONV_CONFIG            (BUCK_CONV_MULTI_PHASE)
+#endif
+
+/* Number of converters and phases of each converter */
+#if (BUCK_CONV_CONFIG == BUCK_CONV_MULTI_PHASE)
+#define BUCK_CONV_NUM               (1U)
+#define BUCK_CONV_PHASES            (2U)
+#elif (BUCK_CONV_CONFIG == BUCK_CONV_SINGLE_PHASE)
+#define BUCK_CONV_NUM               (1U)
+#define BUCK_CONV_PHASES            (1U)
+#elif (BUCK_CONV_CONFIG == BUCK_CONV_DUAL)
+#define BUCK_CONV_NUM               (2U)
+#define BUCK_CONV_PHASES            (1U)
+#else
+#error "BUCK_CONV_CONFIG must be BUCK_CONV_MULTI_PHASE, BUCK_CONV_SINGLE_PHASE or BUCK_CONV_DUAL"
+#endif
+
+/* Phase channels of the results and averages. Channels beyond
+ * BUCK_CONV_PHASES stay zero. */
+#define BUCK_CONV_PHASES_MAX        (2U)
+
+/* Converter of the phase shedding, current sharing, gain scheduling, frequency
+ * response analyzer, load step metrics, capture buffer, flight recorder and
+ * telemetry. */
+#define BUCK_CONV_PRIMARY           (0U)
+
+/* Placement of the control path: 0 - flash (default), 1 - SRAM. Set with
+ * CONTROL_RAM in the Makefile. The callbacks of the solutions and the
+ * functions that they call are enclosed in CONTROL_RAMFUNC_BEGIN/END, which
+ * place them in the .cy_ramfunc section that the startup code copies to SRAM
+ * (the inline callbacks only when the compiler keeps a copy out of line); the
+ * constant tables they read are declared CONTROL_RAMCONST, which places them
+ * in the initialized data instead of the read-only data in flash. The ISRs of
+ * the solutions, with the compensator, are placed by the "Place in RAM"
+ * parameter (ram) of the solutions in design.modus.
+ * sim/hot_path_report checks the placement in the linked image. */
+#ifndef CONTROL_RAM
+#define CONTROL_RAM                 (0)
+#endif
+
+#if CONTROL_RAM
+#define CONTROL_RAMFUNC_BEGIN       CY_RAMFUNC_BEGIN
+#define CONTROL_RAMFUNC_END         CY_RAMFUNC_END
+#define CONTROL_RAMCONST            CY_SECTION(".data")
+#else
+#define CONTROL_RAMFUNC_BEGIN
+#define CONTROL_RAMFUNC_END
+#define CONTROL_RAMCONST            const
+#endif
+
+/* Number of samples for averaging the parameters used for overload protection */
+#define AVERAGING_SAMPLES     (8U)
+#define AVERAGING_SHIFT       (3U)         /* log2(AVERAGING_SAMPLES) */
+#if ((1U << AVERAGING_SHIFT) != AVERAGING_SAMPLES)
+#error "AVERAGING_SAMPLES must be 2^AVERAGING_SHIFT"
+#endif
+
+/* Protection arithmetic: 0 - float32 averages (default), 1 - integer averages
+ * on raw ADC counts. Set with BUCK_PROT_FIXED_POINT in the Makefile. */
+#ifndef BUCK_PROT_FIXED_POINT
+#define BUCK_PROT_FIXED_POINT (0)
+#endif
+
+#if BUCK_PROT_FIXED_POINT
+/* Averages are held in ADC counts with AVERAGING_FRAC_BITS fractional bits
+ * (12 + 15 bits, Q31 range); the ADC results are plain counts. */
+#define AVERAGING_FRAC_BITS   (15U)
+typedef int32_t prot_value_t;
+#define PROT_AVG(counts)      ((prot_value_t)((counts) * (1L << AVERAGING_FRAC_BITS)))
+#if (AVERAGING_FRAC_BITS != 15U)
+#error "PROT_AVG_Q15 assumes 15 fractional bits"
+#endif
+#define PROT_AVG_Q15(avg)     ((int32_t)(avg))
+#else
+typedef float32_t prot_value_t;
+#define PROT_AVG(counts)      ((prot_value_t)(counts))
+#define PROT_AVG_Q15(avg)     ((int32_t)((avg) * 32768.0f))
+#endif
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* buck converter states */
+typedef enum Ifx_buck_states
+{
+    Ifx_BUCK_STATE_IDLE      = 0,
+    Ifx_BUCK_STATE_RAMP      = 1,
+    Ifx_BUCK_STATE_RUN       = 2,
+    Ifx_BUCK_STATE_TEST      = 3,
+    Ifx_BUCK_STATE_FAULT     = 4
+}Ifx_buck_states;
+
+/* Limits of the averaged protection of a converter */
+typedef enum
+{
+    BUCK_CONV_LIMIT_VIN_MIN,
+    BUCK_CONV_LIMIT_VIN_MAX,
+    BUCK_CONV_LIMIT_IOUT_MAX,                               /* Each phase */
+    BUCK_CONV_LIMIT_TEMP_MAX,
+    BUCK_CONV_LIMITS
+} buck_conv_limit_t;
+
+/* PWM of one phase */
+typedef struct
+{
+    TCPWM_Type                      *hw;
+    uint32_t                         num;
+    const cy_stc_tcpwm_pwm_config_t *config;
+} buck_conv_pwm_t;
+
+/* Generated interface of a PCC solution and the PWMs of its phases */
+typedef struct
+{
+    const char               *name;
+    mtb_stc_pwrconv_ctx_t    *ctx;
+    cy_rslt_t               (*enable)(void);
+    cy_rslt_t               (*disable)(void);
+    cy_rslt_t               (*start)(void);
+    void                    (*ramp)(void);
+    uint32_t                (*get_state)(uint32_t mask);
+    void                    (*vout_prot_enable)(void);
+    void                    (*sched_prot)(bool enable);     /* Limit detection of the scheduled channels */
+    void                    (*sched_trigger)(void);
+    uint16_t                (*vin_result)(void);
+    uint16_t                (*iout_result[BUCK_CONV_PHASES])(void);
+    uint16_t                (*temp_result)(void);
+    uint16_t                  vout_min;                     /* Limit detection thresholds, ADC counts */
+    uint16_t                  vout_max;
+    uint16_t                  vin_min;
+    uint16_t                  vin_max;
+    uint16_t                  iout_max;
+    uint16_t                  temp_max;
+    buck_conv_pwm_t           pwm[BUCK_CONV_PHASES];
+} buck_conv_hw_t;
+
+/* Runtime state of a converter */
+typedef struct
+{
+    volatile Ifx_buck_states state;                         /* Written by the state machine only */
+    prot_value_t vin_res;                                   /* Scheduled ADC results */
+    prot_value_t iout_res[BUCK_CONV_PHASES_MAX];
+    prot_value_t temp_res;
+    prot_value_t vin_avg;                                   /* Protection averages */
+    prot_value_t iout_avg[BUCK_CONV_PHASES_MAX];
+    prot_value_t temp_avg;
+    prot_value_t limit[BUCK_CONV_LIMITS];                   /* Averaged protection limits */
+} buck_conv_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern buck_conv_t buck_conv[BUCK_CONV_NUM];
+extern CONTROL_RAMCONST buck_conv_hw_t buck_conv_hw[BUCK_CONV_NUM];
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void buck_conv_init(uint8_t conv);
+void buck_conv_reset(uint8_t conv);
+bool buck_conv_set_limit(uint8_t conv, buck_conv_limit_t limit, uint16_t counts);
+uint16_t buck_conv_get_limit(uint8_t conv, buck_conv_limit_t limit);
+void buck_conv_start(uint8_t conv);
+void buck_conv_stop(uint8_t conv);
+bool buck_conv_ramp_done(uint8_t conv);
+void buck_conv_run(uint8_t conv);
+bool buck_conv_any(Ifx_buck_states state);
+bool buck_conv_active(void);
+
+#endif  /* BUCK_CONV_H */
+/* [] END OF FILE */
@@ -0,0 +1,321 @@
+/*******************************************************************************
+* File Name: buck_conv_callbacks.h
+*
+* Description:
+* Callbacks of one PCC tool solution. buck_protection.h includes this file
+* once per converter with
+*  BUCK_CONV_PCC - name of the solution, e.g. BUCK1
+*  BUCK_CONV_CB  - prefix of the callback names set in the solution, e.g. buck1
+*  BUCK_CONV_IDX - index of the converter in buck_conv[] and buck_conv_hw[]
+* and it defines the fault, pre-process, post-process and scheduled ADC
+* callbacks of the solution. The instance is a constant in each callback, so
+* the control ISR of a converter costs the same as one written for it alone,
+* and the functions of the primary converter are not compiled into the others.
+* There is no include guard, the parameters are undefined at the end.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#if !defined(BUCK_CONV_PCC) || !defined(BUCK_CONV_CB) || !defined(BUCK_CONV_IDX)
+#error "BUCK_CONV_PCC, BUCK_CONV_CB and BUCK_CONV_IDX must be defined"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#ifndef BUCK_CONV_CAT
+#define BUCK_CONV_CAT_(a, b)        a##b
+#define BUCK_CONV_CAT(a, b)         BUCK_CONV_CAT_(a, b)
+#endif
+
+/* Generated function of the solution and callback of the instance */
+#define BUCK_CONV_API(name)         BUCK_CONV_CAT(BUCK_CONV_PCC, name)
+#define BUCK_CONV_FUNC(name)        BUCK_CONV_CAT(BUCK_CONV_CB, name)
+
+/*******************************************************************************
+* Function Name: <cb>_sched_prot
+*********************************************************************************
+* Summary:
+* Enables or disables the limit detection of the Vin, Iout and Temp channels
+* of the solution, called by the fast protection tier through buck_conv_hw[].
+*
+* Parameters:
+*  enable: true to enable the limit detection
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+__STATIC_INLINE void BUCK_CONV_FUNC(_sched_prot)(bool enable)
+{
+    if (enable)
+    {
+        BUCK_CONV_API(_Vin_prot_enable)();
+        BUCK_CONV_API(_Iout1_prot_enable)();
+#if (BUCK_CONV_PHASES > 1U)
+        BUCK_CONV_API(_Iout2_prot_enable)();
+#endif
+        BUCK_CONV_API(_Temp_prot_enable)();
+    }
+    else
+    {
+        BUCK_CONV_API(_Vin_prot_disable)();
+        BUCK_CONV_API(_Iout1_prot_disable)();
+#if (BUCK_CONV_PHASES > 1U)
+        BUCK_CONV_API(_Iout2_prot_disable)();
+#endif
+        BUCK_CONV_API(_Temp_prot_disable)();
+    }
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function Name: <cb>_fault_callback
+*********************************************************************************
+* Summary:
+* This function is executes when a vout fault of the converter is detected, or
+* with the fast protection tier a fault of the input voltage, an output current
+* or the temperature. It disables the converter and posts the fault to the
+* state machine.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+__STATIC_INLINE void BUCK_CONV_FUNC(_fault_callback)(void)
+{
+    ISR_PROFILE_START(ISR_PROFILE_CONV(ISR_PROFILE_FAULT, BUCK_CONV_IDX));
+
+#if (BUCK_CONV_IDX == BUCK_CONV_PRIMARY)
+    /* The last scheduled sample can be up to one period old. */
+    flight_rec_sample();
+#endif
+
+    /*Fault processing after detection of the fault*/
+    fault_processing(BUCK_CONV_IDX, fast_prot_cause(BUCK_CONV_IDX));
+
+    ISR_PROFILE_STOP(ISR_PROFILE_CONV(ISR_PROFILE_FAULT, BUCK_CONV_IDX));
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function Name: <cb>_pre_process_callback
+*********************************************************************************
+* Summary:
+* This is the pre-process callback of the control ISR, executed before the
+* compensator. It starts the execution time measurement of the ISR.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+__STATIC_INLINE void BUCK_CONV_FUNC(_pre_process_callback)(void)
+{
+    ISR_PROFILE_MARK(ISR_PROFILE_CONV(ISR_PROFILE_CTRL_PERIOD, BUCK_CONV_IDX));
+    ISR_PROFILE_START(ISR_PROFILE_CONV(ISR_PROFILE_CTRL, BUCK_CONV_IDX));
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function Name: <cb>_post_process_callback
+*********************************************************************************
+* Summary:
+* This is the post-process callback of the control ISR, executed after the
+* compensator output has been written. It steps the soft start ramp and the
+* setpoint changes of the converter, stops it when the output voltage leaves
+* the window of the setpoint and triggers the fast conversions of its
+* scheduled channels. On the primary converter it also executes the phase
+* shedding transitions, loads the compensator coefficients of the gain
+* scheduling, steps the frequency response analyzer and the auto-tuning,
+* applies the current sharing trim, the analyzer perturbation and the load
+* step feedforward, follows the load steps of the TEST state and feeds the
+* capture buffer. It ends the execution time measurement of the ISR.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+__STATIC_INLINE void BUCK_CONV_FUNC(_post_process_callback)(void)
+{
+    soft_start_control(BUCK_CONV_IDX);
+
+    setpoint_control(BUCK_CONV_IDX);
+    if (setpoint_check(BUCK_CONV_IDX))
+    {
+#if (BUCK_CONV_IDX == BUCK_CONV_PRIMARY)
+        flight_rec_sample();
+#endif
+        fault_processing(BUCK_CONV_IDX, FLIGHT_REC_CAUSE_VOUT);
+    }
+
+#if (BUCK_CONV_IDX == BUCK_CONV_PRIMARY)
+#if (BUCK_CONV_PHASES > 1U)
+    phase_shed_control();
+#endif
+
+    gain_sched_control();
+
+    fra_control();
+
+    autotune_control();
+
+    load_ff_control(buck_conv[BUCK_CONV_IDX].state == Ifx_BUCK_STATE_TEST, phase_shed.phases);
+
+    current_share_apply();
+
+    load_step_control(buck_conv[BUCK_CONV_IDX].state == Ifx_BUCK_STATE_TEST);
+#endif
+
+    if (fast_prot_control(BUCK_CONV_IDX))
+    {
+        BUCK_CONV_API(_scheduled_adc_trigger)();
+    }
+
+#if (BUCK_CONV_IDX == BUCK_CONV_PRIMARY)
+    scope_sample();
+#endif
+
+    ISR_PROFILE_STOP(ISR_PROFILE_CONV(ISR_PROFILE_CTRL, BUCK_CONV_IDX));
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function Name: <cb>_scheduled_adc_callback
+*********************************************************************************
+* Summary:
+* This is the scheduled adc callback of the converter. In this function, the
+* averaged protection of the converter is implemented. On the primary
+* converter every period is recorded by the flight recorder before the limits
+* are checked, its power and energy are accumulated, and the load dependent
+* functions are updated. The temperature of each second is collected for the
+* thermal derating. The conversions
+* triggered by the fast protection tier between two soft start timer periods
+* are only checked by the hardware limit detection.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+__STATIC_INLINE void BUCK_CONV_FUNC(_scheduled_adc_callback)(void)
+{
+    buck_conv_t *conv = &buck_conv[BUCK_CONV_IDX];
+#if (BUCK_CONV_IDX == BUCK_CONV_PRIMARY)
+    bool run;
+#endif
+
+#if FAST_PROT
+    if (!fast_prot_take_tick(BUCK_CONV_IDX))
+    {
+        return;
+    }
+#endif
+
+    ISR_PROFILE_START(ISR_PROFILE_CONV(ISR_PROFILE_SCHED, BUCK_CONV_IDX));
+
+    /* Read result from ADC result register. */
+    conv->vin_res     = (prot_value_t)BUCK_CONV_API(_Vin_get_result)();
+    conv->iout_res[0] = (prot_value_t)BUCK_CONV_API(_Iout1_get_result)();
+#if (BUCK_CONV_PHASES > 1U)
+    conv->iout_res[1] = (prot_value_t)BUCK_CONV_API(_Iout2_get_result)();
+#endif
+    conv->temp_res    = (prot_value_t)BUCK_CONV_API(_Temp_get_result)();
+
+    buck_conv_average(BUCK_CONV_IDX);
+
+#if (BUCK_CONV_IDX == BUCK_CONV_PRIMARY)
+    flight_rec_sample();
+    energy_sample();
+#endif
+
+    thermal_sample(BUCK_CONV_IDX, (uint32_t)conv->temp_res);
+
+    /* Check for vin voltage, output current and temperature range */
+    buck_conv_check(BUCK_CONV_IDX);
+
+#if (BUCK_CONV_IDX == BUCK_CONV_PRIMARY)
+    /* A frequency response sweep only measures the regulating converter, the
+     * auto-tuning also verifies its result under the transient load. */
+    if (fra.active && (conv->state != Ifx_BUCK_STATE_RUN))
+    {
+        fra_abort();
+    }
+    if (autotune_busy() && (conv->state != Ifx_BUCK_STATE_RUN) &&
+        ((autotune.phase != AUTOTUNE_PHASE_VERIFY) || (conv->state != Ifx_BUCK_STATE_TEST)))
+    {
+        autotune_abort();
+    }
+
+    /* Drops or adds the second phase and selects the compensator load band
+     * depending on the load, and balances the phase currents while both
+     * phases switch. The operating point is held during a sweep and the
+     * auto-tuning. */
+    run = ((conv->state == Ifx_BUCK_STATE_RUN) || (conv->state == Ifx_BUCK_STATE_TEST)) && (!fra.active) &&
+          (!autotune_busy());
+#if (BUCK_CONV_PHASES > 1U)
+    phase_shed_update(PROT_AVG_Q15(conv->iout_avg[0]) + PROT_AVG_Q15(conv->iout_avg[1]), run);
+#endif
+    gain_sched_update(PROT_AVG_Q15(conv->iout_avg[0]) + PROT_AVG_Q15(conv->iout_avg[1]), run);
+#if (BUCK_CONV_PHASES > 1U)
+    current_share_update(PROT_AVG_Q15(conv->iout_avg[0]), PROT_AVG_Q15(conv->iout_avg[1]),
+                         run && (phase_shed.phases == 2U));
+#endif
+#endif
+
+    ISR_PROFILE_STOP(ISR_PROFILE_CONV(ISR_PROFILE_SCHED, BUCK_CONV_IDX));
+}
+CONTROL_RAMFUNC_END
+
+#undef BUCK_CONV_API
+#undef BUCK_CONV_FUNC
+#undef BUCK_CONV_PCC
+#undef BUCK_CONV_CB
+#undef BUCK_CONV_IDX
+
+/* [] END OF FILE */
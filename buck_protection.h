@@ -44,22 +44,36 @@
 #ifndef BUCK_PROTECTION_H
 #define BUCK_PROTECTION_H
 #include "cybsp.h"
+#include "scope.h"
+#include "isr_profile.h"
+#include "phase_shed.h"
+#include "gain_sched.h"
+#include "soft_start.h"
+#include "flight_rec.h"
+#include "fra.h"
+#include "autotune.h"
+#include "load_step.h"
+#include "load_ff.h"
+#include "energy.h"
+#include "thermal.h"
+#include "setpoint.h"
+#include "fast_prot.h"
+#include "prot_filter.h"
+#include "buck_conv.h"
+#include "buck_sm.h"
 
 /*******************************************************************************
 * Macros
 *******************************************************************************/
-/* buck converter states */
-typedef enum Ifx_buck_states
-{
-    Ifx_BUCK_STATE_IDLE      = 0,
-    Ifx_BUCK_STATE_RAMP      = 1,
-    Ifx_BUCK_STATE_RUN       = 2,
-    Ifx_BUCK_STATE_TEST      = 3,
-    Ifx_BUCK_STATE_FAULT     = 4
-}Ifx_buck_states;
-
-/* Number of samples for averaging the parameters used for overload protection */
-#define AVERAGING_SAMPLES     (8U)
+/* Limits of the averaged protection in ADC counts: 12 V and 42 V input, 3 A
+ * per phase, 1.3 V temperature sense (75 degC). They are the defaults and the
+ * outer bounds of the limits set at run time. The generated *_MIN/MAX
+ * limits of the solutions are the fast trip thresholds of the hardware limit
+ * detection (see fast_prot.h). */
+#define VIN_MIN_COUNT         (953)
+#define VIN_MAX_COUNT         (3336)
+#define IOUT_MAX_COUNT        (1861)
+#define TEMP_MAX_COUNT        (1613)
 
 /* input voltage */
 #define VIN_COUNT             (1906)       /* ADC count for input voltage - 24v*/
@@ -72,19 +86,6 @@ typedef enum Ifx_buck_states
 /*******************************************************************************
 * Global Variables
 *******************************************************************************/
-/* Variables used for Protection for converter 1*/
-extern float32_t buck1_iout1_adc_res;
-extern float32_t buck1_iout2_adc_res;
-extern float32_t buck1_temp_adc_res;
-extern float32_t vin_adc_res;
-extern float32_t buck1_iout1_avg;
-extern float32_t buck1_iout2_avg;
-extern float32_t buck1_temp_avg;
-extern float32_t vin_avg;
-
-/* state variable */
-extern Ifx_buck_states buck_state;
-
 /* Interrupt configuration structure of button GPIO. */
 extern cy_stc_sysint_t button_press_intr_config;
 
@@ -92,106 +93,136 @@ extern cy_stc_sysint_t button_press_intr_config;
 * Function Name: fault_processing
 *********************************************************************************
 * Summary:
-* This function is executes when a fault is detected. It disables
-* the buck converter and changes the state.
+* This function is executes when a fault is detected. It disables the
+* converter and its limit detection, stops the flight recorder of the primary
+* converter and posts the fault to the state machine, which changes the state
+* and updates the board indication, the transient load and the flight recorder
+* record at a lower priority.
 *
 * Parameters:
-*  void
+*  conv: converter index
+*  cause: FLIGHT_REC_CAUSE_* mask of the limits that tripped
 *
 * Return:
 *  void
 *
 *******************************************************************************/
-__STATIC_INLINE void fault_processing(void)
+__STATIC_INLINE void fault_processing(uint8_t conv, uint8_t cause)
 {
     /* Result variable */
     cy_rslt_t result;
 
     /* Disable the buck converter when protection condition passed. */
     /* Stops the buck converter. */
-    result = BUCK1_disable();
+    result = buck_conv_hw[conv].disable();
     if (result != CY_RSLT_SUCCESS)
     {
         CY_ASSERT(0);
     }
 
-    /* Disable the transient pulses. If it is running. */
-    Cy_TCPWM_TriggerStopOrKill_Single(PWM_LOAD_HW, PWM_LOAD_NUM);
+    /* Stops the limit detection of the scheduled channels. */
+    fast_prot_disarm(conv);
 
-    /* Turn on Fault LED. */
-    Cy_GPIO_Clr(FAULT_LED_PORT, FAULT_LED_NUM);
-
-    /* Stop Run LED */
-    Cy_TCPWM_PWM_SetCompare0Val(PWM_ACT_LED_HW, PWM_ACT_LED_NUM, CLR_LED);
-
-    /* Enables button IRQ after fault event*/
-    NVIC_EnableIRQ(button_press_intr_config.intrSrc);
+    /* Keeps the samples up to the trip until the state machine records them. */
+    if (conv == BUCK_CONV_PRIMARY)
+    {
+        flight_rec_latch();
+    }
 
-    /* Reset buck converter state to idle. */
-    buck_state = Ifx_BUCK_STATE_FAULT;
+    buck_sm_post(BUCK_SM_EV_FAULT, conv, cause);
 }
 
 /*******************************************************************************
-* Function Name: Buck 1 fault callback
+* Function Name: buck_conv_average
 *********************************************************************************
 * Summary:
-* This function is executes when a buck 1 vout fault is detected. It disables
-* the buck converter and changes the state.
+* Adds the scheduled ADC results of a converter to its protection averages
+* with the filter selected for each channel (see prot_filter.h).
 *
 * Parameters:
-*  void
+*  conv: converter index
 *
 * Return:
 *  void
 *
 *******************************************************************************/
-__STATIC_INLINE void buck1_fault_callback(void)
+__STATIC_INLINE void buck_conv_average(uint8_t conv)
 {
-    /*Fault processing after detection of the fault*/
-    fault_processing();
+    buck_conv_t *c = &buck_conv[conv];
+    prot_filter_t *f = &prot_filter[conv];
+    uint32_t phase;
+
+    for (phase = 0U; phase < BUCK_CONV_PHASES; phase++)
+    {
+        c->iout_avg[phase] = prot_filter_step(&f->iout[phase], c->iout_avg[phase], c->iout_res[phase],
+                                              PROT_FILTER_IOUT);
+    }
+    c->temp_avg = prot_filter_step(&f->temp, c->temp_avg, c->temp_res, PROT_FILTER_TEMP);
+    c->vin_avg  = prot_filter_step(&f->vin,  c->vin_avg,  c->vin_res,  PROT_FILTER_VIN);
 }
 
 /*******************************************************************************
-
-* Function Name: buck1_scheduled_adc_callback
+* Function Name: buck_conv_check
 *********************************************************************************
 * Summary:
-* This is the scheduled adc callback from the buck1 scheduled ISR. In this
-* function, protection logic for buck1 is implemented.
+* Compares the protection averages of a converter with its limits of the
+* averaged protection (buck_conv_set_limit()) and stops the converter when one
+* trips after the debounce of the compares (see prot_filter.h).
 *
 * Parameters:
-*  void
+*  conv: converter index
 *
 * Return:
 *  void
 *
 *******************************************************************************/
-
-__STATIC_INLINE void buck1_scheduled_adc_callback(void)
+__STATIC_INLINE void buck_conv_check(uint8_t conv)
 {
-    /* Read result from ADC result register. */
-    vin_adc_res        = BUCK1_Vin_get_result();
-    buck1_iout1_adc_res = BUCK1_Iout1_get_result();
-    buck1_iout2_adc_res = BUCK1_Iout2_get_result();
-    buck1_temp_adc_res = BUCK1_Temp_get_result();
-
-    /*Moving Average calculation*/
-    buck1_iout1_avg = (float32_t)((buck1_iout1_avg - ((buck1_iout1_avg - buck1_iout1_adc_res) / AVERAGING_SAMPLES)));
-    buck1_iout2_avg = (float32_t)((buck1_iout2_avg - ((buck1_iout2_avg - buck1_iout2_adc_res) / AVERAGING_SAMPLES)));
-    buck1_temp_avg = (float32_t)((buck1_temp_avg - ((buck1_temp_avg - buck1_temp_adc_res) / AVERAGING_SAMPLES)));
-    vin_avg        = (float32_t)((vin_avg        - ((vin_avg        - vin_adc_res)        / AVERAGING_SAMPLES)));
-
-
-    /* Check for vin voltage, output current and temperature range */
-    if((vin_avg < BUCK1_Vin_MIN) || (vin_avg > BUCK1_Vin_MAX) ||
-       (buck1_iout1_avg > BUCK1_Iout1_MAX) ||
-       (buck1_iout2_avg > BUCK1_Iout2_MAX) ||
-       (buck1_temp_avg > BUCK1_Temp_MAX))
+    const buck_conv_t *c = &buck_conv[conv];
+    prot_filter_t *f = &prot_filter[conv];
+    uint8_t cause = 0U;
+    uint32_t phase;
+
+    if (prot_filter_trip(&f->vin_low, c->vin_avg < c->limit[BUCK_CONV_LIMIT_VIN_MIN]))
+    {
+        cause |= FLIGHT_REC_CAUSE_VIN_LOW;
+    }
+    if (prot_filter_trip(&f->vin_high, c->vin_avg > c->limit[BUCK_CONV_LIMIT_VIN_MAX]))
+    {
+        cause |= FLIGHT_REC_CAUSE_VIN_HIGH;
+    }
+    for (phase = 0U; phase < BUCK_CONV_PHASES; phase++)
+    {
+        if (prot_filter_trip(&f->iout_high[phase], c->iout_avg[phase] > c->limit[BUCK_CONV_LIMIT_IOUT_MAX]))
+        {
+            cause |= (uint8_t)(FLIGHT_REC_CAUSE_IOUT1 << phase);
+        }
+    }
+    if (prot_filter_trip(&f->temp_high, c->temp_avg > c->limit[BUCK_CONV_LIMIT_TEMP_MAX]))
+    {
+        cause |= FLIGHT_REC_CAUSE_TEMP;
+    }
+    if (cause != 0U)
     {
         /*Fault processing after detection of the fault*/
-        fault_processing();
+        fault_processing(conv, cause);
     }
 }
 
+/*******************************************************************************
+* Callbacks of the PCC tool solutions, see buck_conv_callbacks.h
+*******************************************************************************/
+#define BUCK_CONV_PCC   BUCK1
+#define BUCK_CONV_CB    buck1
+#define BUCK_CONV_IDX   (0U)
+#include "buck_conv_callbacks.h"
+
+#if (BUCK_CONV_NUM > 1U)
+#define BUCK_CONV_PCC   BUCK2
+#define BUCK_CONV_CB    buck2
+#define BUCK_CONV_IDX   (1U)
+#include "buck_conv_callbacks.h"
+#endif
+
 #endif  /* BUCK_PROTECTION_H */
 /* [] END OF FILE */
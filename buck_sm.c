@@ -0,0 +1,643 @@
+/*******************************************************************************
+* File Name: buck_sm.c
+*
+* Description:
+* Transition table and actions of the converter state machine, executed from
+* the PendSV exception.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_protection.h"
+#include "buck_sm.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of converter states */
+#define BUCK_SM_STATES          (5U)
+
+/* Board actions requested by the transition actions */
+#define BUCK_SM_STARTED         (1U << 0)   /* A converter has started its ramp */
+#define BUCK_SM_TEST            (1U << 1)   /* A converter has entered the test state */
+#define BUCK_SM_PULSE_OFF       (1U << 2)   /* A converter has left the test state for RUN */
+
+/* Fields of a queued event */
+#define BUCK_SM_EVENT(data)     ((buck_sm_event_t)((data) & 0xFFU))
+#define BUCK_SM_CONV(data)      ((uint8_t)(((data) >> 8) & 0xFFU))
+#define BUCK_SM_CAUSE(data)     ((uint8_t)(((data) >> 16) & 0xFFU))
+
+/* Events of the button and the commands apply to all converters */
+#define BUCK_SM_ALL_CONV(event) (((event) != BUCK_SM_EV_RAMP_DONE) && ((event) != BUCK_SM_EV_FAULT))
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Action of a transition, executed before the state changes. Returns the
+ * BUCK_SM_* board actions. */
+typedef uint8_t (*buck_sm_action_t)(uint8_t conv, Ifx_buck_states state, uint8_t cause);
+
+typedef struct
+{
+    bool             valid;         /* false - the event is ignored in the state */
+    Ifx_buck_states  next;
+    buck_sm_action_t action;        /* NULL - state change only */
+} buck_sm_transition_t;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+static uint8_t buck_sm_start(uint8_t conv, Ifx_buck_states state, uint8_t cause);
+static uint8_t buck_sm_run(uint8_t conv, Ifx_buck_states state, uint8_t cause);
+static uint8_t buck_sm_test(uint8_t conv, Ifx_buck_states state, uint8_t cause);
+static uint8_t buck_sm_stop(uint8_t conv, Ifx_buck_states state, uint8_t cause);
+static uint8_t buck_sm_pulse_off(uint8_t conv, Ifx_buck_states state, uint8_t cause);
+static uint8_t buck_sm_fault(uint8_t conv, Ifx_buck_states state, uint8_t cause);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+buck_sm_t buck_sm;
+
+/* Transitions by state and event. A fault in the fault state is detected
+ * again while the limit is exceeded and keeps the first record. The stop
+ * command, like the button, clears a fault. */
+static const buck_sm_transition_t buck_sm_table[BUCK_SM_STATES][BUCK_SM_EVENTS] =
+{
+    [Ifx_BUCK_STATE_IDLE] =
+    {
+        [BUCK_SM_EV_BUTTON]    = { true,  Ifx_BUCK_STATE_RAMP,  buck_sm_start },
+        [BUCK_SM_EV_RAMP_DONE] = { false, Ifx_BUCK_STATE_IDLE,  NULL },
+        [BUCK_SM_EV_FAULT]     = { true,  Ifx_BUCK_STATE_FAULT, buck_sm_fault },
+        [BUCK_SM_EV_START]     = { true,  Ifx_BUCK_STATE_RAMP,  buck_sm_start },
+        [BUCK_SM_EV_STOP]      = { false, Ifx_BUCK_STATE_IDLE,  NULL },
+        [BUCK_SM_EV_PULSE_ON]  = { false, Ifx_BUCK_STATE_IDLE,  NULL },
+        [BUCK_SM_EV_PULSE_OFF] = { false, Ifx_BUCK_STATE_IDLE,  NULL },
+    },
+    [Ifx_BUCK_STATE_RAMP] =
+    {
+        /* The button is disabled during the soft start. */
+        [BUCK_SM_EV_BUTTON]    = { false, Ifx_BUCK_STATE_RAMP,  NULL },
+        [BUCK_SM_EV_RAMP_DONE] = { true,  Ifx_BUCK_STATE_RUN,   buck_sm_run },
+        [BUCK_SM_EV_FAULT]     = { true,  Ifx_BUCK_STATE_FAULT, buck_sm_fault },
+        [BUCK_SM_EV_START]     = { false, Ifx_BUCK_STATE_RAMP,  NULL },
+        [BUCK_SM_EV_STOP]      = { true,  Ifx_BUCK_STATE_IDLE,  buck_sm_stop },
+        [BUCK_SM_EV_PULSE_ON]  = { false, Ifx_BUCK_STATE_RAMP,  NULL },
+        [BUCK_SM_EV_PULSE_OFF] = { false, Ifx_BUCK_STATE_RAMP,  NULL },
+    },
+    [Ifx_BUCK_STATE_RUN] =
+    {
+        [BUCK_SM_EV_BUTTON]    = { true,  Ifx_BUCK_STATE_TEST,  buck_sm_test },
+        [BUCK_SM_EV_RAMP_DONE] = { false, Ifx_BUCK_STATE_RUN,   NULL },
+        [BUCK_SM_EV_FAULT]     = { true,  Ifx_BUCK_STATE_FAULT, buck_sm_fault },
+        [BUCK_SM_EV_START]     = { false, Ifx_BUCK_STATE_RUN,   NULL },
+        [BUCK_SM_EV_STOP]      = { true,  Ifx_BUCK_STATE_IDLE,  buck_sm_stop },
+        [BUCK_SM_EV_PULSE_ON]  = { true,  Ifx_BUCK_STATE_TEST,  buck_sm_test },
+        [BUCK_SM_EV_PULSE_OFF] = { false, Ifx_BUCK_STATE_RUN,   NULL },
+    },
+    [Ifx_BUCK_STATE_TEST] =
+    {
+        [BUCK_SM_EV_BUTTON]    = { true,  Ifx_BUCK_STATE_IDLE,  buck_sm_stop },
+        [BUCK_SM_EV_RAMP_DONE] = { false, Ifx_BUCK_STATE_TEST,  NULL },
+        [BUCK_SM_EV_FAULT]     = { true,  Ifx_BUCK_STATE_FAULT, buck_sm_fault },
+        [BUCK_SM_EV_START]     = { false, Ifx_BUCK_STATE_TEST,  NULL },
+        [BUCK_SM_EV_STOP]      = { true,  Ifx_BUCK_STATE_IDLE,  buck_sm_stop },
+        [BUCK_SM_EV_PULSE_ON]  = { false, Ifx_BUCK_STATE_TEST,  NULL },
+        [BUCK_SM_EV_PULSE_OFF] = { true,  Ifx_BUCK_STATE_RUN,   buck_sm_pulse_off },
+    },
+    [Ifx_BUCK_STATE_FAULT] =
+    {
+        [BUCK_SM_EV_BUTTON]    = { true,  Ifx_BUCK_STATE_IDLE,  NULL },
+        [BUCK_SM_EV_RAMP_DONE] = { false, Ifx_BUCK_STATE_FAULT, NULL },
+        [BUCK_SM_EV_FAULT]     = { false, Ifx_BUCK_STATE_FAULT, NULL },
+        [BUCK_SM_EV_START]     = { false, Ifx_BUCK_STATE_FAULT, NULL },
+        [BUCK_SM_EV_STOP]      = { true,  Ifx_BUCK_STATE_IDLE,  NULL },
+        [BUCK_SM_EV_PULSE_ON]  = { false, Ifx_BUCK_STATE_FAULT, NULL },
+        [BUCK_SM_EV_PULSE_OFF] = { false, Ifx_BUCK_STATE_FAULT, NULL },
+    },
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: buck_sm_start
+*********************************************************************************
+* Summary:
+* IDLE to RAMP. Resets the load dependent functions of the primary converter
+* and the thermal derating, and starts the converter, the reference and the
+* compare values are ramped from the control ISR.
+*
+* Parameters:
+*  conv: converter index
+*  state: current state
+*  cause: unused
+*
+* Return:
+*  uint8_t: BUCK_SM_STARTED
+*
+*******************************************************************************/
+static uint8_t buck_sm_start(uint8_t conv, Ifx_buck_states state, uint8_t cause)
+{
+    (void)state;
+    (void)cause;
+
+    if (conv == BUCK_CONV_PRIMARY)
+    {
+        current_share_reset();
+        phase_shed_reset();
+        gain_sched_reset();
+        load_step_reset();
+        load_ff_reset();
+    }
+
+    /* Starts without derating of the peak current limit. */
+    thermal_begin(conv);
+
+    /* The output voltage window follows the setpoint of the soft start. */
+    setpoint_begin(conv);
+
+    /* The control ISR has not run while the converter was off. */
+    ISR_PROFILE_RESYNC(ISR_PROFILE_CONV(ISR_PROFILE_CTRL_PERIOD, conv));
+
+    buck_conv_start(conv);
+
+    return BUCK_SM_STARTED;
+}
+
+/*******************************************************************************
+* Function name: buck_sm_run
+*********************************************************************************
+* Summary:
+* RAMP to RUN. Enables the output voltage protection and, when requested,
+* starts the auto-tuning of the primary converter or, with FRA, measures its
+* loop gain once it has settled.
+*
+* Parameters:
+*  conv: converter index
+*  state: current state
+*  cause: unused
+*
+* Return:
+*  uint8_t: no board action
+*
+*******************************************************************************/
+static uint8_t buck_sm_run(uint8_t conv, Ifx_buck_states state, uint8_t cause)
+{
+    (void)state;
+    (void)cause;
+
+    buck_conv_run(conv);
+
+    if (conv == BUCK_CONV_PRIMARY)
+    {
+        if (autotune.requested)
+        {
+            autotune_begin();
+        }
+#if FRA
+        else
+        {
+            fra_start();
+        }
+#endif
+    }
+
+    return 0U;
+}
+
+/*******************************************************************************
+* Function name: buck_sm_test
+*********************************************************************************
+* Summary:
+* RUN to TEST. The transient load is started by the board action.
+*
+* Parameters:
+*  conv: converter index
+*  state: current state
+*  cause: unused
+*
+* Return:
+*  uint8_t: BUCK_SM_TEST
+*
+*******************************************************************************/
+static uint8_t buck_sm_test(uint8_t conv, Ifx_buck_states state, uint8_t cause)
+{
+    (void)conv;
+    (void)state;
+    (void)cause;
+
+    return BUCK_SM_TEST;
+}
+
+/*******************************************************************************
+* Function name: buck_sm_stop
+*********************************************************************************
+* Summary:
+* RAMP, RUN or TEST to IDLE. Stops the converter.
+*
+* Parameters:
+*  conv: converter index
+*  state: current state
+*  cause: unused
+*
+* Return:
+*  uint8_t: no board action
+*
+*******************************************************************************/
+static uint8_t buck_sm_stop(uint8_t conv, Ifx_buck_states state, uint8_t cause)
+{
+    (void)state;
+    (void)cause;
+
+    buck_conv_stop(conv);
+
+    return 0U;
+}
+
+/*******************************************************************************
+* Function name: buck_sm_pulse_off
+*********************************************************************************
+* Summary:
+* TEST to RUN. The transient load is stopped by the board action.
+*
+* Parameters:
+*  conv: converter index
+*  state: current state
+*  cause: unused
+*
+* Return:
+*  uint8_t: BUCK_SM_PULSE_OFF
+*
+*******************************************************************************/
+static uint8_t buck_sm_pulse_off(uint8_t conv, Ifx_buck_states state, uint8_t cause)
+{
+    (void)conv;
+    (void)state;
+    (void)cause;
+
+    return BUCK_SM_PULSE_OFF;
+}
+
+/*******************************************************************************
+* Function name: buck_sm_fault
+*********************************************************************************
+* Summary:
+* Any state to FAULT. The converter has already been disabled by the fault
+* callback. On the primary converter the flight recorder keeps the samples
+* before the fault and a running capture ends.
+*
+* Parameters:
+*  conv: converter index
+*  state: state before the fault
+*  cause: FLIGHT_REC_CAUSE_* mask of the limits that tripped
+*
+* Return:
+*  uint8_t: no board action
+*
+*******************************************************************************/
+static uint8_t buck_sm_fault(uint8_t conv, Ifx_buck_states state, uint8_t cause)
+{
+    if (conv == BUCK_CONV_PRIMARY)
+    {
+        flight_rec_freeze(cause, (uint8_t)state);
+
+        /* The control loop has stopped, end a running capture. */
+        scope_trigger(SCOPE_TRIG_FAULT);
+    }
+
+    return 0U;
+}
+
+/*******************************************************************************
+* Function name: buck_sm_button_enable
+*********************************************************************************
+* Summary:
+* Enables the button interrupt after the soft start or a fault. A press while
+* it was disabled is discarded, it would otherwise clear the fault or start
+* the test state as soon as the interrupt is enabled.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void buck_sm_button_enable(void)
+{
+    Cy_GPIO_ClearInterrupt(USER_BUTTON_PORT, USER_BUTTON_NUM);
+    NVIC_ClearPendingIRQ(button_press_intr_config.intrSrc);
+    NVIC_EnableIRQ(button_press_intr_config.intrSrc);
+}
+
+/*******************************************************************************
+* Function name: buck_sm_board
+*********************************************************************************
+* Summary:
+* Updates the LEDs, the transient load, the soft start timer and the button
+* interrupt after the transitions of an event. They follow all converters.
+*
+* Parameters:
+*  event: event
+*  actions: BUCK_SM_* board actions of the transitions
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void buck_sm_board(buck_sm_event_t event, uint8_t actions)
+{
+    if ((actions & BUCK_SM_STARTED) != 0U)
+    {
+        /* Disables button IRQ to avoid button actions during soft start. */
+        NVIC_DisableIRQ(button_press_intr_config.intrSrc);
+
+        /* Setting the LED indicating the run status. */
+        Cy_TCPWM_PWM_SetCompare0Val(PWM_ACT_LED_HW, PWM_ACT_LED_NUM, SET_LED);
+
+        /* Starts the soft start of the converter. */
+        Cy_TCPWM_TriggerStart_Single(SOFT_START_COUNTER_HW, SOFT_START_COUNTER_NUM);
+    }
+    else if ((actions & BUCK_SM_TEST) != 0U)
+    {
+        /* Starts PWMs for transient testing. */
+        Cy_TCPWM_TriggerStart_Single(PWM_LOAD_HW, PWM_LOAD_NUM);
+
+        /* Sets the counter for blinking the ACT LED. */
+        Cy_TCPWM_PWM_SetCompare0Val(PWM_ACT_LED_HW, PWM_ACT_LED_NUM, TOGGLE_LED);
+
+        /* Captures the control loop response to the first load steps. */
+        scope_trigger(SCOPE_TRIG_TEST);
+    }
+    else if ((actions & BUCK_SM_PULSE_OFF) != 0U)
+    {
+        /* Stops PWMs for transient testing, the converter keeps running. */
+        Cy_TCPWM_TriggerStopOrKill_Single(PWM_LOAD_HW, PWM_LOAD_NUM);
+        Cy_TCPWM_PWM_SetCompare0Val(PWM_ACT_LED_HW, PWM_ACT_LED_NUM, SET_LED);
+    }
+    else if (((event == BUCK_SM_EV_BUTTON) || (event == BUCK_SM_EV_STOP)) && !buck_conv_active())
+    {
+        /* Stops run LED. */
+        Cy_TCPWM_PWM_SetCompare0Val(PWM_ACT_LED_HW, PWM_ACT_LED_NUM, CLR_LED);
+
+        /* Stops PWMs for transient testing. */
+        Cy_TCPWM_TriggerStopOrKill_Single(PWM_LOAD_HW, PWM_LOAD_NUM);
+
+        /* Stops the soft start timer. */
+        Cy_TCPWM_TriggerStopOrKill_Single(SOFT_START_COUNTER_HW, SOFT_START_COUNTER_NUM);
+    }
+    else
+    {
+        /* No start, test or stop of the board. */
+    }
+
+    switch (event)
+    {
+        case BUCK_SM_EV_FAULT:
+        {
+            /* Disable the transient pulses. If it is running. */
+            Cy_TCPWM_TriggerStopOrKill_Single(PWM_LOAD_HW, PWM_LOAD_NUM);
+
+            /* Turn on Fault LED. */
+            Cy_GPIO_Clr(FAULT_LED_PORT, FAULT_LED_NUM);
+
+            /* Stop Run LED once no converter is enabled. */
+            if (!buck_conv_active())
+            {
+                Cy_TCPWM_PWM_SetCompare0Val(PWM_ACT_LED_HW, PWM_ACT_LED_NUM, CLR_LED);
+            }
+
+            /* Enables button IRQ after fault event*/
+            buck_sm_button_enable();
+            break;
+        }
+
+        case BUCK_SM_EV_RAMP_DONE:
+        {
+            /* Enables button IRQ after soft start. */
+            if (!buck_conv_any(Ifx_BUCK_STATE_RAMP))
+            {
+                buck_sm_button_enable();
+            }
+            break;
+        }
+
+        case BUCK_SM_EV_STOP:
+        {
+            /* Enables button IRQ after a stop during the soft start. */
+            if (!buck_conv_any(Ifx_BUCK_STATE_RAMP))
+            {
+                buck_sm_button_enable();
+            }
+
+            /* Turns OFF fault LED once no converter is in the fault state. */
+            if (!buck_conv_any(Ifx_BUCK_STATE_FAULT))
+            {
+                Cy_GPIO_Set(FAULT_LED_PORT, FAULT_LED_NUM);
+            }
+            break;
+        }
+
+        case BUCK_SM_EV_BUTTON:
+        default:
+        {
+            /* Turns OFF fault LED once no converter is in the fault state. */
+            if (!buck_conv_any(Ifx_BUCK_STATE_FAULT))
+            {
+                Cy_GPIO_Set(FAULT_LED_PORT, FAULT_LED_NUM);
+            }
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function name: buck_sm_transition
+*********************************************************************************
+* Summary:
+* Executes the transition of one converter for an event.
+*
+* Parameters:
+*  event: event
+*  conv: converter index
+*  cause: FLIGHT_REC_CAUSE_* mask of a fault event
+*
+* Return:
+*  uint8_t: BUCK_SM_* board actions, 0 when the event is ignored
+*
+*******************************************************************************/
+static uint8_t buck_sm_transition(buck_sm_event_t event, uint8_t conv, uint8_t cause)
+{
+    Ifx_buck_states state = buck_conv[conv].state;
+    const buck_sm_transition_t *t = &buck_sm_table[state][event];
+    uint8_t actions = 0U;
+
+    if (!t->valid)
+    {
+        buck_sm.ignored++;
+        return 0U;
+    }
+
+    if (t->action != NULL)
+    {
+        actions = t->action(conv, state, cause);
+    }
+    buck_conv[conv].state = t->next;
+
+    return actions;
+}
+
+/*******************************************************************************
+* Function name: buck_sm_init
+*********************************************************************************
+* Summary:
+* Empties the event queue and sets the PendSV exception to the lowest
+* priority, below the button interrupt. Called before the interrupts are
+* enabled.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void buck_sm_init(void)
+{
+    event_queue_init(&buck_sm.queue);
+    for (uint8_t conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        atomic_store_explicit(&buck_sm.fault[conv], 0U, memory_order_relaxed);
+    }
+    buck_sm.processed = 0U;
+    buck_sm.ignored = 0U;
+    buck_sm.fault_overflows = 0U;
+
+    NVIC_SetPriority(PendSV_IRQn, (1UL << __NVIC_PRIO_BITS) - 1UL);
+}
+
+/*******************************************************************************
+* Function name: buck_sm_process
+*********************************************************************************
+* Summary:
+* Executes the transitions of all queued events in the order they were posted.
+* A button or command event applies to each converter, the others to the
+* converter they were posted for. A fault that found the queue full follows
+* the queued events, which were posted before it.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void buck_sm_process(void)
+{
+    uint32_t data;
+    bool lost;
+
+    do
+    {
+        while (event_queue_get(&buck_sm.queue, &data))
+        {
+            buck_sm_event_t event = BUCK_SM_EVENT(data);
+            uint8_t conv = BUCK_SM_CONV(data);
+            uint8_t actions = 0U;
+
+            CY_ASSERT((event < BUCK_SM_EVENTS) && (conv < BUCK_CONV_NUM));
+
+            if (BUCK_SM_ALL_CONV(event))
+            {
+                for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
+                {
+                    actions |= buck_sm_transition(event, conv, 0U);
+                }
+            }
+            else
+            {
+                actions = buck_sm_transition(event, conv, BUCK_SM_CAUSE(data));
+            }
+
+            buck_sm_board(event, actions);
+            buck_sm.processed++;
+        }
+
+        lost = false;
+        for (uint8_t conv = 0U; conv < BUCK_CONV_NUM; conv++)
+        {
+            uint32_t fault = atomic_exchange_explicit(&buck_sm.fault[conv], 0U, memory_order_acquire);
+
+            if (fault != 0U)
+            {
+                buck_sm_board(BUCK_SM_EV_FAULT, buck_sm_transition(BUCK_SM_EV_FAULT, conv, (uint8_t)fault));
+                buck_sm.processed++;
+                buck_sm.fault_overflows++;
+                lost = true;
+            }
+        }
+    } while (lost);
+}
+
+/*******************************************************************************
+* Function name: PendSV_Handler
+*********************************************************************************
+* Summary:
+* PendSV exception, pended by buck_sm_post().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void PendSV_Handler(void)
+{
+    ISR_PROFILE_START(ISR_PROFILE_EVENTS);
+
+    buck_sm_process();
+
+    ISR_PROFILE_STOP(ISR_PROFILE_EVENTS);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,127 @@
+/*******************************************************************************
+* File Name: buck_sm.h
+*
+* Description:
+* Converter state machine driven by events. The button, soft start timer and
+* fault interrupts only take the immediate safety action (the fault callback
+* disables the converter) and post an event to a lock-free queue. The PendSV
+* exception, at the lowest interrupt priority, takes the events in order and
+* executes the transitions of buck_sm_table[]: it is the only writer of the
+* converter states, so the interrupts and the main loop read a consistent
+* state and a button press can no longer overwrite a fault. The commands of
+* the debug UART are posted as events as well.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef BUCK_SM_H
+#define BUCK_SM_H
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "event_queue.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Flag of buck_sm.fault[] above the FLIGHT_REC_CAUSE_* bits */
+#define BUCK_SM_FAULT_LOST          (1UL << 8)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    BUCK_SM_EV_BUTTON,              /* User button, applies to all converters */
+    BUCK_SM_EV_RAMP_DONE,           /* Reference ramp of a converter finished */
+    BUCK_SM_EV_FAULT,               /* Converter disabled by its protection */
+    BUCK_SM_EV_START,               /* Commands of uart_cmd.h, apply to all converters */
+    BUCK_SM_EV_STOP,
+    BUCK_SM_EV_PULSE_ON,
+    BUCK_SM_EV_PULSE_OFF,
+    BUCK_SM_EVENTS
+} buck_sm_event_t;
+
+typedef struct
+{
+    event_queue_t queue;
+    _Atomic uint32_t fault[BUCK_CONV_NUM];  /* Fault not queued: BUCK_SM_FAULT_LOST | cause */
+    uint32_t      processed;        /* Events taken from the queue */
+    uint32_t      ignored;          /* Events without a transition in the state */
+    uint32_t      fault_overflows;  /* Faults taken from fault[] because the queue was full */
+} buck_sm_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern buck_sm_t buck_sm;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void buck_sm_init(void);
+void buck_sm_process(void);
+void PendSV_Handler(void);
+
+/*******************************************************************************
+* Function Name: buck_sm_post
+*********************************************************************************
+* Summary:
+* Posts an event of a converter from any interrupt priority and pends the
+* PendSV exception that executes the transition. A fault is never lost: when
+* the queue is full it is kept in buck_sm.fault[] of the converter, the
+* converter is already disabled and must still reach the fault state.
+*
+* Parameters:
+*  event: event
+*  conv: converter index
+*  cause: FLIGHT_REC_CAUSE_* mask of a fault event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void buck_sm_post(buck_sm_event_t event, uint8_t conv, uint8_t cause)
+{
+    if (!event_queue_post(&buck_sm.queue, (uint32_t)event | ((uint32_t)conv << 8) | ((uint32_t)cause << 16)) &&
+        (event == BUCK_SM_EV_FAULT))
+    {
+        (void)atomic_fetch_or_explicit(&buck_sm.fault[conv], BUCK_SM_FAULT_LOST | cause, memory_order_release);
+    }
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+}
+
+#endif  /* BUCK_SM_H */
+/* [] END OF FILE */
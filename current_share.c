@@ -0,0 +1,175 @@
+/*******************************************************************************
+* File Name: current_share.c
+*
+* Description:
+* Integral controller of the current sharing loop between the two phases.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "current_share.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Integral gain in Q16 for a crossover frequency: the loop gain per update is
+ * ki * CURRENT_SHARE_PLANT_GAIN. */
+#define CURRENT_SHARE_KI(bw_hz)     ((int32_t)(((6.2831853f * (bw_hz)) /                        \
+                                                (CURRENT_SHARE_PLANT_GAIN * CURRENT_SHARE_UPDATE_HZ)) \
+                                               * 65536.0f))
+
+#define CURRENT_SHARE_ACC_MAX       ((int32_t)CURRENT_SHARE_TRIM_MAX << 15)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+current_share_t current_share =
+{
+    .enable    = true,
+    .ki        = CURRENT_SHARE_KI(CURRENT_SHARE_BANDWIDTH_HZ),
+    .acc       = 0,
+    .trim      = 0,
+    .imbalance = 0
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: current_share_set_bandwidth
+*********************************************************************************
+* Summary:
+* Sets the crossover frequency of the sharing loop. Zero or a negative value
+* opens the loop and removes the trim.
+*
+* Parameters:
+*  bandwidth_hz: crossover frequency, Hz
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void current_share_set_bandwidth(float32_t bandwidth_hz)
+{
+    if (bandwidth_hz > 0.0f)
+    {
+        current_share.ki = CURRENT_SHARE_KI(bandwidth_hz);
+        current_share.enable = true;
+    }
+    else
+    {
+        current_share.enable = false;
+        current_share_reset();
+    }
+}
+
+/*******************************************************************************
+* Function name: current_share_reset
+*********************************************************************************
+* Summary:
+* Clears the integrator and the trim before the converter starts.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void current_share_reset(void)
+{
+    current_share.acc       = 0;
+    current_share.trim      = 0;
+    current_share.imbalance = 0;
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: current_share_update
+*********************************************************************************
+* Summary:
+* Computes the imbalance metric and, while the converter regulates and the
+* load is high enough for both phases to conduct continuously, integrates the
+* current difference into the reference trim.
+*
+* Parameters:
+*  iout1_q15: averaged Iout1 result, ADC counts with 15 fractional bits
+*  iout2_q15: averaged Iout2 result, ADC counts with 15 fractional bits
+*  run:       converter in the Run or Test state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void current_share_update(int32_t iout1_q15, int32_t iout2_q15, bool run)
+{
+    int32_t error = iout1_q15 - iout2_q15;
+    int32_t total = iout1_q15 + iout2_q15;
+    int32_t acc;
+
+    if (total <= ((int32_t)CURRENT_SHARE_MIN_TOTAL << 15))
+    {
+        current_share.imbalance = 0;
+        return;
+    }
+    current_share.imbalance = (int16_t)(((int64_t)error * 1000) / total);
+
+    if (run && current_share.enable)
+    {
+        acc = current_share.acc + (int32_t)(((int64_t)error * current_share.ki) >> 16);
+        if (acc > CURRENT_SHARE_ACC_MAX)
+        {
+            acc = CURRENT_SHARE_ACC_MAX;
+        }
+        if (acc < -CURRENT_SHARE_ACC_MAX)
+        {
+            acc = -CURRENT_SHARE_ACC_MAX;
+        }
+        current_share.acc  = acc;
+        current_share.trim = (int16_t)((acc + (1 << 14)) >> 15);
+    }
+}
+CONTROL_RAMFUNC_END
+
+/* [] END OF FILE */
@@ -0,0 +1,141 @@
+/*******************************************************************************
+* File Name: current_share.h
+*
+* Description:
+* Current sharing loop of the two phases. A slow integral controller, updated
+* from the scheduled ADC callback, compares the averaged Iout1 and Iout2
+* results and trims the peak current references of the two CSG slices in
+* opposite directions around the compensator output.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef CURRENT_SHARE_H
+#define CURRENT_SHARE_H
+#include "cybsp.h"
+#include "fra.h"
+#include "buck_conv.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Default crossover frequency of the sharing loop. It must stay well below the
+ * corner of the 8-sample Iout averages (about 2 Hz at the 100 Hz update rate). */
+#ifndef CURRENT_SHARE_BANDWIDTH_HZ
+#define CURRENT_SHARE_BANDWIDTH_HZ  (0.5f)
+#endif
+
+/* Rate of current_share_update(), the scheduled ADC trigger rate. */
+#define CURRENT_SHARE_UPDATE_HZ     (100.0f)
+
+/* Maximum trim of each phase reference, CSG DAC counts (3.36 mA per count). */
+#define CURRENT_SHARE_TRIM_MAX      (60)
+
+/* Imbalance is only computed above this total current, ADC counts (0.2 A). */
+#define CURRENT_SHARE_MIN_TOTAL     (124)
+
+/* Change of Iout1 - Iout2 in ADC counts per DAC count of trim: the references
+ * move by -trim and +trim, one DAC count is 3.3 V / 1023 / CurSenseGain
+ * (0.960 V/A), the Iout sense gives 4095 / 3.3 V * 0.5 V/A counts. */
+#define CURRENT_SHARE_PLANT_GAIN    (2.0f * (3.3f / 1023.0f / 0.960f) * (4095.0f / 3.3f * 0.5f))
+
+/* CSG slices of the two phases (pass[0].csg[0].slice[1] and slice[3]) */
+#define CURRENT_SHARE_CSG_SLICE_1   (1U)
+#define CURRENT_SHARE_CSG_SLICE_2   (3U)
+#define CURRENT_SHARE_DAC_MAX       (1023)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    bool     enable;                /* Loop closed, otherwise the trim is held */
+    int32_t  ki;                    /* Integral gain, Q16 trim per Iout count */
+    int32_t  acc;                   /* Integrator, DAC counts with 15 fractional bits */
+    volatile int16_t trim;          /* Trim applied in the control ISR, DAC counts */
+    int16_t  imbalance;             /* (Iout1 - Iout2) / (Iout1 + Iout2), per mille */
+} current_share_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern current_share_t current_share;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void current_share_set_bandwidth(float32_t bandwidth_hz);
+void current_share_reset(void);
+void current_share_update(int32_t iout1_q15, int32_t iout2_q15, bool run);
+
+/*******************************************************************************
+* Function Name: current_share_apply
+*********************************************************************************
+* Summary:
+* Writes the trimmed peak current references of both phases to the CSG DACs,
+* including the perturbation of a running frequency response sweep. Called
+* from the post-process callback of the control ISR, after the compensator
+* output has been written to both slices by the generated code. A single
+* phase converter only has the first slice, and no trim.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void current_share_apply(void)
+{
+    int32_t ref  = (int32_t)BUCK1_ctx.out + fra.inject;
+    int32_t trim = current_share.trim;
+    int32_t ref1 = ref - trim;
+    int32_t ref2 = ref + trim;
+
+    if ((trim == 0) && (fra.inject == 0))
+    {
+        return;
+    }
+    ref1 = (ref1 < 0) ? 0 : ((ref1 > CURRENT_SHARE_DAC_MAX) ? CURRENT_SHARE_DAC_MAX : ref1);
+    ref2 = (ref2 < 0) ? 0 : ((ref2 > CURRENT_SHARE_DAC_MAX) ? CURRENT_SHARE_DAC_MAX : ref2);
+    Cy_HPPASS_DAC_SetValue(CURRENT_SHARE_CSG_SLICE_1, (uint16_t)ref1);
+#if (BUCK_CONV_PHASES > 1U)
+    Cy_HPPASS_DAC_SetValue(CURRENT_SHARE_CSG_SLICE_2, (uint16_t)ref2);
+#endif
+}
+
+#endif  /* CURRENT_SHARE_H */
+/* [] END OF FILE */
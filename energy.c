@@ -0,0 +1,305 @@
+/*******************************************************************************
+* File Name: energy.c
+*
+* Description:
+* Power, efficiency and energy accounting of the BUCK1 output.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <math.h>
+#include <string.h>
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "phase_shed.h"
+#include "energy.h"
+#include "telemetry.h"
+#include "uart_tx.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Power units x scheduled periods to Wh */
+#define ENERGY_WH_PER_UNIT          ((float64_t)ENERGY_W_PER_UNIT / ((float64_t)ENERGY_SAMPLE_HZ * 3600.0))
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+energy_t energy;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: energy_reset
+*********************************************************************************
+* Summary:
+* Clears the window and the energy.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void energy_reset(void)
+{
+    (void)memset(&energy, 0, sizeof(energy));
+}
+
+/*******************************************************************************
+* Function name: energy_sample
+*********************************************************************************
+* Summary:
+* Called from the scheduled ADC callback of BUCK1 after the results have been
+* read. In the RUN and TEST states, adds the output power, the estimated loss
+* and the output voltage and load current of the period to the window and the
+* energy, and latches the window when it is complete. A window interrupted by
+* another state is discarded. Integer arithmetic only.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void energy_sample(void)
+{
+    const buck_conv_t *conv = &buck_conv[BUCK_CONV_PRIMARY];
+    energy_window_t *w = &energy.acc;
+    uint32_t vout;
+    uint32_t vin;
+    uint32_t iout = 0U;
+    uint32_t p_out;
+    uint64_t p_loss = 0U;
+    uint32_t phase;
+
+    if ((conv->state != Ifx_BUCK_STATE_RUN) && (conv->state != Ifx_BUCK_STATE_TEST))
+    {
+        w->samples = 0U;
+        return;
+    }
+
+    vout = (uint32_t)buck_conv_hw[BUCK_CONV_PRIMARY].ctx->res;
+    vin  = (uint32_t)conv->vin_res;
+
+    /* Conduction loss with the square of the phase current and switching loss
+     * with the product of the input voltage and the phase current. */
+    for (phase = 0U; phase < BUCK_CONV_PHASES; phase++)
+    {
+        uint32_t i = (uint32_t)conv->iout_res[phase];
+
+        iout += i;
+        p_loss += ((uint64_t)(i * i) * ENERGY_K_COND) + ((uint64_t)(vin * i) * ENERGY_K_SWITCH);
+    }
+    p_loss = (p_loss >> 16) + ((uint64_t)ENERGY_K_PHASE * phase_shed.phases);
+    p_out = vout * iout;
+
+    if (w->samples == 0U)
+    {
+        /* Cleared field by field, without a library call from SRAM to flash. */
+        w->p_out    = 0U;
+        w->p_loss   = 0U;
+        w->vout_sq  = 0U;
+        w->iout_sq  = 0U;
+        w->vout_min = UINT16_MAX;
+        w->vout_max = 0U;
+        w->iout_min = UINT16_MAX;
+        w->iout_max = 0U;
+    }
+    w->p_out   += p_out;
+    w->p_loss  += p_loss;
+    w->vout_sq += vout * vout;
+    w->iout_sq += iout * iout;
+    w->vout_min = (uint16_t)((vout < w->vout_min) ? vout : w->vout_min);
+    w->vout_max = (uint16_t)((vout > w->vout_max) ? vout : w->vout_max);
+    w->iout_min = (uint16_t)((iout < w->iout_min) ? iout : w->iout_min);
+    w->iout_max = (uint16_t)((iout > w->iout_max) ? iout : w->iout_max);
+
+    energy.e_out  += p_out;
+    energy.e_loss += p_loss;
+
+    if (++w->samples >= ENERGY_WINDOW_SAMPLES)
+    {
+        energy.last = *w;
+        energy.windows++;
+        energy.pending = true;
+        w->samples = 0U;
+    }
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: energy_result
+*********************************************************************************
+* Summary:
+* Converts the last complete window and the energy to V, A, W and Wh. All
+* values are 0 before the first window.
+*
+* Parameters:
+*  result: converted values
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void energy_result(energy_result_t *result)
+{
+    energy_window_t w;
+    uint64_t e_out;
+    uint64_t e_loss;
+    uint32_t windows;
+    float32_t n;
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    w = energy.last;
+    e_out = energy.e_out;
+    e_loss = energy.e_loss;
+    windows = energy.windows;
+    __set_PRIMASK(primask);
+
+    (void)memset(result, 0, sizeof(*result));
+    result->windows = windows;
+    result->e_out = (float64_t)e_out * ENERGY_WH_PER_UNIT;
+    result->e_in  = (float64_t)(e_out + e_loss) * ENERGY_WH_PER_UNIT;
+    if (w.samples == 0U)
+    {
+        return;
+    }
+
+    n = (float32_t)w.samples;
+    result->p_out = (float32_t)w.p_out * (ENERGY_W_PER_UNIT / n);
+    result->p_in  = (float32_t)(w.p_out + w.p_loss) * (ENERGY_W_PER_UNIT / n);
+    result->efficiency = (w.p_out > 0U) ? (result->p_out / result->p_in) : 0.0f;
+    result->vout_min = (float32_t)w.vout_min * ENERGY_VOUT_PER_COUNT;
+    result->vout_max = (float32_t)w.vout_max * ENERGY_VOUT_PER_COUNT;
+    result->vout_rms = sqrtf((float32_t)w.vout_sq / n) * ENERGY_VOUT_PER_COUNT;
+    result->iout_min = (float32_t)w.iout_min * ENERGY_IOUT_PER_COUNT;
+    result->iout_max = (float32_t)w.iout_max * ENERGY_IOUT_PER_COUNT;
+    result->iout_rms = sqrtf((float32_t)w.iout_sq / n) * ENERGY_IOUT_PER_COUNT;
+}
+
+/*******************************************************************************
+* Function name: energy_put
+*********************************************************************************
+* Summary:
+* Writes a value to a record, least significant byte first.
+*
+*******************************************************************************/
+static void energy_put(uint8_t *dst, uint32_t value, uint32_t size)
+{
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        dst[i] = (uint8_t)(value >> (8U * i));
+    }
+}
+
+/*******************************************************************************
+* Function name: energy_send
+*********************************************************************************
+* Summary:
+* Sends the last complete window and the energy as an energy record of the
+* binary telemetry (TELEMETRY_BINARY). Called from the main loop when a
+* window has completed.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void energy_send(void)
+{
+    uint8_t record[TELEMETRY_ENERGY_SIZE + TELEMETRY_CRC_SIZE];
+    energy_result_t r;
+
+    energy.pending = false;
+    energy_result(&r);
+
+    record[TELEMETRY_ENERGY_OFS_KIND]   = (uint8_t)TELEMETRY_KIND_ENERGY;
+    record[TELEMETRY_ENERGY_OFS_PHASES] = phase_shed.phases;
+    energy_put(&record[TELEMETRY_ENERGY_OFS_WINDOW], r.windows, 4U);
+    energy_put(&record[TELEMETRY_ENERGY_OFS_P_OUT], (uint32_t)lroundf(r.p_out * 1000.0f), 4U);
+    energy_put(&record[TELEMETRY_ENERGY_OFS_P_IN], (uint32_t)lroundf(r.p_in * 1000.0f), 4U);
+    energy_put(&record[TELEMETRY_ENERGY_OFS_EFFICIENCY], (uint32_t)lroundf(r.efficiency * 10000.0f), 2U);
+    energy_put(&record[TELEMETRY_ENERGY_OFS_E_OUT], (uint32_t)llround(r.e_out * 1000.0), 4U);
+    energy_put(&record[TELEMETRY_ENERGY_OFS_E_IN], (uint32_t)llround(r.e_in * 1000.0), 4U);
+    energy_put(&record[TELEMETRY_ENERGY_OFS_VOUT_MIN], (uint32_t)lroundf(r.vout_min * 1000.0f), 2U);
+    energy_put(&record[TELEMETRY_ENERGY_OFS_VOUT_MAX], (uint32_t)lroundf(r.vout_max * 1000.0f), 2U);
+    energy_put(&record[TELEMETRY_ENERGY_OFS_VOUT_RMS], (uint32_t)lroundf(r.vout_rms * 1000.0f), 2U);
+    energy_put(&record[TELEMETRY_ENERGY_OFS_IOUT_MIN], (uint32_t)lroundf(r.iout_min * 1000.0f), 2U);
+    energy_put(&record[TELEMETRY_ENERGY_OFS_IOUT_MAX], (uint32_t)lroundf(r.iout_max * 1000.0f), 2U);
+    energy_put(&record[TELEMETRY_ENERGY_OFS_IOUT_RMS], (uint32_t)lroundf(r.iout_rms * 1000.0f), 2U);
+
+    telemetry_send_record(record, TELEMETRY_ENERGY_SIZE);
+}
+
+/*******************************************************************************
+* Function name: energy_status
+*********************************************************************************
+* Summary:
+* Prints the output power and the efficiency of the last window for the
+* status line in the RUN and TEST states.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void energy_status(void)
+{
+    energy_result_t r;
+
+    energy_result(&r);
+    if (r.windows > 0U)
+    {
+        uart_tx_printf("POUT=%.2f W  EFF=%.1f %%  ", (float64_t)r.p_out, (float64_t)(r.efficiency * 100.0f));
+    }
+}
+
+/* [] END OF FILE */
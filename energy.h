@@ -0,0 +1,149 @@
+/*******************************************************************************
+* File Name: energy.h
+*
+* Description:
+* Power and energy accounting of the BUCK1 output. The scheduled ADC callback
+* combines the output voltage, the phase currents and the input voltage of
+* each 100 Hz period in integer accumulators: the output power, the loss of
+* the power stage from a model of its conduction, switching and fixed
+* losses, and the sums for the minimum, maximum and RMS of the output voltage
+* and the load current. Each window of ENERGY_WINDOW_SAMPLES periods in the
+* RUN or TEST state is latched for the main loop, which converts it to the
+* output power, the estimated input power and the efficiency. The output and
+* input energy are accumulated from the reset.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef ENERGY_H
+#define ENERGY_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Scheduled ADC periods per window (1 s at the soft start timer rate) */
+#define ENERGY_SAMPLE_HZ            (100U)
+#define ENERGY_WINDOW_SAMPLES       (100U)
+
+/* ADC counts to V and A: output voltage (exGain0), load current (0.5 V/A) and
+ * input voltage divider. */
+#define ENERGY_VOUT_PER_COUNT       (3.3f / 4095.0f / 0.239f)
+#define ENERGY_IOUT_PER_COUNT       (3.3f / 4095.0f / 0.5f)
+#define ENERGY_VIN_PER_COUNT        (3.3f / 4095.0f / 0.064f)
+
+/* Loss model of one switching phase: resistance of the inductor and the
+ * MOSFETs, voltage-current overlap time of each edge and switching frequency
+ * for the load dependent losses, and the fixed loss of a switching phase:
+ * gate drive, and the ripple current (0.3 A peak-to-peak at 24 V input) in
+ * the resistance and at the turn-off edge. */
+#define ENERGY_R_PHASE              (0.2f)
+#define ENERGY_T_TRANSITION         (15.0e-9f)
+#define ENERGY_F_SWITCH             (300000.0f)
+#define ENERGY_P_PHASE              (0.048f)
+
+/* The accumulators are in power units of one output voltage count times one
+ * load current count. The loss terms are converted to power units with 16
+ * fractional bits at compile time. */
+#define ENERGY_W_PER_UNIT           (ENERGY_VOUT_PER_COUNT * ENERGY_IOUT_PER_COUNT)
+#define ENERGY_K_COND               ((uint32_t)((ENERGY_IOUT_PER_COUNT * ENERGY_R_PHASE / \
+                                                 ENERGY_VOUT_PER_COUNT * 65536.0f) + 0.5f))
+#define ENERGY_K_SWITCH             ((uint32_t)((ENERGY_VIN_PER_COUNT * ENERGY_T_TRANSITION * ENERGY_F_SWITCH / \
+                                                 ENERGY_VOUT_PER_COUNT * 65536.0f) + 0.5f))
+#define ENERGY_K_PHASE              ((uint32_t)((ENERGY_P_PHASE / ENERGY_W_PER_UNIT) + 0.5f))
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Sums of one window, power units and ADC counts */
+typedef struct
+{
+    uint32_t samples;
+    uint64_t p_out;                 /* Output power */
+    uint64_t p_loss;                /* Estimated loss of the power stage */
+    uint64_t vout_sq;               /* Squares of the output voltage */
+    uint64_t iout_sq;               /* Squares of the load current, sum of the phases */
+    uint16_t vout_min;
+    uint16_t vout_max;
+    uint16_t iout_min;
+    uint16_t iout_max;
+} energy_window_t;
+
+typedef struct
+{
+    energy_window_t acc;            /* Window being accumulated */
+    energy_window_t last;           /* Last complete window */
+    uint64_t e_out;                 /* Output energy since the reset, power units x periods */
+    uint64_t e_loss;                /* Estimated loss energy since the reset */
+    uint32_t windows;               /* Complete windows since the reset */
+    volatile bool pending;          /* A window completed since energy_send() */
+} energy_t;
+
+/* Last complete window and the energy, in V, A, W and Wh */
+typedef struct
+{
+    uint32_t  windows;
+    float32_t p_out;
+    float32_t p_in;                 /* Output power and estimated loss */
+    float32_t efficiency;           /* 0 without output power */
+    float32_t vout_min;
+    float32_t vout_max;
+    float32_t vout_rms;
+    float32_t iout_min;
+    float32_t iout_max;
+    float32_t iout_rms;
+    float64_t e_out;
+    float64_t e_in;
+} energy_result_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern energy_t energy;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void energy_reset(void);
+void energy_sample(void);
+void energy_result(energy_result_t *result);
+void energy_send(void);
+void energy_status(void);
+
+#endif  /* ENERGY_H */
+/* [] END OF FILE */
@@ -0,0 +1,193 @@
+/*******************************************************************************
+* File Name: event_queue.c
+*
+* Description:
+* Bounded lock-free multi-producer single-consumer event queue.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "event_queue.h"
+#ifndef EVENT_QUEUE_TEST
+#include "buck_conv.h"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The host stress test (sim/event_stress.c) builds the queue without the
+ * converter headers and gives up the processor between the steps of a post,
+ * where an interrupt of higher priority can post. */
+#ifdef EVENT_QUEUE_TEST
+void event_queue_preempt(void);
+#define EVENT_QUEUE_PREEMPT()       event_queue_preempt()
+#define CONTROL_RAMFUNC_BEGIN
+#define CONTROL_RAMFUNC_END
+#else
+#define EVENT_QUEUE_PREEMPT()
+#endif
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: event_queue_init
+*********************************************************************************
+* Summary:
+* Empties the queue. Called before any producer is enabled.
+*
+* Parameters:
+*  q: queue
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void event_queue_init(event_queue_t *q)
+{
+    uint32_t i;
+
+    for (i = 0U; i < EVENT_QUEUE_SIZE; i++)
+    {
+        atomic_store_explicit(&q->slot[i].seq, i, memory_order_relaxed);
+        q->slot[i].data = 0U;
+    }
+    atomic_store_explicit(&q->head, 0U, memory_order_relaxed);
+    atomic_store_explicit(&q->dropped, 0U, memory_order_relaxed);
+    q->tail = 0U;
+    q->depth_max = 0U;
+}
+
+/*******************************************************************************
+* Function name: event_queue_post
+*********************************************************************************
+* Summary:
+* Appends an event, from any interrupt priority or thread. The loop only
+* repeats when another producer has reserved the same slot in between, so a
+* post takes a bounded number of steps for a bounded number of producers.
+*
+* Parameters:
+*  q: queue
+*  data: event
+*
+* Return:
+*  bool: false when the queue was full and the event is dropped
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+bool event_queue_post(event_queue_t *q, uint32_t data)
+{
+    uint32_t pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+    event_queue_slot_t *slot;
+
+    for (;;)
+    {
+        int32_t diff;
+
+        slot = &q->slot[pos & EVENT_QUEUE_MASK];
+        diff = (int32_t)(atomic_load_explicit(&slot->seq, memory_order_acquire) - pos);
+        EVENT_QUEUE_PREEMPT();
+        if (diff == 0)
+        {
+            /* The slot is free for this index, reserve it. On failure pos
+             * holds the index reserved by the other producer. */
+            if (atomic_compare_exchange_weak_explicit(&q->head, &pos, pos + 1U,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            /* The slot still holds the event of the previous round. */
+            (void)atomic_fetch_add_explicit(&q->dropped, 1U, memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+        }
+    }
+
+    EVENT_QUEUE_PREEMPT();
+    slot->data = data;
+    atomic_store_explicit(&slot->seq, pos + 1U, memory_order_release);
+    return true;
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: event_queue_get
+*********************************************************************************
+* Summary:
+* Removes the oldest published event. Called by the consumer only.
+*
+* Parameters:
+*  q: queue
+*  data: event, written when the function returns true
+*
+* Return:
+*  bool: false when no event is published at the read index
+*
+*******************************************************************************/
+bool event_queue_get(event_queue_t *q, uint32_t *data)
+{
+    event_queue_slot_t *slot = &q->slot[q->tail & EVENT_QUEUE_MASK];
+    uint32_t depth;
+
+    if (atomic_load_explicit(&slot->seq, memory_order_acquire) != (q->tail + 1U))
+    {
+        return false;
+    }
+
+    depth = atomic_load_explicit(&q->head, memory_order_relaxed) - q->tail;
+    if (depth > q->depth_max)
+    {
+        q->depth_max = depth;
+    }
+
+    *data = slot->data;
+
+    /* Frees the slot for the write index of the next round. */
+    atomic_store_explicit(&slot->seq, q->tail + EVENT_QUEUE_SIZE, memory_order_release);
+    q->tail++;
+    return true;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,91 @@
+/*******************************************************************************
+* File Name: event_queue.h
+*
+* Description:
+* Bounded lock-free event queue with any number of producers and a single
+* consumer. Interrupts of any priority post 32-bit events without disabling
+* interrupts: a producer reserves a slot with a compare-and-swap on the write
+* index (LDREX/STREX on the Cortex-M33) and publishes it with the sequence
+* number of the slot. A producer that is preempted between the two steps only
+* delays the consumer, never another producer. The consumer runs at the
+* lowest priority and reads the events in the order of their reservation.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of slots, a power of two. */
+#define EVENT_QUEUE_SIZE            (16U)
+#define EVENT_QUEUE_MASK            (EVENT_QUEUE_SIZE - 1U)
+#if ((EVENT_QUEUE_SIZE & EVENT_QUEUE_MASK) != 0U)
+#error "EVENT_QUEUE_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    _Atomic uint32_t seq;                       /* Write index the slot is free for, +1 when published */
+    uint32_t         data;
+} event_queue_slot_t;
+
+typedef struct
+{
+    _Atomic uint32_t   head;                    /* Next write index, shared by the producers */
+    uint32_t           tail;                    /* Next read index, consumer only */
+    _Atomic uint32_t   dropped;                 /* Events not posted because the queue was full */
+    uint32_t           depth_max;               /* Highest number of events seen by the consumer */
+    event_queue_slot_t slot[EVENT_QUEUE_SIZE];
+} event_queue_t;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void event_queue_init(event_queue_t *q);
+bool event_queue_post(event_queue_t *q, uint32_t data);
+bool event_queue_get(event_queue_t *q, uint32_t *data);
+
+#endif  /* EVENT_QUEUE_H */
+/* [] END OF FILE */
@@ -0,0 +1,187 @@
+/*******************************************************************************
+* File Name: fast_prot.c
+*
+* Description:
+* Arming and trip cause of the fast protection tier.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "flight_rec.h"
+#include "buck_conv.h"
+#include "fast_prot.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+fast_prot_t fast_prot =
+{
+    .enable = (FAST_PROT != 0)
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: fast_prot_set_enable
+*********************************************************************************
+* Summary:
+* Allows or forbids the fast tier. Takes effect with the next start of each
+* converter.
+*
+* Parameters:
+*  enable: true to allow the fast tier
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void fast_prot_set_enable(bool enable)
+{
+    fast_prot.enable = enable && (FAST_PROT != 0);
+}
+
+/*******************************************************************************
+* Function name: fast_prot_arm
+*********************************************************************************
+* Summary:
+* Enables the limit detection of the scheduled channels of a converter and
+* the fast conversions, called when the converter is enabled.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void fast_prot_arm(uint8_t conv)
+{
+    if (fast_prot.enable)
+    {
+        buck_conv_hw[conv].sched_prot(true);
+        fast_prot.count[conv] = FAST_PROT_TRIG_DIV;
+        fast_prot.armed[conv] = true;
+    }
+}
+
+/*******************************************************************************
+* Function name: fast_prot_disarm
+*********************************************************************************
+* Summary:
+* Disables the limit detection of the scheduled channels and the fast
+* conversions when the converter stops. A limit that stays exceeded then does
+* not keep calling the fault callback.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void fast_prot_disarm(uint8_t conv)
+{
+    if (fast_prot.armed[conv])
+    {
+        fast_prot.armed[conv] = false;
+        buck_conv_hw[conv].sched_prot(false);
+    }
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: fast_prot_cause
+*********************************************************************************
+* Summary:
+* Called from the fault callback of a converter. The limit detection of all
+* its channels calls the same callback, the limits that tripped are found by
+* comparing the last results with the generated thresholds.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  uint8_t: FLIGHT_REC_CAUSE_* mask, with FLIGHT_REC_CAUSE_FAST when one of the
+*  scheduled channels tripped
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+uint8_t fast_prot_cause(uint8_t conv)
+{
+    const buck_conv_hw_t *hw = &buck_conv_hw[conv];
+    uint8_t cause = 0U;
+    uint32_t phase;
+
+    if ((hw->ctx->res > hw->vout_max) || (hw->ctx->res < hw->vout_min))
+    {
+        cause |= FLIGHT_REC_CAUSE_VOUT;
+    }
+    if (fast_prot.armed[conv])
+    {
+        if (hw->vin_result() < hw->vin_min)
+        {
+            cause |= FLIGHT_REC_CAUSE_VIN_LOW | FLIGHT_REC_CAUSE_FAST;
+        }
+        if (hw->vin_result() > hw->vin_max)
+        {
+            cause |= FLIGHT_REC_CAUSE_VIN_HIGH | FLIGHT_REC_CAUSE_FAST;
+        }
+        for (phase = 0U; phase < BUCK_CONV_PHASES; phase++)
+        {
+            if (hw->iout_result[phase]() > hw->iout_max)
+            {
+                cause |= (uint8_t)(FLIGHT_REC_CAUSE_IOUT1 << phase) | FLIGHT_REC_CAUSE_FAST;
+            }
+        }
+        if (hw->temp_result() > hw->temp_max)
+        {
+            cause |= FLIGHT_REC_CAUSE_TEMP | FLIGHT_REC_CAUSE_FAST;
+        }
+    }
+
+    /* The result may already be back inside the window. */
+    return (cause != 0U) ? cause : FLIGHT_REC_CAUSE_VOUT;
+}
+CONTROL_RAMFUNC_END
+
+/* [] END OF FILE */
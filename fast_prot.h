@@ -0,0 +1,168 @@
+/*******************************************************************************
+* File Name: fast_prot.h
+*
+* Description:
+* Fast tier of the input voltage, output current and temperature protection.
+* The HPPASS limit detection compares every conversion of the Vin, Iout and
+* Temp channels of a converter with the fast trip thresholds (hiProtValN and
+* loProtValN of its solution) and calls its fault callback like the Vout
+* limit. While a converter runs, its control ISR triggers its scheduled ADC
+* group every FAST_PROT_TRIG_DIV control periods so that the channels are
+* converted at 10 kHz instead of 100 Hz. The averaged software protection of
+* the scheduled ADC callback remains as the slower second tier at 100 Hz.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef FAST_PROT_H
+#define FAST_PROT_H
+#include "cybsp.h"
+#include "buck_conv.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Fast protection: 0 - averaged software protection only, 1 - hardware limit
+ * detection in front of it (default). Set with FAST_PROT in the Makefile. */
+#ifndef FAST_PROT
+#define FAST_PROT (1)
+#endif
+
+/* Control periods between two conversions of the scheduled ADC group while
+ * the converter runs (300 kHz / 30 = 10 kHz). */
+#define FAST_PROT_TRIG_DIV          (30U)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    bool              enable;                   /* Fast tier allowed */
+    bool              armed[BUCK_CONV_NUM];     /* Limit detection of the scheduled channels enabled */
+    uint16_t          count[BUCK_CONV_NUM];     /* Control periods until the next conversion */
+    volatile bool     tick[BUCK_CONV_NUM];      /* Soft start timer period elapsed, for the averaged tier */
+} fast_prot_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern fast_prot_t fast_prot;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void fast_prot_set_enable(bool enable);
+void fast_prot_arm(uint8_t conv);
+void fast_prot_disarm(uint8_t conv);
+uint8_t fast_prot_cause(uint8_t conv);
+
+/*******************************************************************************
+* Function Name: fast_prot_control
+*********************************************************************************
+* Summary:
+* Called from the post-process callback of the control ISR of a converter.
+* Counts the control periods between two fast conversions of its scheduled
+* channels while the fast tier is armed.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  bool: true when the scheduled ADC group is to be triggered
+*
+*******************************************************************************/
+__STATIC_INLINE bool fast_prot_control(uint8_t conv)
+{
+#if FAST_PROT
+    if (fast_prot.armed[conv] && (--fast_prot.count[conv] == 0U))
+    {
+        fast_prot.count[conv] = FAST_PROT_TRIG_DIV;
+        return true;
+    }
+#else
+    (void)conv;
+#endif
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: fast_prot_tick
+*********************************************************************************
+* Summary:
+* Called from the soft start timer ISR before it triggers the scheduled ADC
+* group of a converter. Marks its next scheduled ADC result for the averaged
+* tier.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void fast_prot_tick(uint8_t conv)
+{
+    fast_prot.tick[conv] = true;
+}
+
+/*******************************************************************************
+* Function Name: fast_prot_take_tick
+*********************************************************************************
+* Summary:
+* Called from the scheduled ADC callback. The conversions triggered by the
+* control ISR only serve the limit detection; the averages, the flight
+* recorder and the load dependent functions keep their 100 Hz period.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  bool: true when the result belongs to a soft start timer period
+*
+*******************************************************************************/
+__STATIC_INLINE bool fast_prot_take_tick(uint8_t conv)
+{
+    bool tick = fast_prot.tick[conv];
+
+    if (tick)
+    {
+        fast_prot.tick[conv] = false;
+    }
+    return tick;
+}
+
+#endif  /* FAST_PROT_H */
+/* [] END OF FILE */
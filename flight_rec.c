@@ -0,0 +1,405 @@
+/*******************************************************************************
+* File Name: flight_rec.c
+*
+* Description:
+* Pre-fault flight recorder: sample ring written by the scheduled ADC
+* callback, fault records in no-init RAM and their dump on the debug UART.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header files
+*******************************************************************************/
+#include <stddef.h>
+#include <string.h>
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "uart_tx.h"
+#include "buck_protection.h"
+#include "telemetry.h"
+#include "flight_rec.h"
+
+#if (FLIGHT_REC_DEPTH & (FLIGHT_REC_DEPTH - 1U)) != 0U
+#error "FLIGHT_REC_DEPTH must be a power of two"
+#endif
+
+#if (FLIGHT_REC_DEPTH > 255U) || (FLIGHT_REC_RECORDS > 32U)
+#error "FLIGHT_REC_DEPTH or FLIGHT_REC_RECORDS too large"
+#endif
+
+#if (TELEMETRY_FLIGHT_OFS_DATA + FLIGHT_REC_CHUNK_BYTES) > 252U
+#error "FLIGHT_REC_CHUNK_BYTES does not fit into one telemetry frame"
+#endif
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+flight_rec_t flight_rec;
+
+/* Not cleared by the start up code, so the records of earlier faults are
+ * still there after a reset. Validated by flight_rec_init(). */
+CY_NOINIT flight_rec_store_t flight_rec_store;
+
+#if !TELEMETRY_BINARY
+static const char *const flight_rec_cause_names[FLIGHT_REC_CAUSES] =
+{
+    "vin_low", "vin_high", "iout1", "iout2", "temp", "vout", "fast"
+};
+#endif
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: flight_rec_crc
+*********************************************************************************
+* Summary:
+* CRC of a fault record, over all bytes before the CRC field.
+*
+* Parameters:
+*  rec: fault record
+*
+* Return:
+*  uint32_t: CRC-16 of the record, zero extended
+*
+*******************************************************************************/
+static uint32_t flight_rec_crc(const flight_rec_record_t *rec)
+{
+    return (uint32_t)telemetry_crc16((const uint8_t *)rec, offsetof(flight_rec_record_t, crc));
+}
+
+/*******************************************************************************
+* Function name: flight_rec_init
+*********************************************************************************
+* Summary:
+* Called once at start up. Clears the retained store when its header is not
+* plausible (power on), counts the start up, invalidates records with a wrong
+* CRC and schedules the valid ones for the dump. Starts an empty ring.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void flight_rec_init(void)
+{
+    flight_rec_store_t *store = &flight_rec_store;
+    uint32_t pending = 0U;
+
+    if ((store->magic != FLIGHT_REC_STORE_MAGIC) || (store->next >= FLIGHT_REC_RECORDS))
+    {
+        memset(store, 0, sizeof(*store));
+        store->magic = FLIGHT_REC_STORE_MAGIC;
+    }
+    store->boots++;
+
+    for (uint32_t slot = 0U; slot < FLIGHT_REC_RECORDS; slot++)
+    {
+        flight_rec_record_t *rec = &store->rec[slot];
+
+        if ((rec->magic == FLIGHT_REC_MAGIC) && (rec->count <= FLIGHT_REC_DEPTH) &&
+            (rec->crc == flight_rec_crc(rec)))
+        {
+            pending |= 1UL << slot;
+        }
+        else
+        {
+            rec->magic = 0U;
+        }
+    }
+
+    flight_rec.tick    = 0U;
+    flight_rec.wr      = 0U;
+    flight_rec.filled  = 0U;
+    flight_rec.sent    = 0U;
+    flight_rec.sent_fault = 0U;
+    flight_rec.pending = pending;
+    flight_rec.frozen  = false;
+}
+
+/*******************************************************************************
+* Function name: flight_rec_sample
+*********************************************************************************
+* Summary:
+* Stores one sample, called from the scheduled ADC callback after the
+* averages have been updated and from the output voltage fault callback. No
+* sample is stored between a fault and its record.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void flight_rec_sample(void)
+{
+    flight_rec_sample_t *s = &flight_rec.ring[flight_rec.wr];
+
+    if (flight_rec.frozen)
+    {
+        return;
+    }
+
+    s->vout      = (uint16_t)BUCK1_ctx.res;
+    s->vin       = (uint16_t)buck_conv[BUCK_CONV_PRIMARY].vin_res;
+    s->iout1     = (uint16_t)buck_conv[BUCK_CONV_PRIMARY].iout_res[0];
+    s->iout2     = (uint16_t)buck_conv[BUCK_CONV_PRIMARY].iout_res[1];
+    s->temp      = (uint16_t)buck_conv[BUCK_CONV_PRIMARY].temp_res;
+    s->state     = (uint8_t)buck_conv[BUCK_CONV_PRIMARY].state;
+    s->phases    = phase_shed.phases;
+    s->vin_avg   = PROT_AVG_Q15(buck_conv[BUCK_CONV_PRIMARY].vin_avg);
+    s->iout1_avg = PROT_AVG_Q15(buck_conv[BUCK_CONV_PRIMARY].iout_avg[0]);
+    s->iout2_avg = PROT_AVG_Q15(buck_conv[BUCK_CONV_PRIMARY].iout_avg[1]);
+    s->temp_avg  = PROT_AVG_Q15(buck_conv[BUCK_CONV_PRIMARY].temp_avg);
+
+    flight_rec.wr = (flight_rec.wr + 1U) & (FLIGHT_REC_DEPTH - 1U);
+    if (flight_rec.filled < FLIGHT_REC_DEPTH)
+    {
+        flight_rec.filled++;
+    }
+    flight_rec.tick++;
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: flight_rec_latch
+*********************************************************************************
+* Summary:
+* Stops the sampling, called from fault_processing() of the primary converter
+* in the interrupt that detected the fault, after the converter has been
+* disabled. The ring keeps the sample that tripped as its last one until
+* flight_rec_freeze() has copied it.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void flight_rec_latch(void)
+{
+    flight_rec.frozen = true;
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: flight_rec_freeze
+*********************************************************************************
+* Summary:
+* Copies the ring into the next record slot, oldest sample first, seals the
+* record with its CRC and resumes the sampling. Called from the state machine
+* in PendSV on the transition of the primary converter into the fault state,
+* the ring was latched by fault_processing().
+*
+* Parameters:
+*  cause: FLIGHT_REC_CAUSE_* mask of the limits that tripped
+*  state: converter state before the fault
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void flight_rec_freeze(uint8_t cause, uint8_t state)
+{
+    flight_rec_store_t *store = &flight_rec_store;
+    uint32_t slot = store->next;
+    flight_rec_record_t *rec = &store->rec[slot];
+    uint16_t count = flight_rec.filled;
+    uint16_t first = (flight_rec.wr - count) & (FLIGHT_REC_DEPTH - 1U);
+
+    /* Invalid until sealed, in case of a reset in between. */
+    rec->magic = 0U;
+
+    for (uint16_t i = 0U; i < count; i++)
+    {
+        rec->samples[i] = flight_rec.ring[(first + i) & (FLIGHT_REC_DEPTH - 1U)];
+    }
+    memset(&rec->samples[count], 0, (FLIGHT_REC_DEPTH - count) * sizeof(flight_rec_sample_t));
+
+    rec->fault    = ++store->faults;
+    rec->boot     = store->boots;
+    rec->tick     = flight_rec.tick;
+    rec->cause    = cause;
+    rec->state    = state;
+    rec->count    = (uint8_t)count;
+    rec->reserved = 0U;
+    rec->magic    = FLIGHT_REC_MAGIC;
+    rec->crc      = flight_rec_crc(rec);
+
+    store->next = (slot + 1U) % FLIGHT_REC_RECORDS;
+    flight_rec.pending |= 1UL << slot;
+    flight_rec.frozen = false;
+}
+
+/*******************************************************************************
+* Function name: flight_rec_ready
+*********************************************************************************
+* Summary:
+* Returns true when a fault record waits for flight_rec_dump().
+*
+*******************************************************************************/
+bool flight_rec_ready(void)
+{
+    return (flight_rec.pending != 0U);
+}
+
+/*******************************************************************************
+* Function name: flight_rec_dump
+*********************************************************************************
+* Summary:
+* Sends the oldest pending fault record on the debug UART. In binary
+* telemetry mode the record bytes go out unchanged as TELEMETRY_KIND_FLIGHT
+* records of FLIGHT_REC_CHUNK_BYTES bytes, for sim/flight_decode.c, otherwise
+* as CSV text with the sample index relative to the tripping sample. Each
+* call writes as much of the record as the UART buffer takes, the record is
+* no longer pending when its last part has been written.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void flight_rec_dump(void)
+{
+    const flight_rec_record_t *rec = NULL;
+    uint32_t slot = 0U;
+    uint32_t primask;
+    uint32_t pos;
+    uint32_t end;
+
+    for (uint32_t i = 0U; i < FLIGHT_REC_RECORDS; i++)
+    {
+        if (((flight_rec.pending & (1UL << i)) != 0U) &&
+            ((rec == NULL) || (flight_rec_store.rec[i].fault < rec->fault)))
+        {
+            rec = &flight_rec_store.rec[i];
+            slot = i;
+        }
+    }
+    if (rec == NULL)
+    {
+        return;
+    }
+
+    /* A new fault may have overwritten the slot, its record starts again. */
+    if (rec->fault != flight_rec.sent_fault)
+    {
+        flight_rec.sent_fault = rec->fault;
+        flight_rec.sent = 0U;
+    }
+    pos = flight_rec.sent;
+
+#if TELEMETRY_BINARY
+    {
+        uint8_t record[TELEMETRY_FLIGHT_OFS_DATA + FLIGHT_REC_CHUNK_BYTES + TELEMETRY_CRC_SIZE];
+        const uint8_t *src = (const uint8_t *)rec;
+        uint32_t n;
+
+        end = sizeof(*rec);
+        for (; pos < end; pos += n)
+        {
+            n = end - pos;
+            if (n > FLIGHT_REC_CHUNK_BYTES)
+            {
+                n = FLIGHT_REC_CHUNK_BYTES;
+            }
+            if (uart_tx_space() < TELEMETRY_FRAME_SIZE(TELEMETRY_FLIGHT_OFS_DATA + n))
+            {
+                break;
+            }
+
+            record[TELEMETRY_FLIGHT_OFS_KIND]          = (uint8_t)TELEMETRY_KIND_FLIGHT;
+            record[TELEMETRY_FLIGHT_OFS_SLOT]          = (uint8_t)slot;
+            record[TELEMETRY_FLIGHT_OFS_OFFSET]        = (uint8_t)pos;
+            record[TELEMETRY_FLIGHT_OFS_OFFSET + 1U]   = (uint8_t)(pos >> 8);
+            record[TELEMETRY_FLIGHT_OFS_COUNT]         = (uint8_t)n;
+            memcpy(&record[TELEMETRY_FLIGHT_OFS_DATA], &src[pos], n);
+
+            telemetry_send_record(record, TELEMETRY_FLIGHT_OFS_DATA + n);
+        }
+    }
+#else
+    /* The header goes out together with the first sample. */
+    if (pos == 0U)
+    {
+        if (uart_tx_space() < (FLIGHT_REC_TEXT_HEADER_MAX + FLIGHT_REC_TEXT_LINE_MAX))
+        {
+            return;
+        }
+        uart_tx_printf("\r\nflight record fault=%lu boot=%lu tick=%lu state=%u samples=%u cause=",
+                       (unsigned long)rec->fault, (unsigned long)rec->boot, (unsigned long)rec->tick,
+                       rec->state, rec->count);
+        for (uint32_t bit = 0U; bit < FLIGHT_REC_CAUSES; bit++)
+        {
+            if ((rec->cause & (1U << bit)) != 0U)
+            {
+                uart_tx_printf("%s%s", ((rec->cause & ((1U << bit) - 1U)) != 0U) ? "+" : "", flight_rec_cause_names[bit]);
+            }
+        }
+        uart_tx_printf("\r\nindex,state,phases,vout,vin,iout1,iout2,temp,vin_avg,iout1_avg,iout2_avg,temp_avg\r\n");
+    }
+    end = rec->count;
+    for (; (pos < end) && (uart_tx_space() >= FLIGHT_REC_TEXT_LINE_MAX); pos++)
+    {
+        const flight_rec_sample_t *s = &rec->samples[pos];
+
+        uart_tx_printf("%d,%u,%u,%u,%u,%u,%u,%u,%.2f,%.2f,%.2f,%.2f\r\n", (int)pos - (int)(rec->count - 1U),
+                       s->state, s->phases, s->vout, s->vin, s->iout1, s->iout2, s->temp,
+                       (float64_t)s->vin_avg / 32768.0, (float64_t)s->iout1_avg / 32768.0,
+                       (float64_t)s->iout2_avg / 32768.0, (float64_t)s->temp_avg / 32768.0);
+    }
+#endif
+
+    flight_rec.sent = (uint16_t)pos;
+    if (pos >= end)
+    {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        flight_rec.pending &= ~(1UL << slot);
+        __set_PRIMASK(primask);
+    }
+}
+
+/* [] END OF FILE */
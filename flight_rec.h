@@ -0,0 +1,164 @@
+/*******************************************************************************
+* File Name: flight_rec.h
+*
+* Description:
+* Pre-fault flight recorder. The scheduled ADC callback writes the raw and
+* averaged Vin, Iout1, Iout2 and Temp results, the output voltage result and
+* the converter state into a ring buffer. On a fault, the ring is frozen into
+* one of several fault records together with the limits that tripped. The
+* records are kept in a no-init RAM section, protected by a CRC, so they
+* survive a reset, and are sent on the debug UART after the fault and after
+* each start up.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef FLIGHT_REC_H
+#define FLIGHT_REC_H
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Samples per record (scheduled ADC periods of 10 ms) and number of retained
+ * fault records. The oldest record is replaced when all are in use. */
+#define FLIGHT_REC_DEPTH            (32U)
+#define FLIGHT_REC_RECORDS          (4U)
+
+/* Identify the retained store and a valid record, the version is in the
+ * lowest byte. */
+#define FLIGHT_REC_STORE_MAGIC      (0x46525301UL)  /* "FRS", 1 */
+#define FLIGHT_REC_MAGIC            (0x46525201UL)  /* "FRR", 1 */
+
+/* Trip causes, bit mask of the limits that were exceeded. */
+#define FLIGHT_REC_CAUSE_VIN_LOW    (0x01U)
+#define FLIGHT_REC_CAUSE_VIN_HIGH   (0x02U)
+#define FLIGHT_REC_CAUSE_IOUT1      (0x04U)
+#define FLIGHT_REC_CAUSE_IOUT2      (0x08U)
+#define FLIGHT_REC_CAUSE_TEMP       (0x10U)
+#define FLIGHT_REC_CAUSE_VOUT       (0x20U)         /* Hardware output voltage limit */
+#define FLIGHT_REC_CAUSE_FAST       (0x40U)         /* Tripped by the hardware limit detection (fast_prot.h) */
+#define FLIGHT_REC_CAUSES           (7U)
+
+/* Record bytes sent per dump frame in binary telemetry mode. */
+#define FLIGHT_REC_CHUNK_BYTES      (200U)
+
+/* Longest CSV header and sample line of the dump in text mode */
+#define FLIGHT_REC_TEXT_HEADER_MAX  (256U)
+#define FLIGHT_REC_TEXT_LINE_MAX    (96U)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* One scheduled ADC period. The averages are ADC counts with 15 fractional
+ * bits (PROT_AVG_Q15). All fields are naturally aligned, so the layout is the
+ * same for the target and the host decoder. */
+typedef struct
+{
+    uint16_t vout;                  /* BUCK1_ctx.res */
+    uint16_t vin;                   /* Raw ADC results */
+    uint16_t iout1;
+    uint16_t iout2;
+    uint16_t temp;
+    uint8_t  state;                 /* State of the primary converter */
+    uint8_t  phases;                /* Active phases */
+    int32_t  vin_avg;               /* Protection averages */
+    int32_t  iout1_avg;
+    int32_t  iout2_avg;
+    int32_t  temp_avg;
+} flight_rec_sample_t;
+
+/* Fault record, the samples are stored oldest first and the last one is the
+ * sample that tripped. */
+typedef struct
+{
+    uint32_t magic;                 /* FLIGHT_REC_MAGIC when valid */
+    uint32_t fault;                 /* Fault number since the store was cleared */
+    uint32_t boot;                  /* Start up number of the fault */
+    uint32_t tick;                  /* Scheduled ADC periods since the start up, they
+                                     * run from the first start of the converter */
+    uint8_t  cause;                 /* FLIGHT_REC_CAUSE_* mask */
+    uint8_t  state;                 /* Converter state before the fault */
+    uint8_t  count;                 /* Valid samples */
+    uint8_t  reserved;
+    flight_rec_sample_t samples[FLIGHT_REC_DEPTH];
+    uint32_t crc;                   /* CRC-16 of the bytes before, zero extended */
+} flight_rec_record_t;
+
+/* Retained store. Only the records are protected by their CRC; the header is
+ * checked for plausibility and cleared otherwise, together with the records. */
+typedef struct
+{
+    uint32_t magic;                 /* FLIGHT_REC_STORE_MAGIC */
+    uint32_t boots;                 /* Start ups since the store was cleared */
+    uint32_t faults;                /* Faults since the store was cleared */
+    uint32_t next;                  /* Record slot of the next fault */
+    flight_rec_record_t rec[FLIGHT_REC_RECORDS];
+} flight_rec_store_t;
+
+/* Live ring, cleared at start up. */
+typedef struct
+{
+    volatile uint32_t pending;      /* Record slots waiting for flight_rec_dump() */
+    uint32_t tick;                  /* Scheduled ADC periods since the start up */
+    uint16_t wr;                    /* Next write index */
+    uint16_t filled;                /* Valid samples, up to FLIGHT_REC_DEPTH */
+    uint16_t sent;                  /* Bytes (binary) or samples (text) of the record
+                                     * being dumped already sent */
+    uint32_t sent_fault;            /* Fault number of the record being dumped */
+    volatile bool frozen;           /* Sampling stopped from the fault until its record */
+    flight_rec_sample_t ring[FLIGHT_REC_DEPTH];
+} flight_rec_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern flight_rec_t flight_rec;
+extern flight_rec_store_t flight_rec_store;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void flight_rec_init(void);
+void flight_rec_sample(void);
+void flight_rec_latch(void);
+void flight_rec_freeze(uint8_t cause, uint8_t state);
+bool flight_rec_ready(void);
+void flight_rec_dump(void);
+
+#endif  /* FLIGHT_REC_H */
+/* [] END OF FILE */
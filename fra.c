@@ -0,0 +1,382 @@
+/*******************************************************************************
+* File Name: fra.c
+*
+* Description:
+* Frequency response analyzer of the BUCK1 voltage loop.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "uart_tx.h"
+#include "fra.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define FRA_PHASE_SPAN              (4294967296.0f)     /* 2^32 */
+#define FRA_TABLE_SHIFT             (32U - FRA_TABLE_BITS)
+#define FRA_TABLE_MASK              (FRA_TABLE_SIZE - 1U)
+#define FRA_PI                      (3.14159265f)
+#define FRA_DEG_PER_RAD             (180.0f / FRA_PI)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+fra_t fra =
+{
+    .active = false,
+    .done   = false,
+    .valid  = false,
+    .inject = 0
+};
+
+int16_t fra_table[FRA_TABLE_SIZE];
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: fra_response
+*********************************************************************************
+* Summary:
+* Computes num / den from the correlation sums of two signals, in dB and in
+* degrees between -360 and 0.
+*
+* Parameters:
+*  num_sin, num_cos: sums of the numerator signal
+*  den_sin, den_cos: sums of the denominator signal
+*  sign:             1 or -1, sign of the ratio
+*  db:               magnitude
+*  deg:              phase
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void fra_response(int64_t num_sin, int64_t num_cos, int64_t den_sin, int64_t den_cos,
+                         float32_t sign, float32_t *db, float32_t *deg)
+{
+    float32_t ns = (float32_t)num_sin;
+    float32_t nc = (float32_t)num_cos;
+    float32_t ds = (float32_t)den_sin;
+    float32_t dc = (float32_t)den_cos;
+    float32_t mag2 = (ds * ds) + (dc * dc);
+    float32_t re;
+    float32_t im;
+
+    if (mag2 <= 0.0f)
+    {
+        *db  = 0.0f;
+        *deg = 0.0f;
+        return;
+    }
+
+    /* The phasor of a signal is sin part + j cos part. */
+    re = sign * ((ns * ds) + (nc * dc)) / mag2;
+    im = sign * ((nc * ds) - (ns * dc)) / mag2;
+
+    *db  = 10.0f * log10f(((re * re) + (im * im)) + 1.0e-20f);
+    *deg = atan2f(im, re) * FRA_DEG_PER_RAD;
+    if (*deg > 0.0f)
+    {
+        *deg -= 360.0f;
+    }
+}
+
+/*******************************************************************************
+* Function name: fra_init
+*********************************************************************************
+* Summary:
+* Fills the injection table and computes the phase increment, the settling
+* time and the measurement time of each point of the sweep. The measurement
+* covers an integer number of injection periods.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void fra_init(void)
+{
+    uint32_t i;
+
+    for (i = 0U; i < FRA_TABLE_SIZE; i++)
+    {
+        fra_table[i] = (int16_t)lroundf(32767.0f * sinf((2.0f * FRA_PI * (float32_t)i) / (float32_t)FRA_TABLE_SIZE));
+    }
+
+    for (i = 0U; i < FRA_POINTS; i++)
+    {
+        fra_point_t *p = &fra.pt[i];
+        float32_t f = FRA_FREQ_MIN * powf(FRA_FREQ_MAX / FRA_FREQ_MIN, (float32_t)i / (float32_t)(FRA_POINTS - 1U));
+        float32_t period;
+        uint32_t cycles;
+
+        p->step   = (uint32_t)lroundf((f / (float32_t)FRA_CTRL_FREQ_HZ) * FRA_PHASE_SPAN);
+        p->freq   = ((float32_t)p->step * (float32_t)FRA_CTRL_FREQ_HZ) / FRA_PHASE_SPAN;
+        period    = FRA_PHASE_SPAN / (float32_t)p->step;
+
+        cycles = (uint32_t)ceilf((p->freq * (float32_t)FRA_MEASURE_MS) / 1000.0f);
+        if (cycles < FRA_MEASURE_CYCLES)
+        {
+            cycles = FRA_MEASURE_CYCLES;
+        }
+        p->settle  = ((FRA_SETTLE_MS * FRA_CTRL_FREQ_HZ) / 1000U) + (uint32_t)((float32_t)FRA_SETTLE_CYCLES * period);
+        p->samples = (uint32_t)lroundf((float32_t)cycles * period);
+    }
+}
+
+/*******************************************************************************
+* Function name: fra_start
+*********************************************************************************
+* Summary:
+* Starts a sweep, called while the converter regulates. The results of the
+* previous sweep are discarded. Can be called from an interrupt handler with a
+* lower priority than the control ISR.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void fra_start(void)
+{
+    if (fra.active)
+    {
+        return;
+    }
+    fra.point     = 0U;
+    fra.measuring = false;
+    fra.phase     = 0U;
+    fra.count     = fra.pt[0].settle + ((FRA_START_DELAY_MS * FRA_CTRL_FREQ_HZ) / 1000U);
+    fra.res0      = (int32_t)BUCK1_ctx.targ;
+    fra.inject    = 0;
+    fra.done      = false;
+    fra.valid     = false;
+    fra.active    = true;
+}
+
+/*******************************************************************************
+* Function name: fra_abort
+*********************************************************************************
+* Summary:
+* Stops a running sweep without results, for example when the converter leaves
+* the RUN state.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void fra_abort(void)
+{
+    fra.active = false;
+    fra.inject = 0;
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: fra_step
+*********************************************************************************
+* Summary:
+* Analyzer engine, called from the control ISR after the compensator while a
+* sweep is active. Sets the perturbation of this period and, once the point
+* has settled, adds the compensator input, the compensator output and the
+* perturbed reference, each multiplied by the sine and the cosine of the
+* injection, to the correlation sums. The work per period is two table reads
+* and six multiply-accumulates, independent of the frequency.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void fra_step(void)
+{
+    fra_point_t *p = &fra.pt[fra.point];
+    uint32_t idx = fra.phase >> FRA_TABLE_SHIFT;
+    int32_t s = fra_table[idx];
+    int32_t c = fra_table[(idx + (FRA_TABLE_SIZE / 4U)) & FRA_TABLE_MASK];
+    int32_t d = ((FRA_AMPLITUDE * s) + (1 << 14)) >> 15;
+
+    fra.phase += p->step;
+    fra.inject = (int16_t)d;
+
+    if (fra.measuring)
+    {
+        int32_t xr = (int32_t)BUCK1_ctx.res - fra.res0;
+        int32_t xc = (int32_t)BUCK1_ctx.out - fra.out0;
+        int32_t xu = xc + d;
+
+        fra.acc.r_sin += (int64_t)xr * s;
+        fra.acc.r_cos += (int64_t)xr * c;
+        fra.acc.c_sin += (int64_t)xc * s;
+        fra.acc.c_cos += (int64_t)xc * c;
+        fra.acc.u_sin += (int64_t)xu * s;
+        fra.acc.u_cos += (int64_t)xu * c;
+    }
+
+    if (--fra.count != 0U)
+    {
+        return;
+    }
+
+    if (!fra.measuring)
+    {
+        fra.acc       = (fra_sums_t){ 0 };
+        fra.out0      = (int32_t)BUCK1_ctx.out;
+        fra.count     = p->samples;
+        fra.measuring = true;
+        return;
+    }
+
+    p->sums = fra.acc;
+    fra.measuring = false;
+    if (++fra.point >= FRA_POINTS)
+    {
+        fra.inject = 0;
+        fra.active = false;
+        fra.done   = true;
+        return;
+    }
+    fra.count = fra.pt[fra.point].settle;
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: fra_ready
+*********************************************************************************
+* Summary:
+* Returns true when a sweep has completed and its results have not been
+* evaluated by fra_report() yet.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool fra_ready(void)
+{
+    return fra.done;
+}
+
+/*******************************************************************************
+* Function name: fra_report
+*********************************************************************************
+* Summary:
+* Evaluates the last sweep: loop gain and plant response of each point, the
+* crossover frequency, interpolated where the loop gain falls through 0 dB,
+* and the phase margin. In text mode, the results are printed together with
+* the design targets. In binary telemetry mode, they are kept in fra for the
+* debugger.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void fra_report(void)
+{
+    uint32_t i;
+
+    fra.done = false;
+    fra.crossover_hz = 0.0f;
+    fra.margin_deg = 0.0f;
+
+    for (i = 0U; i < FRA_POINTS; i++)
+    {
+        fra_point_t *p = &fra.pt[i];
+
+        fra_response(p->sums.c_sin, p->sums.c_cos, p->sums.u_sin, p->sums.u_cos, -1.0f, &p->loop_db, &p->loop_deg);
+        fra_response(p->sums.r_sin, p->sums.r_cos, p->sums.u_sin, p->sums.u_cos, 1.0f, &p->plant_db, &p->plant_deg);
+
+        if ((i > 0U) && (fra.crossover_hz == 0.0f) && (fra.pt[i - 1U].loop_db > 0.0f) && (p->loop_db <= 0.0f))
+        {
+            const fra_point_t *q = &fra.pt[i - 1U];
+            float32_t t = q->loop_db / (q->loop_db - p->loop_db);
+
+            fra.crossover_hz = q->freq * powf(p->freq / q->freq, t);
+            fra.margin_deg = 180.0f + q->loop_deg + (t * (p->loop_deg - q->loop_deg));
+        }
+    }
+    fra.valid = true;
+
+#if !TELEMETRY_BINARY
+    uart_tx_printf("\r\n\nFrequency response  loop gain            plant (DAC to ADC)\r\n");
+    for (i = 0U; i < FRA_POINTS; i++)
+    {
+        const fra_point_t *p = &fra.pt[i];
+
+        uart_tx_printf("%8.0f Hz        %7.2f dB %7.1f deg  %7.2f dB %7.1f deg\r\n", (float64_t)p->freq,
+                       (float64_t)p->loop_db, (float64_t)p->loop_deg, (float64_t)p->plant_db, (float64_t)p->plant_deg);
+    }
+    if (fra.crossover_hz > 0.0f)
+    {
+        uart_tx_printf("Crossover %.0f Hz (design %.0f Hz), phase margin %.1f deg (design %.1f deg)\r\n",
+                       (float64_t)fra.crossover_hz, (float64_t)FRA_DESIGN_CROSSOVER_HZ,
+                       (float64_t)fra.margin_deg, (float64_t)FRA_DESIGN_PHASE_MARGIN);
+    }
+    else
+    {
+        uart_tx_printf("No crossover between %.0f Hz and %.0f Hz (design %.0f Hz)\r\n",
+                       (float64_t)FRA_FREQ_MIN, (float64_t)FRA_FREQ_MAX, (float64_t)FRA_DESIGN_CROSSOVER_HZ);
+    }
+#endif
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,181 @@
+/*******************************************************************************
+* File Name: fra.h
+*
+* Description:
+* Frequency response analyzer of the BUCK1 voltage loop. A small sine wave is
+* added to the peak current reference written to both CSG DACs, after the
+* compensator, and stepped through a logarithmic frequency sweep. For each
+* frequency, the control ISR correlates the compensator input (BUCK1_ctx.res),
+* the compensator output and the perturbed reference with the sine and cosine
+* of the injection (single-bin DFT), so no waveform is stored. The main loop
+* computes the loop gain and the plant response from the accumulated sums and
+* finds the crossover frequency and the phase margin.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef FRA_H
+#define FRA_H
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* 0 - the sweep only runs on fra_start(), 1 - a sweep runs after each soft
+ * start. Set with FRA in the Makefile. */
+#ifndef FRA
+#define FRA (0)
+#endif
+
+/* Design targets of the BUCK1 solution in design.modus (CrossoverFreq,
+ * PhaseMargin), the measured values are reported against them. */
+#define FRA_DESIGN_CROSSOVER_HZ     (5000.0f)
+#define FRA_DESIGN_PHASE_MARGIN     (50.0f)
+
+/* Sweep: FRA_POINTS logarithmically spaced frequencies, Hz. */
+#define FRA_POINTS                  (16U)
+#define FRA_FREQ_MIN                (500.0f)
+#define FRA_FREQ_MAX                (50000.0f)
+
+/* Injection amplitude, CSG DAC counts (3.36 mA per count and phase). */
+#define FRA_AMPLITUDE               (20)
+
+/* Each point settles for FRA_SETTLE_MS plus FRA_SETTLE_CYCLES periods of the
+ * injection and is then measured over at least FRA_MEASURE_CYCLES periods and
+ * FRA_MEASURE_MS. The first point also waits FRA_START_DELAY_MS for the end of
+ * the soft start and of the current sharing transient. */
+#define FRA_SETTLE_MS               (2U)
+#define FRA_SETTLE_CYCLES           (2U)
+#define FRA_MEASURE_CYCLES          (20U)
+#define FRA_MEASURE_MS              (10U)
+#define FRA_START_DELAY_MS          (200U)
+
+/* Control ISR frequency (SwitchingFreq, control loop divider 1). */
+#define FRA_CTRL_FREQ_HZ            (300000U)
+
+/* Injection table, one period of the sine in Q15. The phase accumulator is
+ * 32 bit, its upper FRA_TABLE_BITS bits index the table. */
+#define FRA_TABLE_BITS              (8U)
+#define FRA_TABLE_SIZE              (1U << FRA_TABLE_BITS)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Correlation sums of one point, sine and cosine parts of the compensator
+ * input (r), the compensator output (c) and the perturbed reference (u). */
+typedef struct
+{
+    int64_t  r_sin;
+    int64_t  r_cos;
+    int64_t  c_sin;
+    int64_t  c_cos;
+    int64_t  u_sin;
+    int64_t  u_cos;
+} fra_sums_t;
+
+/* One point of the sweep. The loop gain is -c/u and the plant response from
+ * the DAC to the ADC result r/u. */
+typedef struct
+{
+    uint32_t   step;                /* Phase increment per control period */
+    uint32_t   settle;              /* Control periods before the measurement */
+    uint32_t   samples;             /* Control periods of the measurement */
+    fra_sums_t sums;
+    float32_t  freq;                /* Injection frequency, Hz */
+    float32_t  loop_db;             /* Loop gain */
+    float32_t  loop_deg;
+    float32_t  plant_db;            /* DAC counts to ADC counts */
+    float32_t  plant_deg;
+} fra_point_t;
+
+typedef struct
+{
+    volatile bool active;           /* Sweep running */
+    volatile bool done;             /* Sweep complete, results not yet evaluated */
+    bool       valid;               /* Results of a complete sweep available */
+    bool       measuring;           /* Settling is over for the current point */
+    uint8_t    point;               /* Current point */
+    volatile int16_t inject;        /* Perturbation added to the DAC values */
+    uint32_t   phase;               /* Phase accumulator of the injection */
+    uint32_t   count;               /* Control periods left in the settle or measure phase */
+    int32_t    res0;                /* Operating point removed before the correlation */
+    int32_t    out0;
+    fra_sums_t acc;
+    fra_point_t pt[FRA_POINTS];
+    float32_t  crossover_hz;        /* 0 if the loop gain does not cross 0 dB */
+    float32_t  margin_deg;
+} fra_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern fra_t fra;
+extern int16_t fra_table[FRA_TABLE_SIZE];
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void fra_init(void);
+void fra_start(void);
+void fra_abort(void);
+void fra_step(void);
+bool fra_ready(void);
+void fra_report(void);
+
+/*******************************************************************************
+* Function Name: fra_control
+*********************************************************************************
+* Summary:
+* Called from the post-process callback of the control ISR, before the current
+* sharing writes the DAC values. Runs the analyzer while a sweep is active.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void fra_control(void)
+{
+    if (fra.active)
+    {
+        fra_step();
+    }
+}
+
+#endif  /* FRA_H */
+/* [] END OF FILE */
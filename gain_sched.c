@@ -0,0 +1,234 @@
+/*******************************************************************************
+* File Name: gain_sched.c
+*
+* Description:
+* Load band selection and coefficient set changes of the gain scheduling.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "gain_sched.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define GAIN_SCHED_Q15(a)           (PHASE_SHED_IOUT_COUNTS(a) << 15)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* The sets are designed for the output capacitance of the common output, not
+ * for one output of the dual converter configuration. */
+gain_sched_t gain_sched =
+{
+    .enable  = (GAIN_SCHED != 0) && (BUCK_CONV_CONFIG != BUCK_CONV_DUAL),
+    .band    = GAIN_SCHED_BANDS - 1U,
+    .active  = GAIN_SCHED_SET_PCC,
+    .changes = 0U,
+    .tuned_active = false
+};
+
+/* Band limits as summed Iout averages: the band is raised above the limit plus
+ * the hysteresis and lowered below the limit minus the hysteresis. Computed at
+ * build time, the scheduled ADC callback only compares. */
+static CONTROL_RAMCONST int32_t gain_sched_up_q15[GAIN_SCHED_BANDS - 1U] =
+{
+    GAIN_SCHED_Q15(GAIN_SCHED_BAND_LIMIT_0 + GAIN_SCHED_HYSTERESIS),
+    GAIN_SCHED_Q15(GAIN_SCHED_BAND_LIMIT_1 + GAIN_SCHED_HYSTERESIS)
+};
+static CONTROL_RAMCONST int32_t gain_sched_down_q15[GAIN_SCHED_BANDS - 1U] =
+{
+    GAIN_SCHED_Q15(GAIN_SCHED_BAND_LIMIT_0 - GAIN_SCHED_HYSTERESIS),
+    GAIN_SCHED_Q15(GAIN_SCHED_BAND_LIMIT_1 - GAIN_SCHED_HYSTERESIS)
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: gain_sched_init
+*********************************************************************************
+* Summary:
+* Keeps a copy of the PCC tool coefficients, used while the scheduling is
+* disabled.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void gain_sched_init(void)
+{
+    const mtb_stc_pwrconv_ctrl_2p2z_t *ctrl = &BUCK1_ctx.ctrl;
+
+    gain_sched.pcc.b0     = ctrl->b0;
+    gain_sched.pcc.b1     = ctrl->b1;
+    gain_sched.pcc.b2     = ctrl->b2;
+    gain_sched.pcc.a1     = ctrl->a1;
+    gain_sched.pcc.a2     = ctrl->a2;
+    gain_sched.pcc.inv_b2 = 1.0f / ctrl->b2;
+    gain_sched.active     = GAIN_SCHED_SET_PCC;
+}
+
+/*******************************************************************************
+* Function name: gain_sched_reset
+*********************************************************************************
+* Summary:
+* Selects the highest load band before the converter starts, the one that
+* contains the nominal load of the PCC design. The set is loaded by the first
+* control ISR.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void gain_sched_reset(void)
+{
+    gain_sched.band = GAIN_SCHED_BANDS - 1U;
+}
+
+/*******************************************************************************
+* Function name: gain_sched_set_enable
+*********************************************************************************
+* Summary:
+* Allows or forbids the gain scheduling. When forbidden, the next control ISR
+* returns to the PCC tool coefficients.
+*
+* Parameters:
+*  enable: true to allow scheduling
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void gain_sched_set_enable(bool enable)
+{
+    gain_sched.enable = enable && (GAIN_SCHED != 0) && (BUCK_CONV_CONFIG != BUCK_CONV_DUAL);
+}
+
+/*******************************************************************************
+* Function name: gain_sched_update
+*********************************************************************************
+* Summary:
+* Load band selection, called from the scheduled ADC callback. Moves at most
+* one band per call.
+*
+* Parameters:
+*  iout_sum_q15: sum of the Iout averages, ADC counts with 15 fractional bits
+*  run:          converter in the Run or Test state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void gain_sched_update(int32_t iout_sum_q15, bool run)
+{
+    uint8_t band = gain_sched.band;
+
+    if (!run)
+    {
+        return;
+    }
+
+    if ((band < (GAIN_SCHED_BANDS - 1U)) && (iout_sum_q15 > gain_sched_up_q15[band]))
+    {
+        gain_sched.band = band + 1U;
+    }
+    else if ((band > 0U) && (iout_sum_q15 < gain_sched_down_q15[band - 1U]))
+    {
+        gain_sched.band = band - 1U;
+    }
+    else
+    {
+        /* Stay in the band. */
+    }
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: gain_sched_transfer
+*********************************************************************************
+* Summary:
+* Loads a coefficient set, called from the control ISR after the compensator.
+* The output history is the applied peak current reference and is kept. The
+* older error sample is recomputed so that the history contributes the same
+* value to the next output as with the previous set. As all sets contain the
+* integrator (a1 + a2 = 1), the adjusted sample is zero in steady state.
+*
+* Parameters:
+*  set: index into gain_sched_bank, GAIN_SCHED_SET_PCC, or GAIN_SCHED_SET_TUNED
+*       plus the active phases minus one
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void gain_sched_transfer(uint8_t set)
+{
+    mtb_stc_pwrconv_ctrl_2p2z_t *ctrl = &BUCK1_ctx.ctrl;
+    const gain_sched_coef_t *coef = (set < GAIN_SCHED_SETS) ? &gain_sched_bank[set] :
+                                    ((set == GAIN_SCHED_SET_PCC) ? &gain_sched.pcc :
+                                     &gain_sched.tuned[set - GAIN_SCHED_SET_TUNED]);
+    float32_t hist;
+
+    hist = (ctrl->b1 * ctrl->x1) + (ctrl->b2 * ctrl->x2) + (ctrl->a1 * ctrl->y1) + (ctrl->a2 * ctrl->y2);
+    ctrl->x2 = (hist - (coef->b1 * ctrl->x1) - (coef->a1 * ctrl->y1) - (coef->a2 * ctrl->y2)) * coef->inv_b2;
+
+    ctrl->b0 = coef->b0;
+    ctrl->b1 = coef->b1;
+    ctrl->b2 = coef->b2;
+    ctrl->a1 = coef->a1;
+    ctrl->a2 = coef->a2;
+
+    gain_sched.active = set;
+    gain_sched.changes++;
+}
+CONTROL_RAMFUNC_END
+
+/* [] END OF FILE */
@@ -0,0 +1,160 @@
+/*******************************************************************************
+* File Name: gain_sched.h
+*
+* Description:
+* Load dependent gain scheduling of the BUCK1 2P2Z voltage compensator. The
+* summed Iout averages select one of several load bands, and the coefficient
+* set designed for that band and the number of active phases is loaded in the
+* control ISR. The error history is adjusted at the change so that the next
+* compensator output is the same as with the previous set.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef GAIN_SCHED_H
+#define GAIN_SCHED_H
+#include "cybsp.h"
+#include "phase_shed.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Gain scheduling: 0 - the PCC tool coefficients are always used (default),
+ * 1 - enabled. */
+#ifndef GAIN_SCHED
+#define GAIN_SCHED (0)
+#endif
+
+/* Load bands, the coefficient sets in gain_sched_bank.c are designed for the
+ * band currents (total output current, A). Regenerate gain_sched_bank.c with
+ * "make -C sim gainbank" after a change. */
+#define GAIN_SCHED_BANDS            (3U)
+#define GAIN_SCHED_DESIGN_CURRENTS  { 0.3f, 1.5f, 4.0f }
+/* Upper limits of the lower bands and hysteresis around them, A. */
+#define GAIN_SCHED_BAND_LIMIT_0     (0.8f)
+#define GAIN_SCHED_BAND_LIMIT_1     (2.5f)
+#define GAIN_SCHED_HYSTERESIS       (0.1f)
+/* Crossover frequency of the bank, Hz. At the 5 kHz of the PCC tool set, the
+ * sets for 1.5 A and 4.0 A settle slower than the PCC set. */
+#define GAIN_SCHED_CROSSOVER        (7000.0)
+
+/* Coefficient sets: GAIN_SCHED_BANDS for one active phase, then
+ * GAIN_SCHED_BANDS for two. The PCC tool set follows the bank, then the sets
+ * of the auto-tuning (autotune.h) for one and two active phases. */
+#define GAIN_SCHED_SETS             (2U * GAIN_SCHED_BANDS)
+#define GAIN_SCHED_SET_PCC          (GAIN_SCHED_SETS)
+#define GAIN_SCHED_SET_TUNED        (GAIN_SCHED_SET_PCC + 1U)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* 2P2Z coefficients in the order of mtb_stc_pwrconv_ctrl_2p2z_t, and 1/b2 for
+ * the transfer of the compensator state. */
+typedef struct
+{
+    float32_t b0;
+    float32_t b1;
+    float32_t b2;
+    float32_t a1;
+    float32_t a2;
+    float32_t inv_b2;
+} gain_sched_coef_t;
+
+typedef struct
+{
+    bool              enable;       /* Scheduling allowed */
+    volatile uint8_t  band;         /* Load band selected by the scheduled callback */
+    volatile uint8_t  active;       /* Coefficient set in use, GAIN_SCHED_SET_PCC for the PCC set */
+    uint32_t          changes;      /* Number of coefficient set changes */
+    gain_sched_coef_t pcc;          /* Coefficients generated by the PCC tool */
+    volatile bool     tuned_active; /* Tuned sets in use instead of the bank and the PCC set */
+    gain_sched_coef_t tuned[BUCK_CONV_PHASES_MAX];  /* Sets of the auto-tuning */
+} gain_sched_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern gain_sched_t gain_sched;
+extern CONTROL_RAMCONST gain_sched_coef_t gain_sched_bank[GAIN_SCHED_SETS];
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void gain_sched_init(void);
+void gain_sched_reset(void);
+void gain_sched_set_enable(bool enable);
+void gain_sched_update(int32_t iout_sum_q15, bool run);
+void gain_sched_transfer(uint8_t set);
+
+/*******************************************************************************
+* Function Name: gain_sched_control
+*********************************************************************************
+* Summary:
+* Called from the post-process callback of the control ISR after the phase
+* shedding. Loads the coefficient set of the selected load band and the
+* active phase count when it differs from the set in use. The tuned set of
+* the active phase count takes precedence while the auto-tuning result is in
+* use.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void gain_sched_control(void)
+{
+#if GAIN_SCHED
+    uint8_t set = gain_sched.enable ?
+                  (uint8_t)(gain_sched.band + ((phase_shed.phases == 2U) ? GAIN_SCHED_BANDS : 0U)) :
+                  (uint8_t)GAIN_SCHED_SET_PCC;
+#else
+    uint8_t set = (uint8_t)GAIN_SCHED_SET_PCC;
+#endif
+
+    if (gain_sched.tuned_active)
+    {
+        set = (uint8_t)(GAIN_SCHED_SET_TUNED + phase_shed.phases - 1U);
+    }
+    if (set != gain_sched.active)
+    {
+        gain_sched_transfer(set);
+    }
+}
+
+#endif  /* GAIN_SCHED_H */
+/* [] END OF FILE */
@@ -0,0 +1,71 @@
+/*******************************************************************************
+* File Name: gain_sched_bank.c
+*
+* Description:
+* 2P2Z coefficient sets of the gain scheduling, generated by sim/gain_bank
+* ("make -C sim gainbank") for a 7000 Hz crossover and 50 degree phase
+* margin. Do not edit.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include "gain_sched.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* b0, b1, b2, a1, a2, 1/b2. The comments give the crossover frequency and phase
+ * margin at the design point, and those of the PCC tool set in brackets. */
+CONTROL_RAMCONST gain_sched_coef_t gain_sched_bank[GAIN_SCHED_SETS] =
+{
+    /* 1 phase, 0.3 A: 7005 Hz 50.0 deg (2910 Hz 43.5 deg) */
+    { 2.209427022e+00f, 8.781764937e-02f, -2.121609373e+00f, 1.581014347e+00f, -5.810143469e-01f, -4.713403008e-01f },
+    /* 1 phase, 1.5 A: 7005 Hz 50.0 deg (2898 Hz 46.7 deg) */
+    { 2.142818551e+00f, 8.891673299e-02f, -2.053901818e+00f, 1.595382490e+00f, -5.953824904e-01f, -4.868781901e-01f },
+    /* 1 phase, 4.0 A: 7005 Hz 50.0 deg (2852 Hz 53.1 deg) */
+    { 2.021345157e+00f, 9.120806721e-02f, -1.930137090e+00f, 1.622325197e+00f, -6.223251966e-01f, -5.180979140e-01f },
+    /* 2 phases, 0.3 A: 7005 Hz 50.0 deg (5062 Hz 44.3 deg) */
+    { 1.104713511e+00f, 4.390882468e-02f, -1.060804686e+00f, 1.581014347e+00f, -5.810143469e-01f, -9.426806017e-01f },
+    /* 2 phases, 1.5 A: 7005 Hz 50.0 deg (5047 Hz 46.1 deg) */
+    { 1.071409276e+00f, 4.445836650e-02f, -1.026950909e+00f, 1.595382490e+00f, -5.953824904e-01f, -9.737563802e-01f },
+    /* 2 phases, 4.0 A: 7005 Hz 50.0 deg (5001 Hz 50.0 deg) */
+    { 1.010672579e+00f, 4.560403361e-02f, -9.650685450e-01f, 1.622325197e+00f, -6.223251966e-01f, -1.036195828e+00f },
+};
+
+/* [] END OF FILE */
@@ -0,0 +1,172 @@
+/*******************************************************************************
+* File Name: isr_profile.c
+*
+* Description:
+* Initialization and text report of the interrupt execution time profiler.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "uart_tx.h"
+#include "isr_profile.h"
+
+#if ISR_PROFILE
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+isr_profile_stat_t isr_profile[ISR_PROFILE_COUNT];
+
+static const char *const isr_profile_names[ISR_PROFILE_COUNT] =
+{
+    "ctrl", "ctrl_period", "sched_adc", "fault",
+#if (BUCK_CONV_NUM > 1U)
+    "ctrl_2", "ctrl_period_2", "sched_adc_2", "fault_2",
+#endif
+    "soft_start", "button", "events"
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: isr_profile_init
+*********************************************************************************
+* Summary:
+* Enables the DWT cycle counter and clears the statistics.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void isr_profile_init(void)
+{
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    isr_profile_reset();
+}
+
+/*******************************************************************************
+* Function name: isr_profile_reset
+*********************************************************************************
+* Summary:
+* Clears the statistics of all sections.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void isr_profile_reset(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    for (uint32_t id = 0U; id < (uint32_t)ISR_PROFILE_COUNT; id++)
+    {
+        isr_profile_stat_t *stat = &isr_profile[id];
+
+        stat->count   = 0U;
+        stat->min     = UINT32_MAX;
+        stat->max     = 0U;
+        stat->sum     = 0U;
+        stat->started = false;
+        for (uint32_t bin = 0U; bin < ISR_PROFILE_HIST_BINS; bin++)
+        {
+            stat->hist[bin] = 0U;
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+/*******************************************************************************
+* Function name: isr_profile_report
+*********************************************************************************
+* Summary:
+* Prints count, minimum, mean and maximum of each section in CPU cycles, the
+* maximum in microseconds and the histogram bins from 2^0 cycles upwards.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void isr_profile_report(void)
+{
+    isr_profile_stat_t stat;
+    uint32_t primask;
+
+    uart_tx_printf("\r\nISR profile (cycles at %lu Hz)\r\n", (unsigned long)SystemCoreClock);
+    uart_tx_printf("%-12s %10s %7s %7s %7s %8s  histogram\r\n", "isr", "count", "min", "mean", "max", "max_us");
+    for (uint32_t id = 0U; id < (uint32_t)ISR_PROFILE_COUNT; id++)
+    {
+        /* Consistent copy, the sections keep running. */
+        primask = __get_PRIMASK();
+        __disable_irq();
+        stat = isr_profile[id];
+        __set_PRIMASK(primask);
+
+        if (stat.count == 0U)
+        {
+            uart_tx_printf("%-12s %10u\r\n", isr_profile_names[id], 0U);
+            continue;
+        }
+        uart_tx_printf("%-12s %10lu %7lu %7lu %7lu %8.2f ", isr_profile_names[id], (unsigned long)stat.count,
+                       (unsigned long)stat.min, (unsigned long)(stat.sum / stat.count), (unsigned long)stat.max,
+                       ((float64_t)stat.max * 1.0e6) / (float64_t)SystemCoreClock);
+        for (uint32_t bin = 0U; bin < ISR_PROFILE_HIST_BINS; bin++)
+        {
+            uart_tx_printf(" %lu", (unsigned long)stat.hist[bin]);
+        }
+        uart_tx_printf("\r\n");
+    }
+}
+
+#endif  /* ISR_PROFILE */
+
+/* [] END OF FILE */
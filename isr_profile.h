@@ -0,0 +1,204 @@
+/*******************************************************************************
+* File Name: isr_profile.h
+*
+* Description:
+* Execution time profiler of the interrupt handlers and callbacks, based on the
+* DWT cycle counter. Each profiled section keeps the count, minimum, maximum,
+* sum and a log2 histogram of its duration in CPU cycles. The control ISR also
+* records the interval between its activations, which shows the jitter of the
+* control loop. Everything compiles to nothing unless ISR_PROFILE is set.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef ISR_PROFILE_H
+#define ISR_PROFILE_H
+#include "cybsp.h"
+#include "buck_conv.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* 0 - profiler compiled out, 1 - enabled. Set with ISR_PROFILE in the Makefile,
+ * which enables it for Debug builds. */
+#ifndef ISR_PROFILE
+#define ISR_PROFILE (0)
+#endif
+
+/* Histogram bin k counts durations of 2^k to 2^(k+1)-1 cycles, the last bin
+ * everything above. */
+#define ISR_PROFILE_HIST_BINS       (16U)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Profiled sections. The first ISR_PROFILE_CONV_SECTIONS are repeated for
+ * each converter, see ISR_PROFILE_CONV(). */
+typedef enum
+{
+    ISR_PROFILE_CTRL          = 0,  /* Control ISR, pre- to post-process callback */
+    ISR_PROFILE_CTRL_PERIOD   = 1,  /* Interval between two control ISRs */
+    ISR_PROFILE_SCHED         = 2,  /* Scheduled ADC callback */
+    ISR_PROFILE_FAULT         = 3,  /* Fault callback */
+    ISR_PROFILE_CONV_SECTIONS = 4,
+    ISR_PROFILE_SOFT_START    = ISR_PROFILE_CONV_SECTIONS * BUCK_CONV_NUM,  /* soft_start_prot_intr_handler */
+    ISR_PROFILE_BUTTON,             /* button_press_intr_handler */
+    ISR_PROFILE_EVENTS,             /* PendSV_Handler, state machine transitions */
+    ISR_PROFILE_COUNT
+} isr_profile_id_t;
+
+/* Section of a converter */
+#define ISR_PROFILE_CONV(id, conv)  ((isr_profile_id_t)((uint32_t)(id) + ((uint32_t)ISR_PROFILE_CONV_SECTIONS * (conv))))
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;                   /* Cycles */
+    uint32_t max;                   /* Cycles */
+    uint64_t sum;                   /* Cycles, mean = sum / count */
+    uint32_t start;                 /* Cycle counter at the section start */
+    bool     started;               /* start is valid (interval sections) */
+    uint32_t hist[ISR_PROFILE_HIST_BINS];
+} isr_profile_stat_t;
+
+#if ISR_PROFILE
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern isr_profile_stat_t isr_profile[ISR_PROFILE_COUNT];
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void isr_profile_init(void);
+void isr_profile_reset(void);
+void isr_profile_report(void);
+
+/*******************************************************************************
+* Function Name: isr_profile_add
+*********************************************************************************
+* Summary:
+* Adds one duration to the statistics of a section.
+*
+* Parameters:
+*  stat:   section statistics
+*  cycles: duration in CPU cycles
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_FORCEINLINE void isr_profile_add(isr_profile_stat_t *stat, uint32_t cycles)
+{
+    uint32_t bin = 31U - __CLZ(cycles | 1U);
+
+    if (bin >= ISR_PROFILE_HIST_BINS)
+    {
+        bin = ISR_PROFILE_HIST_BINS - 1U;
+    }
+    stat->hist[bin]++;
+    stat->count++;
+    stat->sum += cycles;
+    if (cycles < stat->min)
+    {
+        stat->min = cycles;
+    }
+    if (cycles > stat->max)
+    {
+        stat->max = cycles;
+    }
+}
+
+/*******************************************************************************
+* Function Name: isr_profile_start / isr_profile_stop
+*********************************************************************************
+* Summary:
+* Mark the start and the end of a profiled section. The duration includes the
+* time spent in higher priority interrupts that preempt the section.
+*
+*******************************************************************************/
+__STATIC_FORCEINLINE void isr_profile_start(isr_profile_id_t id)
+{
+    isr_profile[id].start = DWT->CYCCNT;
+}
+
+__STATIC_FORCEINLINE void isr_profile_stop(isr_profile_id_t id)
+{
+    isr_profile_add(&isr_profile[id], DWT->CYCCNT - isr_profile[id].start);
+}
+
+/*******************************************************************************
+* Function Name: isr_profile_mark
+*********************************************************************************
+* Summary:
+* Records the interval since the previous mark of the section. The first mark
+* after isr_profile_resync() only stores the time.
+*
+*******************************************************************************/
+__STATIC_FORCEINLINE void isr_profile_mark(isr_profile_id_t id)
+{
+    uint32_t now = DWT->CYCCNT;
+
+    if (isr_profile[id].started)
+    {
+        isr_profile_add(&isr_profile[id], now - isr_profile[id].start);
+    }
+    isr_profile[id].start = now;
+    isr_profile[id].started = true;
+}
+
+__STATIC_FORCEINLINE void isr_profile_resync(isr_profile_id_t id)
+{
+    isr_profile[id].started = false;
+}
+
+#define ISR_PROFILE_START(id)       isr_profile_start(id)
+#define ISR_PROFILE_STOP(id)        isr_profile_stop(id)
+#define ISR_PROFILE_MARK(id)        isr_profile_mark(id)
+#define ISR_PROFILE_RESYNC(id)      isr_profile_resync(id)
+
+#else
+
+#define ISR_PROFILE_START(id)
+#define ISR_PROFILE_STOP(id)
+#define ISR_PROFILE_MARK(id)
+#define ISR_PROFILE_RESYNC(id)
+
+#endif  /* ISR_PROFILE */
+
+#endif  /* ISR_PROFILE_H */
+/* [] END OF FILE */
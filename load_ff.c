@@ -0,0 +1,208 @@
+/*******************************************************************************
+* File Name: load_ff.c
+*
+* Description:
+* Load step feedforward of the BUCK1 output in the TEST state.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <math.h>
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "current_share.h"
+#include "load_ff.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+load_ff_t load_ff =
+{
+    .enable = (LOAD_FF != 0),
+    .step   = (int32_t)(((float32_t)LOAD_FF_STEP_MA * LOAD_FF_DAC_PER_A / 1000.0f) + 0.5f),
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: load_ff_reset
+*********************************************************************************
+* Summary:
+* Called when the converter starts. The PWM_LOAD line is low before the TEST
+* state, also when the converter stopped during a high phase.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void load_ff_reset(void)
+{
+    load_ff.line = false;
+    load_ff.active = load_ff.enable;
+}
+
+/*******************************************************************************
+* Function name: load_ff_set_enable
+*********************************************************************************
+* Summary:
+* Requests the feedforward on or off. The control ISR applies the request
+* while the PWM_LOAD line is low.
+*
+* Parameters:
+*  enable: true to request the feedforward
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void load_ff_set_enable(bool enable)
+{
+    load_ff.enable = enable;
+}
+
+/*******************************************************************************
+* Function name: load_ff_set_step
+*********************************************************************************
+* Summary:
+* Sets the load current step that the feedforward starts from, for example for
+* a board with other transient load resistors. It takes effect with the next
+* period of the control ISR and is corrected from the next falling edge on.
+*
+* Parameters:
+*  step_ma: load current step, -LOAD_FF_STEP_MA_MAX to LOAD_FF_STEP_MA_MAX mA
+*
+* Return:
+*  bool: false when the step is out of range
+*
+*******************************************************************************/
+bool load_ff_set_step(int32_t step_ma)
+{
+    if ((step_ma < -LOAD_FF_STEP_MA_MAX) || (step_ma > LOAD_FF_STEP_MA_MAX))
+    {
+        return false;
+    }
+    load_ff.step = (int32_t)lroundf((float32_t)step_ma * LOAD_FF_DAC_PER_A / 1000.0f);
+    return true;
+}
+
+/*******************************************************************************
+* Function name: load_ff_step_ma
+*********************************************************************************
+* Summary:
+* Returns the load current step that the feedforward adds.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  float32_t: load current step, mA
+*
+*******************************************************************************/
+float32_t load_ff_step_ma(void)
+{
+    return (float32_t)load_ff.step * 1000.0f / LOAD_FF_DAC_PER_A;
+}
+
+/*******************************************************************************
+* Function name: load_ff_edge
+*********************************************************************************
+* Summary:
+* Called from the control ISR at an edge of the PWM_LOAD line. At a falling
+* edge, the change of the compensator output times the active phases over the
+* high phase, which a phase shedding transition keeps, is the part of the step
+* that the feedforward missed; half of it is added to the step, so that the
+* noise of a single edge is averaged. The compensator output and history are
+* then moved by the step per phase, up at a rising edge and down at a falling
+* edge, within the clamp of the compensator, and the new reference is written
+* to the CSG slices.
+*
+* Parameters:
+*  line:   PWM_LOAD line after the edge
+*  phases: active phases
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void load_ff_edge(bool line, uint8_t phases)
+{
+    mtb_stc_pwrconv_ctrl_2p2z_t *ctrl = &BUCK1_ctx.ctrl;
+    float32_t delta;
+    float32_t half;
+    float32_t y;
+    int32_t step;
+
+    if (line)
+    {
+        load_ff.edges++;
+    }
+    else
+    {
+        /* Rounded half away from zero by the truncating conversion, like
+         * lroundf() but without a library call from SRAM to flash. */
+        half = ((ctrl->y1 * (float32_t)phases) - load_ff.out_high) * 0.5f;
+        step = load_ff.step + (int32_t)(half + ((half < 0.0f) ? -0.5f : 0.5f));
+        load_ff.step = (step < -LOAD_FF_STEP_MAX) ? -LOAD_FF_STEP_MAX :
+                       ((step > LOAD_FF_STEP_MAX) ? LOAD_FF_STEP_MAX : step);
+    }
+
+    delta = (float32_t)load_ff.step / (float32_t)phases;
+    delta = line ? delta : -delta;
+
+    y = ctrl->y1 + delta;
+    ctrl->y1 = (y > ctrl->max) ? ctrl->max : ((y < ctrl->min) ? ctrl->min : y);
+    y = ctrl->y2 + delta;
+    ctrl->y2 = (y > ctrl->max) ? ctrl->max : ((y < ctrl->min) ? ctrl->min : y);
+    BUCK1_ctx.out = (uint32_t)ctrl->y1;
+    load_ff.out_high = ctrl->y1 * (float32_t)phases;
+
+    Cy_HPPASS_DAC_SetValue(CURRENT_SHARE_CSG_SLICE_1, (uint16_t)BUCK1_ctx.out);
+#if (BUCK_CONV_PHASES > 1U)
+    Cy_HPPASS_DAC_SetValue(CURRENT_SHARE_CSG_SLICE_2, (uint16_t)BUCK1_ctx.out);
+#endif
+}
+CONTROL_RAMFUNC_END
+
+/* [] END OF FILE */
@@ -0,0 +1,140 @@
+/*******************************************************************************
+* File Name: load_ff.h
+*
+* Description:
+* Load step feedforward of the BUCK1 output in the TEST state. The transient
+* load is switched by the firmware itself through PWM_LOAD, so the load
+* current step is known when it happens. The control ISR reads the PWM_LOAD
+* line from its counter in the period of the edge and moves the compensator
+* output and history by the peak current of the step, divided over the active
+* phases, like a phase shedding transition. The compensator then only corrects
+* the difference between the feedforward and the actual step, from the
+* moved output. That correction, the change of the compensator output over
+* the high phase, is measured at each falling edge and half of it is added to
+* the step, so the feedforward follows the load actually switched: the
+* setting of SW4, other load resistors or the complementary transient load 2.
+* The feedforward is switched on and off while the line is low, so that the
+* switch itself does not step the reference.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef LOAD_FF_H
+#define LOAD_FF_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "cybsp.h"
+#include "buck_conv.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Load step feedforward: 0 - disabled, 1 - enabled (default). Set with LOAD_FF
+ * in the Makefile, and at run time with load_ff_set_enable(). */
+#ifndef LOAD_FF
+#define LOAD_FF (1)
+#endif
+
+/* Load current step of the transient load 1 (0.2 A to 1.8 A), mA: start value
+ * and range of the runtime setting and of the learned step. */
+#define LOAD_FF_STEP_MA             (1600)
+#define LOAD_FF_STEP_MA_MAX         (3000)
+
+/* CSG DAC counts per A of peak current (CurSenseGain 0.960 V/A) */
+#define LOAD_FF_DAC_PER_A           (1023.0f / 3.3f * 0.960f)
+#define LOAD_FF_STEP_MAX            ((int32_t)(((float32_t)LOAD_FF_STEP_MA_MAX * LOAD_FF_DAC_PER_A / 1000.0f) + 0.5f))
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    bool              enable;       /* Feedforward requested */
+    bool              active;       /* Feedforward applied, follows enable while the line is low */
+    bool              line;         /* PWM_LOAD line in the previous period */
+    float32_t         out_high;     /* Compensator output after the rising edge times the active phases */
+    volatile int32_t  step;         /* Peak current of the step with one phase, DAC counts */
+    uint32_t          edges;        /* Rising edges with the feedforward applied */
+} load_ff_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern load_ff_t load_ff;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void load_ff_reset(void);
+void load_ff_set_enable(bool enable);
+bool load_ff_set_step(int32_t step_ma);
+float32_t load_ff_step_ma(void);
+void load_ff_edge(bool line, uint8_t phases);
+
+/*******************************************************************************
+* Function Name: load_ff_control
+*********************************************************************************
+* Summary:
+* Called from the post-process callback of the control ISR after the phase
+* shedding transitions. In the TEST state, reads the PWM_LOAD line from its
+* counter (high until the compare value) and applies the feedforward at its
+* edges.
+*
+* Parameters:
+*  test:   converter in the TEST state
+*  phases: active phases
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void load_ff_control(bool test, uint8_t phases)
+{
+    bool line = test && (Cy_TCPWM_PWM_GetCounter(PWM_LOAD_HW, PWM_LOAD_NUM) < PWM_LOAD_config.compare0);
+
+    if ((line != load_ff.line) && load_ff.active)
+    {
+        load_ff_edge(line, phases);
+    }
+    if (!line)
+    {
+        load_ff.active = load_ff.enable;
+    }
+    load_ff.line = line;
+}
+
+#endif  /* LOAD_FF_H */
+/* [] END OF FILE */
@@ -0,0 +1,388 @@
+/*******************************************************************************
+* File Name: load_step.c
+*
+* Description:
+* Load step response metrics of the BUCK1 output in the TEST state.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "uart_tx.h"
+#include "load_step.h"
+#include "telemetry.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define LOAD_STEP_US_PER_PERIOD     (1.0e6f / (float32_t)LOAD_STEP_CTRL_FREQ_HZ)
+#define LOAD_STEP_MV_PER_COUNT      (1000.0f * LOAD_STEP_VOLT_PER_COUNT)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+load_step_t load_step;
+
+static const char *const load_step_names[LOAD_STEP_DIRS] = { "up", "down" };
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: load_step_finish
+*********************************************************************************
+* Summary:
+* Adds the step in progress to the statistics of its direction.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+static void load_step_finish(void)
+{
+    load_step_stats_t *st = &load_step.stats[load_step.dir];
+    const load_step_event_t *ev = &load_step.ev;
+    int32_t peak = ev->peak;
+
+    st->count++;
+    if (load_step.left && (ev->settling == load_step.periods))
+    {
+        st->unsettled++;
+    }
+    st->peak_sum    += peak;
+    st->peak_sq_sum += (uint64_t)(peak * peak);
+    if ((peak * peak) > ((int32_t)st->peak_worst * st->peak_worst))
+    {
+        st->peak_worst = (int16_t)peak;
+    }
+    st->settling_sum += ev->settling;
+    st->recovery_sum += ev->recovery;
+    if (ev->settling > st->settling_max)
+    {
+        st->settling_max = ev->settling;
+    }
+    st->last = *ev;
+
+    load_step.pending |= (1UL << load_step.dir);
+    load_step.tracking = false;
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: load_step_reset
+*********************************************************************************
+* Summary:
+* Clears the statistics, called when the converter starts. The PWM_LOAD line
+* is low before the TEST state, so its first edge is a step up.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void load_step_reset(void)
+{
+    memset(&load_step, 0, sizeof(load_step));
+}
+
+/*******************************************************************************
+* Function name: load_step_track
+*********************************************************************************
+* Summary:
+* Analyzer engine, called from the control ISR in the TEST state. An edge of
+* the load line ends the step in progress and starts a new one. During a step,
+* the deviation of the output voltage result from the reference updates the
+* peak, the undershoot and overshoot, the recovery and the settling time. The
+* step ends after LOAD_STEP_WINDOW control periods.
+*
+* Parameters:
+*  line: PWM_LOAD line, high while the transient load 1 draws the high current
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void load_step_track(bool line)
+{
+    int32_t dev;
+
+    if (line != load_step.line)
+    {
+        load_step.line = line;
+        if (load_step.tracking)
+        {
+            load_step_finish();
+        }
+        load_step.dir      = line ? LOAD_STEP_UP : LOAD_STEP_DOWN;
+        load_step.ref      = (int32_t)BUCK1_ctx.ref;
+        load_step.periods  = 0U;
+        load_step.left     = false;
+        load_step.ev       = (load_step_event_t){ 0 };
+        load_step.tracking = true;
+    }
+    if (!load_step.tracking)
+    {
+        return;
+    }
+
+    load_step.periods++;
+    dev = (int32_t)BUCK1_ctx.res - load_step.ref;
+    if (dev < load_step.ev.undershoot)
+    {
+        load_step.ev.undershoot = (int16_t)dev;
+    }
+    if (dev > load_step.ev.overshoot)
+    {
+        load_step.ev.overshoot = (int16_t)dev;
+    }
+    if ((dev * dev) > ((int32_t)load_step.ev.peak * load_step.ev.peak))
+    {
+        load_step.ev.peak = (int16_t)dev;
+    }
+
+    if ((dev > LOAD_STEP_BAND) || (dev < -LOAD_STEP_BAND))
+    {
+        load_step.left = true;
+        load_step.ev.settling = load_step.periods;
+    }
+    else if (load_step.left && (load_step.ev.recovery == 0U))
+    {
+        load_step.ev.recovery = load_step.periods;
+    }
+    else
+    {
+        /* Within the band. */
+    }
+
+    if (load_step.periods >= LOAD_STEP_WINDOW)
+    {
+        load_step_finish();
+    }
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: load_step_snapshot
+*********************************************************************************
+* Summary:
+* Copies the statistics of one direction with the interrupts disabled.
+*
+* Parameters:
+*  dir: direction
+*  st:  copy
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void load_step_snapshot(load_step_dir_t dir, load_step_stats_t *st)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    *st = load_step.stats[dir];
+    __set_PRIMASK(primask);
+}
+
+/*******************************************************************************
+* Function name: load_step_mean
+*********************************************************************************
+* Summary:
+* Mean of a sum over the steps of a direction, 0 without steps.
+*
+*******************************************************************************/
+static float32_t load_step_mean(float32_t sum, uint32_t count)
+{
+    return (count > 0U) ? (sum / (float32_t)count) : 0.0f;
+}
+
+/*******************************************************************************
+* Function name: load_step_status
+*********************************************************************************
+* Summary:
+* Prints the mean peak deviation and settling time of both directions, for the
+* status line in the TEST state.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void load_step_status(void)
+{
+    load_step_stats_t up;
+    load_step_stats_t down;
+
+    load_step_snapshot(LOAD_STEP_UP, &up);
+    load_step_snapshot(LOAD_STEP_DOWN, &down);
+
+    uart_tx_printf("STEPS=%lu DV=%+.0f/%+.0f mV TS=%.0f/%.0f us  ", (unsigned long)(up.count + down.count),
+                   (float64_t)(load_step_mean((float32_t)up.peak_sum, up.count) * LOAD_STEP_MV_PER_COUNT),
+                   (float64_t)(load_step_mean((float32_t)down.peak_sum, down.count) * LOAD_STEP_MV_PER_COUNT),
+                   (float64_t)(load_step_mean((float32_t)up.settling_sum, up.count) * LOAD_STEP_US_PER_PERIOD),
+                   (float64_t)(load_step_mean((float32_t)down.settling_sum, down.count) * LOAD_STEP_US_PER_PERIOD));
+}
+
+/*******************************************************************************
+* Function name: load_step_report
+*********************************************************************************
+* Summary:
+* Prints the statistics of both directions, called when the TEST state ends.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void load_step_report(void)
+{
+    uart_tx_printf("\r\n\nLoad steps (band +-%.0f mV)  steps  peak mean/std/worst mV   under/over last mV"
+                   "  recovery mean us  settling mean/max us  unsettled\r\n",
+                   (float64_t)((float32_t)LOAD_STEP_BAND * LOAD_STEP_MV_PER_COUNT));
+
+    for (uint32_t dir = 0U; dir < (uint32_t)LOAD_STEP_DIRS; dir++)
+    {
+        load_step_stats_t st;
+        float32_t mean;
+        float32_t var;
+
+        load_step_snapshot((load_step_dir_t)dir, &st);
+        mean = load_step_mean((float32_t)st.peak_sum, st.count);
+        var  = load_step_mean((float32_t)st.peak_sq_sum, st.count) - (mean * mean);
+
+        uart_tx_printf("%-26s %6lu  %+6.0f %5.1f %+6.0f       %+5.0f %+5.0f     %8.0f          %6.0f %6.0f     %6lu\r\n",
+                       load_step_names[dir], (unsigned long)st.count,
+                       (float64_t)(mean * LOAD_STEP_MV_PER_COUNT),
+                       (float64_t)(sqrtf((var > 0.0f) ? var : 0.0f) * LOAD_STEP_MV_PER_COUNT),
+                       (float64_t)((float32_t)st.peak_worst * LOAD_STEP_MV_PER_COUNT),
+                       (float64_t)((float32_t)st.last.undershoot * LOAD_STEP_MV_PER_COUNT),
+                       (float64_t)((float32_t)st.last.overshoot * LOAD_STEP_MV_PER_COUNT),
+                       (float64_t)(load_step_mean((float32_t)st.recovery_sum, st.count) * LOAD_STEP_US_PER_PERIOD),
+                       (float64_t)(load_step_mean((float32_t)st.settling_sum, st.count) * LOAD_STEP_US_PER_PERIOD),
+                       (float64_t)((float32_t)st.settling_max * LOAD_STEP_US_PER_PERIOD),
+                       (unsigned long)st.unsettled);
+    }
+}
+
+/*******************************************************************************
+* Function name: load_step_send
+*********************************************************************************
+* Summary:
+* Sends one binary telemetry record for each direction with a step completed
+* since the last call: the last step and the statistics of the direction.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void load_step_send(void)
+{
+    uint8_t record[TELEMETRY_STEP_SIZE + TELEMETRY_CRC_SIZE];
+    uint32_t primask;
+    uint32_t pending;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    pending = load_step.pending;
+    load_step.pending = 0U;
+    __set_PRIMASK(primask);
+
+    for (uint32_t dir = 0U; dir < (uint32_t)LOAD_STEP_DIRS; dir++)
+    {
+        load_step_stats_t st;
+        int32_t peak_mean;
+        uint32_t settling_mean;
+
+        if ((pending & (1UL << dir)) == 0U)
+        {
+            continue;
+        }
+        load_step_snapshot((load_step_dir_t)dir, &st);
+        peak_mean = (int32_t)lroundf(load_step_mean((float32_t)st.peak_sum * 16.0f, st.count));
+        settling_mean = (uint32_t)lroundf(load_step_mean((float32_t)st.settling_sum, st.count));
+
+        record[TELEMETRY_STEP_OFS_KIND]             = (uint8_t)TELEMETRY_KIND_STEP;
+        record[TELEMETRY_STEP_OFS_DIR]              = (uint8_t)dir;
+        record[TELEMETRY_STEP_OFS_COUNT]            = (uint8_t)st.count;
+        record[TELEMETRY_STEP_OFS_COUNT + 1U]       = (uint8_t)(st.count >> 8);
+        record[TELEMETRY_STEP_OFS_PEAK]             = (uint8_t)st.last.peak;
+        record[TELEMETRY_STEP_OFS_PEAK + 1U]        = (uint8_t)((uint16_t)st.last.peak >> 8);
+        record[TELEMETRY_STEP_OFS_UNDER]            = (uint8_t)st.last.undershoot;
+        record[TELEMETRY_STEP_OFS_UNDER + 1U]       = (uint8_t)((uint16_t)st.last.undershoot >> 8);
+        record[TELEMETRY_STEP_OFS_OVER]             = (uint8_t)st.last.overshoot;
+        record[TELEMETRY_STEP_OFS_OVER + 1U]        = (uint8_t)((uint16_t)st.last.overshoot >> 8);
+        record[TELEMETRY_STEP_OFS_RECOVERY]         = (uint8_t)st.last.recovery;
+        record[TELEMETRY_STEP_OFS_RECOVERY + 1U]    = (uint8_t)(st.last.recovery >> 8);
+        record[TELEMETRY_STEP_OFS_SETTLING]         = (uint8_t)st.last.settling;
+        record[TELEMETRY_STEP_OFS_SETTLING + 1U]    = (uint8_t)(st.last.settling >> 8);
+        record[TELEMETRY_STEP_OFS_PEAK_MEAN]        = (uint8_t)peak_mean;
+        record[TELEMETRY_STEP_OFS_PEAK_MEAN + 1U]   = (uint8_t)((uint32_t)peak_mean >> 8);
+        record[TELEMETRY_STEP_OFS_PEAK_WORST]       = (uint8_t)st.peak_worst;
+        record[TELEMETRY_STEP_OFS_PEAK_WORST + 1U]  = (uint8_t)((uint16_t)st.peak_worst >> 8);
+        record[TELEMETRY_STEP_OFS_SETTLING_MEAN]    = (uint8_t)settling_mean;
+        record[TELEMETRY_STEP_OFS_SETTLING_MEAN + 1U] = (uint8_t)(settling_mean >> 8);
+        record[TELEMETRY_STEP_OFS_SETTLING_MAX]     = (uint8_t)st.settling_max;
+        record[TELEMETRY_STEP_OFS_SETTLING_MAX + 1U] = (uint8_t)(st.settling_max >> 8);
+        record[TELEMETRY_STEP_OFS_UNSETTLED]        = (uint8_t)st.unsettled;
+        record[TELEMETRY_STEP_OFS_UNSETTLED + 1U]   = (uint8_t)(st.unsettled >> 8);
+
+        telemetry_send_record(record, TELEMETRY_STEP_SIZE);
+    }
+}
+
+/* [] END OF FILE */
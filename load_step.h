@@ -0,0 +1,155 @@
+/*******************************************************************************
+* File Name: load_step.h
+*
+* Description:
+* Load step response metrics of the BUCK1 output in the TEST state. The
+* control ISR detects the edges of the PWM_LOAD transient load from its
+* counter and follows the output voltage result around each edge: peak
+* deviation, undershoot and overshoot, recovery into and settling within a
+* band around the reference. Completed steps are added to running statistics
+* for each direction. Nothing but the step in progress is stored, so the
+* analyzer can stay enabled in production.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef LOAD_STEP_H
+#define LOAD_STEP_H
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Settling band around the reference, ADC counts (15 counts = 50 mV). */
+#define LOAD_STEP_BAND              (15)
+
+/* A step is followed for at most this many control periods (20 ms), or until
+ * the next edge. A step still outside the band at the end is unsettled. */
+#define LOAD_STEP_WINDOW            (6000U)
+
+/* Control ISR frequency (SwitchingFreq, control loop divider 1). */
+#define LOAD_STEP_CTRL_FREQ_HZ      (300000U)
+
+/* Output voltage sense: ADC counts to V (exGain0). */
+#define LOAD_STEP_VOLT_PER_COUNT    (3.3f / 4095.0f / 0.239f)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    LOAD_STEP_UP,                   /* PWM_LOAD line rising, transient load 1 high */
+    LOAD_STEP_DOWN,                 /* PWM_LOAD line falling */
+    LOAD_STEP_DIRS
+} load_step_dir_t;
+
+/* One step, deviations from the reference in ADC counts, times in control
+ * periods from the edge. */
+typedef struct
+{
+    int16_t  peak;                  /* Deviation with the largest magnitude */
+    int16_t  undershoot;            /* Lowest deviation, at most 0 */
+    int16_t  overshoot;             /* Highest deviation, at least 0 */
+    uint16_t recovery;              /* First return into the band, 0 if it was not left */
+    uint16_t settling;              /* Last period outside the band, 0 if it was not left */
+} load_step_event_t;
+
+/* Running statistics of one direction. */
+typedef struct
+{
+    uint32_t count;                 /* Completed steps */
+    uint32_t unsettled;             /* Steps still outside the band at the end of the window */
+    int32_t  peak_sum;
+    int16_t  peak_worst;            /* Peak with the largest magnitude */
+    uint16_t settling_max;
+    uint32_t settling_sum;
+    uint32_t recovery_sum;
+    uint64_t peak_sq_sum;           /* For the standard deviation of the peak */
+    load_step_event_t last;
+} load_step_stats_t;
+
+typedef struct
+{
+    bool       line;                /* PWM_LOAD line in the previous period */
+    bool       tracking;            /* A step is followed */
+    bool       left;                /* The output has left the band in this step */
+    load_step_dir_t dir;
+    uint16_t   periods;             /* Control periods since the edge */
+    int32_t    ref;                 /* Reference at the edge */
+    load_step_event_t ev;           /* Step in progress */
+    load_step_stats_t stats[LOAD_STEP_DIRS];
+    volatile uint32_t pending;      /* Directions with a step completed since load_step_send() */
+} load_step_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern load_step_t load_step;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void load_step_reset(void);
+void load_step_track(bool line);
+void load_step_report(void);
+void load_step_send(void);
+void load_step_status(void);
+
+/*******************************************************************************
+* Function Name: load_step_control
+*********************************************************************************
+* Summary:
+* Called from the post-process callback of the control ISR. In the TEST state,
+* reads the PWM_LOAD line from its counter (high until the compare value) and
+* follows the step in progress.
+*
+* Parameters:
+*  test: converter in the TEST state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void load_step_control(bool test)
+{
+    if (test)
+    {
+        load_step_track(Cy_TCPWM_PWM_GetCounter(PWM_LOAD_HW, PWM_LOAD_NUM) < PWM_LOAD_config.compare0);
+    }
+}
+
+#endif  /* LOAD_STEP_H */
+/* [] END OF FILE */
@@ -49,6 +49,9 @@
 #include "cy_retarget_io.h"
 #include "mtb_hal.h"
 #include "buck_protection.h"
+#include "telemetry.h"
+#include "uart_tx.h"
+#include "uart_cmd.h"
 
 /*******************************************************************************
 * Macros
@@ -59,8 +62,6 @@
 #define OUTPUT_VOLT_DVDR  (0.239)          /* Output voltage divider. */
 #define REF_VALUE_ADC     (3.3)            /* ADC reference value. */
 
-/* MACRO For controlling soft start in PCCM mode */
-#define SOFT_START_COMPARE_VAL_STEP (2)
 /*******************************************************************************
 * Global variables
 *******************************************************************************/
@@ -79,22 +80,6 @@ cy_stc_sysint_t button_press_intr_config =
     .intrPriority = 3UL,
 };
 
-/* Variables for protection for converter */
-float32_t buck1_iout1_adc_res         = 0;
-float32_t buck1_temp_adc_res          = 0;
-float32_t buck1_iout2_adc_res         = 0;
-float32_t buck1_iout1_avg             = 0;
-float32_t buck1_temp_avg              = 0;
-float32_t buck1_iout2_avg             = 0;
-float32_t vin_adc_res                 = 0;
-float32_t vin_avg                     = VIN_COUNT;
-
-/* Variables for controlling PWM compare value during soft start */
-uint32_t soft_start_compare_value     = 0;
-
-/* State variable. */
-Ifx_buck_states buck_state = Ifx_BUCK_STATE_IDLE;
-
 /* Debug UART variables. */
 static cy_stc_scb_uart_context_t    DEBUG_UART_context; /* UART context. */
 static mtb_hal_uart_t               DEBUG_UART_hal_obj; /* Debug UART HAL object. */
@@ -115,6 +100,14 @@ void button_press_intr_handler(void);
 /* Function for peripheral initialization and enabling. */
 void hardware_init(void);
 
+/* Function for reporting the converter status on the debug UART. */
+void status_update(void);
+
+#if !TELEMETRY_BINARY
+/* Function for printing the output voltages and load currents. */
+static void status_values(void);
+#endif
+
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
@@ -136,6 +129,20 @@ void hardware_init(void);
 void hardware_init(void)
 {
     cy_rslt_t result;
+    uint8_t conv;
+
+    /* Sets the protection limits and clears the protection variables of the
+     * converters. */
+    for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        buck_conv_init(conv);
+    }
+
+    /* Clears the energy accounting. */
+    energy_reset();
+
+    /* Empties the event queue of the converter state machine. */
+    buck_sm_init();
 
     /* Initializes the timer for transient load testing. */
     result = Cy_TCPWM_PWM_Init(PWM_LOAD_HW, PWM_LOAD_NUM, &PWM_LOAD_config);
@@ -192,6 +199,23 @@ void hardware_init(void)
     Cy_TCPWM_Counter_Enable(SOFT_START_COUNTER_HW, SOFT_START_COUNTER_NUM);
     Cy_TCPWM_PWM_Enable(PWM_STATUS_LED_HW, PWM_STATUS_LED_NUM);
     Cy_TCPWM_PWM_Enable(PWM_ACT_LED_HW, PWM_ACT_LED_NUM);
+
+    /* The capture buffer of the control loop stays idle until the scope
+     * command arms it, so the control ISR does not record by default. */
+
+    /* Keeps the PCC tool compensator coefficients for the gain scheduling. */
+    gain_sched_init();
+
+    /* Checks the fault records kept from before the reset. */
+    flight_rec_init();
+
+    /* Prepares the frequency response sweep. */
+    fra_init();
+
+#if ISR_PROFILE
+    /* Starts the cycle counter for the interrupt execution time profiler. */
+    isr_profile_init();
+#endif
 }
 
 /*******************************************************************************
@@ -199,10 +223,11 @@ void hardware_init(void)
 *********************************************************************************
 * Summary:
 * This is the interrupt service routine (ISR) for the soft start counter interrupt.
-* It gradually increases the reference values until reaching the calculated final
-* reference values in converter. It provides firmware trigger to scheduled adc
-* group. When the reference value reached the target value, it enables the
-* hardware protection for output voltage.
+* It provides firmware trigger to the scheduled adc group of each converter. The
+* reference and the PWM compare values are ramped by the soft start engine in
+* the control ISR (see soft_start.h). When the reference value of a converter
+* reached the target value, it posts the end of the ramp to the state machine,
+* which enables the hardware protection for output voltage.
 *
 * Parameters:
 *  void
@@ -213,45 +238,36 @@ void hardware_init(void)
 *******************************************************************************/
 void soft_start_prot_intr_handler(void)  // rename
 {
-    /* Clears soft start interrupt. */
-    Cy_TCPWM_ClearInterrupt(SOFT_START_COUNTER_HW, SOFT_START_COUNTER_NUM, CY_TCPWM_INT_ON_TC);
+    uint8_t conv;
 
-    /* Increments the reference value for buck1 and buck2. */
-    BUCK1_ramp();
+    ISR_PROFILE_START(ISR_PROFILE_SOFT_START);
 
-    /* Firmware trigger to buck-1 scheduled adc group*/
-    BUCK1_scheduled_adc_trigger();
+    /* Clears soft start interrupt. */
+    Cy_TCPWM_ClearInterrupt(SOFT_START_COUNTER_HW, SOFT_START_COUNTER_NUM, CY_TCPWM_INT_ON_TC);
 
-    if(buck_state == Ifx_BUCK_STATE_RAMP)
+    for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
     {
-        /* Gradually increases the PWM compare value */
-        soft_start_compare_value = soft_start_compare_value + SOFT_START_COMPARE_VAL_STEP;
-        Cy_TCPWM_PWM_SetCompare0Val(PWM_BUCK_1_HW, PWM_BUCK_1_NUM,  soft_start_compare_value);
-        Cy_TCPWM_PWM_SetCompare0Val(PWM_BUCK_2_HW, PWM_BUCK_2_NUM,  soft_start_compare_value);
+        /* Firmware trigger to the scheduled adc group of the converter, the
+         * result is used by the averaged protection. */
+        fast_prot_tick(conv);
+        buck_conv_hw[conv].sched_trigger();
 
-        if((0UL != BUCK1_get_state(MTB_PWRCONV_STATE_RUN)) && (0UL == BUCK1_get_state(MTB_PWRCONV_STATE_RAMP)))
+        /* Moves the converter to the run state at the end of its ramp. */
+        if (buck_conv_ramp_done(conv))
         {
-            /* Setting the soft start flag */
-            buck_state = Ifx_BUCK_STATE_RUN;
-
-            /* Enabling the output voltage protection */
-            BUCK1_Vout_prot_enable();
-
-            /* Enables button IRQ after soft start. */
-            NVIC_EnableIRQ(button_press_intr_config.intrSrc);
-
-            /* Set final compare value after soft start */
-            Cy_TCPWM_PWM_SetCompare0Val(PWM_BUCK_1_HW, PWM_BUCK_1_NUM,  PWM_BUCK_1_config.compare0);/* buck1 */
-            Cy_TCPWM_PWM_SetCompare0Val(PWM_BUCK_2_HW, PWM_BUCK_2_NUM,  PWM_BUCK_2_config.compare0);/* buck2 */
+            buck_sm_post(BUCK_SM_EV_RAMP_DONE, conv, 0U);
         }
     }
+
+    ISR_PROFILE_STOP(ISR_PROFILE_SOFT_START);
 }
 
 /*******************************************************************************
 * Function name: button_press_intr_handler
 *********************************************************************************
 * Summary:
-* This is the button interrupt handler that control the converter state machine.
+* This is the button interrupt handler. It posts the button press to the
+* converter state machine, which moves each converter to its next state.
 *
 * Parameters:
 *  void
@@ -262,120 +278,178 @@ void soft_start_prot_intr_handler(void)  // rename
 *******************************************************************************/
 void button_press_intr_handler(void)
 {
+    ISR_PROFILE_START(ISR_PROFILE_BUTTON);
+
     /* Clears the GPIO interrupt. */
     Cy_GPIO_ClearInterrupt(USER_BUTTON_PORT, USER_BUTTON_NUM);
 
-    /* Result variable */
-    cy_rslt_t result;
-
-    switch (buck_state)
-    {
-        case Ifx_BUCK_STATE_IDLE: /* Button press when the state is Idle. State will switch to run state. */
-        {
-            /* Resets variables used for protection of converter */
-            buck1_iout1_adc_res = 0;
-            buck1_iout2_adc_res = 0;
-            buck1_temp_adc_res  = 0;
-            buck1_iout1_avg     = 0;
-            buck1_iout2_avg     = 0;
-            buck1_temp_avg      = 0;
-            vin_avg             = VIN_COUNT;
-
-
-            /* Set initial compare value for a controlled soft start */
-            soft_start_compare_value = 0;
-            Cy_TCPWM_PWM_SetCompare0Val(PWM_BUCK_1_HW, PWM_BUCK_1_NUM,  soft_start_compare_value);/* buck1 */
-            Cy_TCPWM_PWM_SetCompare0Val(PWM_BUCK_2_HW, PWM_BUCK_2_NUM,  soft_start_compare_value);/* buck2 */
-
-            /* Enables the buck converter. */
-            result = BUCK1_enable();
-            if (result != CY_RSLT_SUCCESS)
-            {
-                CY_ASSERT(0);
-            }
-
-            /* Starts the buck converter */
-            result = BUCK1_start();
-            if (result != CY_RSLT_SUCCESS)
-            {
-                CY_ASSERT(0);
-            }
-
-            /* Disables button IRQ to avoid button actions during soft start. */
-            NVIC_DisableIRQ(button_press_intr_config.intrSrc);
-
-            /* Setting the LED indicating the run status. */
-            Cy_TCPWM_PWM_SetCompare0Val(PWM_ACT_LED_HW, PWM_ACT_LED_NUM, SET_LED);
-
-            /* Turns OFF fault LED. */
-            Cy_GPIO_Set(FAULT_LED_PORT, FAULT_LED_NUM);
-
-            /* Starts the soft start of the converter. */
-            Cy_TCPWM_TriggerStart_Single(SOFT_START_COUNTER_HW, SOFT_START_COUNTER_NUM);
-
-            /* Updates the state of the converter. */
-            buck_state = Ifx_BUCK_STATE_RAMP;
-
-            break;
-        }
-
-        case Ifx_BUCK_STATE_RUN: /* Button press when state is Run. State will switch to Test state. */
-        {
-            /* Sets the counter for blinking the ACT LED. */
-            Cy_TCPWM_TriggerStart_Single(PWM_LOAD_HW, PWM_LOAD_NUM);
-
-            /* Starts PWMs for transient testing. */
-            Cy_TCPWM_PWM_SetCompare0Val(PWM_ACT_LED_HW, PWM_ACT_LED_NUM, TOGGLE_LED);
+    buck_sm_post(BUCK_SM_EV_BUTTON, 0U, 0U);
 
-            /* Updates the state of the converter. */
-            buck_state = Ifx_BUCK_STATE_TEST;
+    ISR_PROFILE_STOP(ISR_PROFILE_BUTTON);
+}
 
-            break;
-        }
+#if !TELEMETRY_BINARY
+/*******************************************************************************
+* Function name: status_values
+********************************************************************************
+* Summary:
+* Prints the output voltage of each converter, the load current of each phase,
+* the number of switching phases of the primary converter, its output power
+* and efficiency, and the peak current limit of a converter being derated.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void status_values(void)
+{
+    uint8_t conv;
+    uint32_t phase;
+    uint32_t load = 1U;
 
-        case Ifx_BUCK_STATE_TEST: /* Button press when state is Test. State will switch to Idle state. */
+    for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        uart_tx_printf("%s_VOUT=%.2f V  ", buck_conv_hw[conv].name, ((float64_t)buck_conv_hw[conv].ctx->res*volt_multiplier));
+    }
+    for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        for (phase = 0U; phase < BUCK_CONV_PHASES; phase++)
         {
-            /* Stops run LED. */;
-            Cy_TCPWM_PWM_SetCompare0Val(PWM_ACT_LED_HW, PWM_ACT_LED_NUM, CLR_LED);
-
-            /* Stops PWMs for transient testing. */
-            Cy_TCPWM_TriggerStopOrKill_Single(PWM_LOAD_HW, PWM_LOAD_NUM);
+            uart_tx_printf("LOAD%lu=%.2f A  ", (unsigned long)load, ((float64_t)buck_conv[conv].iout_res[phase]*current_multiplier));
+            load++;
+        }
+    }
+    uart_tx_printf("PHASES=%u  ", phase_shed.phases);
+    energy_status();
+    thermal_status();
+}
+#endif
 
-            /* Stops the buck converter. */
-            result = BUCK1_disable();
-            if (result != CY_RSLT_SUCCESS)
-            {
-                CY_ASSERT(0);
-            }
+/*******************************************************************************
+* Function name: status_update
+********************************************************************************
+* Summary:
+* Reports the converter status on the debug UART, either as a status line or
+* as a binary telemetry record (TELEMETRY_BINARY), at UART_TX_RATE_HZ. The
+* output is written to the buffer of uart_tx.h, which sends it once the pass
+* of the main loop is complete. A completed scope
+* capture or a pending flight recorder fault record is sent instead of the
+* status, and the results of a completed frequency response sweep are
+* evaluated (and printed in text mode). In text mode, the soft start result
+* is printed once regulation is reached, the load step statistics at the end
+* of the TEST state and, with ISR_PROFILE, the interrupt profile when the
+* converter has stopped. In binary mode, a record of each completed load step
+* and an energy record of each complete window precede the status record.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void status_update(void)
+{
+#if !TELEMETRY_BINARY
+    static Ifx_buck_states report_state = Ifx_BUCK_STATE_IDLE;
+    Ifx_buck_states state = buck_conv[BUCK_CONV_PRIMARY].state;
 
-            /* Stops the soft start timer. */
-            Cy_TCPWM_TriggerStopOrKill_Single(SOFT_START_COUNTER_HW, SOFT_START_COUNTER_NUM);
+    if ((report_state == Ifx_BUCK_STATE_TEST) && (state != Ifx_BUCK_STATE_TEST))
+    {
+        load_step_report();
+    }
+#if ISR_PROFILE
+    if (((state == Ifx_BUCK_STATE_IDLE) || (state == Ifx_BUCK_STATE_FAULT)) &&
+        (report_state != Ifx_BUCK_STATE_IDLE) && (report_state != Ifx_BUCK_STATE_FAULT))
+    {
+        isr_profile_report();
+    }
+#endif
+    report_state = state;
+#endif
 
-            /* Updates the state of the converter. */
-            buck_state = Ifx_BUCK_STATE_IDLE;
+    if (scope_ready())
+    {
+        scope_dump();
+        return;
+    }
 
-            break;
-        }
+    if (flight_rec_ready())
+    {
+        flight_rec_dump();
+        return;
+    }
 
-        case Ifx_BUCK_STATE_FAULT: /* Button press when state is Fault. State will switch to Idle state. */
-        {
-            /* Turns OFF fault LED. */
-            Cy_GPIO_Set(FAULT_LED_PORT, FAULT_LED_NUM);
+    if (fra_ready())
+    {
+        fra_report();
+        return;
+    }
 
-            /* Updates the state of the converter. */
-            buck_state = Ifx_BUCK_STATE_IDLE;
+    if (autotune_ready())
+    {
+        autotune_process();
+        return;
+    }
 
-            break;
-        }
+#if TELEMETRY_BINARY
+    if (0U != load_step.pending)
+    {
+        load_step_send();
+    }
+    if (energy.pending)
+    {
+        energy_send();
+    }
+    if (uart_tx_due())
+    {
+        telemetry_send();
+    }
+#else
+    soft_start_report();
+    setpoint_report();
 
-        default:
-        {
-            /* Updates the state of the converter. */
-            buck_state = Ifx_BUCK_STATE_IDLE;
+    if (!uart_tx_due())
+    {
+        return;
+    }
 
-            break;
-        }
+    /*Printing the active state with output volatge and load*/
+    switch (buck_conv[BUCK_CONV_PRIMARY].state)
+    {
+    case Ifx_BUCK_STATE_IDLE:
+    {
+        uart_tx_printf("\rRegulation Off Transient pulse Off                                                                ");
+        break;
+    }
+    case Ifx_BUCK_STATE_RUN:
+    {
+        uart_tx_printf("\rRegulation On Transient pulse Off ");
+        status_values();
+        break;
+    }
+    case Ifx_BUCK_STATE_TEST:
+    {
+        uart_tx_printf("\rRegulation On Transient pulse On ");
+        status_values();
+        uart_tx_printf(" ");
+        load_step_status();
+        break;
+    }
+    case Ifx_BUCK_STATE_FAULT:
+    {
+        uart_tx_printf("\rFault                                                                                            ");
+        break;
+    }
+    default:
+    {
+        break;
+    }
     }
+#endif
 }
 
 /*******************************************************************************
@@ -436,6 +510,14 @@ int main(void)
         CY_ASSERT(0);
     }
 
+    /* Output is formatted into the buffers of uart_tx.h and sent in the
+     * background. */
+    uart_tx_init(&DEBUG_UART_context);
+
+    /* Commands are received in the UART interrupt and executed in the main
+     * loop. */
+    uart_cmd_init();
+
     /* Enables global interrupts. */
     __enable_irq();
 
@@ -450,63 +532,46 @@ int main(void)
     Cy_TCPWM_PWM_SetCompare0Val(PWM_ACT_LED_HW, PWM_ACT_LED_NUM, CLR_LED);
     Cy_TCPWM_TriggerStart_Single(PWM_ACT_LED_HW, PWM_ACT_LED_NUM);        /* Converter running/transient testing. */
 
+#if TELEMETRY_BINARY
+    /* Starts the binary telemetry stream, records are framed with zero bytes. */
+    telemetry_init();
+#else
     /* Prints the start of the converter information to the terminal. */
-    printf("\x1b[2J\x1b[;H");
-    printf("\r\n---------------------------------------------------------------------------------------------------------------------------------------------------"
-           "\r\nThis code example demonstrates the peak current control mode multi-phase buck converter implementation on the KIT_PSC3M5_DP1."
-           "\r\n "
-           "\r\nPress events on the user button (USER_BTN) on the dual buck evaluation board takes the converter through the following states."
-           "\r\n1. Converter ON - Converter will regulate the output voltage to the 5 V target. ACT_LED(D5) on the dual buck evaluation board will glow."
-           "\r\n2. Transient ON - Activates load transient pulses to evaluate regulation performance on the output target voltage. ACT_LED will toggle. "
-           "\r\n3. Converter OFF - Stops the output voltage regulation. ACT_LED will be off."
-           "\r\n"
-           "\r\nThe STATUS LED on the control card will blink always. FAULT LED on the dual buck evaluation board will glow when the converter detected a fault."
-           "\r\n"
-           "\r\nKIT_PSC3M5_DP1 comes with variable load and transient load."
-           "\r\nTo test the converters by using variable load, keep the SPDT switches SW4 and SW5 in variable mode,"
-           "\r\nturn ON the converter by pressing the user button, and rotate the potentiometers R42 and R61 to vary the load current."
-           "\r\nTo test using the transient load, keep the SPDT switches in the transient mode and switch the converter to the transient test mode. "
-           "\r\n"
-           "\r\nBefore turning on the output, ensure that the 24 V wall adapter is connected to the board, and the header (J14) is connected."
-           "\r\n"
-           "\r\nFor more information, see the README.md of the mtb-example-ce241298-pccm-buck-multi-phase code example."
-           "\r\n---------------------------------------------------------------------------------------------------------------------------------------------------\r\n"
-           "\r\nThe converter state, output voltage, and load current are as follows:\r\n");
+    uart_tx_printf("\x1b[2J\x1b[;H");
+    uart_tx_printf("\r\n---------------------------------------------------------------------------------------------------------------------------------------------------"
+                   "\r\nThis code example demonstrates the peak current control mode multi-phase buck converter implementation on the KIT_PSC3M5_DP1."
+                   "\r\n "
+                   "\r\nPress events on the user button (USER_BTN) on the dual buck evaluation board takes the converter through the following states."
+                   "\r\n1. Converter ON - Converter will regulate the output voltage to the 5 V target. ACT_LED(D5) on the dual buck evaluation board will glow."
+                   "\r\n2. Transient ON - Activates load transient pulses to evaluate regulation performance on the output target voltage. ACT_LED will toggle. "
+                   "\r\n3. Converter OFF - Stops the output voltage regulation. ACT_LED will be off."
+                   "\r\n"
+                   "\r\nThe STATUS LED on the control card will blink always. FAULT LED on the dual buck evaluation board will glow when the converter detected a fault."
+                   "\r\n"
+                   "\r\nKIT_PSC3M5_DP1 comes with variable load and transient load."
+                   "\r\nTo test the converters by using variable load, keep the SPDT switches SW4 and SW5 in variable mode,"
+                   "\r\nturn ON the converter by pressing the user button, and rotate the potentiometers R42 and R61 to vary the load current."
+                   "\r\nTo test using the transient load, keep the SPDT switches in the transient mode and switch the converter to the transient test mode. "
+                   "\r\n"
+                   "\r\nThe converter can also be controlled with commands on this terminal: start, stop, vout <mV>, pulse on|off, pulse <duty %> <Hz>,"
+                   "\r\nlimit [<name> <counts>] and stats, each ended with Enter."
+                   "\r\n"
+                   "\r\nBefore turning on the output, ensure that the 24 V wall adapter is connected to the board, and the header (J14) is connected."
+                   "\r\n"
+                   "\r\nFor more information, see the README.md of the mtb-example-ce241298-pccm-buck-multi-phase code example."
+                   "\r\n---------------------------------------------------------------------------------------------------------------------------------------------------\r\n"
+                   "\r\nThe converter state, output voltage, and load current are as follows:\r\n");
+
+    /* Sends the banner on its own, the first status follows when it is out. */
+    uart_tx_service();
+#endif
 
     for (;;)
     {
-        /*Printing the active state with output volatge and load*/
-        switch (buck_state)
-        {
-        case Ifx_BUCK_STATE_IDLE:
-        {
-            printf("\rRegulation Off Transient pulse Off                                                                ");
-            break;
-        }
-        case Ifx_BUCK_STATE_RUN:
-        {
-            printf("\rRegulation On Transient pulse Off BUCK1_VOUT=%.2f V  LOAD1=%.2f A  LOAD2=%.2f A  ",((float64_t)BUCK1_ctx.res*volt_multiplier)
-                                                                                                        ,((float64_t)buck1_iout1_adc_res*current_multiplier)
-                                                                                                        ,((float64_t)buck1_iout2_adc_res*current_multiplier));
-            break;
-        }
-        case Ifx_BUCK_STATE_TEST:
-        {
-            printf("\rRegulation On Transient pulse On BUCK1_VOUT=%.2f V  LOAD1=%.2f A  LOAD2=%.2f A   ",((float64_t)BUCK1_ctx.res*volt_multiplier)
-                                                                                                        ,((float64_t)buck1_iout1_adc_res*current_multiplier)
-                                                                                                        ,((float64_t)buck1_iout2_adc_res*current_multiplier));
-            break;
-        }
-        case Ifx_BUCK_STATE_FAULT:
-        {
-            printf("\rFault                                                                                            ");
-            break;
-        }
-        default:
-        {
-            break;
-        }
-        }
+        status_update();
+        uart_cmd_process();
+        thermal_process();
+        uart_tx_service();
     }
 }
 
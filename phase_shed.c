@@ -0,0 +1,233 @@
+/*******************************************************************************
+* File Name: phase_shed.c
+*
+* Description:
+* Light load detection and phase transitions of the phase shedding.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "phase_shed.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PHASE_SHED_DROP_Q15         (PHASE_SHED_IOUT_COUNTS(PHASE_SHED_DROP_CURRENT) << 15)
+#define PHASE_SHED_ADD_Q15          (PHASE_SHED_IOUT_COUNTS(PHASE_SHED_ADD_CURRENT) << 15)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+phase_shed_t phase_shed =
+{
+    .enable    = (PHASE_SHED != 0),
+    .phases    = BUCK_CONV_PHASES,
+    .request   = 0U,
+    .low_count = 0U,
+    .drops     = 0U,
+    .adds      = 0U
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: phase_shed_reset
+*********************************************************************************
+* Summary:
+* Returns to the bookkeeping of all phases switching before the converter
+* starts. BUCK1_enable() starts the PWMs of all its phases.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void phase_shed_reset(void)
+{
+    phase_shed.phases    = BUCK_CONV_PHASES;
+    phase_shed.request   = 0U;
+    phase_shed.low_count = 0U;
+}
+
+/*******************************************************************************
+* Function name: phase_shed_set_enable
+*********************************************************************************
+* Summary:
+* Allows or forbids phase shedding. When forbidden in single phase operation,
+* the second phase is added with the next control ISR.
+*
+* Parameters:
+*  enable: true to allow shedding
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void phase_shed_set_enable(bool enable)
+{
+    phase_shed.enable = enable && (PHASE_SHED != 0);
+    if ((!phase_shed.enable) && (phase_shed.phases == 1U))
+    {
+        phase_shed.request = 2U;
+    }
+}
+
+/*******************************************************************************
+* Function name: phase_shed_update
+*********************************************************************************
+* Summary:
+* Light load detection, called from the scheduled ADC callback. Requests the
+* drop of the second phase after PHASE_SHED_DROP_DELAY periods below the drop
+* threshold, and its addition above the add threshold.
+*
+* Parameters:
+*  iout_sum_q15: sum of the Iout averages, ADC counts with 15 fractional bits
+*  run:          converter in the Run or Test state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void phase_shed_update(int32_t iout_sum_q15, bool run)
+{
+    if (!run)
+    {
+        phase_shed.low_count = 0U;
+        return;
+    }
+
+    if (phase_shed.phases == 2U)
+    {
+        if (phase_shed.enable && (iout_sum_q15 < PHASE_SHED_DROP_Q15))
+        {
+            if (++phase_shed.low_count >= PHASE_SHED_DROP_DELAY)
+            {
+                phase_shed.low_count = 0U;
+                phase_shed.request = 1U;
+            }
+        }
+        else
+        {
+            phase_shed.low_count = 0U;
+        }
+    }
+    else if ((!phase_shed.enable) || (iout_sum_q15 > PHASE_SHED_ADD_Q15))
+    {
+        phase_shed.request = 2U;
+    }
+    else
+    {
+        /* Stay in single phase operation. */
+    }
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: phase_shed_switch
+*********************************************************************************
+* Summary:
+* Changes the number of active phases, called from the control ISR after the
+* compensator. Phase 2 is stopped, leaving its switches off, or restarted half
+* a period after phase 1. The compensator output and history are scaled by the
+* inverse change of the phase count, so the total current stays the same, and
+* the new reference is written to both CSG slices.
+*
+* Parameters:
+*  phases: 1 or 2
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void phase_shed_switch(uint8_t phases)
+{
+    mtb_stc_pwrconv_ctrl_2p2z_t *ctrl = &BUCK1_ctx.ctrl;
+    float32_t scale;
+    float32_t y;
+
+    phase_shed.request = 0U;
+    if (phases == phase_shed.phases)
+    {
+        return;
+    }
+
+    if (phases == 1U)
+    {
+        Cy_TCPWM_TriggerStopOrKill_Single(PWM_BUCK_2_HW, PWM_BUCK_2_NUM);
+        current_share_reset();
+        scale = 2.0f;
+        phase_shed.drops++;
+    }
+    else
+    {
+        uint32_t period  = Cy_TCPWM_PWM_GetPeriod0(PWM_BUCK_1_HW, PWM_BUCK_1_NUM);
+        uint32_t counter = Cy_TCPWM_PWM_GetCounter(PWM_BUCK_1_HW, PWM_BUCK_1_NUM) + (period / 2U);
+
+        if (counter >= period)
+        {
+            counter -= period;
+        }
+        Cy_TCPWM_PWM_SetCounter(PWM_BUCK_2_HW, PWM_BUCK_2_NUM, counter);
+        Cy_TCPWM_TriggerStart_Single(PWM_BUCK_2_HW, PWM_BUCK_2_NUM);
+        scale = 0.5f;
+        phase_shed.adds++;
+    }
+
+    y = ctrl->y1 * scale;
+    ctrl->y1 = (y > ctrl->max) ? ctrl->max : y;
+    y = ctrl->y2 * scale;
+    ctrl->y2 = (y > ctrl->max) ? ctrl->max : y;
+    BUCK1_ctx.out = (uint32_t)ctrl->y1;
+
+    Cy_HPPASS_DAC_SetValue(CURRENT_SHARE_CSG_SLICE_1, (uint16_t)BUCK1_ctx.out);
+    Cy_HPPASS_DAC_SetValue(CURRENT_SHARE_CSG_SLICE_2, (uint16_t)BUCK1_ctx.out);
+
+    phase_shed.phases = phases;
+}
+CONTROL_RAMFUNC_END
+
+/* [] END OF FILE */
@@ -0,0 +1,136 @@
+/*******************************************************************************
+* File Name: phase_shed.h
+*
+* Description:
+* Phase shedding of the two-phase buck converter. Below a light load threshold
+* of the summed Iout averages, the second phase is stopped after a delay. It is
+* added again when the summed averages exceed a higher threshold, or at once
+* from the control ISR when the peak current reference of the remaining phase
+* rises above a fast add level after a load step. The transitions take place
+* in the control ISR and rescale the compensator state, so the peak current
+* reference per phase jumps to the value needed by the new phase count.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef PHASE_SHED_H
+#define PHASE_SHED_H
+#include "cybsp.h"
+#include "current_share.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Phase shedding: 0 - both phases always switch, 1 - enabled (default). */
+#ifndef PHASE_SHED
+#define PHASE_SHED (1)
+#endif
+
+/* Conversions from amperes: Iout ADC counts (0.5 V/A) and CSG DAC counts
+ * (CurSenseGain 0.960 V/A). */
+#define PHASE_SHED_IOUT_COUNTS(a)   ((int32_t)((a) * 4095.0f / 3.3f * 0.5f))
+#define PHASE_SHED_DAC_COUNTS(a)    ((uint32_t)((a) * 1023.0f / 3.3f * 0.960f))
+
+/* Drop the second phase below this total output current ... */
+#define PHASE_SHED_DROP_CURRENT     (0.6f)
+/* ... after this many scheduled ADC periods (10 ms each) below it. */
+#define PHASE_SHED_DROP_DELAY       (50U)
+/* Add the second phase above this total output current, */
+#define PHASE_SHED_ADD_CURRENT      (1.0f)
+/* or immediately when the single phase peak current reference exceeds this. */
+#define PHASE_SHED_ADD_PEAK         (1.4f)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    bool              enable;       /* Shedding allowed */
+    volatile uint8_t  phases;       /* Active phases, 1 or 2 */
+    volatile uint8_t  request;      /* Phase count requested by the scheduled callback, 0 if none */
+    uint16_t          low_count;    /* Scheduled periods below the drop threshold */
+    uint32_t          drops;        /* Number of drop transitions */
+    uint32_t          adds;         /* Number of add transitions */
+} phase_shed_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern phase_shed_t phase_shed;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void phase_shed_reset(void);
+void phase_shed_set_enable(bool enable);
+void phase_shed_update(int32_t iout_sum_q15, bool run);
+void phase_shed_switch(uint8_t phases);
+
+/*******************************************************************************
+* Function Name: phase_shed_control
+*********************************************************************************
+* Summary:
+* Called from the post-process callback of the control ISR. Adds the second
+* phase when the peak current reference exceeds PHASE_SHED_ADD_PEAK in single
+* phase operation, and executes transitions requested by phase_shed_update().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void phase_shed_control(void)
+{
+#if PHASE_SHED
+    if ((phase_shed.phases == 1U) && (BUCK1_ctx.out > PHASE_SHED_DAC_COUNTS(PHASE_SHED_ADD_PEAK)))
+    {
+        phase_shed_switch(2U);
+    }
+    else if (phase_shed.request != 0U)
+    {
+        phase_shed_switch(phase_shed.request);
+    }
+    else
+    {
+        /* No transition */
+    }
+#endif
+}
+
+#endif  /* PHASE_SHED_H */
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/*******************************************************************************
+* File Name: prot_filter.c
+*
+* Description:
+* Filters of the averaged protection.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "prot_filter.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+prot_filter_t prot_filter[BUCK_CONV_NUM];
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: prot_filter_reset
+*********************************************************************************
+* Summary:
+* Resets the filters and the debounce of a converter with its protection
+* averages: the input voltage filter starts at the nominal input voltage, the
+* others at zero.
+*
+* Parameters:
+*  conv:       converter index
+*  vin_counts: nominal input voltage, ADC counts
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void prot_filter_reset(uint8_t conv, uint16_t vin_counts)
+{
+    prot_filter_t *f = &prot_filter[conv];
+    uint32_t phase;
+
+    prot_filter_chan_reset(&f->vin, vin_counts);
+    prot_filter_chan_reset(&f->temp, 0U);
+    for (phase = 0U; phase < BUCK_CONV_PHASES_MAX; phase++)
+    {
+        prot_filter_chan_reset(&f->iout[phase], 0U);
+        f->iout_high[phase] = (prot_debounce_t){ 0 };
+    }
+    f->vin_low   = (prot_debounce_t){ 0 };
+    f->vin_high  = (prot_debounce_t){ 0 };
+    f->temp_high = (prot_debounce_t){ 0 };
+}
+
+/* [] END OF FILE */
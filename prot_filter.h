@@ -0,0 +1,284 @@
+/*******************************************************************************
+* File Name: prot_filter.h
+*
+* Description:
+* Filters of the averaged protection. The scheduled ADC callback filters the
+* input voltage, output current and temperature results of each converter
+* before buck_conv_check() compares them with the limits. The filter of each
+* channel is selected at compile time:
+*  - PROT_FILTER_IIR: first order low pass, avg += (res - avg) / 8 (default)
+*  - PROT_FILTER_BOXCAR: mean of the last 8 results from a running sum
+*  - PROT_FILTER_MEDIAN3: median of the last 3 results, rejects single spikes
+* Each limit compare is then debounced: a limit trips when it was exceeded in
+* PROT_FILTER_TRIP_N of the last PROT_FILTER_TRIP_M checks (1 of 1 by
+* default, every exceeded check trips). The defaults keep the averages and the
+* trip decision of the 8 sample IIR bit exact. sim/filter_bench.c compares
+* the false trip rate and the detection latency of the filters.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef PROT_FILTER_H
+#define PROT_FILTER_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "cybsp.h"
+#include "buck_conv.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Filter types */
+#define PROT_FILTER_IIR             (0)
+#define PROT_FILTER_BOXCAR          (1)
+#define PROT_FILTER_MEDIAN3         (2)
+
+/* Filter of each channel. Set with PROT_FILTER_VIN, PROT_FILTER_IOUT and
+ * PROT_FILTER_TEMP in the Makefile. */
+#ifndef PROT_FILTER_VIN
+#define PROT_FILTER_VIN             PROT_FILTER_IIR
+#endif
+#ifndef PROT_FILTER_IOUT
+#define PROT_FILTER_IOUT            PROT_FILTER_IIR
+#endif
+#ifndef PROT_FILTER_TEMP
+#define PROT_FILTER_TEMP            PROT_FILTER_IIR
+#endif
+
+/* Debounce of the limit compares: N of the last M checks exceeded */
+#ifndef PROT_FILTER_TRIP_N
+#define PROT_FILTER_TRIP_N          (1)
+#endif
+#ifndef PROT_FILTER_TRIP_M
+#define PROT_FILTER_TRIP_M          (1)
+#endif
+#if ((PROT_FILTER_TRIP_N < 1) || (PROT_FILTER_TRIP_N > PROT_FILTER_TRIP_M) || (PROT_FILTER_TRIP_M > 32))
+#error "PROT_FILTER_TRIP_N must be 1 to PROT_FILTER_TRIP_M, PROT_FILTER_TRIP_M at most 32"
+#endif
+
+/* Results kept per channel: the boxcar window, the two previous results of
+ * the median, none for the IIR. */
+#define PROT_FILTER_USES(type)      ((PROT_FILTER_VIN == (type)) || (PROT_FILTER_IOUT == (type)) || \
+                                     (PROT_FILTER_TEMP == (type)))
+#ifndef PROT_FILTER_TAPS
+#if PROT_FILTER_USES(PROT_FILTER_BOXCAR)
+#define PROT_FILTER_TAPS            AVERAGING_SAMPLES
+#elif PROT_FILTER_USES(PROT_FILTER_MEDIAN3)
+#define PROT_FILTER_TAPS            (2U)
+#else
+#define PROT_FILTER_TAPS            (1U)
+#endif
+#endif
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Filter state of one channel */
+typedef struct
+{
+    prot_value_t hist[PROT_FILTER_TAPS];        /* Previous results, counts */
+    prot_value_t sum;                           /* Sum of the boxcar window, counts */
+    uint8_t      idx;                           /* Oldest result of the boxcar window */
+} prot_filter_chan_t;
+
+/* Debounce of one limit compare */
+typedef struct
+{
+    uint32_t     hist;                          /* Compare results, bit 0 the last */
+    uint8_t      count;                         /* Exceeded in the last M checks */
+} prot_debounce_t;
+
+/* Filter and debounce state of a converter */
+typedef struct
+{
+    prot_filter_chan_t vin;
+    prot_filter_chan_t iout[BUCK_CONV_PHASES_MAX];
+    prot_filter_chan_t temp;
+    prot_debounce_t    vin_low;
+    prot_debounce_t    vin_high;
+    prot_debounce_t    iout_high[BUCK_CONV_PHASES_MAX];
+    prot_debounce_t    temp_high;
+} prot_filter_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern prot_filter_t prot_filter[BUCK_CONV_NUM];
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void prot_filter_reset(uint8_t conv, uint16_t vin_counts);
+
+/*******************************************************************************
+* Function Name: prot_filter_chan_reset
+*********************************************************************************
+* Summary:
+* Fills the filter state of a channel with a result, so that every filter
+* starts at the average the state machine resets the channel to.
+*
+* Parameters:
+*  f:      filter state of the channel
+*  counts: initial result, ADC counts
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void prot_filter_chan_reset(prot_filter_chan_t *f, uint16_t counts)
+{
+    uint32_t i;
+
+    for (i = 0U; i < PROT_FILTER_TAPS; i++)
+    {
+        f->hist[i] = (prot_value_t)counts;
+    }
+    f->sum = (prot_value_t)((uint32_t)counts * AVERAGING_SAMPLES);
+    f->idx = 0U;
+}
+
+/*******************************************************************************
+* Function Name: prot_filter_step
+*********************************************************************************
+* Summary:
+* Filters a scheduled ADC result of a channel. The type is a constant in the
+* callback, so only the code of the selected filter remains. The boxcar adds
+* the new and subtracts the oldest result from the running sum of the window;
+* the results are integer counts, so the sum is exact in both build modes.
+*
+* Parameters:
+*  f:    filter state of the channel
+*  avg:  previous filter output
+*  res:  ADC result, counts
+*  type: PROT_FILTER_IIR, PROT_FILTER_BOXCAR or PROT_FILTER_MEDIAN3
+*
+* Return:
+*  prot_value_t: filter output, in the unit of the protection averages
+*
+*******************************************************************************/
+__STATIC_INLINE prot_value_t prot_filter_step(prot_filter_chan_t *f, prot_value_t avg, prot_value_t res,
+                                              uint32_t type)
+{
+    prot_value_t a;
+    prot_value_t b;
+    prot_value_t lo;
+    prot_value_t hi;
+
+    if (type == PROT_FILTER_BOXCAR)
+    {
+        f->sum += res - f->hist[f->idx];
+        f->hist[f->idx] = res;
+        f->idx = (uint8_t)((f->idx + 1U) & (PROT_FILTER_TAPS - 1U));
+#if BUCK_PROT_FIXED_POINT
+        return PROT_AVG(f->sum) >> AVERAGING_SHIFT;
+#else
+        return f->sum / (prot_value_t)AVERAGING_SAMPLES;
+#endif
+    }
+
+    if (type == PROT_FILTER_MEDIAN3)
+    {
+        a = f->hist[0];
+        b = f->hist[PROT_FILTER_TAPS - 1U];
+        f->hist[0] = b;
+        f->hist[PROT_FILTER_TAPS - 1U] = res;
+        lo = (a < b) ? a : b;
+        hi = (a < b) ? b : a;
+        hi = (hi < res) ? hi : res;
+        return PROT_AVG((lo > hi) ? lo : hi);
+    }
+
+#if BUCK_PROT_FIXED_POINT
+    /*Moving Average calculation: avg += (res - avg) / 2^AVERAGING_SHIFT, the
+     * arithmetic right shift rounds towards minus infinity. */
+    return avg + ((PROT_AVG(res) - avg) >> AVERAGING_SHIFT);
+#else
+    /*Moving Average calculation*/
+    return (float32_t)((avg - ((avg - res) / AVERAGING_SAMPLES)));
+#endif
+}
+
+/*******************************************************************************
+* Function Name: prot_filter_debounce
+*********************************************************************************
+* Summary:
+* Adds a limit compare to the debounce and counts the exceeded compares of the
+* last m checks.
+*
+* Parameters:
+*  d:        debounce state of the limit
+*  exceeded: limit exceeded in this check
+*  n:        exceeded checks that trip, 1 to m
+*  m:        checks of the window, 1 to 32
+*
+* Return:
+*  bool: true when the limit trips
+*
+*******************************************************************************/
+__STATIC_INLINE bool prot_filter_debounce(prot_debounce_t *d, bool exceeded, uint32_t n, uint32_t m)
+{
+    d->count = (uint8_t)(d->count - ((d->hist >> (m - 1U)) & 1U) + (exceeded ? 1U : 0U));
+    d->hist = (d->hist << 1) | (exceeded ? 1U : 0U);
+    return (d->count >= n);
+}
+
+/*******************************************************************************
+* Function Name: prot_filter_trip
+*********************************************************************************
+* Summary:
+* Debounces a limit compare of the averaged protection with
+* PROT_FILTER_TRIP_N of PROT_FILTER_TRIP_M.
+*
+* Parameters:
+*  d:        debounce state of the limit
+*  exceeded: limit exceeded in this check
+*
+* Return:
+*  bool: true when the limit trips
+*
+*******************************************************************************/
+__STATIC_INLINE bool prot_filter_trip(prot_debounce_t *d, bool exceeded)
+{
+#if (PROT_FILTER_TRIP_M == 1)
+    (void)d;
+    return exceeded;
+#else
+    return prot_filter_debounce(d, exceeded, PROT_FILTER_TRIP_N, PROT_FILTER_TRIP_M);
+#endif
+}
+
+#endif  /* PROT_FILTER_H */
+/* [] END OF FILE */
@@ -0,0 +1,378 @@
+/*******************************************************************************
+* File Name: scope.c
+*
+* Description:
+* Capture buffer for the voltage control loop: acquisition and trigger logic
+* running in the control ISR, and the dump of a completed capture on the debug
+* UART.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "scope.h"
+#include "telemetry.h"
+#include "uart_tx.h"
+
+#if (SCOPE_DEPTH & (SCOPE_DEPTH - 1U)) != 0U
+#error "SCOPE_DEPTH must be a power of two"
+#endif
+
+#if (TELEMETRY_SCOPE_OFS_SAMPLES + SCOPE_CHUNK_SAMPLES * TELEMETRY_SCOPE_SAMPLE_SIZE) > 252U
+#error "SCOPE_CHUNK_SAMPLES does not fit into one telemetry frame"
+#endif
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+scope_t scope;
+scope_sample_t scope_buf[SCOPE_DEPTH];
+
+/* Capture on the RUN -> TEST transition with a quarter of the buffer before
+ * the load steps start, the settings of the scope command. */
+const scope_config_t scope_default_config =
+{
+    .trigger     = SCOPE_TRIG_TEST,
+    .level       = 0U,
+    .decimation  = 1U,
+    .pre_trigger = SCOPE_DEPTH / 4U
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: scope_finish
+*********************************************************************************
+* Summary:
+* Freezes the buffer. The control ISR stops recording and the main loop may
+* read the samples.
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+static void scope_finish(void)
+{
+    scope.capture++;
+    scope.state = SCOPE_STATE_DONE;
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: scope_arm
+*********************************************************************************
+* Summary:
+* Starts a new acquisition. The buffer fills continuously until the configured
+* trigger occurs.
+*
+* Parameters:
+*  config: trigger configuration, copied
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scope_arm(const scope_config_t *config)
+{
+    scope_config_t cfg = *config;
+
+    if (cfg.decimation == 0U)
+    {
+        cfg.decimation = 1U;
+    }
+    if (cfg.pre_trigger >= SCOPE_DEPTH)
+    {
+        cfg.pre_trigger = SCOPE_DEPTH - 1U;
+    }
+
+    /* Stop the ISR before the bookkeeping is reset. */
+    scope.state    = SCOPE_STATE_IDLE;
+    scope.cfg      = cfg;
+    scope.pending  = (uint8_t)SCOPE_TRIG_NONE;
+    scope.dec_cnt  = cfg.decimation;
+    scope.wr       = 0U;
+    scope.filled   = 0U;
+    scope.post     = 0U;
+    scope.trig_pos = 0U;
+    scope.source   = (uint8_t)SCOPE_TRIG_NONE;
+    scope.sent     = 0U;
+    scope.state    = SCOPE_STATE_ARMED;
+}
+
+/*******************************************************************************
+* Function name: scope_trigger
+*********************************************************************************
+* Summary:
+* Reports a trigger event. Matching events are taken over by the control ISR
+* on the next sample. A fault stops the control loop, so a fault ends the
+* capture immediately: with the samples before it when triggering on faults,
+* or with the post-trigger samples recorded so far otherwise.
+*
+* Parameters:
+*  source: event that happened
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scope_trigger(scope_trigger_t source)
+{
+    if (source == SCOPE_TRIG_FAULT)
+    {
+        if ((scope.state == SCOPE_STATE_ARMED) && (scope.cfg.trigger == SCOPE_TRIG_FAULT))
+        {
+            scope.state    = SCOPE_STATE_IDLE;
+            scope.trig_pos = scope.filled;
+            scope.source   = (uint8_t)SCOPE_TRIG_FAULT;
+            scope_finish();
+        }
+        else if (scope.state == SCOPE_STATE_TRIGGERED)
+        {
+            scope_finish();
+        }
+        else
+        {
+            /* Keep armed, the history restarts with the converter. */
+        }
+    }
+    else if ((scope.state == SCOPE_STATE_ARMED) &&
+             ((source == scope.cfg.trigger) || (source == SCOPE_TRIG_FORCE)))
+    {
+        scope.pending = (uint8_t)source;
+    }
+    else
+    {
+        /* Not armed or not the configured trigger. */
+    }
+}
+
+/*******************************************************************************
+* Function name: scope_store
+*********************************************************************************
+* Summary:
+* Stores one sample and runs the trigger logic. Called from scope_sample() in
+* the control ISR.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void scope_store(void)
+{
+    scope_sample_t *sample = &scope_buf[scope.wr];
+    uint16_t prev_res = scope_buf[(scope.wr - 1U) & (SCOPE_DEPTH - 1U)].res;
+    uint8_t source;
+
+    sample->res     = (uint16_t)BUCK1_ctx.res;
+    sample->out     = (uint16_t)BUCK1_ctx.out;
+    sample->compare = (uint16_t)Cy_TCPWM_PWM_GetCompare0Val(PWM_BUCK_1_HW, PWM_BUCK_1_NUM);
+
+    scope.wr = (scope.wr + 1U) & (SCOPE_DEPTH - 1U);
+    if (scope.filled < SCOPE_DEPTH)
+    {
+        scope.filled++;
+    }
+
+    if (scope.state == SCOPE_STATE_TRIGGERED)
+    {
+        if (--scope.post == 0U)
+        {
+            scope_finish();
+        }
+        return;
+    }
+
+    source = scope.pending;
+    if ((source == (uint8_t)SCOPE_TRIG_NONE) && (scope.filled > 1U))
+    {
+        if (scope.cfg.trigger == SCOPE_TRIG_RISING)
+        {
+            if ((prev_res < scope.cfg.level) && (sample->res >= scope.cfg.level))
+            {
+                source = (uint8_t)SCOPE_TRIG_RISING;
+            }
+        }
+        else if (scope.cfg.trigger == SCOPE_TRIG_FALLING)
+        {
+            if ((prev_res > scope.cfg.level) && (sample->res <= scope.cfg.level))
+            {
+                source = (uint8_t)SCOPE_TRIG_FALLING;
+            }
+        }
+        else
+        {
+            /* Event triggers arrive through scope.pending. */
+        }
+    }
+
+    if (source != (uint8_t)SCOPE_TRIG_NONE)
+    {
+        /* The current sample is the trigger sample. */
+        scope.trig_pos = scope.filled - 1U;
+        if (scope.trig_pos > scope.cfg.pre_trigger)
+        {
+            scope.trig_pos = scope.cfg.pre_trigger;
+        }
+        scope.source = source;
+        scope.post   = SCOPE_DEPTH - 1U - scope.trig_pos;
+        if (scope.post == 0U)
+        {
+            scope_finish();
+        }
+        else
+        {
+            scope.state = SCOPE_STATE_TRIGGERED;
+        }
+    }
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: scope_ready
+*********************************************************************************
+* Summary:
+* Returns true when a capture is complete and waits for scope_dump().
+*
+*******************************************************************************/
+bool scope_ready(void)
+{
+    return (scope.state == SCOPE_STATE_DONE);
+}
+
+/*******************************************************************************
+* Function name: scope_dump
+*********************************************************************************
+* Summary:
+* Sends a completed capture on the debug UART, oldest sample first, and leaves
+* the scope idle until it is armed again. In binary telemetry mode the
+* samples go out as TELEMETRY_KIND_SCOPE records of SCOPE_CHUNK_SAMPLES
+* samples, otherwise as CSV text with the sample index relative to the
+* trigger. Each call writes as many samples as the UART buffer takes and
+* returns, the next call continues with the following sample.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void scope_dump(void)
+{
+    uint16_t count = scope.filled;
+    uint16_t first = (scope.wr - count) & (SCOPE_DEPTH - 1U);
+    uint16_t i = scope.sent;
+#if TELEMETRY_BINARY
+    uint8_t record[TELEMETRY_SCOPE_OFS_SAMPLES +
+                   (SCOPE_CHUNK_SAMPLES * TELEMETRY_SCOPE_SAMPLE_SIZE) + TELEMETRY_CRC_SIZE];
+    uint16_t n;
+
+    for (; i < count; i += n)
+    {
+        uint8_t *dst = &record[TELEMETRY_SCOPE_OFS_SAMPLES];
+        uint16_t k;
+
+        n = count - i;
+        if (n > SCOPE_CHUNK_SAMPLES)
+        {
+            n = SCOPE_CHUNK_SAMPLES;
+        }
+        if (uart_tx_space() < TELEMETRY_FRAME_SIZE(TELEMETRY_SCOPE_OFS_SAMPLES + ((uint32_t)n * TELEMETRY_SCOPE_SAMPLE_SIZE)))
+        {
+            break;
+        }
+
+        record[TELEMETRY_SCOPE_OFS_KIND]        = (uint8_t)TELEMETRY_KIND_SCOPE;
+        record[TELEMETRY_SCOPE_OFS_CAPTURE]     = scope.capture;
+        record[TELEMETRY_SCOPE_OFS_SOURCE]      = scope.source;
+        record[TELEMETRY_SCOPE_OFS_COUNT]       = (uint8_t)n;
+        record[TELEMETRY_SCOPE_OFS_INDEX]       = (uint8_t)i;
+        record[TELEMETRY_SCOPE_OFS_INDEX + 1U]  = (uint8_t)(i >> 8);
+        record[TELEMETRY_SCOPE_OFS_PRE]         = (uint8_t)scope.trig_pos;
+        record[TELEMETRY_SCOPE_OFS_PRE + 1U]    = (uint8_t)(scope.trig_pos >> 8);
+        record[TELEMETRY_SCOPE_OFS_DECIM]       = (uint8_t)scope.cfg.decimation;
+        record[TELEMETRY_SCOPE_OFS_DECIM + 1U]  = (uint8_t)(scope.cfg.decimation >> 8);
+
+        for (k = 0U; k < n; k++)
+        {
+            const scope_sample_t *s = &scope_buf[(first + i + k) & (SCOPE_DEPTH - 1U)];
+
+            dst[0] = (uint8_t)s->res;
+            dst[1] = (uint8_t)(s->res >> 8);
+            dst[2] = (uint8_t)s->out;
+            dst[3] = (uint8_t)(s->out >> 8);
+            dst[4] = (uint8_t)s->compare;
+            dst[5] = (uint8_t)(s->compare >> 8);
+            dst += TELEMETRY_SCOPE_SAMPLE_SIZE;
+        }
+
+        telemetry_send_record(record, TELEMETRY_SCOPE_OFS_SAMPLES + ((uint32_t)n * TELEMETRY_SCOPE_SAMPLE_SIZE));
+    }
+#else
+    /* The header goes out together with the first sample. */
+    if (i == 0U)
+    {
+        if (uart_tx_space() < (SCOPE_TEXT_HEADER_MAX + SCOPE_TEXT_LINE_MAX))
+        {
+            return;
+        }
+        uart_tx_printf("\r\nscope capture=%u source=%u decimation=%u pre=%u samples=%u\r\nindex,res,out,compare\r\n",
+                       scope.capture, scope.source, scope.cfg.decimation, scope.trig_pos, count);
+    }
+    for (; (i < count) && (uart_tx_space() >= SCOPE_TEXT_LINE_MAX); i++)
+    {
+        const scope_sample_t *s = &scope_buf[(first + i) & (SCOPE_DEPTH - 1U)];
+
+        uart_tx_printf("%d,%u,%u,%u\r\n", (int)i - (int)scope.trig_pos, s->res, s->out, s->compare);
+    }
+#endif
+
+    scope.sent = i;
+    if (i >= count)
+    {
+        scope.state = SCOPE_STATE_IDLE;
+    }
+}
+
+/* [] END OF FILE */
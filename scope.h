@@ -0,0 +1,163 @@
+/*******************************************************************************
+* File Name: scope.h
+*
+* Description:
+* Capture buffer ("scope") for the voltage control loop. Every N control cycles
+* the output voltage ADC result, the compensator output (next peak current
+* reference) and the PWM compare value are written into a ring buffer. The
+* acquisition stops a configurable number of samples after a trigger, so the
+* buffer holds pre-trigger and post-trigger history.
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef SCOPE_H
+#define SCOPE_H
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of samples in the capture buffer, power of two. */
+#define SCOPE_DEPTH                 (512U)
+
+/* Samples sent per dump frame in binary telemetry mode. */
+#define SCOPE_CHUNK_SAMPLES         (32U)
+
+/* Longest CSV header and sample line of the dump in text mode */
+#define SCOPE_TEXT_HEADER_MAX       (96U)
+#define SCOPE_TEXT_LINE_MAX         (32U)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Trigger sources */
+typedef enum
+{
+    SCOPE_TRIG_NONE         = 0,    /* Only scope_trigger(SCOPE_TRIG_FORCE) */
+    SCOPE_TRIG_TEST         = 1,    /* State change into Ifx_BUCK_STATE_TEST */
+    SCOPE_TRIG_FAULT        = 2,    /* Fault processing */
+    SCOPE_TRIG_RISING       = 3,    /* Vout result crosses the level upwards */
+    SCOPE_TRIG_FALLING      = 4,    /* Vout result crosses the level downwards */
+    SCOPE_TRIG_FORCE        = 5     /* Immediate trigger from the application */
+} scope_trigger_t;
+
+/* Acquisition states, the ISR only records in the ARMED and TRIGGERED states. */
+typedef enum
+{
+    SCOPE_STATE_IDLE        = 0,
+    SCOPE_STATE_DONE        = 1,
+    SCOPE_STATE_ARMED       = 2,
+    SCOPE_STATE_TRIGGERED   = 3
+} scope_state_t;
+
+typedef struct
+{
+    scope_trigger_t trigger;        /* Trigger source */
+    uint16_t        level;          /* Vout ADC counts for the level triggers */
+    uint16_t        decimation;     /* Record every N-th control cycle, >= 1 */
+    uint16_t        pre_trigger;    /* Samples kept before the trigger */
+} scope_config_t;
+
+typedef struct
+{
+    uint16_t res;                   /* BUCK1_ctx.res */
+    uint16_t out;                   /* BUCK1_ctx.out, next peak reference */
+    uint16_t compare;               /* PWM_BUCK_1 compare value */
+} scope_sample_t;
+
+typedef struct
+{
+    volatile scope_state_t state;
+    volatile uint8_t       pending; /* scope_trigger_t requested by other ISRs */
+    scope_config_t         cfg;
+    uint16_t               dec_cnt; /* Control cycles to the next sample */
+    uint16_t               wr;      /* Next write index */
+    uint16_t               filled;  /* Valid samples, up to SCOPE_DEPTH */
+    uint16_t               post;    /* Samples still to record after the trigger */
+    uint16_t               trig_pos;/* Number of samples before the trigger */
+    uint8_t                source;  /* Trigger source of the capture */
+    uint8_t                capture; /* Capture counter */
+    uint16_t               sent;    /* Samples of the capture already dumped */
+} scope_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern scope_t scope;
+extern scope_sample_t scope_buf[SCOPE_DEPTH];
+extern const scope_config_t scope_default_config;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void scope_arm(const scope_config_t *config);
+void scope_trigger(scope_trigger_t source);
+void scope_store(void);
+bool scope_ready(void);
+void scope_dump(void);
+
+/*******************************************************************************
+* Function Name: scope_sample
+*********************************************************************************
+* Summary:
+* Called once per control cycle after the compensator. Counts down the
+* decimation and stores a sample when it expires. While the scope is armed or
+* triggered, every N-th call also runs scope_store(), an out-of-line call that
+* reads the PWM compare value; only while it is idle or done is the cost a load
+* and a compare. The scope is idle from reset and armed for one capture at a
+* time by the scope command.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void scope_sample(void)
+{
+    if (scope.state >= SCOPE_STATE_ARMED)
+    {
+        if (--scope.dec_cnt == 0U)
+        {
+            scope.dec_cnt = scope.cfg.decimation;
+            scope_store();
+        }
+    }
+}
+
+#endif  /* SCOPE_H */
+/* [] END OF FILE */
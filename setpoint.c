@@ -0,0 +1,336 @@
+/*******************************************************************************
+* File Name: setpoint.c
+*
+* Description:
+* Slew rate limited output voltage setpoint changes at run time.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "setpoint.h"
+#include "uart_tx.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+setpoint_t setpoint[BUCK_CONV_NUM];
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: setpoint_window
+*********************************************************************************
+* Summary:
+* Sets the output voltage window of a converter from the lowest and the
+* highest setpoint it has to cover.
+*
+* Parameters:
+*  s:  setpoint of the converter
+*  lo: lowest setpoint, counts
+*  hi: highest setpoint, counts
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+static void setpoint_window(setpoint_t *s, uint32_t lo, uint32_t hi)
+{
+    uint32_t win_hi = (hi * SETPOINT_WINDOW_HI_PCT) / 100U;
+
+    s->win_lo = (uint16_t)((lo * SETPOINT_WINDOW_LO_PCT) / 100U);
+    s->win_hi = (uint16_t)((win_hi > UINT16_MAX) ? UINT16_MAX : win_hi);
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: setpoint_begin
+*********************************************************************************
+* Summary:
+* Called by the state machine before a converter starts. Ends a change in
+* progress and sets the output voltage window around the setpoint that the
+* soft start ramps to.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void setpoint_begin(uint8_t conv)
+{
+    setpoint_t *s = &setpoint[conv];
+    uint32_t targ = buck_conv_hw[conv].ctx->targ;
+
+    s->active = false;
+    setpoint_window(s, targ, targ);
+}
+
+/*******************************************************************************
+* Function name: setpoint_set
+*********************************************************************************
+* Summary:
+* Sets the output voltage setpoint of a converter. In the RUN and TEST states
+* the reference moves from its present value to the new setpoint at the slew
+* rate, and the output voltage window is widened to cover both setpoints
+* until the output voltage has reached the new one. In IDLE and FAULT, the
+* next soft start ramps to the new setpoint. It cannot be changed during the
+* soft start.
+*
+* Parameters:
+*  conv:       converter index
+*  mv:         setpoint, SETPOINT_MV_MIN to SETPOINT_MV_MAX
+*  slew_mv_ms: slew rate, SETPOINT_SLEW_MV_MS_MIN to SETPOINT_SLEW_MV_MS_MAX,
+*              0 for SETPOINT_SLEW_MV_MS
+*
+* Return:
+*  bool: false when a value is out of range or the converter is ramping
+*
+*******************************************************************************/
+bool setpoint_set(uint8_t conv, uint32_t mv, uint32_t slew_mv_ms)
+{
+    setpoint_t *s = &setpoint[conv];
+    mtb_stc_pwrconv_ctx_t *ctx = buck_conv_hw[conv].ctx;
+    Ifx_buck_states state = buck_conv[conv].state;
+    uint32_t counts;
+    uint16_t win_lo;
+    uint16_t win_hi;
+    int32_t step;
+    uint32_t primask;
+
+    if (slew_mv_ms == 0U)
+    {
+        slew_mv_ms = SETPOINT_SLEW_MV_MS;
+    }
+    if ((mv < SETPOINT_MV_MIN) || (mv > SETPOINT_MV_MAX) ||
+        (slew_mv_ms < SETPOINT_SLEW_MV_MS_MIN) || (slew_mv_ms > SETPOINT_SLEW_MV_MS_MAX) ||
+        (state == Ifx_BUCK_STATE_RAMP))
+    {
+        return false;
+    }
+
+    counts = (uint32_t)(((float32_t)mv * (SETPOINT_COUNTS_PER_V / 1000.0f)) + 0.5f);
+    step = (int32_t)(((float32_t)slew_mv_ms * (SETPOINT_COUNTS_PER_V / 1000.0f) /
+                      (float32_t)SETPOINT_STEPS_PER_MS * 65536.0f) + 0.5f);
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    ctx->targ = counts;
+    if ((state == Ifx_BUCK_STATE_RUN) || (state == Ifx_BUCK_STATE_TEST))
+    {
+        s->from         = ctx->ref;
+        s->target       = counts;
+        s->ref_q16      = ctx->ref << 16;
+        s->step_q16     = (counts >= ctx->ref) ? step : -step;
+        s->div_count    = SOFT_START_DIVIDER;
+        s->periods      = 0U;
+        s->done_periods = 0U;
+        s->overshoot    = 0U;
+        s->slew         = slew_mv_ms;
+        s->ramp_done    = (counts == ctx->ref);
+        s->reported     = false;
+
+        /* The window also keeps covering a change still in progress. */
+        win_lo = s->win_lo;
+        win_hi = s->win_hi;
+        setpoint_window(s, (counts < s->from) ? counts : s->from, (counts > s->from) ? counts : s->from);
+        if (s->active)
+        {
+            s->win_lo = (win_lo < s->win_lo) ? win_lo : s->win_lo;
+            s->win_hi = (win_hi > s->win_hi) ? win_hi : s->win_hi;
+        }
+        s->active = true;
+    }
+    __set_PRIMASK(primask);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function name: setpoint_step
+*********************************************************************************
+* Summary:
+* Called from the control ISR of a converter every control period while a
+* setpoint change is in progress. Every SOFT_START_DIVIDER periods the
+* reference moves one step towards the new setpoint. Once the reference is
+* there, the change ends when the output voltage result is within the
+* regulation band, and the window closes around the new setpoint. The
+* excursion past the new setpoint is recorded until SETPOINT_OBSERVE_PERIODS
+* after the end.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void setpoint_step(uint8_t conv)
+{
+    setpoint_t *s = &setpoint[conv];
+    mtb_stc_pwrconv_ctx_t *ctx = buck_conv_hw[conv].ctx;
+    uint32_t res = ctx->res;
+    uint32_t next;
+
+    s->periods++;
+    if ((s->target >= s->from) && (res > s->target) && ((res - s->target) > s->overshoot))
+    {
+        s->overshoot = res - s->target;
+    }
+    if ((s->target < s->from) && (res < s->target) && ((s->target - res) > s->overshoot))
+    {
+        s->overshoot = s->target - res;
+    }
+
+    if (s->ramp_done)
+    {
+        if (s->done_periods == 0U)
+        {
+            if ((res + SOFT_START_REG_BAND >= s->target) && (res <= s->target + SOFT_START_REG_BAND))
+            {
+                s->done_periods = s->periods;
+                s->transitions++;
+                setpoint_window(s, s->target, s->target);
+            }
+        }
+        else if ((s->periods - s->done_periods) >= SETPOINT_OBSERVE_PERIODS)
+        {
+            s->active = false;
+        }
+        return;
+    }
+
+    if (--s->div_count != 0U)
+    {
+        return;
+    }
+    s->div_count = SOFT_START_DIVIDER;
+
+    next = s->ref_q16 + (uint32_t)s->step_q16;
+    if (((s->step_q16 > 0) && (next >= (s->target << 16))) ||
+        ((s->step_q16 < 0) && (next <= (s->target << 16))))
+    {
+        next = s->target << 16;
+        s->ramp_done = true;
+    }
+    s->ref_q16 = next;
+    ctx->ref = next >> 16;
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: setpoint_transition_ms
+*********************************************************************************
+* Summary:
+* Returns the time from the last setpoint change of a converter to the
+* regulation band of the new setpoint.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  float32_t: transition time, ms, 0 while not reached
+*
+*******************************************************************************/
+float32_t setpoint_transition_ms(uint8_t conv)
+{
+    return ((float32_t)setpoint[conv].done_periods * 1000.0f) / (float32_t)SOFT_START_CTRL_FREQ_HZ;
+}
+
+/*******************************************************************************
+* Function name: setpoint_overshoot_mv
+*********************************************************************************
+* Summary:
+* Returns the largest excursion of the output voltage past the new setpoint
+* in the direction of the last change of a converter.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  float32_t: overshoot, mV
+*
+*******************************************************************************/
+float32_t setpoint_overshoot_mv(uint8_t conv)
+{
+    return (float32_t)setpoint[conv].overshoot * (1000.0f / SETPOINT_COUNTS_PER_V);
+}
+
+/*******************************************************************************
+* Function name: setpoint_report
+*********************************************************************************
+* Summary:
+* Prints the result of the last setpoint change of each converter once its
+* measurement has ended.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void setpoint_report(void)
+{
+    uint8_t conv;
+
+    for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        setpoint_t *s = &setpoint[conv];
+
+        if (s->active || s->reported || (s->done_periods == 0U))
+        {
+            continue;
+        }
+        s->reported = true;
+
+        uart_tx_printf("\r\n%s setpoint: %.2f V to %.2f V at %lu mV/ms, transition %.2f ms, overshoot %.0f mV\r\n",
+                       buck_conv_hw[conv].name, (float64_t)((float32_t)s->from / SETPOINT_COUNTS_PER_V),
+                       (float64_t)((float32_t)s->target / SETPOINT_COUNTS_PER_V), (unsigned long)s->slew,
+                       (float64_t)setpoint_transition_ms(conv), (float64_t)setpoint_overshoot_mv(conv));
+    }
+}
+
+/* [] END OF FILE */
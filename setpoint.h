@@ -0,0 +1,183 @@
+/*******************************************************************************
+* File Name: setpoint.h
+*
+* Description:
+* Output voltage setpoint changes at run time, for example for dynamic voltage
+* scaling of the load. A new setpoint in the RUN or TEST state moves the
+* reference of a converter along a slew rate limited trajectory, stepped from
+* the control ISR at the 10 kHz profile step of the soft start. In IDLE, the
+* next soft start ramps to it. The output voltage window, 80 to 120 % of the
+* reference like the generated limits at the nominal 5 V, follows the
+* setpoint: during a change it spans the old and the new setpoint, and it
+* closes around the new setpoint once the output voltage has reached it. The
+* control ISR compares each output voltage result with the window; the
+* generated limit detection remains the outer window. The transition time
+* from the command to the regulation band of the new setpoint and the
+* overshoot past it are measured.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef SETPOINT_H
+#define SETPOINT_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "soft_start.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Range of the output voltage setpoint, mV. It is inside the generated output
+ * voltage limits (4 V and 6 V) with a margin for the transient. */
+#define SETPOINT_MV_MIN             (4500U)
+#define SETPOINT_MV_MAX             (5500U)
+
+/* Slew rate of a setpoint change, mV per ms: default and range */
+#define SETPOINT_SLEW_MV_MS         (100U)
+#define SETPOINT_SLEW_MV_MS_MIN     (10U)
+#define SETPOINT_SLEW_MV_MS_MAX     (2000U)
+
+/* Output voltage sense: ADC counts per V (exGain0) */
+#define SETPOINT_COUNTS_PER_V       (4095.0f * 0.239f / 3.3f)
+
+/* Trajectory steps per ms, at every SOFT_START_DIVIDER control periods */
+#define SETPOINT_STEPS_PER_MS       (SOFT_START_CTRL_FREQ_HZ / SOFT_START_DIVIDER / 1000U)
+
+/* Output voltage window in percent of the setpoint. The generated limits stay
+ * at 4 V and 6 V, so away from 5 V one side of the window is tighter in the
+ * hardware than in the firmware (see README). */
+#define SETPOINT_WINDOW_LO_PCT      (80U)
+#define SETPOINT_WINDOW_HI_PCT      (120U)
+
+/* The transition ends when the output voltage result is within the
+ * regulation band of the soft start around the new setpoint. The overshoot is
+ * recorded for this many control periods (5 ms) after the end. */
+#define SETPOINT_OBSERVE_PERIODS    (SOFT_START_CTRL_FREQ_HZ / 200U)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    volatile bool     active;       /* Trajectory or measurement running */
+    bool              ramp_done;    /* Reference at the new setpoint */
+    bool              reported;     /* Result of the last change printed */
+    uint32_t          ref_q16;      /* Reference on the trajectory, counts with 16 fractional bits */
+    int32_t           step_q16;     /* Change of the reference per trajectory step */
+    uint32_t          div_count;    /* Control periods to the next trajectory step */
+    uint32_t          from;         /* Reference at the command, counts */
+    uint32_t          target;       /* New setpoint, counts */
+    volatile uint16_t win_lo;       /* Output voltage window, counts */
+    volatile uint16_t win_hi;
+    uint32_t          periods;      /* Control periods since the command */
+    uint32_t          done_periods; /* Control periods to the regulation band, 0 if not reached */
+    uint32_t          overshoot;    /* Largest excursion past the new setpoint, counts */
+    uint32_t          slew;         /* Slew rate of the last change, mV per ms */
+    uint32_t          transitions;  /* Changes completed since the reset */
+} setpoint_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern setpoint_t setpoint[BUCK_CONV_NUM];
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void setpoint_begin(uint8_t conv);
+bool setpoint_set(uint8_t conv, uint32_t mv, uint32_t slew_mv_ms);
+void setpoint_step(uint8_t conv);
+float32_t setpoint_transition_ms(uint8_t conv);
+float32_t setpoint_overshoot_mv(uint8_t conv);
+void setpoint_report(void);
+
+/*******************************************************************************
+* Function Name: setpoint_control
+*********************************************************************************
+* Summary:
+* Called from the post-process callback of the control ISR of a converter.
+* Steps the trajectory and the measurement of a setpoint change while one is
+* in progress.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void setpoint_control(uint8_t conv)
+{
+    if (setpoint[conv].active)
+    {
+        setpoint_step(conv);
+    }
+}
+
+/*******************************************************************************
+* Function Name: setpoint_check
+*********************************************************************************
+* Summary:
+* Called from the post-process callback of the control ISR of a converter.
+* Compares the output voltage result with the window of the setpoint in the
+* RUN and TEST states. Results outside of the generated limits are left to
+* the limit detection.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  bool: true when the output voltage is outside of the window
+*
+*******************************************************************************/
+__STATIC_INLINE bool setpoint_check(uint8_t conv)
+{
+    const setpoint_t *s = &setpoint[conv];
+    const buck_conv_hw_t *hw = &buck_conv_hw[conv];
+    uint32_t res = hw->ctx->res;
+    Ifx_buck_states state = buck_conv[conv].state;
+
+    if ((state != Ifx_BUCK_STATE_RUN) && (state != Ifx_BUCK_STATE_TEST))
+    {
+        return false;
+    }
+    return ((res > s->win_hi) && (res <= hw->vout_max)) || ((res < s->win_lo) && (res >= hw->vout_min));
+}
+
+#endif  /* SETPOINT_H */
+/* [] END OF FILE */
@@ -0,0 +1,2222 @@
+/*******************************************************************************
+* File Name: buck_sim.c
+*
+* Description:
+* Host-side closed-loop simulator of the PCCM multi-phase buck converter. The
+* application (main.c and buck_protection.h) is compiled unchanged against
+* the PDL/BSP shims and runs against the peripheral model, the generated
+* BUCK1 driver model and the two-phase power stage model. A scenario script
+* drives the user button, loads, input voltage and temperature, and checks
+* expectations, so the simulator is usable as a regression and benchmark
+* harness.
+*
+* The -r option keeps the retained RAM of the flight recorder in a file: it
+* is loaded before the start up and saved after the run, so consecutive runs
+* behave like resets of the same board.
+*
+* Usage: buck_sim [-s scenario.scn] [-t trace.csv] [-d decimation] [-u uart.bin] [-r retained.bin] [-o] [-q]
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "buck_protection.h"
+#include "prot_ref.h"
+#include "comp_design.h"
+#include "telemetry.h"
+#include "uart_tx.h"
+#include "uart_cmd.h"
+#include "energy.h"
+#include "thermal.h"
+#include "setpoint.h"
+#include "load_ff.h"
+#include "autotune.h"
+#include "sim.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SCN_MAX_EVENTS          (256U)
+#define SCN_MAX_LINE            (160U)
+#define SCN_MAX_TEXT            (64U)
+#define LOG_MAX_TRANSITIONS     (64U)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CMD_BUTTON,
+    CMD_LOAD,
+    CMD_SWITCH,
+    CMD_VIN,
+    CMD_TEMP,
+    CMD_NOISE,
+    CMD_INDUCTOR,
+    CMD_CAPACITOR,
+    CMD_SENSE,
+    CMD_SHARE_BW,
+    CMD_SHED,
+    CMD_MEASURE,
+    CMD_GAIN_SCHED,
+    CMD_LOAD_FF,
+    CMD_TRANSIENT,
+    CMD_SOFT_START,
+    CMD_FRA,
+    CMD_UART_RATE,
+    CMD_UART,
+    CMD_EVENTS,
+    CMD_INJECT,
+    CMD_EXPECT_STATE,
+    CMD_EXPECT_VOUT,
+    CMD_EXPECT_FAULT_LED,
+    CMD_EXPECT_SHARE,
+    CMD_EXPECT_PHASES,
+    CMD_EXPECT_EFFICIENCY,
+    CMD_EXPECT_GAIN_SET,
+    CMD_EXPECT_REGULATION,
+    CMD_EXPECT_INRUSH,
+    CMD_EXPECT_CROSSOVER,
+    CMD_EXPECT_PHASE_MARGIN,
+    CMD_EXPECT_STEP,
+    CMD_EXPECT_SETTLING,
+    CMD_FAST_PROT,
+    CMD_EXPECT_TRIP,
+    CMD_EXPECT_UART_DROPPED,
+    CMD_EXPECT_COMMANDS,
+    CMD_EXPECT_CMD_LATENCY,
+    CMD_EXPECT_FW_EFFICIENCY,
+    CMD_EXPECT_FW_POWER,
+    CMD_EXPECT_TEMP,
+    CMD_EXPECT_CURRENT_LIMIT,
+    CMD_EXPECT_TRANSITION,
+    CMD_EXPECT_OVERSHOOT,
+    CMD_EXPECT_FF_STEP,
+    CMD_EXPECT_AUTOTUNE,
+    CMD_EXPECT_TUNED_C,
+    CMD_EXPECT_TUNED_ESR,
+    CMD_EXPECT_REACTION,
+    CMD_EXPECT_LEAK,
+    CMD_EXPECT_SEQUENCE,
+    CMD_EXPECT_SCOPE,
+    CMD_EXPECT_QUEUE,
+    CMD_END
+} scn_cmd_t;
+
+typedef struct
+{
+    double    t;
+    scn_cmd_t cmd;
+    double    a[3];
+    load_step_dir_t dir;
+    int       line;
+    char      text[SCN_MAX_TEXT];           /* Line sent by the uart command, expected autotune result or
+                                             * state sequence */
+    fault_channel_t ch;                     /* Channel and mode of the inject command */
+    fault_mode_t    mode;
+} scn_event_t;
+
+typedef struct
+{
+    double          t;
+    Ifx_buck_states state;
+} transition_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+plant_t sim_plant;
+
+/* Built-in scenario: soft start, load transients in TEST state with a scope
+ * capture of the first load steps, input under-voltage fault and restart. */
+static const char *default_scenario =
+    "0.010 button\n"
+    "1.300 expect state RUN\n"
+    "1.300 expect vout 4.9 5.1\n"
+    "1.390 uart scope test\n"
+    "1.400 button\n"
+    "1.400 expect state TEST\n"
+    "3.500 expect vout 4.7 5.3\n"
+    "3.600 vin 10.0\n"
+    "3.800 expect state FAULT\n"
+    "3.800 expect fault_led on\n"
+    "3.900 vin 24.0\n"
+    "4.000 button\n"
+    "4.000 expect state IDLE\n"
+    "4.000 expect fault_led off\n"
+    "4.100 end\n";
+
+static scn_event_t scn_events[SCN_MAX_EVENTS + 1U];  /* The events and an end marker. */
+static uint32_t    scn_count;
+static double      scn_end_time = 1.0;
+static uint32_t    scn_failures;
+
+/* Output energy and loss energy of the power stage since the measure command. */
+static bool        meas_active;
+static double      meas_start;
+static double      meas_e_out;
+static double      meas_e_loss;
+
+/* Output voltage excursion after the transient command. */
+static bool        tr_active;
+static double      tr_start;
+static double      tr_band;
+static double      tr_vref;
+static double      tr_min;
+static double      tr_max;
+static double      tr_last_out;
+
+/* Fault detection latency: time of the last load, vin, temp or inject command
+ * while the converter was running, -1 when none came since the last fault,
+ * and time, cause and stimulus of the last fault. */
+static double      trip_stim = -1.0;
+static double      trip_from = -1.0;
+static double      trip_t = -1.0;
+static uint8_t     trip_cause;
+
+static transition_t log_transitions[LOG_MAX_TRANSITIONS];
+static uint32_t     log_count;
+
+/* Load setup: SW4/SW5 position and variable load setting per channel. */
+static bool   load_transient[2] = { true, false };
+static double load_variable[2] = { SIM_LOAD_VARIABLE_MIN, SIM_LOAD_VARIABLE_MIN };
+
+static const char *state_names[] = { "IDLE", "RAMP", "RUN", "TEST", "FAULT" };
+/* Fast hardware limit of a scheduled channel, Vout hardware limit, averaged
+ * software protection. */
+enum { TRIP_FAST, TRIP_VOUT, TRIP_AVG };
+static const char *const trip_tiers[] = { "fast", "vout", "avg" };
+static const char *const cause_names[FLIGHT_REC_CAUSES] =
+{
+    "vin_low", "vin_high", "iout1", "iout2", "temp", "vout", "fast"
+};
+
+/* Application entry points from main.c. */
+extern void hardware_init(void);
+extern void status_update(void);
+
+/*******************************************************************************
+* Function Name: state_parse
+********************************************************************************
+* Summary:
+* Converts a state name to the Ifx_buck_states value, -1 if unknown.
+*
+*******************************************************************************/
+static int state_parse(const char *name)
+{
+    for (int i = 0; i < (int)(sizeof(state_names) / sizeof(state_names[0])); i++)
+    {
+        if (0 == strcmp(name, state_names[i]))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*******************************************************************************
+* Function Name: scn_parse_line
+********************************************************************************
+* Summary:
+* Parses one scenario line of the form "<time> <command> [arguments]".
+* Returns false on a syntax error.
+*
+*******************************************************************************/
+static bool scn_parse_line(char *text, int line)
+{
+    scn_event_t ev = { 0 };
+    char cmd[32] = { 0 };
+    char arg[32] = { 0 };
+    char *hash = strchr(text, '#');
+    int n;
+
+    if (NULL != hash)
+    {
+        *hash = '\0';
+    }
+    n = sscanf(text, "%lf %31s %31s", &ev.t, cmd, arg);
+    if (n <= 0)
+    {
+        return true;
+    }
+    if ((n < 2) || (scn_count >= SCN_MAX_EVENTS))
+    {
+        return false;
+    }
+    ev.line = line;
+
+    if (0 == strcmp(cmd, "button"))
+    {
+        ev.cmd = CMD_BUTTON;
+    }
+    else if (0 == strcmp(cmd, "load"))
+    {
+        ev.cmd = CMD_LOAD;
+        ev.a[1] = -1.0;
+        if (sscanf(text, "%*f %*s %lf %lf", &ev.a[0], &ev.a[1]) < 1)
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "switch"))
+    {
+        char pos[16];
+        ev.cmd = CMD_SWITCH;
+        if (sscanf(text, "%*f %*s %lf %15s", &ev.a[0], pos) != 2)
+        {
+            return false;
+        }
+        ev.a[1] = (0 == strcmp(pos, "transient")) ? 1.0 : 0.0;
+    }
+    else if ((0 == strcmp(cmd, "vin")) || (0 == strcmp(cmd, "temp")) || (0 == strcmp(cmd, "noise")))
+    {
+        ev.cmd = (cmd[0] == 'v') ? CMD_VIN : ((cmd[0] == 't') ? CMD_TEMP : CMD_NOISE);
+        if (sscanf(text, "%*f %*s %lf", &ev.a[0]) != 1)
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "inject"))
+    {
+        char mode[8];
+        double v[3] = { 0.0, 0.0, 0.0 };
+        int ch;
+
+        /* inject <channel> step <value> [<n>], ramp|glitch <value> <ms> [<n>],
+         * off [<n>] */
+        ev.cmd = CMD_INJECT;
+        n = sscanf(text, "%*f %*s %*s %7s %lf %lf %lf", mode, &v[0], &v[1], &v[2]) - 1;
+        ch = fault_inject_channel(arg);
+        ev.mode = (0 == strcmp(mode, "step")) ? FAULT_MODE_STEP :
+                  ((0 == strcmp(mode, "ramp")) ? FAULT_MODE_RAMP :
+                  ((0 == strcmp(mode, "glitch")) ? FAULT_MODE_GLITCH :
+                  ((0 == strcmp(mode, "off")) ? FAULT_MODE_OFF : FAULT_MODES)));
+        if ((ch < 0) || (n < 0) || (ev.mode == FAULT_MODES))
+        {
+            return false;
+        }
+        ev.ch = (fault_channel_t)ch;
+        if (ev.mode == FAULT_MODE_OFF)
+        {
+            ev.a[2] = (n >= 1) ? v[0] : 0.0;
+            if (n > 1)
+            {
+                return false;
+            }
+        }
+        else if (ev.mode == FAULT_MODE_STEP)
+        {
+            ev.a[0] = v[0];
+            ev.a[2] = (n >= 2) ? v[1] : 0.0;
+            if ((n < 1) || (n > 2))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            ev.a[0] = v[0];
+            ev.a[1] = v[1] * 1.0e-3;
+            ev.a[2] = (n >= 3) ? v[2] : 0.0;
+            if ((n < 2) || (v[1] <= 0.0))
+            {
+                return false;
+            }
+        }
+    }
+    else if (0 == strcmp(cmd, "inductor"))
+    {
+        ev.cmd = CMD_INDUCTOR;
+        if (sscanf(text, "%*f %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "capacitor"))
+    {
+        ev.cmd = CMD_CAPACITOR;
+        if (sscanf(text, "%*f %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "sense"))
+    {
+        ev.cmd = CMD_SENSE;
+        if (sscanf(text, "%*f %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "shed"))
+    {
+        ev.cmd = CMD_SHED;
+        ev.a[0] = (0 == strcmp(arg, "on")) ? 1.0 : 0.0;
+        if ((0 != strcmp(arg, "on")) && (0 != strcmp(arg, "off")))
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "fast_prot"))
+    {
+        ev.cmd = CMD_FAST_PROT;
+        ev.a[0] = (0 == strcmp(arg, "on")) ? 1.0 : 0.0;
+        if ((0 != strcmp(arg, "on")) && (0 != strcmp(arg, "off")))
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "measure"))
+    {
+        ev.cmd = CMD_MEASURE;
+    }
+    else if (0 == strcmp(cmd, "gain_sched"))
+    {
+        ev.cmd = CMD_GAIN_SCHED;
+        ev.a[0] = (0 == strcmp(arg, "on")) ? 1.0 : 0.0;
+        if ((0 != strcmp(arg, "on")) && (0 != strcmp(arg, "off")))
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "load_ff"))
+    {
+        ev.cmd = CMD_LOAD_FF;
+        ev.a[0] = (0 == strcmp(arg, "on")) ? 1.0 : 0.0;
+        if ((0 != strcmp(arg, "on")) && (0 != strcmp(arg, "off")))
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "soft_start"))
+    {
+        ev.cmd = CMD_SOFT_START;
+        ev.a[0] = (0 == strcmp(arg, "linear")) ? (double)SOFT_START_PROFILE_LINEAR :
+                  ((0 == strcmp(arg, "scurve")) ? (double)SOFT_START_PROFILE_SCURVE :
+                  ((0 == strcmp(arg, "inrush")) ? (double)SOFT_START_PROFILE_INRUSH : -1.0));
+        if ((ev.a[0] < 0.0) || (sscanf(text, "%*f %*s %*s %lf", &ev.a[1]) != 1))
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "transient"))
+    {
+        ev.cmd = CMD_TRANSIENT;
+        if (sscanf(text, "%*f %*s %lf", &ev.a[0]) != 1)
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "fra"))
+    {
+        ev.cmd = CMD_FRA;
+        if (0 != strcmp(arg, "start"))
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "uart_rate"))
+    {
+        ev.cmd = CMD_UART_RATE;
+        if ((sscanf(text, "%*f %*s %lf", &ev.a[0]) != 1) || (ev.a[0] < 0.0))
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "events"))
+    {
+        ev.cmd = CMD_EVENTS;
+        if ((sscanf(text, "%*f %*s %lf", &ev.a[0]) != 1) || (ev.a[0] < 1.0))
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "uart"))
+    {
+        int start = 0;
+        size_t len;
+
+        ev.cmd = CMD_UART;
+        (void)sscanf(text, "%*f %*s %n", &start);
+        len = strcspn(&text[start], "\r\n");
+        while ((len > 0U) && ((text[start + (int)len - 1] == ' ') || (text[start + (int)len - 1] == '\t')))
+        {
+            len--;
+        }
+        if ((start == 0) || (len == 0U) || (len >= (SCN_MAX_TEXT - 1U)))
+        {
+            return false;
+        }
+        memcpy(ev.text, &text[start], len);
+        ev.text[len] = '\r';
+    }
+    else if (0 == strcmp(cmd, "share_bw"))
+    {
+        ev.cmd = CMD_SHARE_BW;
+        if (sscanf(text, "%*f %*s %lf", &ev.a[0]) != 1)
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "expect"))
+    {
+        if (0 == strcmp(arg, "state"))
+        {
+            char name[16];
+            ev.cmd = CMD_EXPECT_STATE;
+            if ((sscanf(text, "%*f %*s %*s %15s %lf", name, &ev.a[1]) < 1) || (state_parse(name) < 0) ||
+                (ev.a[1] < 0.0) || (ev.a[1] >= (double)BUCK_CONV_NUM))
+            {
+                return false;
+            }
+            ev.a[0] = (double)state_parse(name);
+        }
+        else if (0 == strcmp(arg, "vout"))
+        {
+            ev.cmd = CMD_EXPECT_VOUT;
+            if ((sscanf(text, "%*f %*s %*s %lf %lf %lf", &ev.a[0], &ev.a[1], &ev.a[2]) < 2) ||
+                (ev.a[2] < 0.0) || (ev.a[2] >= (double)SIM_OUTPUTS))
+            {
+                return false;
+            }
+        }
+        else if (0 == strcmp(arg, "share"))
+        {
+            ev.cmd = CMD_EXPECT_SHARE;
+            if (sscanf(text, "%*f %*s %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+            {
+                return false;
+            }
+        }
+        else if (0 == strcmp(arg, "phases"))
+        {
+            ev.cmd = CMD_EXPECT_PHASES;
+            if (sscanf(text, "%*f %*s %*s %lf", &ev.a[0]) != 1)
+            {
+                return false;
+            }
+        }
+        else if (0 == strcmp(arg, "efficiency"))
+        {
+            ev.cmd = CMD_EXPECT_EFFICIENCY;
+            if (sscanf(text, "%*f %*s %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+            {
+                return false;
+            }
+        }
+        else if (0 == strcmp(arg, "gain_set"))
+        {
+            ev.cmd = CMD_EXPECT_GAIN_SET;
+            if (sscanf(text, "%*f %*s %*s %lf", &ev.a[0]) != 1)
+            {
+                return false;
+            }
+        }
+        else if ((0 == strcmp(arg, "crossover")) || (0 == strcmp(arg, "phase_margin")))
+        {
+            ev.cmd = (0 == strcmp(arg, "crossover")) ? CMD_EXPECT_CROSSOVER : CMD_EXPECT_PHASE_MARGIN;
+            if (sscanf(text, "%*f %*s %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+            {
+                return false;
+            }
+        }
+        else if ((0 == strcmp(arg, "step")) || (0 == strcmp(arg, "settling")))
+        {
+            char dir[8];
+            ev.cmd = (0 == strcmp(arg, "step")) ? CMD_EXPECT_STEP : CMD_EXPECT_SETTLING;
+            if ((sscanf(text, "%*f %*s %*s %7s %lf %lf", dir, &ev.a[0], &ev.a[1]) != 3) ||
+                ((0 != strcmp(dir, "up")) && (0 != strcmp(dir, "down"))))
+            {
+                return false;
+            }
+            ev.dir = (0 == strcmp(dir, "up")) ? LOAD_STEP_UP : LOAD_STEP_DOWN;
+        }
+        else if (0 == strcmp(arg, "trip"))
+        {
+            char tier[8];
+            ev.cmd = CMD_EXPECT_TRIP;
+            if (sscanf(text, "%*f %*s %*s %7s %lf %lf", tier, &ev.a[0], &ev.a[1]) != 3)
+            {
+                return false;
+            }
+            ev.a[2] = (0 == strcmp(tier, trip_tiers[TRIP_FAST])) ? (double)TRIP_FAST :
+                      ((0 == strcmp(tier, trip_tiers[TRIP_VOUT])) ? (double)TRIP_VOUT :
+                      ((0 == strcmp(tier, trip_tiers[TRIP_AVG])) ? (double)TRIP_AVG : -1.0));
+            if (ev.a[2] < 0.0)
+            {
+                return false;
+            }
+        }
+        else if ((0 == strcmp(arg, "regulation")) || (0 == strcmp(arg, "inrush")))
+        {
+            ev.cmd = (arg[0] == 'r') ? CMD_EXPECT_REGULATION : CMD_EXPECT_INRUSH;
+            if (sscanf(text, "%*f %*s %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+            {
+                return false;
+            }
+        }
+        else if (0 == strcmp(arg, "uart_dropped"))
+        {
+            ev.cmd = CMD_EXPECT_UART_DROPPED;
+            if (sscanf(text, "%*f %*s %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+            {
+                return false;
+            }
+        }
+        else if ((0 == strcmp(arg, "commands")) || (0 == strcmp(arg, "cmd_latency")))
+        {
+            ev.cmd = (arg[1] == 'o') ? CMD_EXPECT_COMMANDS : CMD_EXPECT_CMD_LATENCY;
+            if (sscanf(text, "%*f %*s %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+            {
+                return false;
+            }
+        }
+        else if ((0 == strcmp(arg, "fw_efficiency")) || (0 == strcmp(arg, "fw_power")))
+        {
+            ev.cmd = (arg[3] == 'e') ? CMD_EXPECT_FW_EFFICIENCY : CMD_EXPECT_FW_POWER;
+            if (sscanf(text, "%*f %*s %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+            {
+                return false;
+            }
+        }
+        else if ((0 == strcmp(arg, "temp")) || (0 == strcmp(arg, "current_limit")))
+        {
+            ev.cmd = (arg[0] == 't') ? CMD_EXPECT_TEMP : CMD_EXPECT_CURRENT_LIMIT;
+            if (sscanf(text, "%*f %*s %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+            {
+                return false;
+            }
+        }
+        else if (0 == strcmp(arg, "ff_step"))
+        {
+            ev.cmd = CMD_EXPECT_FF_STEP;
+            if (sscanf(text, "%*f %*s %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+            {
+                return false;
+            }
+        }
+        else if ((0 == strcmp(arg, "transition")) || (0 == strcmp(arg, "overshoot")))
+        {
+            ev.cmd = (arg[0] == 't') ? CMD_EXPECT_TRANSITION : CMD_EXPECT_OVERSHOOT;
+            if (sscanf(text, "%*f %*s %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+            {
+                return false;
+            }
+        }
+        else if (0 == strcmp(arg, "autotune"))
+        {
+            ev.cmd = CMD_EXPECT_AUTOTUNE;
+            if (sscanf(text, "%*f %*s %*s %15s", ev.text) != 1)
+            {
+                return false;
+            }
+        }
+        else if ((0 == strcmp(arg, "reaction")) || (0 == strcmp(arg, "leak")))
+        {
+            ev.cmd = (arg[0] == 'r') ? CMD_EXPECT_REACTION : CMD_EXPECT_LEAK;
+            if (sscanf(text, "%*f %*s %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+            {
+                return false;
+            }
+        }
+        else if (0 == strcmp(arg, "sequence"))
+        {
+            ev.cmd = CMD_EXPECT_SEQUENCE;
+            if (sscanf(text, "%*f %*s %*s %63s", ev.text) != 1)
+            {
+                return false;
+            }
+        }
+        else if (0 == strcmp(arg, "queue"))
+        {
+            ev.cmd = CMD_EXPECT_QUEUE;
+            if (sscanf(text, "%*f %*s %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+            {
+                return false;
+            }
+        }
+        else if (0 == strcmp(arg, "scope"))
+        {
+            ev.cmd = CMD_EXPECT_SCOPE;
+            if (sscanf(text, "%*f %*s %*s %15s %lf", ev.text, &ev.a[0]) != 2)
+            {
+                return false;
+            }
+        }
+        else if ((0 == strcmp(arg, "tuned_c")) || (0 == strcmp(arg, "tuned_esr")))
+        {
+            ev.cmd = (0 == strcmp(arg, "tuned_c")) ? CMD_EXPECT_TUNED_C : CMD_EXPECT_TUNED_ESR;
+            if (sscanf(text, "%*f %*s %*s %lf %lf", &ev.a[0], &ev.a[1]) != 2)
+            {
+                return false;
+            }
+        }
+        else if (0 == strcmp(arg, "fault_led"))
+        {
+            char val[8];
+            ev.cmd = CMD_EXPECT_FAULT_LED;
+            if (sscanf(text, "%*f %*s %*s %7s", val) != 1)
+            {
+                return false;
+            }
+            ev.a[0] = (0 == strcmp(val, "on")) ? 1.0 : 0.0;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(cmd, "end"))
+    {
+        ev.cmd = CMD_END;
+        scn_end_time = ev.t;
+    }
+    else
+    {
+        return false;
+    }
+
+    scn_events[scn_count++] = ev;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: scn_load
+********************************************************************************
+* Summary:
+* Loads a scenario from a file, or the built-in scenario if path is NULL.
+*
+*******************************************************************************/
+static bool scn_load(const char *path)
+{
+    char buf[SCN_MAX_LINE];
+    int line = 0;
+
+    if (NULL == path)
+    {
+        const char *p = default_scenario;
+        while (*p != '\0')
+        {
+            size_t len = strcspn(p, "\n");
+            memcpy(buf, p, len);
+            buf[len] = '\0';
+            if (!scn_parse_line(buf, ++line))
+            {
+                return false;
+            }
+            p += len + ((p[len] == '\n') ? 1U : 0U);
+        }
+    }
+    else
+    {
+        FILE *f = fopen(path, "r");
+        if (NULL == f)
+        {
+            fprintf(stderr, "cannot open scenario %s\n", path);
+            return false;
+        }
+        while (NULL != fgets(buf, sizeof(buf), f))
+        {
+            if (!scn_parse_line(buf, ++line))
+            {
+                fprintf(stderr, "%s:%d: syntax error\n", path, line);
+                fclose(f);
+                return false;
+            }
+        }
+        fclose(f);
+    }
+    /* The marker after the last event is never due. */
+    scn_events[scn_count].t = HUGE_VAL;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: scn_is_expect
+********************************************************************************
+* Summary:
+* Returns true for the expectation commands.
+*
+*******************************************************************************/
+static bool scn_is_expect(const scn_event_t *ev)
+{
+    return (ev->cmd == CMD_EXPECT_STATE) || (ev->cmd == CMD_EXPECT_VOUT) || (ev->cmd == CMD_EXPECT_FAULT_LED) ||
+           (ev->cmd == CMD_EXPECT_SHARE) || (ev->cmd == CMD_EXPECT_PHASES) || (ev->cmd == CMD_EXPECT_EFFICIENCY) ||
+           (ev->cmd == CMD_EXPECT_CROSSOVER) || (ev->cmd == CMD_EXPECT_PHASE_MARGIN) ||
+           (ev->cmd == CMD_EXPECT_STEP) || (ev->cmd == CMD_EXPECT_SETTLING) || (ev->cmd == CMD_EXPECT_TRIP) ||
+           (ev->cmd == CMD_EXPECT_UART_DROPPED) || (ev->cmd == CMD_EXPECT_COMMANDS) ||
+           (ev->cmd == CMD_EXPECT_CMD_LATENCY) || (ev->cmd == CMD_EXPECT_FW_EFFICIENCY) ||
+           (ev->cmd == CMD_EXPECT_FW_POWER) || (ev->cmd == CMD_EXPECT_TEMP) ||
+           (ev->cmd == CMD_EXPECT_CURRENT_LIMIT) || (ev->cmd == CMD_EXPECT_TRANSITION) ||
+           (ev->cmd == CMD_EXPECT_OVERSHOOT) || (ev->cmd == CMD_EXPECT_FF_STEP) ||
+           (ev->cmd == CMD_EXPECT_AUTOTUNE) || (ev->cmd == CMD_EXPECT_TUNED_C) || (ev->cmd == CMD_EXPECT_TUNED_ESR) ||
+           (ev->cmd == CMD_EXPECT_REACTION) || (ev->cmd == CMD_EXPECT_LEAK) || (ev->cmd == CMD_EXPECT_SEQUENCE) ||
+           (ev->cmd == CMD_EXPECT_SCOPE) || (ev->cmd == CMD_EXPECT_QUEUE);
+}
+
+/*******************************************************************************
+* Function Name: efficiency
+********************************************************************************
+* Summary:
+* Power stage efficiency from the loss model since the measure command, 0 if
+* nothing was measured.
+*
+*******************************************************************************/
+static double efficiency(void)
+{
+    double e_in = meas_e_out + meas_e_loss;
+
+    return (e_in > 0.0) ? (meas_e_out / e_in) : 0.0;
+}
+
+/*******************************************************************************
+* Function Name: soft_start_ms
+********************************************************************************
+* Summary:
+* Time to regulation of the last start of BUCK1 measured by the firmware, ms,
+* or -1 if regulation was not reached.
+*
+*******************************************************************************/
+static double soft_start_ms(void)
+{
+    return (soft_start[0].reg_periods == 0U) ? -1.0 :
+           ((double)soft_start[0].reg_periods * 1000.0 / (double)SOFT_START_CTRL_FREQ_HZ);
+}
+
+/*******************************************************************************
+* Function Name: soft_start_inrush
+********************************************************************************
+* Summary:
+* Peak inrush current per phase of the last start of BUCK1 measured by the
+* firmware, A.
+*
+*******************************************************************************/
+static double soft_start_inrush(void)
+{
+    return (double)soft_start[0].out_max * (SIM_ADC_REF / SIM_DAC_MAX_COUNT / SIM_CUR_SENSE_GAIN);
+}
+
+/*******************************************************************************
+* Function Name: step_peak_mv / step_settling_us
+********************************************************************************
+* Summary:
+* Mean peak deviation and settling time of the load steps of one direction
+* measured by the firmware in the TEST state.
+*
+*******************************************************************************/
+static double step_peak_mv(load_step_dir_t dir)
+{
+    const load_step_stats_t *st = &load_step.stats[dir];
+
+    return (st->count == 0U) ? 0.0 : ((double)st->peak_sum / (double)st->count * LOAD_STEP_VOLT_PER_COUNT * 1.0e3);
+}
+
+static double step_settling_us(load_step_dir_t dir)
+{
+    const load_step_stats_t *st = &load_step.stats[dir];
+
+    return (st->count == 0U) ? 0.0 : ((double)st->settling_sum / (double)st->count * SIM_DT * 1.0e6);
+}
+
+/*******************************************************************************
+* Function Name: cause_tier / cause_text
+********************************************************************************
+* Summary:
+* Protection that detected a fault with the causes of a flight record, and
+* the causes joined by '+'.
+*
+*******************************************************************************/
+static int cause_tier(uint8_t cause)
+{
+    return (0U != (cause & FLIGHT_REC_CAUSE_FAST)) ? TRIP_FAST :
+           ((cause == FLIGHT_REC_CAUSE_VOUT) ? TRIP_VOUT : TRIP_AVG);
+}
+
+static const char *cause_text(uint8_t cause)
+{
+    static char text[64];
+    size_t len = 0U;
+
+    text[0] = '\0';
+    for (unsigned int bit = 0U; bit < FLIGHT_REC_CAUSES; bit++)
+    {
+        if ((0U != (cause & (1U << bit))) && ((1U << bit) != FLIGHT_REC_CAUSE_FAST))
+        {
+            len += (size_t)snprintf(&text[len], sizeof(text) - len, "%s%s", (len > 0U) ? "+" : "", cause_names[bit]);
+        }
+    }
+    return text;
+}
+
+/*******************************************************************************
+* Function Name: trip_stimulus / trip_tier / trip_latency_ms / trip_report
+********************************************************************************
+* Summary:
+* Stimulus of a fault: a load, vin, temp or inject command while the primary
+* converter ramps or runs; a command in IDLE or FAULT only sets up the next
+* start. Protection that detected the last fault, time from its stimulus to
+* the fault, -1 without a stimulus, and its report with the causes of the
+* flight record.
+*
+*******************************************************************************/
+static void trip_stimulus(void)
+{
+    Ifx_buck_states state = buck_conv[BUCK_CONV_PRIMARY].state;
+
+    if ((state == Ifx_BUCK_STATE_RAMP) || (state == Ifx_BUCK_STATE_RUN) || (state == Ifx_BUCK_STATE_TEST))
+    {
+        trip_stim = sim_time;
+    }
+}
+
+static int trip_tier(void)
+{
+    return cause_tier(trip_cause);
+}
+
+static double trip_latency_ms(void)
+{
+    return (trip_from >= 0.0) ? ((trip_t - trip_from) * 1.0e3) : -1.0;
+}
+
+static void trip_report(void)
+{
+    char latency[16] = "-";
+
+    if (trip_t < 0.0)
+    {
+        return;
+    }
+    if (trip_from >= 0.0)
+    {
+        snprintf(latency, sizeof(latency), "%.3f", trip_latency_ms());
+    }
+    printf("trip t=%.4f latency_ms=%s tier=%s cause=%s\n", trip_t, latency, trip_tiers[trip_tier()],
+           cause_text(trip_cause));
+}
+
+/*******************************************************************************
+* Function Name: inject_reaction_us / inject_states / inject_ms / inject_report
+********************************************************************************
+* Summary:
+* Time from the crossing of the window to the stop of the PWMs of an
+* injection, negative when a protection stopped the converter before, the
+* converter states after the start of the injection joined by ',', a time
+* as text, '-' when the event did not occur,
+* and the report of all injections, one line each.
+*
+*******************************************************************************/
+static bool inject_reaction_us(const fault_inject_rec_t *r, double *us)
+{
+    *us = (r->stop_t - r->cross_t) * 1.0e6;
+    return (r->cross_t >= 0.0) && (r->stop_t >= 0.0);
+}
+
+static const char *inject_states(const fault_inject_rec_t *r)
+{
+    static char text[FAULT_INJECT_STATES * 6U];
+    size_t len = 0U;
+
+    text[0] = '\0';
+    for (unsigned int i = 0U; i < r->states; i++)
+    {
+        len += (size_t)snprintf(&text[len], sizeof(text) - len, "%s%s", (i > 0U) ? "," : "",
+                                state_names[r->state[i]]);
+    }
+    return text;
+}
+
+static const char *inject_ms(char *text, size_t size, bool valid, int digits, double ms)
+{
+    if (valid)
+    {
+        snprintf(text, size, "%.*f", digits, ms);
+    }
+    else
+    {
+        snprintf(text, size, "-");
+    }
+    return text;
+}
+
+static void inject_report(void)
+{
+    for (uint32_t i = 0U; i < fault_inject_count(); i++)
+    {
+        const fault_inject_rec_t *r = fault_inject_record(i);
+        uint16_t excursion = (r->peak > r->limit_hi) ? (uint16_t)(r->peak - r->limit_hi) :
+                             ((r->peak < r->limit_lo) ? (uint16_t)(r->limit_lo - r->peak) : 0U);
+        char cross[16];
+        char stop[16];
+        char reaction[16];
+        double us;
+        bool valid = inject_reaction_us(r, &us);
+
+        printf("inject t=%.4f conv=%u channel=%s mode=%s value=%.3f counts=%.0f ms=%.3f limit_lo=%u limit_hi=%u "
+               "cross_ms=%s stop_ms=%s reaction_us=%s peak=%u excursion=%u vout_min=%.3f vout_max=%.3f "
+               "il_peak_max=%.3f leak_mj=%.3f tier=%s cause=%s states=%s\n",
+               r->t, r->conv, fault_inject_channel_name(r->ch), fault_inject_mode_name(r->mode), r->value, r->counts,
+               r->duration * 1.0e3, r->limit_lo, r->limit_hi,
+               inject_ms(cross, sizeof(cross), r->cross_t >= 0.0, 4, (r->cross_t - r->t) * 1.0e3),
+               inject_ms(stop, sizeof(stop), r->stop_t >= 0.0, 4, (r->stop_t - r->t) * 1.0e3),
+               inject_ms(reaction, sizeof(reaction), valid, 1, us), r->peak, excursion,
+               (r->vout_min > r->vout_max) ? 0.0 : r->vout_min, r->vout_max, r->il_max, r->leak_j * 1.0e3,
+               (r->cause != 0U) ? trip_tiers[cause_tier(r->cause)] : "-",
+               (r->cause != 0U) ? cause_text(r->cause) : "-", inject_states(r));
+    }
+}
+
+/*******************************************************************************
+* Function Name: transient_report
+********************************************************************************
+* Summary:
+* Prints the excursion and settling time of the output voltage since the last
+* transient command, and ends the measurement.
+*
+*******************************************************************************/
+static void transient_report(void)
+{
+    if (!tr_active)
+    {
+        return;
+    }
+    printf("transient t=%.4f band_mv=%.0f undershoot_mv=%.1f overshoot_mv=%.1f settling_us=%.0f\n",
+           tr_start, tr_band * 1.0e3, (tr_vref - tr_min) * 1.0e3, (tr_max - tr_vref) * 1.0e3,
+           (tr_last_out - tr_start) * 1.0e6);
+    tr_active = false;
+}
+
+/*******************************************************************************
+* Function Name: model_crossover
+********************************************************************************
+* Summary:
+* Crossover frequency and phase margin of the loop gain of the plant model
+* (comp_design.c) with a compensator, on a fine logarithmic grid over the
+* sweep range of the frequency response analyzer. Both are 0 if the loop gain
+* does not cross 0 dB.
+*
+*******************************************************************************/
+static void model_crossover(const comp_design_in_t *in, const comp_coef_t *coef, double *fc, double *pm)
+{
+    double prev_mag = 0.0;
+    double prev_deg = 0.0;
+    double prev_f = 0.0;
+
+    *fc = 0.0;
+    *pm = 0.0;
+    for (uint32_t i = 0U; i <= 1000U; i++)
+    {
+        double f = FRA_FREQ_MIN * pow(FRA_FREQ_MAX / FRA_FREQ_MIN, (double)i / 1000.0);
+        double mag;
+        double deg;
+
+        comp_loop_gain(in, coef, f, &mag, &deg);
+        deg = (deg > 0.0) ? (deg - 360.0) : deg;
+        if ((i > 0U) && (prev_mag > 1.0) && (mag <= 1.0))
+        {
+            double t = log(prev_mag) / (log(prev_mag) - log(mag));
+
+            *fc = prev_f * pow(f / prev_f, t);
+            *pm = 180.0 + prev_deg + (t * (deg - prev_deg));
+            return;
+        }
+        prev_mag = mag;
+        prev_deg = deg;
+        prev_f = f;
+    }
+}
+
+/*******************************************************************************
+* Function Name: fra_compare
+********************************************************************************
+* Summary:
+* Prints the loop gain measured by the frequency response analyzer next to the
+* loop gain of the plant model (comp_design.c) with the compensator
+* coefficients in use, at the load and the number of phases at the end of the
+* run, and the crossover frequency and phase margin of both. The model uses
+* the output capacitor of the simulated power stage.
+*
+*******************************************************************************/
+static void fra_compare(void)
+{
+    comp_design_in_t in;
+    comp_coef_t coef;
+    double model_fc;
+    double model_pm;
+
+    if (!fra.valid)
+    {
+        return;
+    }
+    comp_design_default(&in);
+    in.phases = (double)phase_shed.phases;
+    in.c      = sim_plant.p.c;
+    in.esr    = sim_plant.p.esr;
+    if (sim_plant.iload > 0.0)
+    {
+        in.r_load = sim_plant.vout / sim_plant.iload;
+    }
+    coef.b0 = BUCK1_ctx.ctrl.b0;
+    coef.b1 = BUCK1_ctx.ctrl.b1;
+    coef.b2 = BUCK1_ctx.ctrl.b2;
+    coef.a1 = BUCK1_ctx.ctrl.a1;
+    coef.a2 = BUCK1_ctx.ctrl.a2;
+
+    for (uint32_t i = 0U; i < FRA_POINTS; i++)
+    {
+        const fra_point_t *p = &fra.pt[i];
+        double mag;
+        double deg;
+
+        comp_loop_gain(&in, &coef, p->freq, &mag, &deg);
+        deg = (deg > 0.0) ? (deg - 360.0) : deg;
+        printf("fra f=%.0f loop_db=%.2f loop_deg=%.1f model_db=%.2f model_deg=%.1f plant_db=%.2f plant_deg=%.1f\n",
+               (double)p->freq, (double)p->loop_db, (double)p->loop_deg, 20.0 * log10(mag), deg,
+               (double)p->plant_db, (double)p->plant_deg);
+    }
+
+    model_crossover(&in, &coef, &model_fc, &model_pm);
+    printf("fra crossover_hz=%.0f margin_deg=%.1f model_crossover_hz=%.0f model_margin_deg=%.1f "
+           "design_crossover_hz=%.0f design_margin_deg=%.1f\n", (double)fra.crossover_hz, (double)fra.margin_deg,
+           model_fc, model_pm, (double)FRA_DESIGN_CROSSOVER_HZ, (double)FRA_DESIGN_PHASE_MARGIN);
+}
+
+/*******************************************************************************
+* Function Name: autotune_compare
+********************************************************************************
+* Summary:
+* Prints the result of the last auto-tuning: the identified plant next to the
+* simulated power stage, the tuned coefficients of the active phase count next
+* to those of comp_design_2p2z() for the identified plant, and the crossover
+* frequency and phase margin of the tuned coefficients on the model of the
+* simulated power stage.
+*
+*******************************************************************************/
+static void autotune_compare(void)
+{
+    const autotune_plant_t *p = &autotune.plant;
+    const gain_sched_coef_t *t;
+    comp_design_in_t in;
+    comp_coef_t model;
+    comp_coef_t tuned;
+    double c = sim_plant.p.c / (double)sim_plant.outputs;     /* Output capacitors of BUCK1 */
+    double esr = sim_plant.p.esr * (double)sim_plant.outputs;
+    double fc;
+    double pm;
+
+    if (autotune.runs == 0U)
+    {
+        return;
+    }
+    printf("autotune result=%s reason=%s c_uf=%.1f esr_mohm=%.2f delay=%.2f delay_eff=%.2f r_load=%.2f fit=%.4f "
+           "switches=%u verify_peak=%d plant_c_uf=%.1f plant_esr_mohm=%.2f\n",
+           autotune_result_name(autotune.result), (autotune.reason != NULL) ? autotune.reason : "-",
+           (double)p->c_uf, (double)p->esr_mohm, (double)p->delay, (double)p->delay_eff, (double)p->r_load,
+           (double)p->fit,
+           autotune.switches, (int)autotune.verify_peak, c * 1.0e6, esr * 1.0e3);
+    if (!gain_sched.tuned_active)
+    {
+        return;
+    }
+
+    t = &gain_sched.tuned[autotune.phases - 1U];
+    tuned.b0 = t->b0;
+    tuned.b1 = t->b1;
+    tuned.b2 = t->b2;
+    tuned.a1 = t->a1;
+    tuned.a2 = t->a2;
+    comp_design_default(&in);
+    in.c      = p->c_uf * 1.0e-6;
+    in.esr    = p->esr_mohm * 1.0e-3;
+    in.r_load = p->r_load;
+    in.delay  = p->delay;
+    in.phases = (double)autotune.phases;
+    comp_design_2p2z(&in, &model);
+    printf("autotune b0=%.6f b1=%.6f b2=%.6f a1=%.6f a2=%.6f model_b0=%.6f model_b1=%.6f model_b2=%.6f "
+           "model_a1=%.6f model_a2=%.6f\n", tuned.b0, tuned.b1, tuned.b2, tuned.a1, tuned.a2,
+           model.b0, model.b1, model.b2, model.a1, model.a2);
+
+    in.c     = c;
+    in.esr   = esr;
+    in.delay = SIM_TIME_DELAY;
+    model_crossover(&in, &tuned, &fc, &pm);
+    printf("autotune plant_crossover_hz=%.0f plant_margin_deg=%.1f design_crossover_hz=%.0f design_margin_deg=%.1f\n",
+           fc, pm, (double)AUTOTUNE_CROSSOVER_HZ, (double)AUTOTUNE_PHASE_MARGIN);
+}
+
+/*******************************************************************************
+* Function Name: cmd_latency_us
+********************************************************************************
+* Summary:
+* Longest time from the end of a command line to the end of its execution
+* measured by the firmware, us.
+*
+*******************************************************************************/
+static double cmd_latency_us(void)
+{
+    return (double)uart_cmd.latency_max * 1.0e6 / SIM_CPU_CLK_HZ;
+}
+
+/*******************************************************************************
+* Function Name: scn_execute
+********************************************************************************
+* Summary:
+* Applies a scenario event to the simulation or evaluates an expectation.
+*
+*******************************************************************************/
+static void scn_execute(const scn_event_t *ev)
+{
+    bool ok = true;
+    char what[64] = { 0 };
+
+    switch (ev->cmd)
+    {
+        case CMD_BUTTON:
+            hw_model_button_press();
+            break;
+
+        case CMD_LOAD:
+            load_variable[0] = ev->a[0];
+            load_variable[1] = (ev->a[1] >= 0.0) ? ev->a[1] : ev->a[0];
+            trip_stimulus();
+            break;
+
+        case CMD_SWITCH:
+            if ((ev->a[0] >= 1.0) && (ev->a[0] <= 2.0))
+            {
+                load_transient[(int)ev->a[0] - 1] = (ev->a[1] > 0.5);
+            }
+            break;
+
+        case CMD_VIN:
+            sim_plant.vin = ev->a[0];
+            trip_stimulus();
+            break;
+
+        case CMD_TEMP:
+            sim_plant.t_ambient = ev->a[0];
+            trip_stimulus();
+            break;
+
+        case CMD_INJECT:
+            if (ev->mode == FAULT_MODE_OFF)
+            {
+                fault_inject_stop((unsigned int)ev->a[2], ev->ch);
+            }
+            else if (fault_inject_start((unsigned int)ev->a[2], ev->ch, ev->mode, ev->a[0], ev->a[1]))
+            {
+                trip_stimulus();
+            }
+            else
+            {
+                printf("inject t=%.4f line=%d FAIL: no channel %s on converter %.0f\n", sim_time, ev->line,
+                       fault_inject_channel_name(ev->ch), ev->a[2]);
+                scn_failures++;
+            }
+            break;
+
+        case CMD_NOISE:
+            conv_model_set_adc_noise(ev->a[0]);
+            break;
+
+        case CMD_INDUCTOR:
+            sim_plant.p.l[0] = ev->a[0] * 1.0e-6;
+            sim_plant.p.l[1] = ev->a[1] * 1.0e-6;
+            plant_update(&sim_plant);
+            break;
+
+        case CMD_CAPACITOR:
+            sim_plant.p.c   = ev->a[0] * 1.0e-6;
+            sim_plant.p.esr = ev->a[1] * 1.0e-3;
+            plant_update(&sim_plant);
+            break;
+
+        case CMD_SENSE:
+            sim_plant.p.k_sense[0] = ev->a[0];
+            sim_plant.p.k_sense[1] = ev->a[1];
+            plant_update(&sim_plant);
+            break;
+
+        case CMD_SHED:
+            phase_shed_set_enable(ev->a[0] > 0.5);
+            break;
+
+        case CMD_MEASURE:
+            meas_active = true;
+            meas_start  = sim_time;
+            meas_e_out  = 0.0;
+            meas_e_loss = 0.0;
+            break;
+
+        case CMD_GAIN_SCHED:
+            gain_sched_set_enable(ev->a[0] > 0.5);
+            break;
+
+        case CMD_LOAD_FF:
+            load_ff_set_enable(ev->a[0] > 0.5);
+            break;
+
+        case CMD_FAST_PROT:
+            fast_prot_set_enable(ev->a[0] > 0.5);
+            break;
+
+        case CMD_SOFT_START:
+            soft_start_set_profile((soft_start_profile_t)ev->a[0], (uint32_t)ev->a[1]);
+            break;
+
+        case CMD_TRANSIENT:
+            transient_report();
+            tr_active   = true;
+            tr_start    = sim_time;
+            tr_band     = ev->a[0];
+            tr_vref     = (double)BUCK1_ctx.ref * SIM_ADC_REF / SIM_ADC_MAX_COUNT / SIM_GAIN_VOUT;
+            tr_min      = sim_plant.vout;
+            tr_max      = sim_plant.vout;
+            tr_last_out = sim_time;
+            break;
+
+        case CMD_SHARE_BW:
+            current_share_set_bandwidth((float32_t)ev->a[0]);
+            break;
+
+        case CMD_FRA:
+            fra_start();
+            break;
+
+        case CMD_UART_RATE:
+            uart_tx_set_rate((uint32_t)ev->a[0]);
+            break;
+
+        case CMD_UART:
+            hw_model_uart_input(ev->text);
+            break;
+
+        case CMD_EVENTS:
+            /* Posted like from an interrupt that preempts the PendSV
+             * exception: the events of a ramp end of converter 0 are ignored
+             * in RUN and wait for the next PendSV. */
+            for (int i = 0; i < (int)ev->a[0]; i++)
+            {
+                (void)event_queue_post(&buck_sm.queue, (uint32_t)BUCK_SM_EV_RAMP_DONE);
+            }
+            break;
+
+        case CMD_EXPECT_QUEUE:
+        {
+            uint32_t dropped = atomic_load_explicit(&buck_sm.queue.dropped, memory_order_relaxed);
+
+            ok = ((double)dropped == ev->a[0]) && ((double)buck_sm.fault_overflows == ev->a[1]);
+            snprintf(what, sizeof(what), "queue %.0f dropped %.0f fault_overflows (got %u %u)", ev->a[0], ev->a[1],
+                     (unsigned int)dropped, (unsigned int)buck_sm.fault_overflows);
+            break;
+        }
+
+        case CMD_EXPECT_COMMANDS:
+            ok = ((double)uart_cmd.executed == ev->a[0]) && ((double)uart_cmd.rejected == ev->a[1]);
+            snprintf(what, sizeof(what), "commands %.0f ok %.0f rejected (got %u %u)", ev->a[0], ev->a[1],
+                     uart_cmd.executed, uart_cmd.rejected);
+            break;
+
+        case CMD_EXPECT_CMD_LATENCY:
+            ok = (uart_cmd.executed > 0U) && (cmd_latency_us() >= ev->a[0]) && (cmd_latency_us() <= ev->a[1]);
+            snprintf(what, sizeof(what), "cmd_latency in [%.1f, %.1f] us (got %.1f)", ev->a[0], ev->a[1],
+                     cmd_latency_us());
+            break;
+
+        case CMD_EXPECT_FW_EFFICIENCY:
+        case CMD_EXPECT_FW_POWER:
+        {
+            energy_result_t r;
+            double got;
+
+            energy_result(&r);
+            got = (ev->cmd == CMD_EXPECT_FW_EFFICIENCY) ? (double)r.efficiency : (double)r.p_out;
+            ok = (r.windows > 0U) && (got >= ev->a[0]) && (got <= ev->a[1]);
+            snprintf(what, sizeof(what), "%s in [%.4f, %.4f] (got %.4f)",
+                     (ev->cmd == CMD_EXPECT_FW_EFFICIENCY) ? "fw_efficiency" : "fw_power", ev->a[0], ev->a[1], got);
+            break;
+        }
+
+        case CMD_EXPECT_TEMP:
+            ok = (sim_plant.temp >= ev->a[0]) && (sim_plant.temp <= ev->a[1]);
+            snprintf(what, sizeof(what), "temp in [%.1f, %.1f] degC (got %.2f)", ev->a[0], ev->a[1], sim_plant.temp);
+            break;
+
+        case CMD_EXPECT_CURRENT_LIMIT:
+        {
+            double limit = (double)thermal_limit_a(BUCK_CONV_PRIMARY);
+            ok = (limit >= ev->a[0]) && (limit <= ev->a[1]);
+            snprintf(what, sizeof(what), "current_limit in [%.2f, %.2f] A (got %.3f)", ev->a[0], ev->a[1], limit);
+            break;
+        }
+
+        case CMD_EXPECT_FF_STEP:
+        {
+            double step = (double)load_ff_step_ma();
+            ok = (step >= ev->a[0]) && (step <= ev->a[1]);
+            snprintf(what, sizeof(what), "ff_step in [%.0f, %.0f] mA (got %.0f)", ev->a[0], ev->a[1], step);
+            break;
+        }
+
+        case CMD_EXPECT_TRANSITION:
+        case CMD_EXPECT_OVERSHOOT:
+        {
+            /* Measured by the firmware; not done while a change is in progress. */
+            double got = (ev->cmd == CMD_EXPECT_TRANSITION) ? (double)setpoint_transition_ms(BUCK_CONV_PRIMARY) :
+                                                              (double)setpoint_overshoot_mv(BUCK_CONV_PRIMARY);
+            ok = !setpoint[BUCK_CONV_PRIMARY].active && (setpoint[BUCK_CONV_PRIMARY].done_periods > 0U) &&
+                 (got >= ev->a[0]) && (got <= ev->a[1]);
+            snprintf(what, sizeof(what), "%s in [%.2f, %.2f] %s (got %.2f)",
+                     (ev->cmd == CMD_EXPECT_TRANSITION) ? "transition" : "overshoot", ev->a[0], ev->a[1],
+                     (ev->cmd == CMD_EXPECT_TRANSITION) ? "ms" : "mV", got);
+            break;
+        }
+
+        case CMD_EXPECT_UART_DROPPED:
+            ok = ((double)uart_tx.dropped >= ev->a[0]) && ((double)uart_tx.dropped <= ev->a[1]);
+            snprintf(what, sizeof(what), "uart_dropped in [%.0f, %.0f] (got %u)", ev->a[0], ev->a[1], uart_tx.dropped);
+            break;
+
+        case CMD_EXPECT_STATE:
+        {
+            Ifx_buck_states state = buck_conv[(int)ev->a[1]].state;
+            ok = ((int)state == (int)ev->a[0]);
+            snprintf(what, sizeof(what), "state %s (got %s)", state_names[(int)ev->a[0]],
+                     ((unsigned int)state < 5U) ? state_names[state] : "?");
+            if (ev->a[1] > 0.0)
+            {
+                snprintf(&what[strlen(what)], sizeof(what) - strlen(what), " conv %d", (int)ev->a[1]);
+            }
+            break;
+        }
+
+        case CMD_EXPECT_VOUT:
+        {
+            double vout = (ev->a[2] > 0.0) ? sim_plant.vout2 : sim_plant.vout;
+            ok = (vout >= ev->a[0]) && (vout <= ev->a[1]);
+            snprintf(what, sizeof(what), "vout in [%.3f, %.3f] (got %.3f)", ev->a[0], ev->a[1], vout);
+            if (ev->a[2] > 0.0)
+            {
+                snprintf(&what[strlen(what)], sizeof(what) - strlen(what), " output %d", (int)ev->a[2]);
+            }
+            break;
+        }
+
+        case CMD_EXPECT_SHARE:
+        {
+            double sum = sim_plant.il_avg[0] + sim_plant.il_avg[1];
+            double pm = (sum > 0.0) ? (1000.0 * (sim_plant.il_avg[0] - sim_plant.il_avg[1]) / sum) : 0.0;
+            ok = (pm >= ev->a[0]) && (pm <= ev->a[1]);
+            snprintf(what, sizeof(what), "share in [%.0f, %.0f] per mille (got %.1f)", ev->a[0], ev->a[1], pm);
+            break;
+        }
+
+        case CMD_EXPECT_PHASES:
+            ok = ((double)phase_shed.phases == ev->a[0]);
+            snprintf(what, sizeof(what), "phases %.0f (got %u)", ev->a[0], phase_shed.phases);
+            break;
+
+        case CMD_EXPECT_EFFICIENCY:
+        {
+            double eff = efficiency();
+            ok = (eff >= ev->a[0]) && (eff <= ev->a[1]);
+            snprintf(what, sizeof(what), "efficiency in [%.4f, %.4f] (got %.4f)", ev->a[0], ev->a[1], eff);
+            break;
+        }
+
+        case CMD_EXPECT_AUTOTUNE:
+            ok = (0 == strcmp(autotune_busy() ? "busy" : autotune_result_name(autotune.result), ev->text));
+            snprintf(what, sizeof(what), "autotune %.15s (got %s)", ev->text,
+                     autotune_busy() ? "busy" : autotune_result_name(autotune.result));
+            break;
+
+        case CMD_EXPECT_SCOPE:
+        {
+            static const char *const names[] = { "idle", "done", "armed", "triggered" };
+
+            ok = (0 == strcmp(names[scope.state], ev->text)) && (scope.capture == (uint8_t)ev->a[0]);
+            snprintf(what, sizeof(what), "scope %.15s captures=%.0f (got %s captures=%u)", ev->text, ev->a[0],
+                     names[scope.state], scope.capture);
+            break;
+        }
+
+        case CMD_EXPECT_TUNED_C:
+        case CMD_EXPECT_TUNED_ESR:
+        {
+            double got = (ev->cmd == CMD_EXPECT_TUNED_C) ? (double)autotune.plant.c_uf :
+                         (double)autotune.plant.esr_mohm;
+
+            ok = (autotune.runs > 0U) && (got >= ev->a[0]) && (got <= ev->a[1]);
+            snprintf(what, sizeof(what), "%s in [%.1f, %.1f] (got %.1f)",
+                     (ev->cmd == CMD_EXPECT_TUNED_C) ? "tuned_c" : "tuned_esr", ev->a[0], ev->a[1], got);
+            break;
+        }
+
+        case CMD_EXPECT_REACTION:
+        case CMD_EXPECT_LEAK:
+        {
+            uint32_t count = fault_inject_count();
+            const fault_inject_rec_t *r = (count > 0U) ? fault_inject_record(count - 1U) : NULL;
+            double got = -1.0;
+
+            ok = (NULL != r);
+            if (ok && (ev->cmd == CMD_EXPECT_REACTION))
+            {
+                ok = inject_reaction_us(r, &got);
+            }
+            else if (ok)
+            {
+                got = r->leak_j * 1.0e3;
+            }
+            ok = ok && (got >= ev->a[0]) && (got <= ev->a[1]);
+            snprintf(what, sizeof(what), "%s in [%.3f, %.3f] %s (got %.3f)",
+                     (ev->cmd == CMD_EXPECT_REACTION) ? "reaction" : "leak", ev->a[0], ev->a[1],
+                     (ev->cmd == CMD_EXPECT_REACTION) ? "us" : "mJ", got);
+            break;
+        }
+
+        case CMD_EXPECT_SEQUENCE:
+        {
+            uint32_t count = fault_inject_count();
+            const char *got = (count > 0U) ? inject_states(fault_inject_record(count - 1U)) : "-";
+
+            ok = (0 == strcmp(got, ev->text));
+            snprintf(what, sizeof(what), "sequence %.20s (got %.20s)", ev->text, got);
+            break;
+        }
+
+        case CMD_EXPECT_GAIN_SET:
+            ok = ((double)gain_sched.active == ev->a[0]);
+            snprintf(what, sizeof(what), "gain_set %.0f (got %u)", ev->a[0], gain_sched.active);
+            break;
+
+        case CMD_EXPECT_REGULATION:
+            ok = (soft_start_ms() >= ev->a[0]) && (soft_start_ms() <= ev->a[1]);
+            snprintf(what, sizeof(what), "regulation in [%.2f, %.2f] ms (got %.2f)", ev->a[0], ev->a[1],
+                     soft_start_ms());
+            break;
+
+        case CMD_EXPECT_INRUSH:
+            ok = (soft_start_inrush() >= ev->a[0]) && (soft_start_inrush() <= ev->a[1]);
+            snprintf(what, sizeof(what), "inrush in [%.2f, %.2f] A (got %.2f)", ev->a[0], ev->a[1],
+                     soft_start_inrush());
+            break;
+
+        case CMD_EXPECT_CROSSOVER:
+            ok = fra.valid && (fra.crossover_hz >= ev->a[0]) && (fra.crossover_hz <= ev->a[1]);
+            snprintf(what, sizeof(what), "crossover in [%.0f, %.0f] Hz (got %.0f)", ev->a[0], ev->a[1],
+                     fra.valid ? (double)fra.crossover_hz : 0.0);
+            break;
+
+        case CMD_EXPECT_PHASE_MARGIN:
+            ok = fra.valid && (fra.margin_deg >= ev->a[0]) && (fra.margin_deg <= ev->a[1]);
+            snprintf(what, sizeof(what), "phase_margin in [%.1f, %.1f] deg (got %.1f)", ev->a[0], ev->a[1],
+                     fra.valid ? (double)fra.margin_deg : 0.0);
+            break;
+
+        case CMD_EXPECT_STEP:
+            ok = (load_step.stats[ev->dir].count > 0U) && (step_peak_mv(ev->dir) >= ev->a[0]) &&
+                 (step_peak_mv(ev->dir) <= ev->a[1]);
+            snprintf(what, sizeof(what), "step %s peak in [%.0f, %.0f] mV (got %.1f)",
+                     (ev->dir == LOAD_STEP_UP) ? "up" : "down", ev->a[0], ev->a[1], step_peak_mv(ev->dir));
+            break;
+
+        case CMD_EXPECT_SETTLING:
+            ok = (load_step.stats[ev->dir].count > 0U) && (step_settling_us(ev->dir) >= ev->a[0]) &&
+                 (step_settling_us(ev->dir) <= ev->a[1]);
+            snprintf(what, sizeof(what), "settling %s in [%.0f, %.0f] us (got %.0f)",
+                     (ev->dir == LOAD_STEP_UP) ? "up" : "down", ev->a[0], ev->a[1], step_settling_us(ev->dir));
+            break;
+
+        case CMD_EXPECT_TRIP:
+            ok = (trip_from >= 0.0) && (trip_tier() == (int)ev->a[2]) &&
+                 (trip_latency_ms() >= ev->a[0]) && (trip_latency_ms() <= ev->a[1]);
+            if (trip_from >= 0.0)
+            {
+                snprintf(what, sizeof(what), "trip %s in [%.3f, %.3f] ms (got %s %.3f)", trip_tiers[(int)ev->a[2]],
+                         ev->a[0], ev->a[1], trip_tiers[trip_tier()], trip_latency_ms());
+            }
+            else
+            {
+                snprintf(what, sizeof(what), "trip %s in [%.3f, %.3f] ms (got %s)", trip_tiers[(int)ev->a[2]],
+                         ev->a[0], ev->a[1], (trip_t >= 0.0) ? "a fault without stimulus" : "no fault");
+            }
+            break;
+
+        case CMD_EXPECT_FAULT_LED:
+            ok = (hw_model_fault_led_on() == (ev->a[0] > 0.5));
+            snprintf(what, sizeof(what), "fault_led %s", (ev->a[0] > 0.5) ? "on" : "off");
+            break;
+
+        default:
+            break;
+    }
+
+    if (what[0] != '\0')
+    {
+        printf("expect t=%.4f line=%d %s: %s\n", ev->t, ev->line, ok ? "PASS" : "FAIL", what);
+        if (!ok)
+        {
+            scn_failures++;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: load_conductance
+********************************************************************************
+* Summary:
+* Equivalent conductance of the onboard loads on each output. The transient
+* load of channel 1 follows the PWM_LOAD line output and channel 2 its
+* complement. With two outputs (J14 removed) channel 1 loads output 1 and
+* channel 2 output 2, otherwise both load the common output.
+*
+*******************************************************************************/
+static void load_conductance(double g_load[PLANT_OUTPUT_MAX])
+{
+    bool line = hw_model_load_line();
+    bool running = hw_model_pwm_running(PWM_LOAD_NUM);
+
+    g_load[0] = 0.0;
+    g_load[1] = 0.0;
+    for (unsigned int ch = 0U; ch < 2U; ch++)
+    {
+        double i;
+
+        if (load_transient[ch])
+        {
+            bool high = running && ((ch == 0U) ? line : (!line));
+            i = high ? SIM_LOAD_TRANSIENT_HIGH : SIM_LOAD_TRANSIENT_LOW;
+        }
+        else
+        {
+            i = load_variable[ch];
+        }
+        g_load[(SIM_OUTPUTS > 1U) ? ch : 0U] += i / SIM_VOUT_NOM;
+    }
+}
+
+/*******************************************************************************
+* Function Name: sim_app_init
+********************************************************************************
+* Summary:
+* Performs the application start up of main() up to the status loop.
+*
+*******************************************************************************/
+static void sim_app_init(void)
+{
+    static cy_stc_scb_uart_context_t uart_context;
+
+    (void)cybsp_init();
+    (void)Cy_SCB_UART_Init(DEBUG_UART_HW, &DEBUG_UART_config, &uart_context);
+    uart_tx_init(&uart_context);
+    uart_cmd_init();
+    __enable_irq();
+    hardware_init();
+    Cy_GPIO_Set(FAULT_LED_PORT, FAULT_LED_NUM);
+    Cy_TCPWM_TriggerStart_Single(PWM_STATUS_LED_HW, PWM_STATUS_LED_NUM);
+    Cy_TCPWM_PWM_SetCompare0Val(PWM_ACT_LED_HW, PWM_ACT_LED_NUM, CLR_LED);
+    Cy_TCPWM_TriggerStart_Single(PWM_ACT_LED_HW, PWM_ACT_LED_NUM);
+#if TELEMETRY_BINARY
+    telemetry_init();
+#endif
+}
+
+/*******************************************************************************
+* Function Name: prot_vector
+********************************************************************************
+* Summary:
+* Next pseudo-random ADC result of a protection test vector. Results dwell
+* around the given limit so that the averages cross it in both directions.
+*
+*******************************************************************************/
+static uint16_t prot_vector(uint32_t *seed, uint16_t prev, uint32_t limit)
+{
+    uint32_t r;
+    int32_t v;
+
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 17;
+    *seed ^= *seed << 5;
+    r = *seed;
+
+    switch (r & 3U)
+    {
+        case 0U:
+            v = (int32_t)((r >> 8) % 4096U);
+            break;
+        case 1U:
+            v = (int32_t)prev;
+            break;
+        default:
+            v = (int32_t)limit + (int32_t)((r >> 8) % 81U) - 40;
+            break;
+    }
+    return (uint16_t)((v < 0) ? 0 : ((v > 4095) ? 4095 : v));
+}
+
+/*******************************************************************************
+* Function Name: prot_check
+********************************************************************************
+* Summary:
+* Drives buck1_scheduled_adc_callback() with pseudo-random ADC results and
+* compares the averages and the trip decision bit by bit against the host
+* reference model of the build mode (BUCK_PROT_FIXED_POINT). Also reports the
+* host time per callback and how often the fixed point and float32 modes
+* decide differently.
+*
+* Parameters:
+*  vectors: number of scheduled ADC periods to run
+*
+* Return:
+*  uint32_t: number of mismatches
+*
+*******************************************************************************/
+static uint32_t prot_check(uint32_t vectors)
+{
+    static const uint32_t limits[PROT_REF_CHANNELS] =
+    {
+        VIN_MIN_COUNT, IOUT_MAX_COUNT, IOUT_MAX_COUNT, TEMP_MAX_COUNT
+    };
+    prot_ref_t ref;
+    prot_ref_t other;
+    uint16_t res[PROT_REF_CHANNELS] = { VIN_COUNT, 0U, 0U, 0U };
+    uint32_t seed = 0x2545F491UL;
+    uint32_t mismatches = 0U;
+    uint32_t trips = 0U;
+    uint32_t divergence = 0U;
+    uint64_t dut_ns;
+    uint64_t t0;
+
+    hw_model_reset();
+    plant_init(&sim_plant);
+    sim_app_init();
+    prot_ref_reset(&ref);
+    prot_ref_reset(&other);
+
+    for (uint32_t n = 0U; n < vectors; n++)
+    {
+        const prot_value_t *dut[PROT_REF_CHANNELS] =
+        {
+            &buck_conv[0].vin_avg, &buck_conv[0].iout_avg[0], &buck_conv[0].iout_avg[1], &buck_conv[0].temp_avg
+        };
+        bool ref_trip;
+        bool other_trip;
+        bool dut_trip;
+
+        for (unsigned int ch = 0U; ch < PROT_REF_CHANNELS; ch++)
+        {
+            /* Vin also dwells around its upper limit. */
+            uint32_t limit = ((ch == PROT_REF_VIN) && (0U != (n & 0x400U))) ? VIN_MAX_COUNT : limits[ch];
+            res[ch] = prot_vector(&seed, res[ch], limit);
+        }
+#if (BUCK_CONV_PHASES == 1U)
+        /* The second current channel is not converted. */
+        res[PROT_REF_IOUT2] = 0U;
+#endif
+        conv_model_set_sched_results(0U, res);
+
+        buck_conv[0].state = Ifx_BUCK_STATE_RUN;
+        fast_prot_tick(0U);
+        buck1_scheduled_adc_callback();
+        buck_sm_process();
+        dut_trip = (buck_conv[0].state == Ifx_BUCK_STATE_FAULT);
+
+#if BUCK_PROT_FIXED_POINT
+        ref_trip = prot_ref_step_fixed(&ref, res);
+        other_trip = prot_ref_step_float(&other, res);
+        for (unsigned int ch = 0U; ch < PROT_REF_CHANNELS; ch++)
+        {
+            if ((int64_t)*dut[ch] != ref.fixed[ch])
+            {
+                mismatches++;
+            }
+        }
+#else
+        ref_trip = prot_ref_step_float(&ref, res);
+        other_trip = prot_ref_step_fixed(&other, res);
+        for (unsigned int ch = 0U; ch < PROT_REF_CHANNELS; ch++)
+        {
+            if (0 != memcmp(dut[ch], &ref.flt[ch], sizeof(float32_t)))
+            {
+                mismatches++;
+            }
+        }
+#endif
+        if (dut_trip != ref_trip)
+        {
+            mismatches++;
+        }
+        if (other_trip != ref_trip)
+        {
+            divergence++;
+        }
+
+        /* Restart after a trip in either mode, as from the IDLE state. */
+        if (ref_trip || other_trip || dut_trip)
+        {
+            trips += ref_trip ? 1U : 0U;
+            prot_ref_reset(&ref);
+            prot_ref_reset(&other);
+            buck_conv_reset(0U);
+        }
+    }
+
+    /* Host time of the callback without a trip. The results are non-zero so
+     * that the float averages do not decay into subnormals, which are slow
+     * on the host but not on the Cortex-M33 FPU. */
+    res[PROT_REF_VIN] = VIN_COUNT;
+    res[PROT_REF_IOUT1] = res[PROT_REF_IOUT2] = res[PROT_REF_TEMP] = 1000U;
+    conv_model_set_sched_results(0U, res);
+    t0 = hw_model_host_ns();
+    for (uint32_t n = 0U; n < vectors; n++)
+    {
+        buck1_scheduled_adc_callback();
+    }
+    dut_ns = hw_model_host_ns() - t0;
+
+    printf("prot_check mode=%s vectors=%u trips=%u mismatches=%u mode_divergence=%u host_ns_per_call=%.1f\n",
+           BUCK_PROT_FIXED_POINT ? "fixed" : "float", vectors, trips, mismatches, divergence,
+           (double)dut_ns / (double)vectors);
+    return mismatches;
+}
+
+/*******************************************************************************
+* Function Name: isr_cost_report
+********************************************************************************
+* Summary:
+* Prints the host time of the control ISR and scheduled ADC callbacks of each
+* converter in its state at the end of the scenario.
+*
+*******************************************************************************/
+static void isr_cost_report(uint32_t calls)
+{
+    for (unsigned int conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        double ctrl_ns;
+        double sched_ns;
+
+        conv_model_isr_cost(conv, calls, &ctrl_ns, &sched_ns);
+        printf("isr_cost conv=%s state=%s phases=%u calls=%u ctrl_ns=%.1f sched_ns=%.1f\n", buck_conv_hw[conv].name,
+               state_names[buck_conv[conv].state], BUCK_CONV_PHASES, calls, ctrl_ns, sched_ns);
+    }
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs the scenario and prints a summary. The exit code is the number of
+* failed expectations (2 on a usage or assertion error).
+*
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+    const char *scenario = NULL;
+    const char *trace_path = NULL;
+    const char *uart_path = NULL;
+    const char *retain_path = NULL;
+    bool output_timing = false;
+    uint64_t output_ns = 0U;
+    uint64_t output_write_ns = 0U;
+    uint64_t output_writes = 0U;
+    uint64_t passes = 0U;
+    FILE *trace = NULL;
+    uint32_t decimation = 30U;
+    bool quiet = false;
+    uint32_t next_stim = 0U;
+    uint32_t next_expect = 0U;
+    plant_phase_input_t in[PLANT_PHASE_MAX];
+    const uint32_t pwm[PLANT_PHASE_MAX] = { PWM_BUCK_1_NUM, PWM_BUCK_2_NUM };
+    bool inputs_valid = false;
+    uint32_t hw_changes = 0U;
+    double g_load[PLANT_OUTPUT_MAX] = { 0.0, 0.0 };
+    uint64_t wall_start;
+    uint64_t wall_ns;
+    Ifx_buck_states last_state;
+    double vout_min = 1.0e9;
+    double vout_max = 0.0;
+    double il_max = 0.0;
+    uint32_t isr_calls = 0U;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((0 == strcmp(argv[i], "-s")) && ((i + 1) < argc))
+        {
+            scenario = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-t")) && ((i + 1) < argc))
+        {
+            trace_path = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-u")) && ((i + 1) < argc))
+        {
+            uart_path = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-r")) && ((i + 1) < argc))
+        {
+            retain_path = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "-d")) && ((i + 1) < argc))
+        {
+            decimation = (uint32_t)strtoul(argv[++i], NULL, 0);
+            decimation = (decimation == 0U) ? 1U : decimation;
+        }
+        else if ((0 == strcmp(argv[i], "-p")) && ((i + 1) < argc))
+        {
+            return (0U == prot_check((uint32_t)strtoul(argv[++i], NULL, 0))) ? 0 : 1;
+        }
+        else if ((0 == strcmp(argv[i], "-i")) && ((i + 1) < argc))
+        {
+            isr_calls = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if (0 == strcmp(argv[i], "-o"))
+        {
+            output_timing = true;
+        }
+        else if (0 == strcmp(argv[i], "-q"))
+        {
+            quiet = true;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-s scenario.scn] [-t trace.csv] [-d decimation] [-u uart.bin] [-r retained.bin] [-i calls] [-o] [-q] | -p vectors\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (!scn_load(scenario))
+    {
+        return 2;
+    }
+    if (NULL != trace_path)
+    {
+        trace = fopen(trace_path, "w");
+        if (NULL == trace)
+        {
+            fprintf(stderr, "cannot open %s\n", trace_path);
+            return 2;
+        }
+        fprintf(trace, "time,state,vout,il1,il2,iload,vin,temp,res,ref,out,phases,p_loss\n");
+    }
+    if (NULL != uart_path)
+    {
+        sim_uart_out = fopen(uart_path, "wb");
+        if (NULL == sim_uart_out)
+        {
+            fprintf(stderr, "cannot open %s\n", uart_path);
+            return 2;
+        }
+    }
+
+    if (NULL != retain_path)
+    {
+        FILE *f = fopen(retain_path, "rb");
+
+        /* A missing file is a power on, the store is cleared. */
+        if ((NULL == f) || (1U != fread(&flight_rec_store, sizeof(flight_rec_store), 1U, f)))
+        {
+            memset(&flight_rec_store, 0xA5, sizeof(flight_rec_store));
+        }
+        if (NULL != f)
+        {
+            fclose(f);
+        }
+    }
+
+    hw_model_reset();
+    plant_init(&sim_plant);
+    sim_app_init();
+    last_state = buck_conv[BUCK_CONV_PRIMARY].state;
+    log_transitions[log_count++] = (transition_t){ 0.0, last_state };
+
+    wall_start = hw_model_host_ns();
+    while (sim_time < scn_end_time)
+    {
+        /* Stimuli are applied before the period, expectations are checked
+         * after it so that they see the reaction to a stimulus at the same
+         * time stamp. */
+        while (scn_events[next_stim].t <= sim_time)
+        {
+            if (!scn_is_expect(&scn_events[next_stim]))
+            {
+                scn_execute(&scn_events[next_stim]);
+                inputs_valid = false;
+            }
+            next_stim++;
+        }
+
+        /* The peak current references of the period were written in the
+         * last one, before the control ISR writes those of the next. */
+        hw_model_step();
+        in[0].i_peak = conv_model_peak_current(0U) * sim_plant.inv_k_sense[0];
+        in[1].i_peak = conv_model_peak_current(1U) * sim_plant.inv_k_sense[1];
+        conv_model_ctrl_isr();
+        conv_model_service();
+        hw_model_service_irqs();
+
+        /* The PWM and load settings only change on peripheral writes. */
+        if ((!inputs_valid) || (hw_changes != sim_hw_changes))
+        {
+            for (unsigned int ph = 0U; ph < PLANT_PHASE_MAX; ph++)
+            {
+                in[ph].d_max  = (double)hw_model_pwm_compare(pwm[ph]) / (double)hw_model_pwm_period(pwm[ph]);
+                in[ph].active = conv_model_phase_enabled(ph) && hw_model_pwm_running(pwm[ph]) &&
+                                (in[ph].d_max > 0.0);
+            }
+            load_conductance(g_load);
+            hw_changes = sim_hw_changes;
+            inputs_valid = true;
+        }
+        plant_step(&sim_plant, in, g_load);
+
+        while (scn_events[next_expect].t <= sim_time)
+        {
+            if (scn_is_expect(&scn_events[next_expect]))
+            {
+                scn_execute(&scn_events[next_expect]);
+            }
+            next_expect++;
+        }
+
+        /* One pass of the main loop every SIM_MAIN_LOOP_PERIODS periods, and
+         * at the end of a period in which a command line was completed, so
+         * that commands see the latency of a main loop that polls without
+         * pause. The UART sends in the background. With -o the host time of
+         * the passes is measured, separately for those that wrote output. */
+        if ((0U == (sim_step % SIM_MAIN_LOOP_PERIODS)) || (uart_cmd.tail != uart_cmd.head))
+        {
+            passes++;
+            hw_model_main_loop();
+            if (output_timing)
+            {
+                uint32_t written = uart_tx.sent + uart_tx.len;
+                uint64_t t0 = hw_model_host_ns();
+                uint64_t dt;
+
+                status_update();
+                uart_cmd_process();
+                thermal_process();
+                uart_tx_service();
+                dt = hw_model_host_ns() - t0;
+                output_ns += dt;
+                if ((uart_tx.sent + uart_tx.len) != written)
+                {
+                    output_write_ns += dt;
+                    output_writes++;
+                }
+            }
+            else
+            {
+                status_update();
+                uart_cmd_process();
+                thermal_process();
+                uart_tx_service();
+            }
+        }
+
+        if (buck_conv[BUCK_CONV_PRIMARY].state != last_state)
+        {
+            last_state = buck_conv[BUCK_CONV_PRIMARY].state;
+            if (last_state == Ifx_BUCK_STATE_FAULT)
+            {
+                trip_t = sim_time;
+                trip_from = trip_stim;
+                trip_stim = -1.0;
+                trip_cause = flight_rec_store.rec[(flight_rec_store.next + FLIGHT_REC_RECORDS - 1U) %
+                                                  FLIGHT_REC_RECORDS].cause;
+            }
+            if (log_count < LOG_MAX_TRANSITIONS)
+            {
+                log_transitions[log_count++] = (transition_t){ sim_time, last_state };
+            }
+        }
+        fault_inject_monitor();
+        if ((last_state == Ifx_BUCK_STATE_RUN) || (last_state == Ifx_BUCK_STATE_TEST))
+        {
+            vout_min = (sim_plant.vout < vout_min) ? sim_plant.vout : vout_min;
+            vout_max = (sim_plant.vout > vout_max) ? sim_plant.vout : vout_max;
+        }
+        for (unsigned int ph = 0U; ph < PLANT_PHASE_MAX; ph++)
+        {
+            il_max = (sim_plant.il_peak[ph] > il_max) ? sim_plant.il_peak[ph] : il_max;
+        }
+        if (tr_active)
+        {
+            tr_min = (sim_plant.vout < tr_min) ? sim_plant.vout : tr_min;
+            tr_max = (sim_plant.vout > tr_max) ? sim_plant.vout : tr_max;
+            if (fabs(sim_plant.vout - tr_vref) > tr_band)
+            {
+                tr_last_out = sim_time;
+            }
+        }
+        if (meas_active)
+        {
+            meas_e_out  += sim_plant.vout * sim_plant.iload * SIM_DT;
+            meas_e_loss += sim_plant.p_loss * SIM_DT;
+        }
+
+        if ((NULL != trace) && (0U == (sim_step % decimation)))
+        {
+            fprintf(trace, "%.7f,%d,%.4f,%.4f,%.4f,%.4f,%.3f,%.2f,%u,%u,%u,%u,%.4f\n", sim_time, (int)last_state,
+                    sim_plant.vout, sim_plant.il_avg[0], sim_plant.il_avg[1], sim_plant.iload,
+                    sim_plant.vin, sim_plant.temp, (unsigned int)BUCK1_ctx.res,
+                    (unsigned int)BUCK1_ctx.ref, (unsigned int)BUCK1_ctx.out, phase_shed.phases,
+                    sim_plant.p_loss);
+        }
+
+        sim_step++;
+        sim_time = (double)sim_step * SIM_DT;
+    }
+    wall_ns = hw_model_host_ns() - wall_start;
+
+    while (next_expect < scn_count)
+    {
+        if (scn_is_expect(&scn_events[next_expect]))
+        {
+            scn_execute(&scn_events[next_expect]);
+        }
+        next_expect++;
+    }
+    transient_report();
+    trip_report();
+    inject_report();
+    fra_compare();
+    autotune_compare();
+    for (unsigned int dir = 0U; dir < (unsigned int)LOAD_STEP_DIRS; dir++)
+    {
+        const load_step_stats_t *st = &load_step.stats[dir];
+
+        if (st->count > 0U)
+        {
+            printf("load_step dir=%s count=%u peak_mv=%.1f worst_mv=%.1f settling_us=%.0f settling_max_us=%.0f "
+                   "recovery_us=%.0f unsettled=%u\n", (dir == LOAD_STEP_UP) ? "up" : "down", st->count,
+                   step_peak_mv((load_step_dir_t)dir), st->peak_worst * LOAD_STEP_VOLT_PER_COUNT * 1.0e3,
+                   step_settling_us((load_step_dir_t)dir), st->settling_max * SIM_DT * 1.0e6,
+                   (double)st->recovery_sum / (double)st->count * SIM_DT * 1.0e6, st->unsettled);
+        }
+    }
+    if (soft_start[0].periods > 0U)
+    {
+        printf("soft_start profile=%d time_ms=%u regulation_ms=%.2f inrush_a=%.2f held_steps=%u\n",
+               (int)soft_start[0].profile, soft_start[0].time_ms, soft_start_ms(), soft_start_inrush(),
+               soft_start[0].hold_steps);
+    }
+    if (isr_calls > 0U)
+    {
+        isr_cost_report(isr_calls);
+    }
+    printf("uart bytes=%llu busy=%.3f sent=%u dropped=%u dropped_bytes=%u", (unsigned long long)sim_uart_bytes,
+           (double)sim_uart_bytes * 10.0 / SIM_UART_BAUD / sim_time, uart_tx.sent, uart_tx.dropped,
+           uart_tx.dropped_bytes);
+    if (output_timing)
+    {
+        printf(" passes=%llu host_ms=%.2f writes=%llu write_ms=%.2f ns_per_write=%.0f", (unsigned long long)passes,
+               (double)output_ns / 1.0e6, (unsigned long long)output_writes, (double)output_write_ns / 1.0e6,
+               (output_writes > 0U) ? ((double)output_write_ns / (double)output_writes) : 0.0);
+    }
+    printf("\n");
+    if ((uart_cmd.executed + uart_cmd.rejected) > 0U)
+    {
+        printf("cmd executed=%u rejected=%u lost=%u rx_overruns=%u latency_max_us=%.1f latency_mean_us=%.1f\n",
+               uart_cmd.executed, uart_cmd.rejected, uart_cmd.overflows + uart_cmd.too_long,
+               hw_model_uart_rx_overruns(), cmd_latency_us(),
+               (double)uart_cmd.latency_sum * 1.0e6 / SIM_CPU_CLK_HZ /
+               (double)(uart_cmd.executed + uart_cmd.rejected));
+    }
+    if (energy.windows > 0U)
+    {
+        energy_result_t r;
+
+        energy_result(&r);
+        printf("energy windows=%u p_out=%.3f p_in=%.3f efficiency=%.4f plant_efficiency=%.4f e_out_wh=%.5f "
+               "e_in_wh=%.5f vout_rms=%.3f iout_min=%.3f iout_rms=%.3f iout_max=%.3f\n",
+               r.windows, r.p_out, r.p_in, r.efficiency, efficiency(), r.e_out, r.e_in, r.vout_rms,
+               r.iout_min, r.iout_rms, r.iout_max);
+    }
+    if (thermal.conv[BUCK_CONV_PRIMARY].activations > 0U)
+    {
+        printf("thermal activations=%u derated=%u temp=%.2f limit_a=%.3f\n",
+               thermal.conv[BUCK_CONV_PRIMARY].activations, thermal.conv[BUCK_CONV_PRIMARY].active ? 1U : 0U,
+               sim_plant.temp, (double)thermal_limit_a(BUCK_CONV_PRIMARY));
+    }
+    if (setpoint[BUCK_CONV_PRIMARY].transitions > 0U)
+    {
+        printf("setpoint transitions=%u vout_mv=%.0f transition_ms=%.2f overshoot_mv=%.1f\n",
+               setpoint[BUCK_CONV_PRIMARY].transitions,
+               (double)BUCK1_ctx.targ * 1000.0 / (double)SETPOINT_COUNTS_PER_V,
+               (double)setpoint_transition_ms(BUCK_CONV_PRIMARY), (double)setpoint_overshoot_mv(BUCK_CONV_PRIMARY));
+    }
+
+    if (!quiet)
+    {
+        for (uint32_t i = 0U; i < log_count; i++)
+        {
+            printf("transition t=%.4f state=%s\n", log_transitions[i].t, state_names[log_transitions[i].state]);
+        }
+    }
+    printf("summary scenario=%s sim_time=%.3f steps=%llu wall_ms=%.1f speedup=%.0f ns_per_step=%.1f "
+           "vout_min=%.3f vout_max=%.3f il_peak_max=%.3f efficiency=%.4f p_loss=%.4f failures=%u\n",
+           (NULL != scenario) ? scenario : "builtin", sim_time, (unsigned long long)sim_step,
+           (double)wall_ns / 1.0e6, sim_time / ((double)wall_ns / 1.0e9), (double)wall_ns / (double)sim_step,
+           (vout_min > vout_max) ? 0.0 : vout_min, vout_max, il_max, efficiency(),
+           meas_active ? (meas_e_loss / (sim_time - meas_start)) : 0.0, scn_failures);
+
+    if (NULL != trace)
+    {
+        fclose(trace);
+    }
+    if (NULL != sim_uart_out)
+    {
+        fclose(sim_uart_out);
+    }
+    if (NULL != retain_path)
+    {
+        FILE *f = fopen(retain_path, "wb");
+
+        if ((NULL == f) || (1U != fwrite(&flight_rec_store, sizeof(flight_rec_store), 1U, f)))
+        {
+            fprintf(stderr, "cannot write %s\n", retain_path);
+            scn_failures++;
+        }
+        if (NULL != f)
+        {
+            fclose(f);
+        }
+    }
+    return (int)scn_failures;
+}
+
+/* [] END OF FILE */
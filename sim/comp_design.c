@@ -0,0 +1,197 @@
+/*******************************************************************************
+* File Name: comp_design.c
+*
+* Description:
+* Type-II (2P2Z) voltage compensator design for the peak current mode buck.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <complex.h>
+#include <math.h>
+#include "comp_design.h"
+#include "sim_config.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PI                      (3.14159265358979323846)
+#define DEG_PER_RAD             (180.0 / PI)
+
+/*******************************************************************************
+* Function Name: plant_response
+********************************************************************************
+* Summary:
+* Frequency response from the peak current DAC value to the output voltage ADC
+* result, including the loop delay.
+*
+*******************************************************************************/
+static double complex plant_response(const comp_design_in_t *in, double f)
+{
+    const double w = 2.0 * PI * f;
+    const double complex zc = in->esr + (1.0 / (I * w * in->c));
+    const double complex zout = (in->r_load * zc) / (in->r_load + zc);
+
+    return in->phases * in->k_dac * zout * in->k_adc * cexp(-I * w * in->delay / in->f_sw);
+}
+
+/*******************************************************************************
+* Function Name: comp_response
+********************************************************************************
+* Summary:
+* Frequency response of the discrete 2P2Z compensator.
+*
+*******************************************************************************/
+static double complex comp_response(const comp_design_in_t *in, const comp_coef_t *coef, double f)
+{
+    const double complex z1 = cexp(-I * 2.0 * PI * f / in->f_sw);
+    const double complex z2 = z1 * z1;
+
+    return (coef->b0 + (coef->b1 * z1) + (coef->b2 * z2)) / (1.0 - (coef->a1 * z1) - (coef->a2 * z2));
+}
+
+/*******************************************************************************
+* Function Name: comp_design_default
+********************************************************************************
+* Summary:
+* Fills the design inputs from the design.modus parameters in sim_config.h.
+*
+* Parameters:
+*  in: design inputs
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void comp_design_default(comp_design_in_t *in)
+{
+    in->c      = SIM_C0_CAPACITANCE;
+    in->esr    = SIM_C0_ESR;
+    in->r_load = SIM_VOUT_NOM / SIM_IOUT_NOM;
+    in->phases = (double)SIM_PHASE_NUM;
+    in->f_sw   = SIM_SWITCHING_FREQ;
+    in->delay  = SIM_TIME_DELAY;
+    in->f_c    = SIM_CROSSOVER_FREQ;
+    in->pm     = SIM_PHASE_MARGIN;
+    in->k_adc  = SIM_GAIN_VOUT * SIM_ADC_MAX_COUNT / SIM_ADC_REF;
+    in->k_dac  = SIM_ADC_REF / SIM_DAC_MAX_COUNT / SIM_CUR_SENSE_GAIN;
+}
+
+/*******************************************************************************
+* Function Name: comp_design_2p2z
+********************************************************************************
+* Summary:
+* Designs the integrator plus zero/pole pair (K-factor method) that places the
+* crossover at in->f_c with phase margin in->pm, and discretizes it with the
+* bilinear transform.
+*
+* Parameters:
+*  in:   design inputs
+*  coef: resulting coefficients
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void comp_design_2p2z(const comp_design_in_t *in, comp_coef_t *coef)
+{
+    const double wc = 2.0 * PI * in->f_c;
+    const double k = 2.0 * in->f_sw;
+    double boost;
+    double kf;
+    double wz;
+    double wp;
+    double gain;
+    double n1;
+    double n0;
+    double a0;
+    double complex c_shape;
+
+    /* Phase the compensator must add on top of the -90 degree integrator. */
+    boost = (-180.0 + in->pm) - (carg(plant_response(in, in->f_c)) * DEG_PER_RAD) + 90.0;
+    if (boost < 1.0)
+    {
+        boost = 1.0;
+    }
+    if (boost > 85.0)
+    {
+        boost = 85.0;
+    }
+    kf = tan((45.0 + (boost / 2.0)) / DEG_PER_RAD);
+    wz = wc / kf;
+    wp = wc * kf;
+
+    /* C(s) = gain * (1 + s/wz) / (s * (1 + s/wp)), gain sets |L(jwc)| = 1. */
+    c_shape = (1.0 + (I * wc / wz)) / ((I * wc) * (1.0 + (I * wc / wp)));
+    gain = 1.0 / cabs(plant_response(in, in->f_c) * c_shape);
+
+    /* Numerator n1*s + n0, denominator s^2 + wp*s, both scaled by wp. */
+    n1 = gain * wp / wz;
+    n0 = gain * wp;
+    a0 = (k * k) + (wp * k);
+
+    coef->b0 = ((n1 * k) + n0) / a0;
+    coef->b1 = (2.0 * n0) / a0;
+    coef->b2 = (n0 - (n1 * k)) / a0;
+    coef->a1 = (2.0 * k * k) / a0;
+    coef->a2 = -((k * k) - (wp * k)) / a0;
+}
+
+/*******************************************************************************
+* Function Name: comp_loop_gain
+********************************************************************************
+* Summary:
+* Evaluates the open loop gain of the modelled plant with the given discrete
+* compensator.
+*
+* Parameters:
+*  in:        design inputs describing the plant
+*  coef:      compensator coefficients
+*  f:         frequency, Hz
+*  mag:       loop gain magnitude (linear)
+*  phase_deg: loop gain phase, degrees
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void comp_loop_gain(const comp_design_in_t *in, const comp_coef_t *coef, double f,
+                    double *mag, double *phase_deg)
+{
+    const double complex l = plant_response(in, f) * comp_response(in, coef, f);
+
+    *mag = cabs(l);
+    *phase_deg = carg(l) * DEG_PER_RAD;
+}
+
+/* [] END OF FILE */
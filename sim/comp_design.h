@@ -0,0 +1,84 @@
+/*******************************************************************************
+* File Name: comp_design.h
+*
+* Description:
+* Type-II (2P2Z) voltage compensator design for the peak current mode buck.
+* Reproduces the PCC tool flow on the host: the plant is modelled as the output
+* impedance driven by a current source, the compensator places a zero and a
+* pole around the crossover frequency to meet the phase margin, and the result
+* is discretized with the bilinear transform.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef COMP_DESIGN_H
+#define COMP_DESIGN_H
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Design inputs. Gains describe the digital loop in ADC and DAC counts. */
+typedef struct
+{
+    double c;                   /* Output capacitance, F. */
+    double esr;                 /* Output capacitor ESR, Ohm. */
+    double r_load;              /* Load resistance at the design point, Ohm. */
+    double phases;              /* Number of active phases. */
+    double f_sw;                /* Control loop frequency, Hz. */
+    double delay;               /* Loop delay in control periods. */
+    double f_c;                 /* Crossover frequency, Hz. */
+    double pm;                  /* Phase margin, degrees. */
+    double k_adc;               /* Output voltage feedback gain, counts/V. */
+    double k_dac;               /* Peak current per DAC count and phase, A. */
+} comp_design_in_t;
+
+/* Discrete 2P2Z coefficients: y = b0*x + b1*x1 + b2*x2 + a1*y1 + a2*y2. */
+typedef struct
+{
+    double b0;
+    double b1;
+    double b2;
+    double a1;
+    double a2;
+} comp_coef_t;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void comp_design_default(comp_design_in_t *in);
+void comp_design_2p2z(const comp_design_in_t *in, comp_coef_t *coef);
+void comp_loop_gain(const comp_design_in_t *in, const comp_coef_t *coef, double f,
+                    double *mag, double *phase_deg);
+
+#endif /* COMP_DESIGN_H */
+/* [] END OF FILE */
@@ -0,0 +1,564 @@
+/*******************************************************************************
+* File Name: conv_model.c
+*
+* Description:
+* Model of the PCC tool generated converter drivers (BUCK1, and BUCK2 in the
+* dual configuration of buck_conv.h): enable/start/ramp control, the 300 kHz
+* voltage control ISR with the 2P2Z compensator and the CSG peak current
+* reference, the hardware limit detection of the Vout and of the scheduled
+* channels and the scheduled ADC group with its callback. Each converter
+* drives its phases of the power stage model and regulates its output. The
+* application callbacks are taken from buck_protection.h just like in the
+* generated code. The results pass through the fault injection
+* (fault_inject.c) before the firmware and the limit detection see them.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <math.h>
+#include <string.h>
+#include "buck_protection.h"
+#include "comp_design.h"
+#include "sim.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define ADC_COUNTS(v, gain)     ((v) * ((gain) * (SIM_ADC_MAX_COUNT / SIM_ADC_REF)))
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* One generated converter driver */
+typedef struct
+{
+    mtb_stc_pwrconv_ctx_t *ctx;
+    unsigned int phase;             /* First power stage phase */
+    unsigned int phases;
+    const double *vout;             /* Regulated output of the power stage */
+    bool     enabled;
+    bool     vout_prot;
+    bool     sched_prot[4];         /* Vin, Iout1, Iout2, Temp limit detection */
+    bool     sched_pending;
+    uint16_t sched_res[4];          /* Vin, Iout1, Iout2, Temp */
+    uint16_t vout_min;              /* Generated limits */
+    uint16_t vout_max;
+    uint16_t vin_min;
+    uint16_t vin_max;
+    uint16_t iout_max;
+    uint16_t temp_max;
+} conv_model_t;
+
+/* Callbacks set in the solution of a converter */
+typedef struct
+{
+    void   (*pre_process)(void);
+    void   (*post_process)(void);
+    void   (*fault)(void);
+    void   (*scheduled)(void);
+} conv_callbacks_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+mtb_stc_pwrconv_ctx_t BUCK1_ctx;
+#if (BUCK_CONV_NUM > 1U)
+mtb_stc_pwrconv_ctx_t BUCK2_ctx;
+#endif
+
+static conv_model_t conv_model[BUCK_CONV_NUM];
+/* Constant, so that the loops over the converters call the callbacks directly
+ * and the optimizer can inline them. */
+static const conv_callbacks_t conv_callbacks[BUCK_CONV_NUM] =
+{
+    { buck1_pre_process_callback, buck1_post_process_callback, buck1_fault_callback, buck1_scheduled_adc_callback },
+#if (BUCK_CONV_NUM > 1U)
+    { buck2_pre_process_callback, buck2_post_process_callback, buck2_fault_callback, buck2_scheduled_adc_callback },
+#endif
+};
+static double   conv_adc_noise;
+static uint32_t conv_noise_state = 0x12345678UL;
+static double   conv_csg_dac[4];        /* CSG slice DAC registers, A. */
+static const uint8_t  conv_csg_slice[PLANT_PHASE_MAX] = { SIM_CSG_SLICE_1, SIM_CSG_SLICE_2 };
+static const uint32_t conv_pwm[PLANT_PHASE_MAX] = { PWM_BUCK_1_NUM, PWM_BUCK_2_NUM };
+
+/*******************************************************************************
+* Function Name: adc_convert
+********************************************************************************
+* Summary:
+* Converts an analog value to a 12-bit ADC result with optional noise.
+*
+*******************************************************************************/
+static uint16_t adc_convert(double counts)
+{
+    if (conv_adc_noise > 0.0)
+    {
+        /* Sum of four uniform variates approximates a Gaussian, scaled to
+         * sigma = 1. */
+        double n = -2.0;
+        for (int i = 0; i < 4; i++)
+        {
+            conv_noise_state ^= conv_noise_state << 13;
+            conv_noise_state ^= conv_noise_state >> 17;
+            conv_noise_state ^= conv_noise_state << 5;
+            n += (double)conv_noise_state * (1.0 / 4294967296.0);
+        }
+        counts += n * (1.7320508075688772 * conv_adc_noise);
+    }
+    if (counts < 0.0)
+    {
+        counts = 0.0;
+    }
+    if (counts > SIM_ADC_MAX_COUNT)
+    {
+        counts = SIM_ADC_MAX_COUNT;
+    }
+    return (uint16_t)(counts + 0.5);
+}
+
+/*******************************************************************************
+* Function Name: conv_init
+********************************************************************************
+* Summary:
+* Initializes the context of one converter and designs its 2P2Z compensator
+* from the design.modus parameters (crossover frequency and phase margin) for
+* its phases and its share of the output capacitance.
+*
+*******************************************************************************/
+static void conv_init(conv_model_t *m, mtb_stc_pwrconv_ctx_t *ctx, unsigned int phase, unsigned int phases)
+{
+    comp_design_in_t in;
+    comp_coef_t coef;
+
+    comp_design_default(&in);
+    in.phases = (double)phases;
+    in.c      /= (double)SIM_OUTPUTS;
+    in.esr    *= (double)SIM_OUTPUTS;
+    in.r_load *= (double)SIM_OUTPUTS;
+    comp_design_2p2z(&in, &coef);
+
+    memset(m, 0, sizeof(*m));
+    m->ctx    = ctx;
+    m->phase  = phase;
+    m->phases = phases;
+    m->vout   = ((SIM_OUTPUTS > 1U) && (phase > 0U)) ? &sim_plant.vout2 : &sim_plant.vout;
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->targ = (uint32_t)floor(ADC_COUNTS(SIM_VOUT_NOM, SIM_GAIN_VOUT) + 0.5);
+    ctx->rampStep = ctx->targ / SIM_RAMP_CALLS;
+    ctx->ctrl.b0 = (float32_t)coef.b0;
+    ctx->ctrl.b1 = (float32_t)coef.b1;
+    ctx->ctrl.b2 = (float32_t)coef.b2;
+    ctx->ctrl.a1 = (float32_t)coef.a1;
+    ctx->ctrl.a2 = (float32_t)coef.a2;
+    ctx->ctrl.min = 0.0f;
+    ctx->ctrl.max = (float32_t)SIM_DAC_MAX_COUNT;
+}
+
+/*******************************************************************************
+* Function Name: conv_model_init
+********************************************************************************
+* Summary:
+* Initializes the converters of the configuration: BUCK1 on both phases, on
+* phase 1 only, or BUCK1 on phase 1 and BUCK2 on phase 2.
+*
+*******************************************************************************/
+void conv_model_init(void)
+{
+    conv_model_t *m = &conv_model[0];
+
+    conv_init(m, &BUCK1_ctx, 0U, BUCK_CONV_PHASES);
+    m->vout_min = BUCK1_Vout_MIN;
+    m->vout_max = BUCK1_Vout_MAX;
+    m->vin_min  = BUCK1_Vin_MIN;
+    m->vin_max  = BUCK1_Vin_MAX;
+    m->iout_max = BUCK1_Iout1_MAX;
+    m->temp_max = BUCK1_Temp_MAX;
+
+#if (BUCK_CONV_NUM > 1U)
+    m = &conv_model[1];
+    conv_init(m, &BUCK2_ctx, 1U, 1U);
+    m->vout_min = BUCK2_Vout_MIN;
+    m->vout_max = BUCK2_Vout_MAX;
+    m->vin_min  = BUCK2_Vin_MIN;
+    m->vin_max  = BUCK2_Vin_MAX;
+    m->iout_max = BUCK2_Iout1_MAX;
+    m->temp_max = BUCK2_Temp_MAX;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: conv_model_set_adc_noise
+********************************************************************************
+* Summary:
+* Sets the standard deviation of the ADC noise in LSB.
+*
+*******************************************************************************/
+void conv_model_set_adc_noise(double lsb)
+{
+    conv_adc_noise = lsb;
+}
+
+/*******************************************************************************
+* Function Name: conv_model_phase_enabled
+********************************************************************************
+* Summary:
+* Returns true when the converter of a power stage phase is enabled and
+* switches the phase.
+*
+*******************************************************************************/
+bool conv_model_phase_enabled(unsigned int phase)
+{
+    for (unsigned int i = 0U; i < BUCK_CONV_NUM; i++)
+    {
+        const conv_model_t *m = &conv_model[i];
+
+        if ((phase >= m->phase) && (phase < (m->phase + m->phases)))
+        {
+            return m->enabled;
+        }
+    }
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: conv_model_enabled
+********************************************************************************
+* Summary:
+* Returns true while a converter is enabled, from its enable until the disable
+* that stops its PWMs.
+*
+*******************************************************************************/
+bool conv_model_enabled(unsigned int conv)
+{
+    return conv_model[conv].enabled;
+}
+
+/*******************************************************************************
+* Function Name: conv_model_peak_current
+********************************************************************************
+* Summary:
+* Returns the peak current reference of a phase in amperes, as set by the CSG
+* DAC from the compensator output. The output computed from the sample taken at
+* the start of period k is applied in period k + 1, which together with the
+* sampling gives the TimeDelay of two periods assumed by the design. Read before
+* the control ISR of the period, the DAC buffer register still holds the value
+* written in the last period, which the DAC takes over at the start of this one.
+*
+*******************************************************************************/
+double conv_model_peak_current(unsigned int phase)
+{
+    return conv_csg_dac[conv_csg_slice[phase]];
+}
+
+/*******************************************************************************
+* Function Name: Cy_HPPASS_DAC_SetValue
+********************************************************************************
+* Summary:
+* Writes the DAC buffer register of a CSG slice, kept as the peak current
+* reference it sets. The value is taken over at the start of the next switching
+* period.
+*
+*******************************************************************************/
+void Cy_HPPASS_DAC_SetValue(uint8_t dacIdx, uint16_t value)
+{
+    conv_csg_dac[dacIdx & 3U] = (double)value * (SIM_ADC_REF / SIM_DAC_MAX_COUNT / SIM_CUR_SENSE_GAIN);
+}
+
+/*******************************************************************************
+* Function Name: conv_model_set_sched_results
+********************************************************************************
+* Summary:
+* Overrides the scheduled ADC results (Vin, Iout1, Iout2, Temp) of a converter
+* returned by the generated getters, used to drive the protection callback
+* directly.
+*
+*******************************************************************************/
+void conv_model_set_sched_results(unsigned int conv, const uint16_t res[4])
+{
+    memcpy(conv_model[conv].sched_res, res, sizeof(conv_model[conv].sched_res));
+}
+
+/*******************************************************************************
+* Function Name: conv_ctrl_isr
+********************************************************************************
+* Summary:
+* Voltage control loop ISR of one converter. The output voltage result is
+* moved to ctx.res (DMA_BUCK1_PROT), the 2P2Z compensator computes the new peak
+* current reference and writes it to the DACs of the CSG slices of its phases,
+* and the limit detection checks the result against the Vout window. The pre-
+* and post-process callbacks run around the compensator. The DAC values are
+* taken over by the phases at the start of the next period.
+*
+*******************************************************************************/
+static void conv_ctrl_isr(unsigned int conv)
+{
+    conv_model_t *m = &conv_model[conv];
+    const conv_callbacks_t *cb = &conv_callbacks[conv];
+    mtb_stc_pwrconv_ctx_t *ctx = m->ctx;
+    mtb_stc_pwrconv_ctrl_2p2z_t *c = &ctx->ctrl;
+    uint32_t out;
+
+    cb->pre_process();
+
+    ctx->res = fault_inject_apply(conv, FAULT_CH_VOUT,
+                                  adc_convert(ADC_COUNTS(*m->vout, SIM_GAIN_VOUT)), m->vout_min, m->vout_max);
+
+    if (0UL != (ctx->state & MTB_PWRCONV_STATE_RUN))
+    {
+        float32_t x = (float32_t)ctx->ref - (float32_t)ctx->res;
+        float32_t y = (c->b0 * x) + (c->b1 * c->x1) + (c->b2 * c->x2) + (c->a1 * c->y1) + (c->a2 * c->y2);
+
+        if (y > c->max)
+        {
+            y = c->max;
+        }
+        if (y < c->min)
+        {
+            y = c->min;
+        }
+        c->x2 = c->x1;
+        c->x1 = x;
+        c->y2 = c->y1;
+        c->y1 = y;
+        ctx->out = (uint32_t)y;
+    }
+
+    /* Written from a register, not reloaded from ctx.out after the store. */
+    out = ctx->out;
+    for (unsigned int ph = m->phase; ph < (m->phase + m->phases); ph++)
+    {
+        Cy_HPPASS_DAC_SetValue(conv_csg_slice[ph], (uint16_t)out);
+    }
+
+    cb->post_process();
+
+    if (m->vout_prot && ((ctx->res > m->vout_max) || (ctx->res < m->vout_min)))
+    {
+        cb->fault();
+    }
+}
+
+/*******************************************************************************
+* Function Name: conv_model_ctrl_isr
+********************************************************************************
+* Summary:
+* Runs the control ISR of each enabled converter, executed once per control
+* period.
+*
+*******************************************************************************/
+void conv_model_ctrl_isr(void)
+{
+    for (unsigned int i = 0U; i < BUCK_CONV_NUM; i++)
+    {
+        if (conv_model[i].enabled)
+        {
+            conv_ctrl_isr(i);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: conv_model_service
+********************************************************************************
+* Summary:
+* Completes the pending scheduled ADC group conversions, checks the results of
+* the channels with limit detection against their window and runs the
+* scheduled callback from the scheduled ADC ISR of each converter. The limit
+* detection calls the protection callback first, like the Vout limit.
+*
+*******************************************************************************/
+void conv_model_service(void)
+{
+    for (unsigned int i = 0U; i < BUCK_CONV_NUM; i++)
+    {
+        conv_model_t *m = &conv_model[i];
+        bool trip = false;
+
+        if (!m->sched_pending)
+        {
+            continue;
+        }
+        m->sched_pending = false;
+
+        m->sched_res[0] = fault_inject_apply(i, FAULT_CH_VIN, adc_convert(ADC_COUNTS(sim_plant.vin, SIM_GAIN_VIN)),
+                                             m->vin_min, m->vin_max);
+        for (unsigned int ph = 0U; ph < m->phases; ph++)
+        {
+            m->sched_res[1U + ph] = fault_inject_apply(i, (fault_channel_t)(FAULT_CH_IOUT1 + ph),
+                                                       adc_convert(ADC_COUNTS(sim_plant.il_avg[m->phase + ph],
+                                                                              SIM_GAIN_IOUT)), 0U, m->iout_max);
+            trip = trip || (m->sched_prot[1U + ph] && (m->sched_res[1U + ph] > m->iout_max));
+        }
+        m->sched_res[3] = fault_inject_apply(i, FAULT_CH_TEMP,
+                                             adc_convert(ADC_COUNTS(SIM_TEMP_SENSE_OFFSET +
+                                                                    (SIM_TEMP_SENSE_SLOPE * sim_plant.temp),
+                                                                    SIM_GAIN_TEMP)), 0U, m->temp_max);
+
+        if (trip ||
+            (m->sched_prot[0] && ((m->sched_res[0] < m->vin_min) || (m->sched_res[0] > m->vin_max))) ||
+            (m->sched_prot[3] && (m->sched_res[3] > m->temp_max)))
+        {
+            conv_callbacks[i].fault();
+        }
+
+        conv_callbacks[i].scheduled();
+    }
+}
+
+/*******************************************************************************
+* Function Name: conv_model_isr_cost
+********************************************************************************
+* Summary:
+* Host time of the application part of the control ISR (pre- and post-process
+* callbacks) and of the scheduled ADC callback of a converter, averaged over
+* a number of calls in its present state. Each scheduled call is marked as a
+* soft start timer period, so the averaged tier runs as at 100 Hz.
+*
+*******************************************************************************/
+void conv_model_isr_cost(unsigned int conv, uint32_t calls, double *ctrl_ns, double *sched_ns)
+{
+    conv_model_t *m = &conv_model[conv];
+    const conv_callbacks_t *cb = &conv_callbacks[conv];
+    uint64_t t0;
+
+    t0 = hw_model_host_ns();
+    for (uint32_t n = 0U; n < calls; n++)
+    {
+        cb->pre_process();
+        cb->post_process();
+    }
+    *ctrl_ns = (double)(hw_model_host_ns() - t0) / (double)calls;
+    m->sched_pending = false;
+
+    t0 = hw_model_host_ns();
+    for (uint32_t n = 0U; n < calls; n++)
+    {
+        fast_prot_tick((uint8_t)conv);
+        cb->scheduled();
+    }
+    *sched_ns = (double)(hw_model_host_ns() - t0) / (double)calls;
+}
+
+/*******************************************************************************
+* Function Name: conv_enable / conv_disable / conv_start / conv_ramp
+********************************************************************************
+* Summary:
+* Generated converter control of one converter: the enable starts the PWMs of
+* its phases, the disable stops them together with all limit detection.
+*
+*******************************************************************************/
+static cy_rslt_t conv_enable(conv_model_t *m)
+{
+    memset(&m->ctx->ctrl.x1, 0, 4U * sizeof(float32_t));
+    m->ctx->out = 0U;
+    m->ctx->ref = 0U;
+    for (unsigned int ph = m->phase; ph < (m->phase + m->phases); ph++)
+    {
+        conv_csg_dac[conv_csg_slice[ph]] = 0.0;
+    }
+    m->enabled = true;
+    for (unsigned int ph = m->phase; ph < (m->phase + m->phases); ph++)
+    {
+        Cy_TCPWM_TriggerStart_Single(PWM_BUCK_1_HW, conv_pwm[ph]);
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t conv_disable(conv_model_t *m)
+{
+    for (unsigned int ph = m->phase; ph < (m->phase + m->phases); ph++)
+    {
+        Cy_TCPWM_TriggerStopOrKill_Single(PWM_BUCK_1_HW, conv_pwm[ph]);
+    }
+    m->enabled = false;
+    m->vout_prot = false;
+    memset(m->sched_prot, 0, sizeof(m->sched_prot));
+    m->ctx->state = 0UL;
+    m->ctx->out = 0U;
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t conv_start(conv_model_t *m)
+{
+    m->ctx->ref = 0U;
+    m->ctx->state = MTB_PWRCONV_STATE_RUN | MTB_PWRCONV_STATE_RAMP;
+    return CY_RSLT_SUCCESS;
+}
+
+static void conv_ramp(conv_model_t *m)
+{
+    mtb_stc_pwrconv_ctx_t *ctx = m->ctx;
+
+    if (0UL != (ctx->state & MTB_PWRCONV_STATE_RAMP))
+    {
+        ctx->ref += ctx->rampStep;
+        if (ctx->ref >= ctx->targ)
+        {
+            ctx->ref = ctx->targ;
+            ctx->state &= ~MTB_PWRCONV_STATE_RAMP;
+        }
+    }
+}
+
+/*******************************************************************************
+* Generated API of the solutions. Iout2 only exists in the two phase BUCK1.
+*******************************************************************************/
+#define CONV_MODEL_API(pcc, idx)                                                               \
+    cy_rslt_t pcc##_enable(void)            { return conv_enable(&conv_model[idx]); }         \
+    cy_rslt_t pcc##_disable(void)           { return conv_disable(&conv_model[idx]); }        \
+    cy_rslt_t pcc##_start(void)             { return conv_start(&conv_model[idx]); }          \
+    void pcc##_ramp(void)                   { conv_ramp(&conv_model[idx]); }                  \
+    uint32_t pcc##_get_state(uint32_t mask) { return pcc##_ctx.state & mask; }                \
+    void pcc##_Vout_prot_enable(void)       { conv_model[idx].vout_prot = true; }             \
+    void pcc##_Vout_prot_disable(void)      { conv_model[idx].vout_prot = false; }            \
+    void pcc##_Vin_prot_enable(void)        { conv_model[idx].sched_prot[0] = true; }         \
+    void pcc##_Vin_prot_disable(void)       { conv_model[idx].sched_prot[0] = false; }        \
+    void pcc##_Iout1_prot_enable(void)      { conv_model[idx].sched_prot[1] = true; }         \
+    void pcc##_Iout1_prot_disable(void)     { conv_model[idx].sched_prot[1] = false; }        \
+    void pcc##_Temp_prot_enable(void)       { conv_model[idx].sched_prot[3] = true; }         \
+    void pcc##_Temp_prot_disable(void)      { conv_model[idx].sched_prot[3] = false; }        \
+    void pcc##_scheduled_adc_trigger(void)  { conv_model[idx].sched_pending = true; }         \
+    uint16_t pcc##_Vin_get_result(void)     { return conv_model[idx].sched_res[0]; }          \
+    uint16_t pcc##_Iout1_get_result(void)   { return conv_model[idx].sched_res[1]; }          \
+    uint16_t pcc##_Temp_get_result(void)    { return conv_model[idx].sched_res[3]; }
+
+CONV_MODEL_API(BUCK1, 0U)
+void BUCK1_Iout2_prot_enable(void)          { conv_model[0].sched_prot[2] = true; }
+void BUCK1_Iout2_prot_disable(void)         { conv_model[0].sched_prot[2] = false; }
+uint16_t BUCK1_Iout2_get_result(void)       { return conv_model[0].sched_res[2]; }
+#if (BUCK_CONV_NUM > 1U)
+CONV_MODEL_API(BUCK2, 1U)
+#endif
+
+/* [] END OF FILE */
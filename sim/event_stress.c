@@ -0,0 +1,342 @@
+/*******************************************************************************
+* File Name: event_stress.c
+*
+* Description:
+* Host test of the event queue of the converter state machine (event_queue.h).
+* The first part fills, overflows and drains the queue over many rounds, with
+* the indices starting just below the 32-bit wrap. The second part posts
+* tagged events from several producer threads, which preempt each other at
+* any instruction like interrupts of different priorities, while one consumer
+* thread takes them. Every accepted event must be received exactly once and
+* in the order of its producer, and every rejected one must be counted as
+* dropped.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "event_queue.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PRODUCERS               (4U)
+#define EVENTS_DEFAULT          (200000U)
+#define EVENTS_MAX              (1UL << 24)
+
+/* Producer in the upper byte, sequence number in the lower 24 bits */
+#define EVENT(p, n)             (((uint32_t)(p) << 24) | (uint32_t)(n))
+#define EVENT_PRODUCER(e)       ((e) >> 24)
+#define EVENT_SEQ(e)            ((e) & 0xFFFFFFUL)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t  id;
+    uint32_t  events;
+    uint32_t  rejected;
+    uint8_t  *accepted;             /* Per sequence number, written by the producer */
+} producer_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static event_queue_t queue;
+static producer_t    producers[PRODUCERS];
+static _Atomic uint32_t producers_done;
+static _Thread_local uint32_t preempt_seed = 0x9E3779B9UL;
+static bool preempt_enable;
+
+/*******************************************************************************
+* Function Name: event_queue_preempt
+********************************************************************************
+* Summary:
+* Called by event_queue_post() between its steps (EVENT_QUEUE_TEST). Gives up
+* the processor at one in four calls, so that another producer posts between
+* the steps also on a single core host.
+*
+*******************************************************************************/
+void event_queue_preempt(void)
+{
+    preempt_seed ^= preempt_seed << 13;
+    preempt_seed ^= preempt_seed >> 17;
+    preempt_seed ^= preempt_seed << 5;
+    if (preempt_enable && ((preempt_seed & 3U) == 0U))
+    {
+        (void)sched_yield();
+    }
+}
+
+/*******************************************************************************
+* Function Name: check_single
+********************************************************************************
+* Summary:
+* Fills the queue from one thread until it rejects an event, then drains it
+* and checks the order, for a number of rounds with different fill levels.
+*
+* Return:
+*  uint32_t: number of errors
+*
+*******************************************************************************/
+static uint32_t check_single(void)
+{
+    const uint32_t base = 0U - (4U * EVENT_QUEUE_SIZE);
+    uint32_t errors = 0U;
+    uint32_t next = 0U;
+    uint32_t expect = 0U;
+    uint32_t dropped = 0U;
+    uint32_t data;
+
+    /* Starts the indices below the wrap, as after 2^32 - 64 events. */
+    event_queue_init(&queue);
+    for (uint32_t i = 0U; i < EVENT_QUEUE_SIZE; i++)
+    {
+        atomic_store(&queue.slot[i].seq, base + i);
+    }
+    atomic_store(&queue.head, base);
+    queue.tail = base;
+
+    for (uint32_t round = 0U; round < 1000U; round++)
+    {
+        uint32_t fill = (round % (EVENT_QUEUE_SIZE + 2U)) + 1U;
+
+        for (uint32_t i = 0U; i < fill; i++)
+        {
+            bool full = ((next - expect) >= EVENT_QUEUE_SIZE);
+
+            if (event_queue_post(&queue, next) == full)
+            {
+                errors++;
+            }
+            if (full)
+            {
+                dropped++;
+            }
+            else
+            {
+                next++;
+            }
+        }
+        while (event_queue_get(&queue, &data))
+        {
+            if (data != expect)
+            {
+                errors++;
+            }
+            expect++;
+        }
+        if (expect != next)
+        {
+            errors++;
+        }
+    }
+
+    if ((atomic_load(&queue.dropped) != dropped) || (queue.depth_max != EVENT_QUEUE_SIZE))
+    {
+        errors++;
+    }
+    printf("event_stress single rounds=1000 events=%u dropped=%u errors=%u\n", next, dropped, errors);
+    return errors;
+}
+
+/*******************************************************************************
+* Function Name: producer_thread
+********************************************************************************
+* Summary:
+* Posts the events of one producer as fast as possible, it only yields after a
+* rejected event so that the consumer catches up.
+*
+*******************************************************************************/
+static void *producer_thread(void *arg)
+{
+    producer_t *p = (producer_t *)arg;
+
+    for (uint32_t n = 0U; n < p->events; n++)
+    {
+        if (event_queue_post(&queue, EVENT(p->id, n)))
+        {
+            p->accepted[n] = 1U;
+        }
+        else
+        {
+            p->rejected++;
+            (void)sched_yield();
+        }
+    }
+    (void)atomic_fetch_add(&producers_done, 1U);
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: check_threads
+********************************************************************************
+* Summary:
+* Runs the producer threads against the consumer in the calling thread.
+*
+* Parameters:
+*  events: events of each producer
+*
+* Return:
+*  uint32_t: number of errors
+*
+*******************************************************************************/
+static uint32_t check_threads(uint32_t events)
+{
+    pthread_t threads[PRODUCERS];
+    uint8_t *received[PRODUCERS];
+    int64_t last[PRODUCERS];
+    uint64_t delivered = 0U;
+    uint64_t rejected = 0U;
+    uint32_t errors = 0U;
+    uint32_t data;
+
+    event_queue_init(&queue);
+    atomic_store(&producers_done, 0U);
+    preempt_enable = true;
+    for (uint32_t p = 0U; p < PRODUCERS; p++)
+    {
+        producers[p].id = p;
+        producers[p].events = events;
+        producers[p].rejected = 0U;
+        producers[p].accepted = calloc(events, 1U);
+        received[p] = calloc(events, 1U);
+        last[p] = -1;
+        if ((NULL == producers[p].accepted) || (NULL == received[p]))
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(2);
+        }
+    }
+    for (uint32_t p = 0U; p < PRODUCERS; p++)
+    {
+        if (0 != pthread_create(&threads[p], NULL, producer_thread, &producers[p]))
+        {
+            fprintf(stderr, "cannot create thread\n");
+            exit(2);
+        }
+    }
+
+    for (;;)
+    {
+        /* The producers may have finished after an empty poll. */
+        bool done = (atomic_load(&producers_done) == PRODUCERS);
+
+        if (event_queue_get(&queue, &data))
+        {
+            uint32_t p = EVENT_PRODUCER(data);
+            uint32_t n = EVENT_SEQ(data);
+
+            if ((p >= PRODUCERS) || (n >= events) || ((int64_t)n <= last[p]) || (0U != received[p][n]))
+            {
+                errors++;
+            }
+            else
+            {
+                received[p][n] = 1U;
+                last[p] = (int64_t)n;
+            }
+            delivered++;
+        }
+        else if (done)
+        {
+            break;
+        }
+        else
+        {
+            /* Queue empty, the producers are running. */
+            (void)sched_yield();
+        }
+    }
+
+    for (uint32_t p = 0U; p < PRODUCERS; p++)
+    {
+        (void)pthread_join(threads[p], NULL);
+        for (uint32_t n = 0U; n < events; n++)
+        {
+            if (producers[p].accepted[n] != received[p][n])
+            {
+                errors++;
+            }
+        }
+        rejected += producers[p].rejected;
+        free(producers[p].accepted);
+        free(received[p]);
+    }
+
+    if (((delivered + rejected) != ((uint64_t)events * PRODUCERS)) || (atomic_load(&queue.dropped) != rejected))
+    {
+        errors++;
+    }
+    printf("event_stress threads producers=%u posted=%llu delivered=%llu dropped=%llu depth_max=%u errors=%u\n",
+           PRODUCERS, (unsigned long long)events * PRODUCERS, (unsigned long long)delivered,
+           (unsigned long long)rejected, queue.depth_max, errors);
+    return errors;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Usage: event_stress [events per producer]. Returns 1 on any error.
+*
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+    uint32_t events = EVENTS_DEFAULT;
+    uint32_t errors;
+
+    if (argc > 1)
+    {
+        events = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+    if ((argc > 2) || (0U == events) || (events > EVENTS_MAX))
+    {
+        fprintf(stderr, "usage: %s [events per producer, 1..%lu]\n", argv[0], EVENTS_MAX);
+        return 2;
+    }
+
+    errors = check_single();
+    errors += check_threads(events);
+
+    return (0U == errors) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,415 @@
+/*******************************************************************************
+* File Name: fault_inject.c
+*
+* Description:
+* Fault injection on the results of the converter model. A scenario steps,
+* ramps or glitches the Vin, Iout1, Iout2 or Temp result returned by the
+* BUCKx_*_get_result() getters, or the Vout result of the control ISR and its
+* limit detection, at a chosen time. The injected value replaces the
+* conversion of the power stage model in every result the firmware reads,
+* so the fast hardware limits, the averaged protection and the Vout limits see
+* the same signal. For each injection, the time the injected signal leaves
+* the tightest window that one of the protection tiers checks, the time the
+* PWMs of the converter stop,
+* the result farthest outside the window before that, the excursion of the
+* output voltage and inductor current, the input energy from the crossing to
+* the stop and the sequence of converter states are recorded for the report
+* of buck_sim.c.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "buck_protection.h"
+#include "sim.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define FAULT_COUNTS_PER_V      (SIM_ADC_MAX_COUNT / SIM_ADC_REF)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Injection of one result channel */
+typedef struct
+{
+    fault_mode_t mode;
+    double       t0;                /* Start, s */
+    double       from;              /* Result at the start, counts */
+    double       to;                /* Injected value, counts */
+    double       duration;          /* Ramp or glitch duration, s */
+    double       last;              /* Last result of the model, counts */
+    uint16_t     lo;                /* Window of the hardware limit detection */
+    uint16_t     hi;
+    fault_inject_rec_t *rec;        /* Measurement, NULL when all records are used */
+} fault_inject_t;
+
+/* Sensing of a channel: counts = (offset + slope * value) * gain * 4095 / 3.3 */
+typedef struct
+{
+    const char *name;
+    double      gain;
+    double      offset;
+    double      slope;
+} fault_channel_info_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const fault_channel_info_t fault_channel_info[FAULT_CHANNELS] =
+{
+    { "vin",   SIM_GAIN_VIN,  0.0,                   1.0 },
+    { "iout1", SIM_GAIN_IOUT, 0.0,                   1.0 },
+    { "iout2", SIM_GAIN_IOUT, 0.0,                   1.0 },
+    { "temp",  SIM_GAIN_TEMP, SIM_TEMP_SENSE_OFFSET, SIM_TEMP_SENSE_SLOPE },
+    { "vout",  SIM_GAIN_VOUT, 0.0,                   1.0 },
+};
+
+static const char *const fault_mode_names[FAULT_MODES] = { "off", "step", "ramp", "glitch" };
+
+static fault_inject_t      fault_inj[BUCK_CONV_NUM][FAULT_CHANNELS];
+static fault_inject_rec_t  fault_rec[FAULT_INJECT_RECORDS];
+static uint32_t            fault_rec_count;
+static fault_inject_rec_t *fault_active[BUCK_CONV_NUM];  /* Injection measured on each converter */
+static bool                fault_enabled[BUCK_CONV_NUM]; /* Converter enabled in the last period */
+
+/*******************************************************************************
+* Function Name: fault_inject_channel / fault_inject_channel_name /
+*                fault_inject_mode_name
+********************************************************************************
+* Summary:
+* Converts between the channel names of the scenarios and fault_channel_t, -1
+* for an unknown name, and returns the name of an injection mode.
+*
+*******************************************************************************/
+int fault_inject_channel(const char *name)
+{
+    for (int ch = 0; ch < (int)FAULT_CHANNELS; ch++)
+    {
+        if (0 == strcmp(name, fault_channel_info[ch].name))
+        {
+            return ch;
+        }
+    }
+    return -1;
+}
+
+const char *fault_inject_channel_name(fault_channel_t ch)
+{
+    return fault_channel_info[ch].name;
+}
+
+const char *fault_inject_mode_name(fault_mode_t mode)
+{
+    return fault_mode_names[mode];
+}
+
+/*******************************************************************************
+* Function Name: fault_inject_value
+********************************************************************************
+* Summary:
+* Injected signal of a channel at a time, in ADC counts.
+*
+*******************************************************************************/
+static double fault_inject_value(const fault_inject_t *inj, double t)
+{
+    double dt = t - inj->t0;
+
+    if ((inj->mode == FAULT_MODE_RAMP) && (dt < inj->duration))
+    {
+        return inj->from + ((inj->to - inj->from) * dt / inj->duration);
+    }
+    return inj->to;
+}
+
+/*******************************************************************************
+* Function Name: fault_inject_window
+********************************************************************************
+* Summary:
+* Window of a channel that the protection acts on: the window of the hardware
+* limit detection, narrowed by the limits of the averaged protection of the
+* scheduled channels, or for the Vout by the window of the setpoint in the RUN
+* and TEST states. A result inside the window is no fault.
+*
+*******************************************************************************/
+static void fault_inject_window(unsigned int conv, fault_channel_t ch, uint16_t *lo, uint16_t *hi)
+{
+    const fault_inject_t *inj = &fault_inj[conv][ch];
+    uint16_t l = inj->lo;
+    uint16_t h = inj->hi;
+    uint16_t lim;
+
+    switch (ch)
+    {
+        case FAULT_CH_VIN:
+            lim = buck_conv_get_limit((uint8_t)conv, BUCK_CONV_LIMIT_VIN_MIN);
+            l = (lim > l) ? lim : l;
+            lim = buck_conv_get_limit((uint8_t)conv, BUCK_CONV_LIMIT_VIN_MAX);
+            h = (lim < h) ? lim : h;
+            break;
+
+        case FAULT_CH_IOUT1:
+        case FAULT_CH_IOUT2:
+            lim = buck_conv_get_limit((uint8_t)conv, BUCK_CONV_LIMIT_IOUT_MAX);
+            h = (lim < h) ? lim : h;
+            break;
+
+        case FAULT_CH_TEMP:
+            lim = buck_conv_get_limit((uint8_t)conv, BUCK_CONV_LIMIT_TEMP_MAX);
+            h = (lim < h) ? lim : h;
+            break;
+
+        default:
+            if ((buck_conv[conv].state == Ifx_BUCK_STATE_RUN) || (buck_conv[conv].state == Ifx_BUCK_STATE_TEST))
+            {
+                l = (setpoint[conv].win_lo > l) ? setpoint[conv].win_lo : l;
+                h = (setpoint[conv].win_hi < h) ? setpoint[conv].win_hi : h;
+            }
+            break;
+    }
+    *lo = l;
+    *hi = h;
+}
+
+/*******************************************************************************
+* Function Name: fault_inject_outside
+********************************************************************************
+* Summary:
+* Distance of a result outside the window of a measurement, 0 inside.
+*
+*******************************************************************************/
+static uint16_t fault_inject_outside(const fault_inject_rec_t *rec, uint16_t res)
+{
+    return (res > rec->limit_hi) ? (uint16_t)(res - rec->limit_hi) :
+           ((res < rec->limit_lo) ? (uint16_t)(rec->limit_lo - res) : 0U);
+}
+
+/*******************************************************************************
+* Function Name: fault_inject_start
+********************************************************************************
+* Summary:
+* Starts an injection on a channel of a converter at the present simulated
+* time and starts its measurement, which ends the measurement of the previous
+* injection on the converter. A ramp starts from the last result of the model.
+* Returns false for a converter or channel that does not exist.
+*
+*******************************************************************************/
+bool fault_inject_start(unsigned int conv, fault_channel_t ch, fault_mode_t mode, double value, double duration)
+{
+    const fault_channel_info_t *info = &fault_channel_info[ch];
+    fault_inject_t *inj;
+    fault_inject_rec_t *rec = NULL;
+
+    if ((conv >= BUCK_CONV_NUM) || (ch >= FAULT_CHANNELS) || ((ch == FAULT_CH_IOUT2) && (BUCK_CONV_PHASES < 2U)) ||
+        ((ch == FAULT_CH_IOUT2) && (conv != BUCK_CONV_PRIMARY)))
+    {
+        return false;
+    }
+
+    inj = &fault_inj[conv][ch];
+    inj->mode     = mode;
+    inj->t0       = sim_time;
+    inj->from     = inj->last;
+    inj->to       = (info->offset + (info->slope * value)) * info->gain * FAULT_COUNTS_PER_V;
+    inj->to       = (inj->to < 0.0) ? 0.0 : ((inj->to > SIM_ADC_MAX_COUNT) ? SIM_ADC_MAX_COUNT : inj->to);
+    inj->duration = duration;
+
+    if (fault_rec_count < FAULT_INJECT_RECORDS)
+    {
+        rec = &fault_rec[fault_rec_count++];
+        memset(rec, 0, sizeof(*rec));
+        rec->t        = sim_time;
+        rec->conv     = conv;
+        rec->ch       = ch;
+        rec->mode     = mode;
+        rec->value    = value;
+        rec->counts   = inj->to;
+        rec->duration = duration;
+        rec->cross_t  = -1.0;
+        rec->stop_t   = -1.0;
+        rec->peak     = (uint16_t)(inj->last + 0.5);
+        fault_inject_window(conv, ch, &rec->limit_lo, &rec->limit_hi);
+        rec->vout_min = 1.0e9;
+        rec->state[0] = (uint8_t)buck_conv[conv].state;
+        rec->states   = 1U;
+    }
+    inj->rec = rec;
+    fault_active[conv] = rec;
+    fault_enabled[conv] = conv_model_enabled(conv);
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: fault_inject_stop
+********************************************************************************
+* Summary:
+* Ends the injection on a channel, the results follow the model again. The
+* measurement continues until the next injection on the converter.
+*
+*******************************************************************************/
+void fault_inject_stop(unsigned int conv, fault_channel_t ch)
+{
+    if ((conv < BUCK_CONV_NUM) && (ch < FAULT_CHANNELS))
+    {
+        fault_inj[conv][ch].mode = FAULT_MODE_OFF;
+    }
+}
+
+/*******************************************************************************
+* Function Name: fault_inject_apply
+********************************************************************************
+* Summary:
+* Called by the converter model for each conversion of a channel with the
+* result of the power stage model and the window of the hardware limit
+* detection of the channel. Returns the result that the firmware reads: the
+* result of the model, or the injected signal while an injection runs. A
+* glitch ends after its duration.
+*
+*******************************************************************************/
+uint16_t fault_inject_apply(unsigned int conv, fault_channel_t ch, uint16_t res, uint16_t lo, uint16_t hi)
+{
+    fault_inject_t *inj = &fault_inj[conv][ch];
+    uint16_t out;
+
+    inj->last = (double)res;
+    inj->lo = lo;
+    inj->hi = hi;
+    if ((inj->mode == FAULT_MODE_GLITCH) && ((sim_time - inj->t0) >= inj->duration))
+    {
+        inj->mode = FAULT_MODE_OFF;
+    }
+    if (inj->mode == FAULT_MODE_OFF)
+    {
+        return res;
+    }
+
+    out = (uint16_t)(fault_inject_value(inj, sim_time) + 0.5);
+    if ((NULL != inj->rec) && (inj->rec->stop_t < 0.0) &&
+        (fault_inject_outside(inj->rec, out) > fault_inject_outside(inj->rec, inj->rec->peak)))
+    {
+        inj->rec->peak = out;
+    }
+    return out;
+}
+
+/*******************************************************************************
+* Function Name: fault_inject_monitor
+********************************************************************************
+* Summary:
+* Called once per control period after the main loop. Updates the measurement
+* of the last injection on each converter: the window, the crossing of the
+* injected signal out of it, the stop of the PWMs, the output voltage and
+* inductor current until the stop, the input energy of the power stage
+* between the crossing and the stop, and the changes of the converter state.
+*
+*******************************************************************************/
+void fault_inject_monitor(void)
+{
+    for (unsigned int conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        fault_inject_rec_t *rec = fault_active[conv];
+        const fault_inject_t *inj;
+        bool enabled = conv_model_enabled(conv);
+        /* Phases and output of the converter, as in conv_model_init() */
+        unsigned int first = conv;
+        unsigned int phases = (conv == 0U) ? BUCK_CONV_PHASES : 1U;
+        double vout = ((SIM_OUTPUTS > 1U) && (conv > 0U)) ? sim_plant.vout2 : sim_plant.vout;
+
+        if (NULL == rec)
+        {
+            continue;
+        }
+        inj = &fault_inj[conv][rec->ch];
+        if ((rec->stop_t < 0.0) && enabled)
+        {
+            fault_inject_window(conv, rec->ch, &rec->limit_lo, &rec->limit_hi);
+        }
+
+        if ((rec->cross_t < 0.0) && (inj->rec == rec) && (inj->mode != FAULT_MODE_OFF) &&
+            (0U != fault_inject_outside(rec, (uint16_t)(fault_inject_value(inj, sim_time) + 0.5))))
+        {
+            rec->cross_t = sim_time;
+        }
+
+        /* Excursion and energy are measured until the stop, or until the end
+         * of an injection that did not stop the converter */
+        if ((rec->stop_t < 0.0) && (inj->rec == rec) && (inj->mode != FAULT_MODE_OFF))
+        {
+            rec->vout_min = (vout < rec->vout_min) ? vout : rec->vout_min;
+            rec->vout_max = (vout > rec->vout_max) ? vout : rec->vout_max;
+            for (unsigned int ph = first; ph < (first + phases); ph++)
+            {
+                rec->il_max = (sim_plant.il_peak[ph] > rec->il_max) ? sim_plant.il_peak[ph] : rec->il_max;
+            }
+            if (rec->cross_t >= 0.0)
+            {
+                rec->leak_j += sim_plant.vin * sim_plant.iin * SIM_DT;
+            }
+        }
+        if ((rec->stop_t < 0.0) && fault_enabled[conv] && (!enabled))
+        {
+            rec->stop_t = sim_time;
+            if ((conv == BUCK_CONV_PRIMARY) && (buck_conv[conv].state == Ifx_BUCK_STATE_FAULT))
+            {
+                rec->cause = flight_rec_store.rec[(flight_rec_store.next + FLIGHT_REC_RECORDS - 1U) %
+                                                  FLIGHT_REC_RECORDS].cause;
+            }
+        }
+        fault_enabled[conv] = enabled;
+
+        if ((rec->states < FAULT_INJECT_STATES) && (rec->state[rec->states - 1U] != (uint8_t)buck_conv[conv].state))
+        {
+            rec->state[rec->states++] = (uint8_t)buck_conv[conv].state;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: fault_inject_count / fault_inject_record
+********************************************************************************
+* Summary:
+* Number of measured injections and the measurement of one of them.
+*
+*******************************************************************************/
+uint32_t fault_inject_count(void)
+{
+    return fault_rec_count;
+}
+
+const fault_inject_rec_t *fault_inject_record(uint32_t i)
+{
+    return &fault_rec[i];
+}
+
+/* [] END OF FILE */
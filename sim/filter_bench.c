@@ -0,0 +1,423 @@
+/*******************************************************************************
+* File Name: filter_bench.c
+*
+* Description:
+* Benchmark of the protection filters of prot_filter.h in the build mode of
+* the simulation (BUCK_PROT_FIXED_POINT). Each filter and debounce runs the
+* same ADC result traces of one channel against a limit, at the 100 Hz of the
+* scheduled ADC callback:
+*  - noise: results at 85 % of the limit with gaussian noise and single and
+*    double full scale spikes; every trip is a false trip and restarts the
+*    filter
+*  - step: results at 70 % of the limit step to 110 %; the detection latency
+*    is the number of results from the step to the trip
+* A recorded trace, one result per line (the first field of CSV lines, other
+* lines are skipped), is replayed instead of the synthetic traces and the
+* trips are reported. The host time per result is measured on the noise or
+* the recorded trace.
+*
+*   filter_bench [-l <limit counts>] [<trace>]
+*
+* The limit applies to the recorded trace, IOUT_MAX_COUNT by default.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* All filters are selected at run time here, so every channel keeps the
+ * boxcar window. */
+#define PROT_FILTER_TAPS        AVERAGING_SAMPLES
+#include "prot_filter.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_RATE_HZ           (100.0)     /* Scheduled ADC callback */
+#define BENCH_LIMIT             (1861U)     /* IOUT_MAX_COUNT */
+#define BENCH_NOISE_RESULTS     (1000000U)  /* 2.8 h of results */
+#define BENCH_NOISE_LEVEL       (0.85)      /* Of the limit */
+#define BENCH_NOISE_SIGMA       (0.02)      /* Of the limit */
+#define BENCH_SPIKE_RATE        (0.001)     /* Spikes per result */
+#define BENCH_SPIKE_DOUBLE      (0.25)      /* Fraction of double spikes */
+#define BENCH_STEP_TRIALS       (10000U)
+#define BENCH_STEP_FROM         (0.70)
+#define BENCH_STEP_TO           (1.10)
+#define BENCH_STEP_PRE          (32U)       /* Results before the step, at most */
+#define BENCH_STEP_MAX          (200U)      /* Results after the step before a miss */
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    uint32_t    type;
+    uint32_t    n;                          /* Debounce: n of the last m compares */
+    uint32_t    m;
+} bench_filter_t;
+
+typedef struct
+{
+    prot_filter_chan_t f;
+    prot_value_t       avg;
+    prot_debounce_t    d;
+} bench_chan_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const bench_filter_t filters[] =
+{
+    { "iir",     PROT_FILTER_IIR,     1U, 1U },
+    { "iir",     PROT_FILTER_IIR,     2U, 3U },
+    { "iir",     PROT_FILTER_IIR,     3U, 5U },
+    { "boxcar",  PROT_FILTER_BOXCAR,  1U, 1U },
+    { "boxcar",  PROT_FILTER_BOXCAR,  2U, 3U },
+    { "boxcar",  PROT_FILTER_BOXCAR,  3U, 5U },
+    { "median3", PROT_FILTER_MEDIAN3, 1U, 1U },
+    { "median3", PROT_FILTER_MEDIAN3, 2U, 3U },
+    { "median3", PROT_FILTER_MEDIAN3, 3U, 5U },
+};
+
+static uint32_t seed = 0x2545F491UL;
+
+/*******************************************************************************
+* Function Name: uniform
+********************************************************************************
+* Summary:
+* Pseudo-random number in (0, 1).
+*
+*******************************************************************************/
+static double uniform(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return ((double)seed + 0.5) / 4294967296.0;
+}
+
+/*******************************************************************************
+* Function Name: result
+********************************************************************************
+* Summary:
+* ADC result at a level with gaussian noise, in counts.
+*
+*******************************************************************************/
+static uint16_t result(double level)
+{
+    double v = level + (sqrt(-2.0 * log(uniform())) * cos(6.283185307 * uniform()) * BENCH_NOISE_SIGMA * BENCH_LIMIT);
+
+    return (uint16_t)((v < 0.0) ? 0.0 : ((v > 4095.0) ? 4095.0 : (v + 0.5)));
+}
+
+/*******************************************************************************
+* Function Name: chan_reset
+********************************************************************************
+* Summary:
+* Starts a channel settled at a result.
+*
+*******************************************************************************/
+static void chan_reset(bench_chan_t *c, uint16_t counts)
+{
+    prot_filter_chan_reset(&c->f, counts);
+    c->avg = PROT_AVG(counts);
+    c->d = (prot_debounce_t){ 0 };
+}
+
+/*******************************************************************************
+* Function Name: chan_step
+********************************************************************************
+* Summary:
+* Filters a result and compares the output with the limit.
+*
+*******************************************************************************/
+static inline bool chan_step(bench_chan_t *c, const bench_filter_t *flt, uint16_t res, prot_value_t limit)
+{
+    c->avg = prot_filter_step(&c->f, c->avg, (prot_value_t)res, flt->type);
+    return prot_filter_debounce(&c->d, c->avg > limit, flt->n, flt->m);
+}
+
+/*******************************************************************************
+* Function Name: host_ns
+********************************************************************************
+* Summary:
+* Monotonic host time, ns.
+*
+*******************************************************************************/
+static uint64_t host_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: replay
+********************************************************************************
+* Summary:
+* Runs a trace through a filter, started at the first result and restarted at
+* the result after each trip, and returns the trips, the result of the first trip and
+* the host time.
+*
+*******************************************************************************/
+static uint32_t replay(const bench_filter_t *flt, const uint16_t *trace, uint32_t len, uint32_t limit,
+                       uint32_t *first, double *ns_per_result)
+{
+    bench_chan_t c;
+    prot_value_t lim = PROT_AVG(limit);
+    uint32_t trips = 0U;
+    bool restart = true;
+    uint64_t t0;
+
+    *first = 0U;
+    t0 = host_ns();
+    for (uint32_t i = 0U; i < len; i++)
+    {
+        if (restart)
+        {
+            chan_reset(&c, trace[i]);
+            restart = false;
+        }
+        if (chan_step(&c, flt, trace[i], lim))
+        {
+            if (trips++ == 0U)
+            {
+                *first = i;
+            }
+            restart = true;
+        }
+    }
+    *ns_per_result = (double)(host_ns() - t0) / (double)len;
+    return trips;
+}
+
+/*******************************************************************************
+* Function Name: step_latency
+********************************************************************************
+* Summary:
+* Runs the step trials of a filter and returns the mean and the largest
+* detection latency in results, and the steps not detected.
+*
+*******************************************************************************/
+static uint32_t step_latency(const bench_filter_t *flt, double *mean, uint32_t *max)
+{
+    const double from = BENCH_STEP_FROM * BENCH_LIMIT;
+    const double to = BENCH_STEP_TO * BENCH_LIMIT;
+    prot_value_t lim = PROT_AVG(BENCH_LIMIT);
+    bench_chan_t c;
+    uint32_t missed = 0U;
+    uint64_t sum = 0U;
+
+    *max = 0U;
+    seed = 0x9E3779B9UL;
+    for (uint32_t trial = 0U; trial < BENCH_STEP_TRIALS; trial++)
+    {
+        uint32_t pre = (uint32_t)(uniform() * BENCH_STEP_PRE);
+        uint32_t k;
+
+        chan_reset(&c, (uint16_t)from);
+        for (k = 0U; k < pre; k++)
+        {
+            (void)chan_step(&c, flt, result(from), lim);
+        }
+        for (k = 1U; k <= BENCH_STEP_MAX; k++)
+        {
+            if (chan_step(&c, flt, result(to), lim))
+            {
+                break;
+            }
+        }
+        if (k > BENCH_STEP_MAX)
+        {
+            missed++;
+            continue;
+        }
+        sum += k;
+        *max = (k > *max) ? k : *max;
+    }
+    *mean = (BENCH_STEP_TRIALS > missed) ? ((double)sum / (double)(BENCH_STEP_TRIALS - missed)) : 0.0;
+    return missed;
+}
+
+/*******************************************************************************
+* Function Name: load_trace
+********************************************************************************
+* Summary:
+* Reads the first field of each line of a recorded trace that starts with a
+* number.
+*
+*******************************************************************************/
+static uint16_t *load_trace(const char *path, uint32_t *len)
+{
+    FILE *f = fopen(path, "r");
+    uint16_t *trace = NULL;
+    uint32_t size = 0U;
+    char line[256];
+
+    *len = 0U;
+    if (f == NULL)
+    {
+        return NULL;
+    }
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        char *end;
+        long v = strtol(line, &end, 10);
+
+        if ((end == line) || (v < 0) || (v > 4095))
+        {
+            continue;
+        }
+        if (*len == size)
+        {
+            size = (size == 0U) ? 4096U : (size * 2U);
+            trace = realloc(trace, size * sizeof(uint16_t));
+            if (trace == NULL)
+            {
+                break;
+            }
+        }
+        trace[(*len)++] = (uint16_t)v;
+    }
+    fclose(f);
+    return trace;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs the synthetic or the recorded trace through each filter and prints a
+* line per filter.
+*
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+    uint32_t limit = BENCH_LIMIT;
+    uint16_t *trace;
+    uint32_t len;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((0 == strcmp(argv[i], "-l")) && ((i + 1) < argc))
+        {
+            limit = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if (argv[i][0] != '-')
+        {
+            path = argv[i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: filter_bench [-l <limit counts>] [<trace>]\n");
+            return 2;
+        }
+    }
+
+    if (path != NULL)
+    {
+        trace = load_trace(path, &len);
+        if (len == 0U)
+        {
+            fprintf(stderr, "filter_bench: no results in %s\n", path);
+            return 1;
+        }
+        printf("filter_bench mode=%s trace=%s results=%u limit=%u\n",
+               BUCK_PROT_FIXED_POINT ? "fixed" : "float", path, len, limit);
+        for (size_t i = 0U; i < (sizeof(filters) / sizeof(filters[0])); i++)
+        {
+            uint32_t first;
+            double ns;
+            uint32_t trips = replay(&filters[i], trace, len, limit, &first, &ns);
+
+            printf("filter=%s trip=%u/%u trips=%u first_trip_s=%.2f host_ns_per_result=%.2f\n",
+                   filters[i].name, filters[i].n, filters[i].m, trips,
+                   (trips != 0U) ? ((double)first / BENCH_RATE_HZ) : 0.0, ns);
+        }
+        free(trace);
+        return 0;
+    }
+
+    /* The noise trace with spikes, the same for every filter. */
+    len = BENCH_NOISE_RESULTS;
+    trace = malloc(len * sizeof(uint16_t));
+    if (trace == NULL)
+    {
+        return 1;
+    }
+    for (uint32_t i = 0U; i < len; i++)
+    {
+        trace[i] = result(BENCH_NOISE_LEVEL * BENCH_LIMIT);
+        if (uniform() < BENCH_SPIKE_RATE)
+        {
+            trace[i] = 4095U;
+            if ((uniform() < BENCH_SPIKE_DOUBLE) && ((i + 1U) < len))
+            {
+                trace[++i] = 4095U;
+            }
+        }
+    }
+
+    printf("filter_bench mode=%s rate_hz=%.0f limit=%u noise=%.0f%%+-%.0f%% spikes_per_s=%.2f results=%u "
+           "step=%.0f%%->%.0f%% trials=%u\n", BUCK_PROT_FIXED_POINT ? "fixed" : "float", BENCH_RATE_HZ, BENCH_LIMIT,
+           BENCH_NOISE_LEVEL * 100.0, BENCH_NOISE_SIGMA * 100.0, BENCH_SPIKE_RATE * BENCH_RATE_HZ, len,
+           BENCH_STEP_FROM * 100.0, BENCH_STEP_TO * 100.0, BENCH_STEP_TRIALS);
+    for (size_t i = 0U; i < (sizeof(filters) / sizeof(filters[0])); i++)
+    {
+        uint32_t first;
+        uint32_t max;
+        double ns;
+        double mean;
+        uint32_t trips = replay(&filters[i], trace, len, BENCH_LIMIT, &first, &ns);
+        uint32_t missed = step_latency(&filters[i], &mean, &max);
+
+        printf("filter=%s trip=%u/%u false_trips_per_h=%.2f latency_mean_ms=%.1f latency_max_ms=%.0f "
+               "missed=%u host_ns_per_result=%.2f\n", filters[i].name, filters[i].n, filters[i].m,
+               (double)trips * 3600.0 * BENCH_RATE_HZ / (double)len, mean * 1000.0 / BENCH_RATE_HZ,
+               (double)max * 1000.0 / BENCH_RATE_HZ, missed, ns);
+    }
+    free(trace);
+    return 0;
+}
+
+/* [] END OF FILE */
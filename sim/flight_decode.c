@@ -0,0 +1,275 @@
+/*******************************************************************************
+* File Name: flight_decode.c
+*
+* Description:
+* Host decoder of the flight recorder fault records (flight_rec.h). The input
+* is either a memory image of flight_rec_store read with the debugger, for
+* example after a reset in the field, or the records extracted from a binary
+* telemetry stream with "telemetry_decode -f". The input is searched for the
+* record magic, each record is checked with its CRC, and the samples are
+* written as CSV in physical units, oldest record first. A summary of each
+* record goes to stderr.
+*
+* Usage: flight_decode [input.bin [output.csv]]
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "flight_rec.h"
+#include "telemetry.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define INPUT_MAX               (1UL << 20)
+#define RECORD_SIZE             (sizeof(flight_rec_record_t))
+#define SAMPLE_SIZE             (sizeof(flight_rec_sample_t))
+
+/* Scaling of the ADC results, see main.c. */
+#define ADC_LSB_V               (3.3 / 4095.0)
+#define VOUT_GAIN               (0.239)
+#define IOUT_GAIN               (0.5)
+#define VIN_GAIN                (0.064)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const char *const cause_names[FLIGHT_REC_CAUSES] =
+{
+    "vin_low", "vin_high", "iout1", "iout2", "temp", "vout", "fast"
+};
+
+static const char *const state_names[] = { "IDLE", "RAMP", "RUN", "TEST", "FAULT" };
+
+/*******************************************************************************
+* Function Name: crc16
+********************************************************************************
+* Summary:
+* Bitwise CRC-16/CCITT-FALSE, as telemetry_crc16() of the firmware.
+*
+*******************************************************************************/
+static uint16_t crc16(const uint8_t *data, uint32_t size)
+{
+    uint16_t crc = TELEMETRY_CRC_INIT;
+
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        crc ^= (uint16_t)((uint16_t)data[i] << 8);
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ TELEMETRY_CRC_POLY) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static double get_avg(const uint8_t *p)
+{
+    return (double)(int32_t)get_u32(p) / 32768.0;
+}
+
+static const char *state_name(uint8_t state)
+{
+    return (state < (sizeof(state_names) / sizeof(state_names[0]))) ? state_names[state] : "?";
+}
+
+/*******************************************************************************
+* Function Name: write_record
+********************************************************************************
+* Summary:
+* Writes the samples of one record, the index is relative to the sample that
+* tripped and the tick is the scheduled ADC period since the start up (the
+* tick counter of the record includes the tripping sample).
+*
+*******************************************************************************/
+static void write_record(FILE *out, const uint8_t *rec)
+{
+    uint32_t fault = get_u32(&rec[offsetof(flight_rec_record_t, fault)]);
+    uint32_t tick = get_u32(&rec[offsetof(flight_rec_record_t, tick)]);
+    uint8_t count = rec[offsetof(flight_rec_record_t, count)];
+    char cause[64] = "";
+
+    for (uint32_t bit = 0U; bit < FLIGHT_REC_CAUSES; bit++)
+    {
+        if ((rec[offsetof(flight_rec_record_t, cause)] & (1U << bit)) != 0U)
+        {
+            if (cause[0] != '\0')
+            {
+                strcat(cause, "+");
+            }
+            strcat(cause, cause_names[bit]);
+        }
+    }
+
+    fprintf(stderr, "flight_decode fault=%u boot=%u tick=%u state=%s cause=%s samples=%u\n",
+            fault, get_u32(&rec[offsetof(flight_rec_record_t, boot)]), tick,
+            state_name(rec[offsetof(flight_rec_record_t, state)]), cause, count);
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        const uint8_t *s = &rec[offsetof(flight_rec_record_t, samples) + (i * SAMPLE_SIZE)];
+        int32_t index = (int32_t)i - (int32_t)(count - 1U);
+
+        fprintf(out, "%u,%s,%d,%d,%s,%u,%.3f,%.3f,%.3f,%.3f,%u,%.3f,%.3f,%.3f,%.2f\n",
+                fault, cause, index, (int32_t)tick - 1 + index,
+                state_name(s[offsetof(flight_rec_sample_t, state)]), s[offsetof(flight_rec_sample_t, phases)],
+                get_u16(&s[offsetof(flight_rec_sample_t, vout)]) * ADC_LSB_V / VOUT_GAIN,
+                get_u16(&s[offsetof(flight_rec_sample_t, vin)]) * ADC_LSB_V / VIN_GAIN,
+                get_u16(&s[offsetof(flight_rec_sample_t, iout1)]) * ADC_LSB_V / IOUT_GAIN,
+                get_u16(&s[offsetof(flight_rec_sample_t, iout2)]) * ADC_LSB_V / IOUT_GAIN,
+                get_u16(&s[offsetof(flight_rec_sample_t, temp)]),
+                get_avg(&s[offsetof(flight_rec_sample_t, vin_avg)]) * ADC_LSB_V / VIN_GAIN,
+                get_avg(&s[offsetof(flight_rec_sample_t, iout1_avg)]) * ADC_LSB_V / IOUT_GAIN,
+                get_avg(&s[offsetof(flight_rec_sample_t, iout2_avg)]) * ADC_LSB_V / IOUT_GAIN,
+                get_avg(&s[offsetof(flight_rec_sample_t, temp_avg)]));
+    }
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+    FILE *in = stdin;
+    FILE *out = stdout;
+    uint8_t *buf;
+    size_t size;
+    const uint8_t *recs[64];
+    uint32_t records = 0U;
+    uint32_t crc_errors = 0U;
+
+    if (argc > 3)
+    {
+        fprintf(stderr, "usage: %s [input.bin [output.csv]]\n", argv[0]);
+        return 2;
+    }
+    if (argc > 1)
+    {
+        in = fopen(argv[1], "rb");
+        if (NULL == in)
+        {
+            fprintf(stderr, "cannot open %s\n", argv[1]);
+            return 2;
+        }
+    }
+    if (argc > 2)
+    {
+        out = fopen(argv[2], "w");
+        if (NULL == out)
+        {
+            fprintf(stderr, "cannot open %s\n", argv[2]);
+            return 2;
+        }
+    }
+
+    buf = malloc(INPUT_MAX);
+    if (NULL == buf)
+    {
+        return 2;
+    }
+    size = fread(buf, 1U, INPUT_MAX, in);
+
+    /* Records are found at any byte position, so a lost telemetry frame only
+     * costs the record it belongs to. */
+    for (size_t pos = 0U; (pos + RECORD_SIZE) <= size; )
+    {
+        const uint8_t *rec = &buf[pos];
+
+        if (get_u32(rec) != FLIGHT_REC_MAGIC)
+        {
+            pos++;
+            continue;
+        }
+        if ((rec[offsetof(flight_rec_record_t, count)] > FLIGHT_REC_DEPTH) ||
+            (crc16(rec, offsetof(flight_rec_record_t, crc)) != get_u32(&rec[offsetof(flight_rec_record_t, crc)])))
+        {
+            crc_errors++;
+            pos++;
+            continue;
+        }
+        if (records < (sizeof(recs) / sizeof(recs[0])))
+        {
+            recs[records++] = rec;
+        }
+        pos += RECORD_SIZE;
+    }
+
+    /* Oldest fault first, the slots of the store are reused round robin. */
+    for (uint32_t i = 1U; i < records; i++)
+    {
+        for (uint32_t k = i; (k > 0U) && (get_u32(&recs[k - 1U][offsetof(flight_rec_record_t, fault)]) >
+                                          get_u32(&recs[k][offsetof(flight_rec_record_t, fault)])); k--)
+        {
+            const uint8_t *t = recs[k];
+            recs[k] = recs[k - 1U];
+            recs[k - 1U] = t;
+        }
+    }
+
+    fprintf(out, "fault,cause,index,tick,state,phases,vout_v,vin_v,iout1_a,iout2_a,temp_res,"
+                 "vin_avg_v,iout1_avg_a,iout2_avg_a,temp_avg\n");
+    for (uint32_t i = 0U; i < records; i++)
+    {
+        write_record(out, recs[i]);
+    }
+    fprintf(stderr, "flight_decode records=%u crc_errors=%u\n", records, crc_errors);
+
+    free(buf);
+    if (in != stdin)
+    {
+        fclose(in);
+    }
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+    return (records > 0U) ? 0 : 1;
+}
+
+/* [] END OF FILE */
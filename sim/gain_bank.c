@@ -0,0 +1,194 @@
+/*******************************************************************************
+* File Name: gain_bank.c
+*
+* Description:
+* Generates gain_sched_bank.c, the 2P2Z coefficient sets of the gain
+* scheduling. Each set is designed with comp_design_2p2z() for the crossover
+* frequency and phase margin of design.modus, at the design current of its
+* load band (GAIN_SCHED_DESIGN_CURRENTS in gain_sched.h) and one or two active
+* phases. The achieved crossover and phase margin of each set and of the PCC
+* design at the same operating point are written as comments.
+*
+*   gain_bank > ../gain_sched_bank.c
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include "comp_design.h"
+#include "sim_config.h"
+#include "gain_sched.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const char *const license[] =
+{
+    "* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or",
+    "* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.",
+    "*",
+    "* This software, including source code, documentation and related",
+    "* materials (\"Software\") is owned by Cypress Semiconductor Corporation",
+    "* or one of its affiliates (\"Cypress\") and is protected by and subject to",
+    "* worldwide patent protection (United States and foreign),",
+    "* United States copyright laws and international treaty provisions.",
+    "* Therefore, you may use this Software only as provided in the license",
+    "* agreement accompanying the software package from which you",
+    "* obtained this Software (\"EULA\").",
+    "* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,",
+    "* non-transferable license to copy, modify, and compile the Software",
+    "* source code solely for use in connection with Cypress's",
+    "* integrated circuit products.  Any reproduction, modification, translation,",
+    "* compilation, or representation of this Software except as specified",
+    "* above is prohibited without the express written permission of Cypress.",
+    "*",
+    "* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,",
+    "* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED",
+    "* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress",
+    "* reserves the right to make changes to the Software without notice. Cypress",
+    "* does not assume any liability arising out of the application or use of the",
+    "* Software or any product or circuit described in the Software. Cypress does",
+    "* not authorize its products for use in any products where a malfunction or",
+    "* failure of the Cypress product may reasonably be expected to result in",
+    "* significant property damage, injury or death (\"High Risk Product\"). By",
+    "* including Cypress's product in a High Risk Product, the manufacturer",
+    "* of such system or application assumes all risk of such use and in doing",
+    "* so agrees to indemnify Cypress against all liability.",
+    "*******************************************************************************/",
+};
+
+static const float design_currents[GAIN_SCHED_BANDS] = GAIN_SCHED_DESIGN_CURRENTS;
+
+/*******************************************************************************
+* Function Name: crossover
+********************************************************************************
+* Summary:
+* Finds the crossover frequency and phase margin of a compensator with the
+* plant of the design inputs.
+*
+*******************************************************************************/
+static void crossover(const comp_design_in_t *in, const comp_coef_t *coef, double *f_c, double *pm)
+{
+    double mag;
+    double phase;
+
+    *f_c = 0.0;
+    *pm = 0.0;
+    for (double f = 10.0; f < (in->f_sw / 2.0); f *= 1.001)
+    {
+        comp_loop_gain(in, coef, f, &mag, &phase);
+        if (mag < 1.0)
+        {
+            *f_c = f;
+            *pm = 180.0 + phase;
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Writes the coefficient bank as C source to stdout.
+*
+*******************************************************************************/
+int main(void)
+{
+    comp_design_in_t in;
+    comp_coef_t pcc;
+    comp_coef_t coef;
+    double f_c;
+    double pm;
+    double f_c_pcc;
+    double pm_pcc;
+
+    comp_design_default(&in);
+    comp_design_2p2z(&in, &pcc);
+    in.f_c = GAIN_SCHED_CROSSOVER;
+
+    printf("/*******************************************************************************\n"
+           "* File Name: gain_sched_bank.c\n"
+           "*\n"
+           "* Description:\n"
+           "* 2P2Z coefficient sets of the gain scheduling, generated by sim/gain_bank\n"
+           "* (\"make -C sim gainbank\") for a %.0f Hz crossover and %.0f degree phase\n"
+           "* margin. Do not edit.\n"
+           "*\n"
+           "* Related document: See README.md\n"
+           "*\n"
+           "*******************************************************************************\n",
+           in.f_c, in.pm);
+    for (unsigned int i = 0U; i < (sizeof(license) / sizeof(license[0])); i++)
+    {
+        printf("%s\n", license[i]);
+    }
+    printf("\n"
+           "/*******************************************************************************\n"
+           "* Header Files\n"
+           "*******************************************************************************/\n"
+           "#include \"cybsp.h\"\n"
+           "#include \"gain_sched.h\"\n"
+           "\n"
+           "/*******************************************************************************\n"
+           "* Global variables\n"
+           "*******************************************************************************/\n"
+           "/* b0, b1, b2, a1, a2, 1/b2. The comments give the crossover frequency and phase\n"
+           " * margin at the design point, and those of the PCC tool set in brackets. */\n"
+           "CONTROL_RAMCONST gain_sched_coef_t gain_sched_bank[GAIN_SCHED_SETS] =\n"
+           "{\n");
+    for (unsigned int phases = 1U; phases <= 2U; phases++)
+    {
+        for (unsigned int band = 0U; band < GAIN_SCHED_BANDS; band++)
+        {
+            in.phases = (double)phases;
+            in.r_load = SIM_VOUT_NOM / design_currents[band];
+            comp_design_2p2z(&in, &coef);
+            crossover(&in, &coef, &f_c, &pm);
+            crossover(&in, &pcc, &f_c_pcc, &pm_pcc);
+            printf("    /* %u phase%s, %.1f A: %.0f Hz %.1f deg (%.0f Hz %.1f deg) */\n",
+                   phases, (phases > 1U) ? "s" : "", design_currents[band], f_c, pm, f_c_pcc, pm_pcc);
+            printf("    { %.9ef, %.9ef, %.9ef, %.9ef, %.9ef, %.9ef },\n",
+                   coef.b0, coef.b1, coef.b2, coef.a1, coef.a2, 1.0 / coef.b2);
+        }
+    }
+    printf("};\n"
+           "\n"
+           "/* [] END OF FILE */\n");
+    return 0;
+}
+
+/* [] END OF FILE */
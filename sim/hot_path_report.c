@@ -0,0 +1,501 @@
+/*******************************************************************************
+* File Name: hot_path_report.c
+*
+* Description:
+* Placement report of the control path in a linked image. The symbols of the
+* control ISR, the scheduled ADC and fault callbacks, the functions that they
+* call and the data they read are listed in hot_path.txt, one name or shell
+* wildcard pattern per line. The tool reads the symbol table of the ELF file,
+* the firmware image of a CONTROL_RAM=1 build or the simulation, and prints the
+* type, size, address, section and placement of each listed symbol:
+*  - ram:     in a writable section or a section without contents, or in a
+*             load segment that the startup code copies (its virtual and load
+*             addresses differ), for example .cy_ramfunc in .data
+*  - flash:   in any other section, executed or read with wait states
+*  - absent:  no symbol of the name, the compiler inlined the function or
+*             the configuration does not build it
+* Compiler clones of a function (name.part.0, name.cold, ...) are reported
+* with it. A summary line follows with the code and data bytes in each memory.
+*
+* Usage: hot_path_report [-c] [-R section]... [-i pattern]... list elf
+*  -c          exits with 1 when a listed symbol is in flash
+*  -R section  section that is copied to SRAM on the target, for images
+*              without load addresses (the host simulation)
+*  -i pattern  ignores the listed symbols that match
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <fnmatch.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define INPUT_MAX               (64UL << 20)
+#define LIST_MAX                (256U)
+#define OPTION_MAX              (16U)
+
+/* ELF constants */
+#define ELFCLASS32              (1U)
+#define ELFCLASS64              (2U)
+#define ELFDATA2LSB             (1U)
+#define EM_ARM                  (40U)
+#define SHT_SYMTAB              (2U)
+#define SHT_NOBITS              (8U)
+#define SHF_WRITE               (0x1U)
+#define SHF_ALLOC               (0x2U)
+#define SHN_LORESERVE           (0xff00U)
+#define PT_LOAD                 (1U)
+#define STT_OBJECT              (1U)
+#define STT_FUNC                (2U)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    uint32_t    type;
+    uint64_t    flags;
+    uint64_t    addr;
+    uint64_t    offset;
+    uint64_t    size;
+    uint32_t    link;
+    uint64_t    entsize;
+} section_t;
+
+typedef struct
+{
+    uint32_t    type;
+    uint64_t    vaddr;
+    uint64_t    paddr;
+    uint64_t    memsz;
+} segment_t;
+
+typedef struct
+{
+    const uint8_t *buf;
+    size_t         size;
+    bool           is64;
+    uint32_t       machine;
+    section_t     *sec;
+    uint32_t       secs;
+    segment_t     *seg;
+    uint32_t       segs;
+} elf_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const char *ram_sections[OPTION_MAX];
+static uint32_t ram_section_count;
+static const char *ignore_patterns[OPTION_MAX];
+static uint32_t ignore_count;
+
+static uint16_t get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t get_u64(const uint8_t *p)
+{
+    return (uint64_t)get_u32(p) | ((uint64_t)get_u32(&p[4]) << 32);
+}
+
+/* Address sized field of the ELF class */
+static uint64_t get_addr(const elf_t *e, const uint8_t *p)
+{
+    return e->is64 ? get_u64(p) : get_u32(p);
+}
+
+static bool in_file(const elf_t *e, uint64_t offset, uint64_t size)
+{
+    return (offset <= e->size) && (size <= (e->size - offset));
+}
+
+/*******************************************************************************
+* Function Name: elf_load
+********************************************************************************
+* Summary:
+* Checks the ELF header of a little endian 32 or 64 bit image and reads its
+* section and program headers.
+*
+*******************************************************************************/
+static bool elf_load(elf_t *e)
+{
+    const uint8_t *h = e->buf;
+    uint64_t shoff;
+    uint64_t phoff;
+    uint32_t shentsize;
+    uint32_t phentsize;
+    uint32_t shstrndx;
+
+    if ((e->size < 52U) || (memcmp(h, "\177ELF", 4U) != 0) || (h[5] != ELFDATA2LSB) ||
+        ((h[4] != ELFCLASS32) && (h[4] != ELFCLASS64)))
+    {
+        return false;
+    }
+    e->is64 = (h[4] == ELFCLASS64);
+    if (e->is64 && (e->size < 64U))
+    {
+        return false;
+    }
+    e->machine = get_u16(&h[18]);
+
+    phoff     = e->is64 ? get_u64(&h[32]) : get_u32(&h[28]);
+    shoff     = e->is64 ? get_u64(&h[40]) : get_u32(&h[32]);
+    phentsize = get_u16(&h[e->is64 ? 54 : 42]);
+    e->segs   = get_u16(&h[e->is64 ? 56 : 44]);
+    shentsize = get_u16(&h[e->is64 ? 58 : 46]);
+    e->secs   = get_u16(&h[e->is64 ? 60 : 48]);
+    shstrndx  = get_u16(&h[e->is64 ? 62 : 50]);
+
+    if (!in_file(e, shoff, (uint64_t)shentsize * e->secs) || !in_file(e, phoff, (uint64_t)phentsize * e->segs) ||
+        (shstrndx >= e->secs) || (shentsize < (e->is64 ? 64U : 40U)) ||
+        ((e->segs > 0U) && (phentsize < (e->is64 ? 56U : 32U))))
+    {
+        return false;
+    }
+
+    e->sec = calloc(e->secs, sizeof(section_t));
+    e->seg = calloc(e->segs + 1U, sizeof(segment_t));
+    if ((NULL == e->sec) || (NULL == e->seg))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0U; i < e->secs; i++)
+    {
+        const uint8_t *s = &e->buf[shoff + ((uint64_t)i * shentsize)];
+        section_t *sec = &e->sec[i];
+
+        sec->name    = (const char *)(uintptr_t)get_u32(&s[0]);     /* Offset until the names are read */
+        sec->type    = get_u32(&s[4]);
+        sec->flags   = get_addr(e, &s[8]);
+        sec->addr    = get_addr(e, &s[e->is64 ? 16 : 12]);
+        sec->offset  = get_addr(e, &s[e->is64 ? 24 : 16]);
+        sec->size    = get_addr(e, &s[e->is64 ? 32 : 20]);
+        sec->link    = get_u32(&s[e->is64 ? 40 : 24]);
+        sec->entsize = get_addr(e, &s[e->is64 ? 56 : 36]);
+    }
+
+    /* Section names */
+    for (uint32_t i = 0U; i < e->secs; i++)
+    {
+        const section_t *str = &e->sec[shstrndx];
+        uint64_t name = (uint64_t)(uintptr_t)e->sec[i].name;
+
+        e->sec[i].name = (in_file(e, str->offset, str->size) && (name < str->size)) ?
+                         (const char *)&e->buf[str->offset + name] : "?";
+    }
+
+    for (uint32_t i = 0U; i < e->segs; i++)
+    {
+        const uint8_t *p = &e->buf[phoff + ((uint64_t)i * phentsize)];
+        segment_t *seg = &e->seg[i];
+
+        seg->type  = get_u32(&p[0]);
+        seg->vaddr = get_addr(e, &p[e->is64 ? 16 : 8]);
+        seg->paddr = get_addr(e, &p[e->is64 ? 24 : 12]);
+        seg->memsz = get_addr(e, &p[e->is64 ? 40 : 20]);
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: in_ram
+********************************************************************************
+* Summary:
+* Placement of a symbol: true in SRAM, false in flash.
+*
+*******************************************************************************/
+static bool in_ram(const elf_t *e, const section_t *sec, uint64_t addr)
+{
+    for (uint32_t i = 0U; i < ram_section_count; i++)
+    {
+        if (0 == strcmp(sec->name, ram_sections[i]))
+        {
+            return true;
+        }
+    }
+    if (((sec->flags & SHF_WRITE) != 0U) || (sec->type == SHT_NOBITS))
+    {
+        return true;
+    }
+    for (uint32_t i = 0U; i < e->segs; i++)
+    {
+        const segment_t *seg = &e->seg[i];
+
+        if ((seg->type == PT_LOAD) && (addr >= seg->vaddr) && ((addr - seg->vaddr) < seg->memsz))
+        {
+            return (seg->vaddr != seg->paddr);
+        }
+    }
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: matches
+********************************************************************************
+* Summary:
+* Compares a symbol name with a pattern of the list. A compiler clone matches
+* the pattern of its function: the name up to the first '.' is compared.
+*
+*******************************************************************************/
+static bool matches(const char *pattern, const char *name)
+{
+    char base[256];
+    size_t len = strcspn(name, ".");
+
+    if ((len == 0U) || (len >= sizeof(base)))
+    {
+        return false;
+    }
+    memcpy(base, name, len);
+    base[len] = '\0';
+    return (0 == fnmatch(pattern, base, 0));
+}
+
+static bool ignored(const char *name)
+{
+    for (uint32_t i = 0U; i < ignore_count; i++)
+    {
+        if (0 == fnmatch(ignore_patterns[i], name, 0))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: read_list
+********************************************************************************
+* Summary:
+* Reads the patterns of the hot path list, without comments and blank lines.
+*
+*******************************************************************************/
+static uint32_t read_list(FILE *in, char *patterns[LIST_MAX])
+{
+    char line[256];
+    uint32_t count = 0U;
+
+    while ((NULL != fgets(line, sizeof(line), in)) && (count < LIST_MAX))
+    {
+        char *p = line + strspn(line, " \t");
+
+        p[strcspn(p, " \t\r\n#")] = '\0';
+        if ((p[0] != '\0') && !ignored(p))
+        {
+            patterns[count] = strdup(p);
+            if (NULL == patterns[count])
+            {
+                break;
+            }
+            count++;
+        }
+    }
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Reports the listed symbols in the order of the list.
+*
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+    elf_t elf = { 0 };
+    const section_t *symtab = NULL;
+    const section_t *strtab;
+    char *patterns[LIST_MAX];
+    uint32_t count;
+    uint32_t ram = 0U;
+    uint32_t flash = 0U;
+    uint32_t absent = 0U;
+    uint64_t bytes[2][2] = { { 0U } };      /* [ram][code] */
+    bool check = false;
+    FILE *in;
+    uint8_t *buf;
+    int arg;
+
+    for (arg = 1; (arg < argc) && (argv[arg][0] == '-'); arg++)
+    {
+        if (0 == strcmp(argv[arg], "-c"))
+        {
+            check = true;
+        }
+        else if ((0 == strcmp(argv[arg], "-R")) && ((arg + 1) < argc) && (ram_section_count < OPTION_MAX))
+        {
+            ram_sections[ram_section_count++] = argv[++arg];
+        }
+        else if ((0 == strcmp(argv[arg], "-i")) && ((arg + 1) < argc) && (ignore_count < OPTION_MAX))
+        {
+            ignore_patterns[ignore_count++] = argv[++arg];
+        }
+        else
+        {
+            break;
+        }
+    }
+    if ((argc - arg) != 2)
+    {
+        fprintf(stderr, "usage: %s [-c] [-R section]... [-i pattern]... list elf\n", argv[0]);
+        return 2;
+    }
+
+    in = fopen(argv[arg], "r");
+    if (NULL == in)
+    {
+        fprintf(stderr, "cannot open %s\n", argv[arg]);
+        return 2;
+    }
+    count = read_list(in, patterns);
+    fclose(in);
+
+    in = fopen(argv[arg + 1], "rb");
+    if (NULL == in)
+    {
+        fprintf(stderr, "cannot open %s\n", argv[arg + 1]);
+        return 2;
+    }
+    buf = malloc(INPUT_MAX);
+    if (NULL == buf)
+    {
+        return 2;
+    }
+    elf.size = fread(buf, 1U, INPUT_MAX, in);
+    elf.buf = buf;
+    fclose(in);
+
+    if (!elf_load(&elf))
+    {
+        fprintf(stderr, "%s is not a little endian ELF file\n", argv[arg + 1]);
+        return 2;
+    }
+    for (uint32_t i = 0U; i < elf.secs; i++)
+    {
+        if ((elf.sec[i].type == SHT_SYMTAB) && (elf.sec[i].link < elf.secs))
+        {
+            symtab = &elf.sec[i];
+        }
+    }
+    if ((NULL == symtab) || (symtab->entsize < (elf.is64 ? 24U : 16U)) ||
+        !in_file(&elf, symtab->offset, symtab->size))
+    {
+        fprintf(stderr, "%s has no symbol table, link without -s\n", argv[arg + 1]);
+        return 2;
+    }
+    strtab = &elf.sec[symtab->link];
+    if (!in_file(&elf, strtab->offset, strtab->size))
+    {
+        return 2;
+    }
+
+    printf("%-36s %-4s %6s %-18s %-16s %s\n", "symbol", "type", "size", "address", "section", "place");
+    for (uint32_t n = 0U; n < count; n++)
+    {
+        bool found = false;
+
+        for (uint64_t off = 0U; (off + symtab->entsize) <= symtab->size; off += symtab->entsize)
+        {
+            const uint8_t *s = &elf.buf[symtab->offset + off];
+            uint32_t name = get_u32(&s[0]);
+            uint32_t info = s[elf.is64 ? 4 : 12];
+            uint32_t shndx = get_u16(&s[elf.is64 ? 6 : 14]);
+            uint64_t addr = get_addr(&elf, &s[elf.is64 ? 8 : 4]);
+            uint64_t size = get_addr(&elf, &s[elf.is64 ? 16 : 8]);
+            uint32_t type = info & 0xFU;
+            const char *sym;
+            bool code = (type == STT_FUNC);
+            bool place;
+
+            if (((type != STT_FUNC) && (type != STT_OBJECT)) || (shndx == 0U) || (shndx >= SHN_LORESERVE) ||
+                (shndx >= elf.secs) || (name >= strtab->size) || ((elf.sec[shndx].flags & SHF_ALLOC) == 0U))
+            {
+                continue;
+            }
+            sym = (const char *)&elf.buf[strtab->offset + name];
+            if (!matches(patterns[n], sym) || ignored(sym))
+            {
+                continue;
+            }
+
+            /* Thumb functions have bit 0 of the address set */
+            if (code && (elf.machine == EM_ARM))
+            {
+                addr &= ~(uint64_t)1U;
+            }
+            place = in_ram(&elf, &elf.sec[shndx], addr);
+            found = true;
+            if (place)
+            {
+                ram++;
+            }
+            else
+            {
+                flash++;
+            }
+            bytes[place ? 1 : 0][code ? 1 : 0] += size;
+
+            printf("%-36s %-4s %6llu 0x%016llx %-16s %s\n", sym, code ? "func" : "data", (unsigned long long)size,
+                   (unsigned long long)addr, elf.sec[shndx].name, place ? "ram" : "flash");
+        }
+
+        if (!found)
+        {
+            absent++;
+            printf("%-36s %-4s %6s %-18s %-16s %s\n", patterns[n], "-", "-", "-", "-", "absent");
+        }
+    }
+
+    printf("hot_path ram=%u flash=%u absent=%u ram_code=%llu ram_data=%llu flash_code=%llu flash_data=%llu\n",
+           ram, flash, absent, (unsigned long long)bytes[1][1], (unsigned long long)bytes[1][0],
+           (unsigned long long)bytes[0][1], (unsigned long long)bytes[0][0]);
+
+    return (check && (flash > 0U)) ? 1 : 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,940 @@
+/*******************************************************************************
+* File Name: hw_model.c
+*
+* Description:
+* Behavioral model of the PSOC Control C3 peripherals used by the application:
+* TCPWM counters and PWMs, GPIO, NVIC/SysInt and the debug UART. It implements
+* the PDL shim functions and holds the Device Configurator generated
+* configuration structures.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <math.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include "cybsp.h"
+#include "cy_retarget_io.h"
+#include "sim.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CNT_MAX                 (9U)
+#define IRQ_MAX                 (256U)
+#define CNT_INDEX(num)          ((((num) >> 8U) * 3U) + ((num) & 0xFFU))
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    bool      enabled;
+    bool      running;
+    uint32_t  period;
+    uint32_t  compare0;
+    uint32_t  int_mask;
+    double    clk_hz;
+    double    start_time;
+    uint32_t  counter;          /* Counter value loaded at the next start. */
+    double    next_tc;          /* Next terminal count, s. */
+    double    next_edge;        /* Next line output edge, s. */
+    bool      line;             /* Line output level. */
+    IRQn_Type irq;              /* Interrupt raised on terminal count, -1 if none. */
+} sim_cnt_t;
+
+typedef struct
+{
+    cy_israddress handler;
+    uint32_t      priority;
+    bool          enabled;
+    bool          pending;
+} sim_irq_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+TCPWM_Type     sim_tcpwm0;
+GPIO_PRT_Type  sim_gpio_prt[10];
+CySCB_Type     sim_scb3;
+uint32_t       sim_hw_changes;
+DCB_Type       sim_dcb;
+DWT_Type       sim_dwt;
+SCB_Type       sim_scb;
+uint32_t       SystemCoreClock = (uint32_t)SIM_CPU_CLK_HZ;
+
+/* Device Configurator generated configuration (design.modus). */
+const cy_stc_tcpwm_pwm_config_t PWM_BUCK_1_config =
+{
+    .period0 = SIM_PWM_BUCK_PERIOD, .compare0 = SIM_PWM_BUCK_COMPARE, .interruptSources = CY_TCPWM_INT_NONE
+};
+const cy_stc_tcpwm_pwm_config_t PWM_BUCK_2_config =
+{
+    .period0 = SIM_PWM_BUCK_PERIOD, .compare0 = SIM_PWM_BUCK_COMPARE, .interruptSources = CY_TCPWM_INT_NONE
+};
+const cy_stc_tcpwm_pwm_config_t PWM_LOAD_config =
+{
+    .period0 = SIM_LOAD_PERIOD, .compare0 = SIM_LOAD_COMPARE, .interruptSources = CY_TCPWM_INT_NONE
+};
+const cy_stc_tcpwm_counter_config_t SOFT_START_COUNTER_config =
+{
+    .period = SIM_SOFT_START_PERIOD, .compare0 = 16384U, .interruptSources = CY_TCPWM_INT_ON_TC
+};
+const cy_stc_tcpwm_pwm_config_t PWM_STATUS_LED_config =
+{
+    .period0 = 10000U, .compare0 = 5000U, .interruptSources = CY_TCPWM_INT_NONE
+};
+const cy_stc_tcpwm_pwm_config_t PWM_ACT_LED_config =
+{
+    .period0 = 10000U, .compare0 = 0U, .interruptSources = CY_TCPWM_INT_NONE
+};
+const cy_stc_scb_uart_config_t DEBUG_UART_config = { .oversample = 8U };
+const mtb_hal_uart_configurator_t DEBUG_UART_hal_config = { .base = &sim_scb3 };
+
+uint64_t sim_step;
+double   sim_time;
+FILE    *sim_uart_out;
+uint64_t sim_uart_bytes;
+
+static sim_cnt_t sim_cnt[CNT_MAX];
+static sim_irq_t sim_irq[IRQ_MAX];
+static uint32_t  sim_irq_pending_count;
+static bool      sim_primask;
+static sim_cnt_t *sim_soft_start_cnt = &sim_cnt[CNT_INDEX(SOFT_START_COUNTER_NUM)];
+static sim_cnt_t *sim_load_cnt = &sim_cnt[CNT_INDEX(PWM_LOAD_NUM)];
+static cy_stc_scb_uart_context_t *sim_uart_ctx;    /* Transfer in progress, NULL if none. */
+static double    sim_uart_done;                     /* End of the transfer, s. */
+
+/* Receive side: characters sent by the scenario, the RX FIFO and its
+ * not-empty interrupt. */
+static char      sim_uart_input[SIM_UART_RX_INPUT];
+static uint32_t  sim_uart_input_len;
+static uint32_t  sim_uart_input_pos;
+static double    sim_uart_rx_next;                  /* End of the next character, s. */
+static uint8_t   sim_uart_rx_fifo[SIM_UART_RX_FIFO];
+static uint32_t  sim_uart_rx_head;
+static uint32_t  sim_uart_rx_count;
+static uint32_t  sim_uart_rx_mask;
+static uint32_t  sim_uart_rx_overruns;
+static uint32_t  sim_cycles;                        /* CYCCNT at the start of the period. */
+static double    sim_hw_next;                       /* Earliest counter or UART event, s. */
+
+/*******************************************************************************
+* Function Name: cnt_get
+********************************************************************************
+* Summary:
+* Returns the model of a TCPWM counter.
+*
+*******************************************************************************/
+static sim_cnt_t *cnt_get(uint32_t cntNum)
+{
+    uint32_t idx = CNT_INDEX(cntNum);
+
+    CY_ASSERT(idx < CNT_MAX);
+    return &sim_cnt[idx];
+}
+
+/*******************************************************************************
+* Function Name: irq_set_pending
+********************************************************************************
+* Summary:
+* Marks an interrupt as pending.
+*
+*******************************************************************************/
+static void irq_set_pending(IRQn_Type irqn)
+{
+    CY_ASSERT((irqn >= 0) && ((uint32_t)irqn < IRQ_MAX));
+    if (!sim_irq[irqn].pending)
+    {
+        sim_irq[irqn].pending = true;
+        sim_irq_pending_count++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: hw_model_reset
+********************************************************************************
+* Summary:
+* Resets all peripheral models and the simulated time.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hw_model_reset(void)
+{
+    memset(sim_cnt, 0, sizeof(sim_cnt));
+    memset(sim_irq, 0, sizeof(sim_irq));
+    memset(sim_gpio_prt, 0, sizeof(sim_gpio_prt));
+    sim_irq_pending_count = 0U;
+    sim_primask = true;
+    sim_step = 0U;
+    sim_time = 0.0;
+    sim_uart_bytes = 0U;
+    sim_uart_ctx = NULL;
+    sim_uart_input_len = 0U;
+    sim_uart_input_pos = 0U;
+    sim_uart_rx_head = 0U;
+    sim_uart_rx_count = 0U;
+    sim_uart_rx_mask = 0U;
+    sim_uart_rx_overruns = 0U;
+    sim_cycles = 0U;
+    sim_hw_next = 0.0;
+    memset(&sim_dcb, 0, sizeof(sim_dcb));
+    memset(&sim_dwt, 0, sizeof(sim_dwt));
+    memset(&sim_scb, 0, sizeof(sim_scb));
+
+    for (uint32_t i = 0U; i < CNT_MAX; i++)
+    {
+        sim_cnt[i].irq = -1;
+        sim_cnt[i].clk_hz = 10.0e3;
+    }
+    cnt_get(PWM_BUCK_1_NUM)->clk_hz = SIM_PWM_CLK_HZ;
+    cnt_get(PWM_BUCK_2_NUM)->clk_hz = SIM_PWM_CLK_HZ;
+    cnt_get(SOFT_START_COUNTER_NUM)->clk_hz = 1.0e6;
+    cnt_get(SOFT_START_COUNTER_NUM)->irq = SOFT_START_COUNTER_IRQ;
+}
+
+/*******************************************************************************
+* Function Name: cycles_advance
+********************************************************************************
+* Summary:
+* Advances the DWT cycle counter to the given count unless the handlers have
+* already run past it.
+*
+*******************************************************************************/
+static void cycles_advance(uint32_t cycles)
+{
+    if ((int32_t)(cycles - sim_dwt.CYCCNT) > 0)
+    {
+        sim_dwt.CYCCNT = cycles;
+    }
+}
+
+/*******************************************************************************
+* Function Name: hw_model_events
+********************************************************************************
+* Summary:
+* Executes the events of the counters and the debug UART that are due and
+* returns the time of the next one. A counter start or a UART transfer or input
+* sets sim_hw_next to zero, so that the events are scheduled again.
+*
+*******************************************************************************/
+static double hw_model_events(void)
+{
+    sim_cnt_t *cnt = sim_soft_start_cnt;
+    double next = HUGE_VAL;
+
+    if (cnt->running && (sim_time >= cnt->next_tc))
+    {
+        cnt->next_tc += (double)cnt->period / cnt->clk_hz;
+        if ((0UL != (cnt->int_mask & CY_TCPWM_INT_ON_TC)) && (cnt->irq >= 0))
+        {
+            irq_set_pending(cnt->irq);
+        }
+    }
+
+    cnt = sim_load_cnt;
+    if (cnt->running && (sim_time >= cnt->next_edge))
+    {
+        cnt->line = !cnt->line;
+        sim_hw_changes++;
+        cnt->next_edge += (double)(cnt->line ? cnt->compare0 : (cnt->period - cnt->compare0)) / cnt->clk_hz;
+    }
+
+    /* The transfer is written out when its last byte has left the UART, the
+     * interrupt of the high-level API then ends it. */
+    if ((NULL != sim_uart_ctx) && (sim_time >= sim_uart_done))
+    {
+        if (NULL != sim_uart_out)
+        {
+            fwrite(sim_uart_ctx->txBuf, 1U, sim_uart_ctx->txBufSize, sim_uart_out);
+        }
+        sim_uart_bytes += sim_uart_ctx->txBufSize;
+        sim_uart_ctx = NULL;
+        irq_set_pending(DEBUG_UART_IRQ);
+    }
+
+    /* Received characters enter the RX FIFO at the baud rate, a character
+     * arriving at a full FIFO is lost. */
+    while ((sim_uart_input_pos < sim_uart_input_len) && (sim_time >= sim_uart_rx_next))
+    {
+        if (sim_uart_rx_count < SIM_UART_RX_FIFO)
+        {
+            sim_uart_rx_fifo[(sim_uart_rx_head + sim_uart_rx_count) % SIM_UART_RX_FIFO] =
+                (uint8_t)sim_uart_input[sim_uart_input_pos];
+            sim_uart_rx_count++;
+        }
+        else
+        {
+            sim_uart_rx_overruns++;
+        }
+        sim_uart_input_pos++;
+        sim_uart_rx_next += 10.0 / SIM_UART_BAUD;
+        if (0UL != (sim_uart_rx_mask & CY_SCB_UART_RX_NOT_EMPTY))
+        {
+            irq_set_pending(DEBUG_UART_IRQ);
+        }
+    }
+
+    if (sim_soft_start_cnt->running && (sim_soft_start_cnt->next_tc < next))
+    {
+        next = sim_soft_start_cnt->next_tc;
+    }
+    if (sim_load_cnt->running && (sim_load_cnt->next_edge < next))
+    {
+        next = sim_load_cnt->next_edge;
+    }
+    if ((NULL != sim_uart_ctx) && (sim_uart_done < next))
+    {
+        next = sim_uart_done;
+    }
+    if ((sim_uart_input_pos < sim_uart_input_len) && (sim_uart_rx_next < next))
+    {
+        next = sim_uart_rx_next;
+    }
+    return next;
+}
+
+/*******************************************************************************
+* Function Name: hw_model_step
+********************************************************************************
+* Summary:
+* Advances the event driven counters (soft start timer and transient load PWM)
+* and the debug UART transfer to the current simulated time and raises their
+* interrupts. The models are only updated at the time of their next event.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hw_model_step(void)
+{
+    if (0UL != (sim_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        sim_cycles += SIM_CPU_CYCLES_PER_STEP;
+        cycles_advance(sim_cycles);
+    }
+
+    if (sim_time >= sim_hw_next)
+    {
+        sim_hw_next = hw_model_events();
+    }
+}
+
+/*******************************************************************************
+* Function Name: irq_service_pending
+********************************************************************************
+* Summary:
+* Executes the pending and enabled interrupt handlers in priority order.
+*
+*******************************************************************************/
+static void irq_service_pending(void)
+{
+    while ((0U != sim_irq_pending_count) && (!sim_primask))
+    {
+        int32_t best = -1;
+
+        for (uint32_t i = 0U; i < IRQ_MAX; i++)
+        {
+            if (sim_irq[i].pending && sim_irq[i].enabled && (NULL != sim_irq[i].handler) &&
+                ((best < 0) || (sim_irq[i].priority < sim_irq[best].priority)))
+            {
+                best = (int32_t)i;
+            }
+        }
+        if (best < 0)
+        {
+            break;
+        }
+        sim_irq[best].pending = false;
+        sim_irq_pending_count--;
+        if (0UL != (sim_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk))
+        {
+            sim_dwt.CYCCNT += SIM_IRQ_ENTRY_CYCLES;
+        }
+        sim_irq[best].handler();
+    }
+}
+
+/*******************************************************************************
+* Function Name: hw_model_service_irqs
+********************************************************************************
+* Summary:
+* Executes the pending and enabled interrupt handlers in priority order, then
+* the pending PendSV exception, until neither is pending. The handlers do not
+* nest.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hw_model_service_irqs(void)
+{
+    for (;;)
+    {
+        irq_service_pending();
+        if (sim_primask || (0UL == (sim_scb.ICSR & SCB_ICSR_PENDSVSET_Msk)))
+        {
+            break;
+        }
+        sim_scb.ICSR &= ~SCB_ICSR_PENDSVSET_Msk;
+        PendSV_Handler();
+    }
+}
+
+/*******************************************************************************
+* Function Name: hw_model_main_loop
+********************************************************************************
+* Summary:
+* Called before the pass of the main loop. The pass runs in the time the
+* interrupts leave, at the end of the period, so the DWT cycle counter
+* advances to the end of the period.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hw_model_main_loop(void)
+{
+    if (0UL != (sim_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        cycles_advance(sim_cycles + SIM_CPU_CYCLES_PER_STEP);
+    }
+}
+
+/*******************************************************************************
+* Function Name: hw_model_button_press
+********************************************************************************
+* Summary:
+* Simulates a press of USER_BTN by raising the GPIO interrupt.
+*
+*******************************************************************************/
+void hw_model_button_press(void)
+{
+    irq_set_pending(USER_BUTTON_IRQ);
+}
+
+/*******************************************************************************
+* Function Name: hw_model_pwm_running / compare / period
+********************************************************************************
+* Summary:
+* Accessors used by the converter model and the harness.
+*
+*******************************************************************************/
+bool hw_model_pwm_running(uint32_t cntNum)
+{
+    return cnt_get(cntNum)->running;
+}
+
+uint32_t hw_model_pwm_compare(uint32_t cntNum)
+{
+    return cnt_get(cntNum)->compare0;
+}
+
+uint32_t hw_model_pwm_period(uint32_t cntNum)
+{
+    return cnt_get(cntNum)->period;
+}
+
+bool hw_model_load_line(void)
+{
+    return sim_load_cnt->running && sim_load_cnt->line;
+}
+
+bool hw_model_fault_led_on(void)
+{
+    /* FAULT_LED is active low. */
+    return 0UL == Cy_GPIO_Read(FAULT_LED_PORT, FAULT_LED_NUM);
+}
+
+uint64_t hw_model_host_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Core and NVIC
+*******************************************************************************/
+void sim_assert_failed(const char *file, int line)
+{
+    fprintf(stderr, "CY_ASSERT failed at %s:%d (t=%.6f s)\n", file, line, sim_time);
+    exit(2);
+}
+
+void __enable_irq(void)
+{
+    sim_primask = false;
+}
+
+void __disable_irq(void)
+{
+    sim_primask = true;
+}
+
+uint32_t __get_PRIMASK(void)
+{
+    return sim_primask ? 1UL : 0UL;
+}
+
+void __set_PRIMASK(uint32_t priMask)
+{
+    sim_primask = (0UL != priMask);
+}
+
+void NVIC_EnableIRQ(IRQn_Type irqn)
+{
+    sim_irq[irqn].enabled = true;
+}
+
+void NVIC_DisableIRQ(IRQn_Type irqn)
+{
+    sim_irq[irqn].enabled = false;
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type irqn)
+{
+    if (sim_irq[irqn].pending)
+    {
+        sim_irq[irqn].pending = false;
+        sim_irq_pending_count--;
+    }
+}
+
+void NVIC_SetPendingIRQ(IRQn_Type irqn)
+{
+    irq_set_pending(irqn);
+}
+
+uint32_t NVIC_GetEnableIRQ(IRQn_Type irqn)
+{
+    return sim_irq[irqn].enabled ? 1UL : 0UL;
+}
+
+void NVIC_SetPriority(IRQn_Type irqn, uint32_t priority)
+{
+    /* PendSV always runs after the interrupts. */
+    if (irqn >= 0)
+    {
+        sim_irq[irqn].priority = priority;
+    }
+}
+
+cy_rslt_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress userIsr)
+{
+    sim_irq[config->intrSrc].handler = userIsr;
+    sim_irq[config->intrSrc].priority = config->intrPriority;
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* TCPWM
+*******************************************************************************/
+cy_rslt_t Cy_TCPWM_PWM_Init(TCPWM_Type *base, uint32_t cntNum, cy_stc_tcpwm_pwm_config_t const *config)
+{
+    sim_hw_changes++;
+    sim_cnt_t *cnt = cnt_get(cntNum);
+
+    (void)base;
+    cnt->period = config->period0;
+    cnt->compare0 = config->compare0;
+    cnt->int_mask = config->interruptSources;
+    return CY_RSLT_SUCCESS;
+}
+
+void Cy_TCPWM_PWM_Enable(TCPWM_Type *base, uint32_t cntNum)
+{
+    sim_hw_changes++;
+    (void)base;
+    cnt_get(cntNum)->enabled = true;
+}
+
+void Cy_TCPWM_PWM_Disable(TCPWM_Type *base, uint32_t cntNum)
+{
+    sim_hw_changes++;
+    sim_cnt_t *cnt = cnt_get(cntNum);
+
+    (void)base;
+    cnt->enabled = false;
+    cnt->running = false;
+    cnt->line = false;
+}
+
+void Cy_TCPWM_PWM_SetCompare0Val(TCPWM_Type *base, uint32_t cntNum, uint32_t compare0)
+{
+    sim_hw_changes++;
+    (void)base;
+    cnt_get(cntNum)->compare0 = compare0;
+}
+
+void Cy_TCPWM_PWM_SetPeriod0(TCPWM_Type *base, uint32_t cntNum, uint32_t period0)
+{
+    sim_hw_changes++;
+    (void)base;
+    cnt_get(cntNum)->period = period0;
+}
+
+uint32_t Cy_TCPWM_PWM_GetCompare0Val(TCPWM_Type const *base, uint32_t cntNum)
+{
+    (void)base;
+    return cnt_get(cntNum)->compare0;
+}
+
+uint32_t Cy_TCPWM_PWM_GetPeriod0(TCPWM_Type const *base, uint32_t cntNum)
+{
+    (void)base;
+    return cnt_get(cntNum)->period;
+}
+
+uint32_t Cy_TCPWM_PWM_GetCounter(TCPWM_Type const *base, uint32_t cntNum)
+{
+    sim_cnt_t *cnt = cnt_get(cntNum);
+    uint64_t ticks;
+
+    (void)base;
+    if ((!cnt->running) || (0U == cnt->period))
+    {
+        return 0UL;
+    }
+    ticks = (uint64_t)((sim_time - cnt->start_time) * cnt->clk_hz);
+    return (uint32_t)(ticks % cnt->period);
+}
+
+void Cy_TCPWM_PWM_SetCounter(TCPWM_Type *base, uint32_t cntNum, uint32_t count)
+{
+    (void)base;
+    cnt_get(cntNum)->counter = count;
+}
+
+cy_rslt_t Cy_TCPWM_Counter_Init(TCPWM_Type *base, uint32_t cntNum, cy_stc_tcpwm_counter_config_t const *config)
+{
+    sim_cnt_t *cnt = cnt_get(cntNum);
+
+    (void)base;
+    cnt->period = config->period;
+    cnt->compare0 = config->compare0;
+    cnt->int_mask = config->interruptSources;
+    return CY_RSLT_SUCCESS;
+}
+
+void Cy_TCPWM_Counter_Enable(TCPWM_Type *base, uint32_t cntNum)
+{
+    Cy_TCPWM_PWM_Enable(base, cntNum);
+}
+
+void Cy_TCPWM_Counter_Disable(TCPWM_Type *base, uint32_t cntNum)
+{
+    Cy_TCPWM_PWM_Disable(base, cntNum);
+}
+
+uint32_t Cy_TCPWM_Counter_GetCounter(TCPWM_Type const *base, uint32_t cntNum)
+{
+    return Cy_TCPWM_PWM_GetCounter(base, cntNum);
+}
+
+void Cy_TCPWM_Counter_SetPeriod(TCPWM_Type *base, uint32_t cntNum, uint32_t period)
+{
+    (void)base;
+    cnt_get(cntNum)->period = period;
+}
+
+void Cy_TCPWM_TriggerStart_Single(TCPWM_Type *base, uint32_t cntNum)
+{
+    sim_hw_changes++;
+    sim_cnt_t *cnt = cnt_get(cntNum);
+
+    (void)base;
+    if (cnt->enabled && (!cnt->running))
+    {
+        cnt->running = true;
+        cnt->start_time = sim_time - ((double)cnt->counter / cnt->clk_hz);
+        cnt->counter = 0U;
+        cnt->next_tc = cnt->start_time + ((double)cnt->period / cnt->clk_hz);
+        cnt->line = (cnt->compare0 > 0U);
+        cnt->next_edge = sim_time + ((double)cnt->compare0 / cnt->clk_hz);
+        sim_hw_next = 0.0;
+    }
+}
+
+void Cy_TCPWM_TriggerStopOrKill_Single(TCPWM_Type *base, uint32_t cntNum)
+{
+    sim_hw_changes++;
+    sim_cnt_t *cnt = cnt_get(cntNum);
+
+    (void)base;
+    cnt->running = false;
+    cnt->line = false;
+}
+
+/* A reload restarts the PWM counter from zero, also while it is running. */
+void Cy_TCPWM_TriggerReloadOrIndex_Single(TCPWM_Type *base, uint32_t cntNum)
+{
+    sim_cnt_t *cnt = cnt_get(cntNum);
+
+    cnt->running = false;
+    cnt->counter = 0U;
+    Cy_TCPWM_TriggerStart_Single(base, cntNum);
+}
+
+void Cy_TCPWM_ClearInterrupt(TCPWM_Type *base, uint32_t cntNum, uint32_t source)
+{
+    (void)base;
+    (void)cntNum;
+    (void)source;
+}
+
+/*******************************************************************************
+* GPIO
+*******************************************************************************/
+void Cy_GPIO_Set(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    base->out |= (1UL << pinNum);
+}
+
+void Cy_GPIO_Clr(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    base->out &= ~(1UL << pinNum);
+}
+
+void Cy_GPIO_Inv(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    base->out ^= (1UL << pinNum);
+}
+
+uint32_t Cy_GPIO_Read(GPIO_PRT_Type const *base, uint32_t pinNum)
+{
+    return (base->out >> pinNum) & 1UL;
+}
+
+void Cy_GPIO_ClearInterrupt(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    (void)base;
+    (void)pinNum;
+}
+
+/*******************************************************************************
+* SCB UART, HAL and retarget-io
+*******************************************************************************/
+cy_en_scb_uart_status_t Cy_SCB_UART_Init(CySCB_Type *base, cy_stc_scb_uart_config_t const *config,
+                                         cy_stc_scb_uart_context_t *context)
+{
+    (void)base;
+    (void)config;
+    context->txStatus = 0UL;
+    return CY_SCB_UART_SUCCESS;
+}
+
+void Cy_SCB_UART_Enable(CySCB_Type *base)
+{
+    (void)base;
+}
+
+uint32_t Cy_SCB_UART_PutArray(CySCB_Type *base, void *buffer, uint32_t size)
+{
+    (void)base;
+    if (NULL != sim_uart_out)
+    {
+        fwrite(buffer, 1U, size, sim_uart_out);
+    }
+    sim_uart_bytes += size;
+    return size;
+}
+
+void Cy_SCB_UART_PutArrayBlocking(CySCB_Type *base, void *buffer, uint32_t size)
+{
+    (void)Cy_SCB_UART_PutArray(base, buffer, size);
+}
+
+cy_en_scb_uart_status_t Cy_SCB_UART_Transmit(CySCB_Type *base, void *buffer, uint32_t size,
+                                             cy_stc_scb_uart_context_t *context)
+{
+    (void)base;
+    if (0UL != (context->txStatus & CY_SCB_UART_TRANSMIT_ACTIVE))
+    {
+        return CY_SCB_UART_TRANSMIT_BUSY;
+    }
+    context->txStatus = CY_SCB_UART_TRANSMIT_ACTIVE;
+    context->txBuf = buffer;
+    context->txBufSize = size;
+    sim_uart_ctx = context;
+    sim_uart_done = sim_time + ((double)size * 10.0 / SIM_UART_BAUD);
+    sim_hw_next = 0.0;
+    return CY_SCB_UART_SUCCESS;
+}
+
+uint32_t Cy_SCB_UART_GetTransmitStatus(CySCB_Type const *base, cy_stc_scb_uart_context_t const *context)
+{
+    (void)base;
+    return context->txStatus;
+}
+
+void Cy_SCB_UART_Interrupt(CySCB_Type *base, cy_stc_scb_uart_context_t *context)
+{
+    (void)base;
+    if (sim_uart_ctx != context)
+    {
+        context->txStatus &= ~CY_SCB_UART_TRANSMIT_ACTIVE;
+    }
+}
+
+uint32_t Cy_SCB_UART_GetArray(CySCB_Type const *base, void *buffer, uint32_t size)
+{
+    uint8_t *dst = (uint8_t *)buffer;
+    uint32_t n = 0U;
+
+    (void)base;
+    while ((n < size) && (sim_uart_rx_count > 0U))
+    {
+        dst[n++] = sim_uart_rx_fifo[sim_uart_rx_head];
+        sim_uart_rx_head = (sim_uart_rx_head + 1U) % SIM_UART_RX_FIFO;
+        sim_uart_rx_count--;
+    }
+    return n;
+}
+
+/* The not-empty status is set again while the FIFO holds data. */
+void Cy_SCB_UART_ClearRxFifoStatus(CySCB_Type *base, uint32_t clearMask)
+{
+    (void)base;
+    (void)clearMask;
+}
+
+void Cy_SCB_SetRxInterruptMask(CySCB_Type *base, uint32_t interruptMask)
+{
+    (void)base;
+    sim_uart_rx_mask = interruptMask;
+    if ((0UL != (sim_uart_rx_mask & CY_SCB_UART_RX_NOT_EMPTY)) && (sim_uart_rx_count > 0U))
+    {
+        irq_set_pending(DEBUG_UART_IRQ);
+    }
+}
+
+/*******************************************************************************
+* Function Name: hw_model_uart_input
+********************************************************************************
+* Summary:
+* Sends characters to DEBUG_UART. They are received one after the other at the
+* baud rate, after the characters sent before.
+*
+*******************************************************************************/
+void hw_model_uart_input(const char *text)
+{
+    size_t len = strlen(text);
+
+    if (sim_uart_input_pos == sim_uart_input_len)
+    {
+        sim_uart_input_pos = 0U;
+        sim_uart_input_len = 0U;
+        sim_uart_rx_next = sim_time + (10.0 / SIM_UART_BAUD);
+    }
+    if ((sim_uart_input_len + len) > SIM_UART_RX_INPUT)
+    {
+        len = SIM_UART_RX_INPUT - sim_uart_input_len;
+    }
+    memcpy(&sim_uart_input[sim_uart_input_len], text, len);
+    sim_uart_input_len += (uint32_t)len;
+    sim_hw_next = 0.0;
+}
+
+uint32_t hw_model_uart_rx_overruns(void)
+{
+    return sim_uart_rx_overruns;
+}
+
+cy_rslt_t mtb_hal_uart_setup(mtb_hal_uart_t *obj, const mtb_hal_uart_configurator_t *config,
+                             cy_stc_scb_uart_context_t *context, const void *clk)
+{
+    (void)context;
+    (void)clk;
+    obj->base = config->base;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_retarget_io_init(mtb_hal_uart_t *obj)
+{
+    (void)obj;
+    return CY_RSLT_SUCCESS;
+}
+
+int sim_uart_printf(const char *format, ...)
+{
+    char buf[512];
+    va_list args;
+    int n;
+
+    va_start(args, format);
+    n = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    if (n > 0)
+    {
+        (void)Cy_SCB_UART_PutArray(&sim_scb3, buf, ((uint32_t)n < sizeof(buf)) ? (uint32_t)n : (uint32_t)(sizeof(buf) - 1U));
+    }
+    return n;
+}
+
+/*******************************************************************************
+* Function Name: cybsp_init
+********************************************************************************
+* Summary:
+* Board initialization: configures the converter PWMs (done by the generated
+* initialization of the solutions on the target).
+*
+*******************************************************************************/
+cy_rslt_t cybsp_init(void)
+{
+    (void)Cy_TCPWM_PWM_Init(PWM_BUCK_1_HW, PWM_BUCK_1_NUM, &PWM_BUCK_1_config);
+    (void)Cy_TCPWM_PWM_Init(PWM_BUCK_2_HW, PWM_BUCK_2_NUM, &PWM_BUCK_2_config);
+    Cy_TCPWM_PWM_Enable(PWM_BUCK_1_HW, PWM_BUCK_1_NUM);
+    Cy_TCPWM_PWM_Enable(PWM_BUCK_2_HW, PWM_BUCK_2_NUM);
+    conv_model_init();
+    return CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,340 @@
+/*******************************************************************************
+* File Name: plant.c
+*
+* Description:
+* Discrete-time model of the two-phase synchronous buck power stage operated
+* in peak current control mode, with a common output or one output per phase.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "plant.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define DIODE_DROP              (0.7)       /* Body diode forward voltage, V. */
+
+/*******************************************************************************
+* Function Name: plant_init
+********************************************************************************
+* Summary:
+* Loads the default power stage parameters and resets the state to a
+* discharged output at nominal input voltage and ambient temperature.
+*
+* Parameters:
+*  plant: power stage model
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void plant_init(plant_t *plant)
+{
+    memset(plant, 0, sizeof(*plant));
+
+    for (unsigned int ph = 0U; ph < PLANT_PHASE_MAX; ph++)
+    {
+        plant->p.l[ph] = SIM_L0_INDUCTANCE;
+        plant->p.k_sense[ph] = 1.0;
+    }
+    plant->p.r_l          = SIM_L0_ESR;
+    plant->p.c            = SIM_C0_CAPACITANCE;
+    plant->p.esr          = SIM_C0_ESR;
+    plant->p.t_sw         = 1.0 / SIM_SWITCHING_FREQ;
+    plant->p.t_min_on     = SIM_BLANK_TIME;
+    plant->p.t_transition = 15.0e-9;
+    plant->p.p_gate       = 0.03;
+    plant->p.r_th         = SIM_THERMAL_RES;
+    plant->p.tau_th       = SIM_THERMAL_TAU;
+    plant->outputs        = SIM_OUTPUTS;
+
+    plant_update(plant);
+
+    plant->vin       = SIM_VIN_NOM;
+    plant->t_ambient = SIM_TEMP_AMBIENT;
+    plant->temp      = SIM_TEMP_AMBIENT;
+}
+
+/*******************************************************************************
+* Function Name: plant_update
+********************************************************************************
+* Summary:
+* Recomputes the derived constants after a change of plant->p.
+*
+* Parameters:
+*  plant: power stage model
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void plant_update(plant_t *plant)
+{
+    for (unsigned int ph = 0U; ph < PLANT_PHASE_MAX; ph++)
+    {
+        plant->inv_l[ph] = 1.0 / plant->p.l[ph];
+        plant->r_over_l[ph] = plant->p.r_l / plant->p.l[ph];
+        plant->inv_k_sense[ph] = 1.0 / plant->p.k_sense[ph];
+    }
+    plant->inv_t_sw      = 1.0 / plant->p.t_sw;
+    plant->half_inv_t_sw = 0.5 / plant->p.t_sw;
+    /* With two outputs, each has half the output capacitance. The output
+     * voltage follows the capacitor and the ESR drop of the same current. */
+    plant->t_over_c      = plant->p.t_sw / plant->p.c * (double)plant->outputs;
+    plant->k_vout        = plant->t_over_c + (plant->p.esr * (double)plant->outputs);
+    plant->k_switching   = plant->p.t_transition / plant->p.t_sw;
+    plant->t_loss_over_tau = plant->p.t_sw * (double)PLANT_LOSS_PERIODS / plant->p.tau_th;
+}
+
+/*******************************************************************************
+* Function Name: phase_step
+********************************************************************************
+* Summary:
+* Advances one phase by one switching period. The high side switch turns on at
+* the start of the period and is turned off by the CSG comparator when the
+* inductor current reaches the peak reference, or by the PWM compare value at
+* the maximum duty cycle. An inactive phase freewheels through the body diodes.
+*
+* Parameters:
+*  plant: power stage model
+*  ph:    phase index
+*  in:    phase inputs for this period
+*
+* Return:
+*  double: average input current drawn by the phase
+*
+*******************************************************************************/
+static double phase_step(plant_t *plant, unsigned int ph, const plant_phase_input_t *in)
+{
+    const double t     = plant->p.t_sw;
+    const double inv_l = plant->inv_l[ph];
+    const double i0    = plant->il[ph];
+    const double vout  = ((plant->outputs > 1U) && (ph > 0U)) ? plant->vout2 : plant->vout;
+    const double v_l   = vout * inv_l;
+    const double t_max = in->d_max * t;
+    bool trip;
+    double t_on;
+    double t_off;
+    double i_pk;
+    double i_end;
+    double i_avg;
+    double m1;
+    double m2;
+
+    if (!in->active)
+    {
+        /* Both switches off: current decays through the body diodes. */
+        if (i0 > 0.0)
+        {
+            m2 = (vout + DIODE_DROP) * inv_l;
+            i_end = i0 - (m2 * t);
+            if (i_end < 0.0)
+            {
+                double t0 = i0 / m2;
+                i_avg = i0 * t0 * plant->half_inv_t_sw;
+                i_end = 0.0;
+            }
+            else
+            {
+                i_avg = 0.5 * (i0 + i_end);
+            }
+        }
+        else
+        {
+            i_end = 0.0;
+            i_avg = 0.0;
+        }
+        plant->il[ph]      = i_end;
+        plant->il_avg[ph]  = i_avg;
+        plant->il_peak[ph] = i0;
+        plant->m1[ph]      = (plant->vin * inv_l) - v_l;
+        plant->inv_m1[ph]  = (plant->m1[ph] > 0.0) ? (1.0 / plant->m1[ph]) : 0.0;
+        return 0.0;
+    }
+
+    /* The on-time slope is taken from the previous period so that its
+     * reciprocal is off the critical path; the state changes by far less
+     * than the slope accuracy within one period. The output voltage enters
+     * the slopes last, it is the latest result of the previous period. */
+    m1 = plant->m1[ph];
+    m2 = v_l + (i0 * plant->r_over_l[ph]);
+    plant->m1[ph] = ((plant->vin * inv_l) - (i0 * plant->r_over_l[ph])) - v_l;
+
+    trip = (m1 > 0.0) && (in->i_peak > i0);
+    if (trip)
+    {
+        t_on = (in->i_peak - i0) * plant->inv_m1[ph];
+    }
+    else
+    {
+        t_on = (m1 <= 0.0) ? t_max : plant->p.t_min_on;
+    }
+    plant->inv_m1[ph] = (plant->m1[ph] > 0.0) ? (1.0 / plant->m1[ph]) : 0.0;
+    if (t_on < plant->p.t_min_on)
+    {
+        t_on = plant->p.t_min_on;
+        trip = false;
+    }
+    if (t_on > t_max)
+    {
+        t_on = t_max;
+        trip = false;
+    }
+
+    /* The comparator turns the high side switch off at the peak reference. */
+    i_pk  = trip ? in->i_peak : (i0 + (m1 * t_on));
+    t_off = t - t_on;
+    i_end = i_pk - (m2 * t_off);
+
+    i_avg = (((i0 + i_pk) * t_on) + ((i_pk + i_end) * t_off)) * plant->half_inv_t_sw;
+    plant->il_avg[ph]  = i_avg;
+    plant->il_peak[ph] = i_pk;
+    plant->il[ph]      = i_end;
+
+    return (i0 + i_pk) * t_on * plant->half_inv_t_sw;
+}
+
+/*******************************************************************************
+* Function Name: plant_loss
+********************************************************************************
+* Summary:
+* Estimates the power stage loss from the currents of the last period and
+* advances the board temperature by PLANT_LOSS_PERIODS periods. The temperature
+* follows the loss with a time constant of seconds, so the loss of one period
+* in PLANT_LOSS_PERIODS stands for all of them.
+*
+* Parameters:
+*  plant: power stage model
+*  in:    inputs of each phase in the last period
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void plant_loss(plant_t *plant, const plant_phase_input_t in[PLANT_PHASE_MAX])
+{
+    double loss = 0.0;
+
+    for (unsigned int ph = 0U; ph < PLANT_PHASE_MAX; ph++)
+    {
+        double i_avg = plant->il_avg[ph];
+        double i_pk  = plant->il_peak[ph];
+        double ripple;
+
+        if (!in[ph].active)
+        {
+            /* Freewheeling through the body diodes. */
+            loss += i_avg * DIODE_DROP;
+            continue;
+        }
+
+        /* Conduction loss with the RMS current of the triangular ripple, from
+         * the peak down to the current at the end of the period. */
+        ripple = i_pk - plant->il[ph];
+        loss += ((i_avg * i_avg) + ((ripple * ripple) * (1.0 / 12.0))) * plant->p.r_l;
+
+        /* Switching loss estimate: voltage-current overlap at both edges. */
+        loss += plant->vin * (i_pk > 0.0 ? i_pk : -i_pk) * plant->k_switching;
+        loss += plant->p.p_gate;
+    }
+    plant->p_loss = loss;
+    plant->temp += ((plant->t_ambient + (loss * plant->p.r_th)) - plant->temp) * plant->t_loss_over_tau;
+}
+
+/*******************************************************************************
+* Function Name: plant_step
+********************************************************************************
+* Summary:
+* Advances the power stage by one switching period.
+*
+* Parameters:
+*  plant:  power stage model
+*  in:     inputs of each phase
+*  g_load: load conductance of each output, S
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void plant_step(plant_t *plant, const plant_phase_input_t in[PLANT_PHASE_MAX], const double g_load[PLANT_OUTPUT_MAX])
+{
+    double i_total = 0.0;
+    double i_in = 0.0;
+    double i_c;
+
+    /* The load currents follow the output voltages at the start of the period. */
+    plant->iload = plant->vout * g_load[0];
+    if (plant->outputs > 1U)
+    {
+        plant->iload2 = plant->vout2 * g_load[1];
+    }
+
+    for (unsigned int ph = 0U; ph < PLANT_PHASE_MAX; ph++)
+    {
+        i_in += phase_step(plant, ph, &in[ph]);
+        i_total += plant->il_avg[ph];
+    }
+
+    if (plant->outputs > 1U)
+    {
+        /* Phase 2 supplies output 2 only. */
+        i_total -= plant->il_avg[1];
+        i_c = plant->il_avg[1] - plant->iload2;
+        plant->vout2 = plant->vc2 + (i_c * plant->k_vout);
+        plant->vc2  += i_c * plant->t_over_c;
+        if (plant->vout2 < 0.0)
+        {
+            plant->vout2 = 0.0;
+        }
+    }
+
+    i_c = i_total - plant->iload;
+    plant->iin   = i_in;
+    plant->vout  = plant->vc + (i_c * plant->k_vout);
+    plant->vc   += i_c * plant->t_over_c;
+    if (plant->vout < 0.0)
+    {
+        plant->vout = 0.0;
+    }
+
+    if (0U == plant->loss_count)
+    {
+        plant->loss_count = PLANT_LOSS_PERIODS;
+        plant_loss(plant, in);
+    }
+    plant->loss_count--;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,124 @@
+/*******************************************************************************
+* File Name: plant.h
+*
+* Description:
+* Discrete-time model of the two-phase synchronous buck power stage operated
+* in peak current control mode. The model advances one switching period per
+* call and resolves the on and off intervals of every phase analytically. The
+* phases supply a common output, or with SIM_OUTPUTS = 2 one output each.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PLANT_H
+#define PLANT_H
+
+#include <stdbool.h>
+#include "sim_config.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PLANT_PHASE_MAX         (2U)
+#define PLANT_OUTPUT_MAX        (2U)
+#define PLANT_LOSS_PERIODS      (8U)    /* Periods per update of the loss and temperature estimate */
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Power stage parameters. Defaults come from sim_config.h. */
+typedef struct
+{
+    double l[PLANT_PHASE_MAX];  /* Inductance of each phase, H. */
+    double k_sense[PLANT_PHASE_MAX]; /* Current sense gain of each phase relative to CurSenseGain. */
+    double r_l;                 /* Inductor and switch resistance, Ohm. */
+    double c;                   /* Output capacitance, F. */
+    double esr;                 /* Output capacitor ESR, Ohm. */
+    double t_sw;                /* Switching period, s. */
+    double t_min_on;            /* Minimum on time (leading edge blanking), s. */
+    double t_transition;        /* Switching transition time for loss estimate, s. */
+    double p_gate;              /* Gate drive loss per active phase, W. */
+    double r_th;                /* Board thermal resistance, degC/W. */
+    double tau_th;              /* Board thermal time constant, s. */
+} plant_params_t;
+
+/* Power stage state. */
+typedef struct
+{
+    plant_params_t p;
+    double vin;                 /* Input voltage, V. */
+    double t_ambient;           /* Ambient temperature, degC. */
+    double il[PLANT_PHASE_MAX]; /* Inductor current at the start of the period, A. */
+    double il_avg[PLANT_PHASE_MAX]; /* Average inductor current of the last period, A. */
+    double il_peak[PLANT_PHASE_MAX];/* Peak inductor current of the last period, A. */
+    unsigned int outputs;       /* 1 - common output, 2 - output 2 supplied by phase 2. */
+    double vc;                  /* Capacitor voltage, V. */
+    double vout;                /* Output voltage (including ESR drop), V. */
+    double iload;               /* Load current of the last period, A. */
+    double vc2;                 /* Output 2 with two outputs, as above. */
+    double vout2;
+    double iload2;
+    double iin;                 /* Average input current of the last period, A. */
+    double p_loss;              /* Estimated power stage loss, updated every PLANT_LOSS_PERIODS, W. */
+    double temp;                /* Board temperature, degC. */
+    unsigned int loss_count;    /* Periods to the next loss update. */
+    double m1[PLANT_PHASE_MAX];     /* On-time current slope, A/s. */
+    double inv_m1[PLANT_PHASE_MAX];
+    double inv_l[PLANT_PHASE_MAX];  /* Derived constants, see plant_update(). */
+    double r_over_l[PLANT_PHASE_MAX];
+    double inv_k_sense[PLANT_PHASE_MAX];
+    double inv_t_sw;
+    double half_inv_t_sw;
+    double t_over_c;
+    double k_vout;
+    double k_switching;
+    double t_loss_over_tau;
+} plant_t;
+
+/* Inputs applied to one phase for one switching period. */
+typedef struct
+{
+    bool   active;              /* Phase is switching (PWM and converter enabled, d_max > 0). */
+    double i_peak;              /* Peak current reference from the CSG DAC, A. */
+    double d_max;               /* Maximum duty cycle from the PWM compare value. */
+} plant_phase_input_t;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void plant_init(plant_t *plant);
+void plant_update(plant_t *plant);
+void plant_step(plant_t *plant, const plant_phase_input_t in[PLANT_PHASE_MAX], const double g_load[PLANT_OUTPUT_MAX]);
+
+#endif /* PLANT_H */
+/* [] END OF FILE */
@@ -0,0 +1,296 @@
+/*******************************************************************************
+* File Name: prot_ref.c
+*
+* Description:
+* Host reference models of the protection averaging and limit check. The
+* fixed point model is written with 64-bit integers and explicit floor
+* division, independent of the shift implementation in buck_protection.h.
+* The boxcar sums its window and the median sorts its three results anew
+* each period, and the debounce counts the kept compares, independent of the
+* running sum and the shift register in prot_filter.h.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "prot_ref.h"
+#include "cycfg.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define REF_FRAC_BITS           (15)        /* AVERAGING_FRAC_BITS */
+#define REF_SAMPLES             (8)         /* AVERAGING_SAMPLES */
+#define REF_VIN_INIT            (1906)      /* VIN_COUNT */
+#define REF_VIN_MIN             (953)       /* VIN_MIN_COUNT */
+#define REF_VIN_MAX             (3336)      /* VIN_MAX_COUNT */
+#define REF_IOUT_MAX            (1861)      /* IOUT_MAX_COUNT */
+#define REF_TEMP_MAX            (1613)      /* TEMP_MAX_COUNT */
+
+/* Filters and debounce of the build, defaults of prot_filter.h */
+#define REF_IIR                 (0)         /* PROT_FILTER_IIR */
+#define REF_BOXCAR              (1)         /* PROT_FILTER_BOXCAR */
+#define REF_MEDIAN3             (2)         /* PROT_FILTER_MEDIAN3 */
+#ifndef PROT_FILTER_VIN
+#define PROT_FILTER_VIN         REF_IIR
+#endif
+#ifndef PROT_FILTER_IOUT
+#define PROT_FILTER_IOUT        REF_IIR
+#endif
+#ifndef PROT_FILTER_TEMP
+#define PROT_FILTER_TEMP        REF_IIR
+#endif
+#ifndef PROT_FILTER_TRIP_N
+#define PROT_FILTER_TRIP_N      (1)
+#endif
+#ifndef PROT_FILTER_TRIP_M
+#define PROT_FILTER_TRIP_M      (1)
+#endif
+
+static const int ref_filter[PROT_REF_CHANNELS] =
+{
+    PROT_FILTER_VIN, PROT_FILTER_IOUT, PROT_FILTER_IOUT, PROT_FILTER_TEMP
+};
+
+/*******************************************************************************
+* Function Name: floor_div
+********************************************************************************
+* Summary:
+* Integer division rounding towards minus infinity.
+*
+*******************************************************************************/
+static int64_t floor_div(int64_t num, int64_t den)
+{
+    int64_t q = num / den;
+
+    if (((num % den) != 0) && ((num < 0) != (den < 0)))
+    {
+        q--;
+    }
+    return q;
+}
+
+/*******************************************************************************
+* Function Name: limits_exceeded
+********************************************************************************
+* Summary:
+* Limit check on averages scaled by 2^frac_bits (0 for the float model),
+* debounced with PROT_FILTER_TRIP_N of the last PROT_FILTER_TRIP_M compares.
+*
+*******************************************************************************/
+static bool limits_exceeded(prot_ref_t *ref, const double avg[PROT_REF_CHANNELS], int frac_bits)
+{
+    const double scale = (double)(1L << frac_bits);
+    const bool exceeded[PROT_REF_LIMITS] =
+    {
+        avg[PROT_REF_VIN] < (REF_VIN_MIN * scale),
+        avg[PROT_REF_VIN] > (REF_VIN_MAX * scale),
+        avg[PROT_REF_IOUT1] > (REF_IOUT_MAX * scale),
+        avg[PROT_REF_IOUT2] > (REF_IOUT_MAX * scale),
+        avg[PROT_REF_TEMP] > (REF_TEMP_MAX * scale)
+    };
+    bool trip = false;
+
+    for (unsigned int lim = 0U; lim < PROT_REF_LIMITS; lim++)
+    {
+        unsigned int count = 0U;
+
+        memmove(&ref->exceeded[lim][1], &ref->exceeded[lim][0], (PROT_REF_HIST - 1U) * sizeof(bool));
+        ref->exceeded[lim][0] = exceeded[lim];
+        for (unsigned int i = 0U; i < PROT_FILTER_TRIP_M; i++)
+        {
+            count += ref->exceeded[lim][i] ? 1U : 0U;
+        }
+        trip = trip || (count >= PROT_FILTER_TRIP_N);
+    }
+    return trip;
+}
+
+/*******************************************************************************
+* Function Name: add_result
+********************************************************************************
+* Summary:
+* Keeps a result of a channel and returns the sum of the boxcar window or the
+* median of the last three results, in counts.
+*
+*******************************************************************************/
+static int64_t add_result(prot_ref_t *ref, unsigned int ch, uint16_t res)
+{
+    int64_t sum = 0;
+    uint16_t m[3];
+
+    memmove(&ref->res[ch][1], &ref->res[ch][0], (PROT_REF_HIST - 1U) * sizeof(uint16_t));
+    ref->res[ch][0] = res;
+
+    if (ref_filter[ch] == REF_BOXCAR)
+    {
+        for (unsigned int i = 0U; i < REF_SAMPLES; i++)
+        {
+            sum += ref->res[ch][i];
+        }
+        return sum;
+    }
+
+    /* Insertion sort of the last three results */
+    for (unsigned int i = 0U; i < 3U; i++)
+    {
+        unsigned int j = i;
+
+        while ((j > 0U) && (m[j - 1U] > ref->res[ch][i]))
+        {
+            m[j] = m[j - 1U];
+            j--;
+        }
+        m[j] = ref->res[ch][i];
+    }
+    return m[1];
+}
+
+/*******************************************************************************
+* Function Name: prot_ref_reset
+********************************************************************************
+* Summary:
+* Resets the averages as the IDLE state button handler does.
+*
+* Parameters:
+*  ref: reference model state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void prot_ref_reset(prot_ref_t *ref)
+{
+    for (unsigned int ch = 0U; ch < PROT_REF_CHANNELS; ch++)
+    {
+        ref->fixed[ch] = 0;
+        ref->flt[ch] = 0.0f;
+    }
+    ref->fixed[PROT_REF_VIN] = (int64_t)REF_VIN_INIT * (1L << REF_FRAC_BITS);
+    ref->flt[PROT_REF_VIN] = (float)REF_VIN_INIT;
+    for (unsigned int i = 0U; i < PROT_REF_HIST; i++)
+    {
+        for (unsigned int ch = 0U; ch < PROT_REF_CHANNELS; ch++)
+        {
+            ref->res[ch][i] = (ch == PROT_REF_VIN) ? REF_VIN_INIT : 0U;
+        }
+        for (unsigned int lim = 0U; lim < PROT_REF_LIMITS; lim++)
+        {
+            ref->exceeded[lim][i] = false;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: prot_ref_step_fixed
+********************************************************************************
+* Summary:
+* One scheduled ADC period of the fixed point mode. IIR:
+* avg = avg + floor((res * 2^frac_bits - avg) / AVERAGING_SAMPLES), boxcar:
+* avg = floor(sum * 2^frac_bits / AVERAGING_SAMPLES), median:
+* avg = median * 2^frac_bits.
+*
+* Parameters:
+*  ref: reference model state
+*  res: ADC results in the order Vin, Iout1, Iout2, Temp
+*
+* Return:
+*  bool: true when a protection limit is exceeded
+*
+*******************************************************************************/
+bool prot_ref_step_fixed(prot_ref_t *ref, const uint16_t res[PROT_REF_CHANNELS])
+{
+    double avg[PROT_REF_CHANNELS];
+
+    for (unsigned int ch = 0U; ch < PROT_REF_CHANNELS; ch++)
+    {
+        int64_t target = (int64_t)res[ch] * (1L << REF_FRAC_BITS);
+        int64_t filtered = add_result(ref, ch, res[ch]);
+
+        if (ref_filter[ch] == REF_BOXCAR)
+        {
+            ref->fixed[ch] = floor_div(filtered * (1L << REF_FRAC_BITS), REF_SAMPLES);
+        }
+        else if (ref_filter[ch] == REF_MEDIAN3)
+        {
+            ref->fixed[ch] = filtered * (1L << REF_FRAC_BITS);
+        }
+        else
+        {
+            ref->fixed[ch] += floor_div(target - ref->fixed[ch], REF_SAMPLES);
+        }
+        avg[ch] = (double)ref->fixed[ch];
+    }
+    return limits_exceeded(ref, avg, REF_FRAC_BITS);
+}
+
+/*******************************************************************************
+* Function Name: prot_ref_step_float
+********************************************************************************
+* Summary:
+* One scheduled ADC period of the float32 mode.
+*
+* Parameters:
+*  ref: reference model state
+*  res: ADC results in the order Vin, Iout1, Iout2, Temp
+*
+* Return:
+*  bool: true when a protection limit is exceeded
+*
+*******************************************************************************/
+bool prot_ref_step_float(prot_ref_t *ref, const uint16_t res[PROT_REF_CHANNELS])
+{
+    double avg[PROT_REF_CHANNELS];
+
+    for (unsigned int ch = 0U; ch < PROT_REF_CHANNELS; ch++)
+    {
+        int64_t filtered = add_result(ref, ch, res[ch]);
+
+        if (ref_filter[ch] == REF_BOXCAR)
+        {
+            ref->flt[ch] = (float)filtered / (float)REF_SAMPLES;
+        }
+        else if (ref_filter[ch] == REF_MEDIAN3)
+        {
+            ref->flt[ch] = (float)filtered;
+        }
+        else
+        {
+            ref->flt[ch] = ref->flt[ch] - ((ref->flt[ch] - (float)res[ch]) / (float)REF_SAMPLES);
+        }
+        avg[ch] = (double)ref->flt[ch];
+    }
+    return limits_exceeded(ref, avg, 0);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,84 @@
+/*******************************************************************************
+* File Name: prot_ref.h
+*
+* Description:
+* Host reference models of the protection averaging and limit check in
+* buck1_scheduled_adc_callback(), used to verify both build modes of
+* buck_protection.h with the filters and the debounce of the build
+* (prot_filter.h).
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROT_REF_H
+#define PROT_REF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Order of the scheduled ADC results. */
+#define PROT_REF_VIN            (0U)
+#define PROT_REF_IOUT1          (1U)
+#define PROT_REF_IOUT2          (2U)
+#define PROT_REF_TEMP           (3U)
+#define PROT_REF_CHANNELS       (4U)
+
+/* Limit compares: Vin low, Vin high, Iout1, Iout2, Temp */
+#define PROT_REF_LIMITS         (5U)
+
+/* Results and compares kept: the boxcar window and the longest debounce */
+#define PROT_REF_HIST           (32U)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    int64_t fixed[PROT_REF_CHANNELS];   /* Averages, counts * 2^frac_bits. */
+    float   flt[PROT_REF_CHANNELS];     /* Averages of the float32 mode. */
+    uint16_t res[PROT_REF_CHANNELS][PROT_REF_HIST];        /* Results, newest first. */
+    bool    exceeded[PROT_REF_LIMITS][PROT_REF_HIST];      /* Compares, newest first. */
+} prot_ref_t;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void prot_ref_reset(prot_ref_t *ref);
+bool prot_ref_step_fixed(prot_ref_t *ref, const uint16_t res[PROT_REF_CHANNELS]);
+bool prot_ref_step_float(prot_ref_t *ref, const uint16_t res[PROT_REF_CHANNELS]);
+
+#endif /* PROT_REF_H */
+/* [] END OF FILE */
@@ -0,0 +1,256 @@
+/*******************************************************************************
+* File Name: cy_pdl.h
+*
+* Description:
+* Host simulation replacement for the Peripheral Driver Library (PDL) umbrella
+* header. Only the types, macros and functions used by the application are
+* provided. The functions are implemented by the hardware model in hw_model.c.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_PDL_H
+#define CY_PDL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/*******************************************************************************
+* Compiler and core macros
+*******************************************************************************/
+#define __STATIC_INLINE         static inline
+#define __STATIC_FORCEINLINE    static inline __attribute__((always_inline))
+#define __WEAK                  __attribute__((weak))
+#define CY_SECTION(name)        __attribute__((section(name)))
+#define CY_RAMFUNC_BEGIN        __attribute__((section(".cy_ramfunc")))
+#define CY_RAMFUNC_END
+#define CY_NOINIT
+#define CY_ALIGN(align)         __attribute__((aligned(align)))
+#define CY_UNUSED_PARAMETER(x)  ((void)(x))
+
+typedef float  float32_t;
+typedef double float64_t;
+
+typedef uint32_t cy_rslt_t;
+#define CY_RSLT_SUCCESS         ((cy_rslt_t)0x00000000U)
+
+/* Assertions abort the simulation with the failing location. */
+void sim_assert_failed(const char *file, int line);
+#define CY_ASSERT(x)            do { if (!(x)) { sim_assert_failed(__FILE__, __LINE__); } } while (0)
+
+/*******************************************************************************
+* Core interrupt control (CMSIS)
+*******************************************************************************/
+typedef int32_t IRQn_Type;
+
+void __enable_irq(void);
+void __disable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t priMask);
+#define __DMB()                 __sync_synchronize()
+#define __DSB()                 __sync_synchronize()
+#define __ISB()                 __sync_synchronize()
+#define __CLZ(x)                ((uint32_t)__builtin_clz(x))
+
+/* Core clock of the simulated CPU, SIM_CPU_CLK_HZ. */
+extern uint32_t SystemCoreClock;
+
+/* Debug control block and data watchpoint and trace unit. The cycle counter
+ * advances with the simulated time. */
+typedef struct
+{
+    uint32_t DEMCR;
+} DCB_Type;
+
+typedef struct
+{
+    uint32_t CTRL;
+    uint32_t CYCCNT;
+} DWT_Type;
+
+/* System control block. Setting PENDSVSET pends the PendSV exception, which
+ * runs after the pending interrupts at the lowest priority. */
+typedef struct
+{
+    uint32_t ICSR;
+} SCB_Type;
+
+extern DCB_Type sim_dcb;
+extern DWT_Type sim_dwt;
+extern SCB_Type sim_scb;
+#define DCB                     (&sim_dcb)
+#define DWT                     (&sim_dwt)
+#define SCB                     (&sim_scb)
+#define SCB_ICSR_PENDSVSET_Msk  (1UL << 28)
+#define PendSV_IRQn             ((IRQn_Type)-2)
+#define __NVIC_PRIO_BITS        (3U)
+
+/* Exception handler of the application, called by hw_model_service_irqs(). */
+void PendSV_Handler(void);
+#define DCB_DEMCR_TRCENA_Msk    (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk  (1UL << 0)
+
+void NVIC_EnableIRQ(IRQn_Type irqn);
+void NVIC_DisableIRQ(IRQn_Type irqn);
+void NVIC_ClearPendingIRQ(IRQn_Type irqn);
+void NVIC_SetPendingIRQ(IRQn_Type irqn);
+uint32_t NVIC_GetEnableIRQ(IRQn_Type irqn);
+void NVIC_SetPriority(IRQn_Type irqn, uint32_t priority);
+
+/*******************************************************************************
+* System interrupt (SysInt)
+*******************************************************************************/
+typedef void (*cy_israddress)(void);
+
+typedef struct
+{
+    IRQn_Type intrSrc;
+    uint32_t  intrPriority;
+} cy_stc_sysint_t;
+
+cy_rslt_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress userIsr);
+
+/*******************************************************************************
+* TCPWM
+*******************************************************************************/
+typedef struct
+{
+    uint32_t reserved;
+} TCPWM_Type;
+
+#define CY_TCPWM_INT_NONE       (0x0UL)
+#define CY_TCPWM_INT_ON_TC      (0x1UL)
+#define CY_TCPWM_INT_ON_CC0     (0x2UL)
+
+typedef struct
+{
+    uint32_t period0;
+    uint32_t compare0;
+    uint32_t interruptSources;
+} cy_stc_tcpwm_pwm_config_t;
+
+typedef struct
+{
+    uint32_t period;
+    uint32_t compare0;
+    uint32_t interruptSources;
+} cy_stc_tcpwm_counter_config_t;
+
+cy_rslt_t Cy_TCPWM_PWM_Init(TCPWM_Type *base, uint32_t cntNum, cy_stc_tcpwm_pwm_config_t const *config);
+void Cy_TCPWM_PWM_Enable(TCPWM_Type *base, uint32_t cntNum);
+void Cy_TCPWM_PWM_Disable(TCPWM_Type *base, uint32_t cntNum);
+void Cy_TCPWM_PWM_SetCompare0Val(TCPWM_Type *base, uint32_t cntNum, uint32_t compare0);
+void Cy_TCPWM_PWM_SetPeriod0(TCPWM_Type *base, uint32_t cntNum, uint32_t period0);
+uint32_t Cy_TCPWM_PWM_GetCompare0Val(TCPWM_Type const *base, uint32_t cntNum);
+uint32_t Cy_TCPWM_PWM_GetCounter(TCPWM_Type const *base, uint32_t cntNum);
+void Cy_TCPWM_PWM_SetCounter(TCPWM_Type *base, uint32_t cntNum, uint32_t count);
+uint32_t Cy_TCPWM_PWM_GetPeriod0(TCPWM_Type const *base, uint32_t cntNum);
+
+cy_rslt_t Cy_TCPWM_Counter_Init(TCPWM_Type *base, uint32_t cntNum, cy_stc_tcpwm_counter_config_t const *config);
+void Cy_TCPWM_Counter_Enable(TCPWM_Type *base, uint32_t cntNum);
+void Cy_TCPWM_Counter_Disable(TCPWM_Type *base, uint32_t cntNum);
+uint32_t Cy_TCPWM_Counter_GetCounter(TCPWM_Type const *base, uint32_t cntNum);
+void Cy_TCPWM_Counter_SetPeriod(TCPWM_Type *base, uint32_t cntNum, uint32_t period);
+
+void Cy_TCPWM_TriggerStart_Single(TCPWM_Type *base, uint32_t cntNum);
+void Cy_TCPWM_TriggerStopOrKill_Single(TCPWM_Type *base, uint32_t cntNum);
+void Cy_TCPWM_TriggerReloadOrIndex_Single(TCPWM_Type *base, uint32_t cntNum);
+void Cy_TCPWM_ClearInterrupt(TCPWM_Type *base, uint32_t cntNum, uint32_t source);
+
+/*******************************************************************************
+* HPPASS comparator and slope generator, implemented in conv_model.c
+*******************************************************************************/
+void Cy_HPPASS_DAC_SetValue(uint8_t dacIdx, uint16_t value);
+
+/*******************************************************************************
+* GPIO
+*******************************************************************************/
+typedef struct
+{
+    uint32_t out;
+    uint32_t in;
+} GPIO_PRT_Type;
+
+void Cy_GPIO_Set(GPIO_PRT_Type *base, uint32_t pinNum);
+void Cy_GPIO_Clr(GPIO_PRT_Type *base, uint32_t pinNum);
+void Cy_GPIO_Inv(GPIO_PRT_Type *base, uint32_t pinNum);
+uint32_t Cy_GPIO_Read(GPIO_PRT_Type const *base, uint32_t pinNum);
+void Cy_GPIO_ClearInterrupt(GPIO_PRT_Type *base, uint32_t pinNum);
+
+/*******************************************************************************
+* SCB UART
+*******************************************************************************/
+typedef struct
+{
+    uint32_t reserved;
+} CySCB_Type;
+
+/* Transfer state of the high-level API */
+typedef struct
+{
+    volatile uint32_t txStatus;
+    void             *txBuf;
+    uint32_t          txBufSize;
+} cy_stc_scb_uart_context_t;
+
+typedef struct
+{
+    uint32_t oversample;
+} cy_stc_scb_uart_config_t;
+
+typedef uint32_t cy_en_scb_uart_status_t;
+#define CY_SCB_UART_SUCCESS     (0UL)
+#define CY_SCB_UART_TRANSMIT_BUSY (0x00E20004UL)
+
+#define CY_SCB_UART_TRANSMIT_ACTIVE (0x01UL)
+
+/* RX FIFO status and interrupt source */
+#define CY_SCB_UART_RX_NOT_EMPTY    (0x04UL)
+
+cy_en_scb_uart_status_t Cy_SCB_UART_Init(CySCB_Type *base, cy_stc_scb_uart_config_t const *config,
+                                         cy_stc_scb_uart_context_t *context);
+void Cy_SCB_UART_Enable(CySCB_Type *base);
+uint32_t Cy_SCB_UART_PutArray(CySCB_Type *base, void *buffer, uint32_t size);
+void Cy_SCB_UART_PutArrayBlocking(CySCB_Type *base, void *buffer, uint32_t size);
+cy_en_scb_uart_status_t Cy_SCB_UART_Transmit(CySCB_Type *base, void *buffer, uint32_t size,
+                                             cy_stc_scb_uart_context_t *context);
+uint32_t Cy_SCB_UART_GetTransmitStatus(CySCB_Type const *base, cy_stc_scb_uart_context_t const *context);
+void Cy_SCB_UART_Interrupt(CySCB_Type *base, cy_stc_scb_uart_context_t *context);
+uint32_t Cy_SCB_UART_GetArray(CySCB_Type const *base, void *buffer, uint32_t size);
+void Cy_SCB_UART_ClearRxFifoStatus(CySCB_Type *base, uint32_t clearMask);
+void Cy_SCB_SetRxInterruptMask(CySCB_Type *base, uint32_t interruptMask);
+
+#endif /* CY_PDL_H */
+/* [] END OF FILE */
@@ -0,0 +1,191 @@
+/*******************************************************************************
+* File Name: cycfg.h
+*
+* Description:
+* Host simulation replacement for the Device Configurator and PCC tool
+* generated headers. The aliases, configuration structures and the BUCK1
+* interface mirror templates/TARGET_KIT_PSC3M5_CC1/config/design.modus. The
+* BUCK1 and BUCK2 functions are implemented by the converter model in
+* conv_model.c.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CYCFG_H
+#define CYCFG_H
+
+#include "cy_pdl.h"
+#include "mtb_hal.h"
+
+/*******************************************************************************
+* Peripheral instances
+*******************************************************************************/
+extern TCPWM_Type     sim_tcpwm0;
+extern GPIO_PRT_Type  sim_gpio_prt[10];
+extern CySCB_Type     sim_scb3;
+
+/* TCPWM counter numbers follow the PDL (group << 8 | counter) encoding. */
+#define PWM_BUCK_1_HW               (&sim_tcpwm0)
+#define PWM_BUCK_1_NUM              (0UL)
+#define PWM_BUCK_2_HW               (&sim_tcpwm0)
+#define PWM_BUCK_2_NUM              (1UL)
+#define PWM_LOAD_HW                 (&sim_tcpwm0)
+#define PWM_LOAD_NUM                (256UL)
+#define SOFT_START_COUNTER_HW       (&sim_tcpwm0)
+#define SOFT_START_COUNTER_NUM      (512UL)
+#define PWM_STATUS_LED_HW           (&sim_tcpwm0)
+#define PWM_STATUS_LED_NUM          (513UL)
+#define PWM_ACT_LED_HW              (&sim_tcpwm0)
+#define PWM_ACT_LED_NUM             (514UL)
+
+#define FAULT_LED_PORT              (&sim_gpio_prt[3])
+#define FAULT_LED_NUM               (0UL)
+#define USER_BUTTON_PORT            (&sim_gpio_prt[9])
+#define USER_BUTTON_NUM             (4UL)
+
+#define SOFT_START_COUNTER_IRQ      ((IRQn_Type)58)
+#define USER_BUTTON_IRQ             ((IRQn_Type)9)
+
+#define DEBUG_UART_HW               (&sim_scb3)
+#define DEBUG_UART_IRQ              ((IRQn_Type)3)
+
+extern const cy_stc_tcpwm_pwm_config_t      PWM_BUCK_1_config;
+extern const cy_stc_tcpwm_pwm_config_t      PWM_BUCK_2_config;
+extern const cy_stc_tcpwm_pwm_config_t      PWM_LOAD_config;
+extern const cy_stc_tcpwm_counter_config_t  SOFT_START_COUNTER_config;
+extern const cy_stc_tcpwm_pwm_config_t      PWM_STATUS_LED_config;
+extern const cy_stc_tcpwm_pwm_config_t      PWM_ACT_LED_config;
+extern const cy_stc_scb_uart_config_t       DEBUG_UART_config;
+extern const mtb_hal_uart_configurator_t    DEBUG_UART_hal_config;
+
+/*******************************************************************************
+* BUCK1 (PCC tool generated interface)
+*******************************************************************************/
+/* Converter state bits returned by BUCK1_get_state(). */
+#define MTB_PWRCONV_STATE_RUN       (0x1UL)
+#define MTB_PWRCONV_STATE_RAMP      (0x2UL)
+
+/* 2P2Z compensator: y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] + a1*y[n-1] + a2*y[n-2] */
+typedef struct
+{
+    float32_t b0;
+    float32_t b1;
+    float32_t b2;
+    float32_t a1;
+    float32_t a2;
+    float32_t x1;
+    float32_t x2;
+    float32_t y1;
+    float32_t y2;
+    float32_t min;
+    float32_t max;
+} mtb_stc_pwrconv_ctrl_2p2z_t;
+
+/* Converter runtime context. */
+typedef struct
+{
+    uint32_t state;     /* MTB_PWRCONV_STATE_* bits */
+    uint32_t targ;      /* Target reference in ADC counts */
+    uint32_t ref;       /* Actual (ramped) reference in ADC counts */
+    uint32_t rampStep;  /* Reference increment per BUCK1_ramp() call */
+    uint32_t res;       /* Latest output voltage ADC result */
+    uint32_t out;       /* Compensator output: peak current DAC value */
+    mtb_stc_pwrconv_ctrl_2p2z_t ctrl;
+} mtb_stc_pwrconv_ctx_t;
+
+extern mtb_stc_pwrconv_ctx_t BUCK1_ctx;
+
+/* Protection limits in ADC counts (hiProtValN/loProtValN scaled by exGainN). */
+#define BUCK1_Vout_MIN              (1186U)
+#define BUCK1_Vout_MAX              (1780U)
+#define BUCK1_Iout1_MAX             (1985U)
+#define BUCK1_Vin_MIN               (715U)
+#define BUCK1_Vin_MAX               (3574U)
+#define BUCK1_Temp_MAX              (1737U)
+#define BUCK1_Iout2_MAX             (1985U)
+
+cy_rslt_t BUCK1_enable(void);
+cy_rslt_t BUCK1_disable(void);
+cy_rslt_t BUCK1_start(void);
+void BUCK1_ramp(void);
+uint32_t BUCK1_get_state(uint32_t mask);
+void BUCK1_Vout_prot_enable(void);
+void BUCK1_Vout_prot_disable(void);
+void BUCK1_Iout1_prot_enable(void);
+void BUCK1_Iout1_prot_disable(void);
+void BUCK1_Vin_prot_enable(void);
+void BUCK1_Vin_prot_disable(void);
+void BUCK1_Temp_prot_enable(void);
+void BUCK1_Temp_prot_disable(void);
+void BUCK1_Iout2_prot_enable(void);
+void BUCK1_Iout2_prot_disable(void);
+void BUCK1_scheduled_adc_trigger(void);
+uint16_t BUCK1_Vin_get_result(void);
+uint16_t BUCK1_Iout1_get_result(void);
+uint16_t BUCK1_Iout2_get_result(void);
+uint16_t BUCK1_Temp_get_result(void);
+
+#if defined(BUCK_CONV_CONFIG) && (BUCK_CONV_CONFIG == 2)
+/*******************************************************************************
+* BUCK2 (second single phase solution of the dual converter configuration)
+*******************************************************************************/
+extern mtb_stc_pwrconv_ctx_t BUCK2_ctx;
+
+#define BUCK2_Vout_MIN              (BUCK1_Vout_MIN)
+#define BUCK2_Vout_MAX              (BUCK1_Vout_MAX)
+#define BUCK2_Iout1_MAX             (BUCK1_Iout1_MAX)
+#define BUCK2_Vin_MIN               (BUCK1_Vin_MIN)
+#define BUCK2_Vin_MAX               (BUCK1_Vin_MAX)
+#define BUCK2_Temp_MAX              (BUCK1_Temp_MAX)
+
+cy_rslt_t BUCK2_enable(void);
+cy_rslt_t BUCK2_disable(void);
+cy_rslt_t BUCK2_start(void);
+void BUCK2_ramp(void);
+uint32_t BUCK2_get_state(uint32_t mask);
+void BUCK2_Vout_prot_enable(void);
+void BUCK2_Vout_prot_disable(void);
+void BUCK2_Iout1_prot_enable(void);
+void BUCK2_Iout1_prot_disable(void);
+void BUCK2_Vin_prot_enable(void);
+void BUCK2_Vin_prot_disable(void);
+void BUCK2_Temp_prot_enable(void);
+void BUCK2_Temp_prot_disable(void);
+void BUCK2_scheduled_adc_trigger(void);
+uint16_t BUCK2_Vin_get_result(void);
+uint16_t BUCK2_Iout1_get_result(void);
+uint16_t BUCK2_Temp_get_result(void);
+#endif
+
+#endif /* CYCFG_H */
+/* [] END OF FILE */
@@ -0,0 +1,163 @@
+/*******************************************************************************
+* File Name: sim.h
+*
+* Description:
+* Interfaces between the host simulator modules: the peripheral model
+* (hw_model.c), the PCC generated converter model (conv_model.c), the fault
+* injection (fault_inject.c) and the simulation harness (buck_sim.c).
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "plant.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_DT                  (1.0 / SIM_SWITCHING_FREQ)
+#define SIM_CPU_CYCLES_PER_STEP ((uint32_t)(SIM_CPU_CLK_HZ / SIM_SWITCHING_FREQ))
+#define SIM_IRQ_ENTRY_CYCLES    (12U)           /* Interrupt entry of the CM33, cycles. */
+#define SIM_MAIN_LOOP_PERIODS   (4U)            /* Switching periods per pass of the main loop. */
+#define SIM_UART_BAUD           (115200.0)
+#define SIM_UART_RX_FIFO        (16U)           /* DEBUG_UART RX FIFO, bytes. */
+#define SIM_UART_RX_INPUT       (1024U)         /* Characters sent to DEBUG_UART, not yet received. */
+#define FAULT_INJECT_RECORDS    (16U)           /* Injections measured in one run. */
+#define FAULT_INJECT_STATES     (8U)            /* States recorded after an injection. */
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Result channels of the fault injection: the scheduled channels of the
+ * BUCKx_*_get_result() getters and the Vout result of the limit detection. */
+typedef enum
+{
+    FAULT_CH_VIN,
+    FAULT_CH_IOUT1,
+    FAULT_CH_IOUT2,
+    FAULT_CH_TEMP,
+    FAULT_CH_VOUT,
+    FAULT_CHANNELS
+} fault_channel_t;
+
+typedef enum
+{
+    FAULT_MODE_OFF,
+    FAULT_MODE_STEP,                /* Value from the start on */
+    FAULT_MODE_RAMP,                /* From the present result to the value over the duration, then held */
+    FAULT_MODE_GLITCH,              /* Value for the duration, then released */
+    FAULT_MODES
+} fault_mode_t;
+
+/* Measurement of one injection. Times are simulated time, -1 when the event
+ * did not occur. */
+typedef struct
+{
+    double          t;              /* Start of the injection */
+    unsigned int    conv;
+    fault_channel_t ch;
+    fault_mode_t    mode;
+    double          value;          /* Injected value, V, A or degC */
+    double          counts;         /* Injected value, ADC counts */
+    double          duration;       /* Ramp or glitch duration, s */
+    uint16_t        limit_lo;       /* Tightest window of the protection of the channel */
+    uint16_t        limit_hi;
+    double          cross_t;        /* Injected signal first outside the window */
+    double          stop_t;         /* PWMs of the converter stopped */
+    uint16_t        peak;           /* Result farthest outside the window before the stop */
+    double          vout_min;       /* Output voltage and inductor peak current until the stop */
+    double          vout_max;
+    double          il_max;
+    double          leak_j;         /* Input energy from the crossing to the stop */
+    uint8_t         cause;          /* FLIGHT_REC_CAUSE_* of the fault of the primary converter */
+    uint8_t         states;         /* Converter states from the start on */
+    uint8_t         state[FAULT_INJECT_STATES];
+} fault_inject_rec_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+extern uint64_t sim_step;           /* Control periods since reset. */
+extern double   sim_time;           /* Simulated time, s. */
+extern plant_t  sim_plant;          /* Power stage model. */
+extern FILE    *sim_uart_out;       /* Destination of DEBUG_UART output, may be NULL. */
+extern uint64_t sim_uart_bytes;     /* Bytes written to DEBUG_UART. */
+extern uint32_t sim_hw_changes;     /* Incremented when a PWM output changes. */
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+/* hw_model.c */
+void hw_model_reset(void);
+void hw_model_step(void);
+void hw_model_service_irqs(void);
+void hw_model_main_loop(void);
+void hw_model_button_press(void);
+bool hw_model_pwm_running(uint32_t cntNum);
+uint32_t hw_model_pwm_compare(uint32_t cntNum);
+uint32_t hw_model_pwm_period(uint32_t cntNum);
+bool hw_model_load_line(void);
+bool hw_model_fault_led_on(void);
+void hw_model_uart_input(const char *text);
+uint32_t hw_model_uart_rx_overruns(void);
+uint64_t hw_model_host_ns(void);
+
+/* conv_model.c */
+void conv_model_init(void);
+void conv_model_ctrl_isr(void);
+void conv_model_service(void);
+bool conv_model_phase_enabled(unsigned int phase);
+double conv_model_peak_current(unsigned int phase);
+void conv_model_set_adc_noise(double lsb);
+void conv_model_set_sched_results(unsigned int conv, const uint16_t res[4]);
+void conv_model_isr_cost(unsigned int conv, uint32_t calls, double *ctrl_ns, double *sched_ns);
+bool conv_model_enabled(unsigned int conv);
+
+/* fault_inject.c */
+int fault_inject_channel(const char *name);
+const char *fault_inject_channel_name(fault_channel_t ch);
+const char *fault_inject_mode_name(fault_mode_t mode);
+bool fault_inject_start(unsigned int conv, fault_channel_t ch, fault_mode_t mode, double value, double duration);
+void fault_inject_stop(unsigned int conv, fault_channel_t ch);
+uint16_t fault_inject_apply(unsigned int conv, fault_channel_t ch, uint16_t res, uint16_t lo, uint16_t hi);
+void fault_inject_monitor(void);
+uint32_t fault_inject_count(void);
+const fault_inject_rec_t *fault_inject_record(uint32_t i);
+
+#endif /* SIM_H */
+/* [] END OF FILE */
@@ -0,0 +1,114 @@
+/*******************************************************************************
+* File Name: sim_config.h
+*
+* Description:
+* Design parameters of the simulated KIT_PSC3M5_DP1 power stage and of the
+* PCC tool configuration. The values are taken from the BUCK1 personality in
+* templates/TARGET_KIT_PSC3M5_CC1/config/design.modus and must be kept in sync
+* with it.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SIM_CONFIG_H
+#define SIM_CONFIG_H
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Power stage (design.modus: L0Inductance, Lesr, C0Capacitance, C0Esr). */
+#define SIM_L0_INDUCTANCE       (43.0e-6)       /* Inductance per phase, H. */
+#define SIM_L0_ESR              (200.0e-3)      /* Inductor + switch resistance, Ohm. */
+#define SIM_C0_CAPACITANCE      (236.0e-6)      /* Output capacitance, F. */
+#define SIM_C0_ESR              (12.5e-3)       /* Output capacitor ESR, Ohm. */
+#define SIM_PHASE_NUM           (2U)            /* phaseNum */
+
+/* Outputs of the phases: 1 - common output, 2 - J14 removed, phase 1 and
+ * phase 2 supply separate outputs with half the output capacitance each (the
+ * dual converter configuration of buck_conv.h). */
+#if defined(BUCK_CONV_CONFIG) && (BUCK_CONV_CONFIG == 2)
+#define SIM_OUTPUTS             (2U)
+#else
+#define SIM_OUTPUTS             (1U)
+#endif
+
+/* Operating point (design.modus: vInNom, vOutNom, iOutNom). */
+#define SIM_VIN_NOM             (24.0)
+#define SIM_VOUT_NOM            (5.0)
+#define SIM_IOUT_NOM            (4.0)
+
+/* Timing (design.modus: SwitchingFreq, TimeDelay, CrossoverFreq, PhaseMargin). */
+#define SIM_SWITCHING_FREQ      (300000.0)
+#define SIM_TIME_DELAY          (2.0)           /* Control loop delay in switching periods. */
+#define SIM_CROSSOVER_FREQ      (5000.0)
+#define SIM_PHASE_MARGIN        (50.0)
+#define SIM_BLANK_TIME          (200.0e-9)      /* csgBlankTime: minimum on time. */
+
+/* Sensing (design.modus: exGain0..4, CurSenseGain). */
+#define SIM_ADC_REF             (3.3)
+#define SIM_ADC_MAX_COUNT       (4095.0)
+#define SIM_GAIN_VOUT           (0.239)         /* V/V */
+#define SIM_GAIN_IOUT           (0.5)           /* V/A */
+#define SIM_GAIN_VIN            (0.064)         /* V/V */
+#define SIM_GAIN_TEMP           (1.0)           /* V/V */
+#define SIM_CUR_SENSE_GAIN      (0.960)         /* CSG comparator input, V/A */
+#define SIM_DAC_MAX_COUNT       (1023.0)        /* CSG slope DAC resolution. */
+#define SIM_CSG_SLICE_1         (1U)            /* csg0: pass[0].csg[0].slice[1] */
+#define SIM_CSG_SLICE_2         (3U)            /* csg1: pass[0].csg[0].slice[3] */
+
+/* Board temperature sensor and thermal path (not part of design.modus). */
+#define SIM_TEMP_SENSE_OFFSET   (0.55)          /* Sensor output at 0 degC, V. */
+#define SIM_TEMP_SENSE_SLOPE    (0.010)         /* V/degC */
+#define SIM_TEMP_AMBIENT        (25.0)          /* degC */
+#define SIM_THERMAL_RES         (20.0)          /* degC/W */
+#define SIM_THERMAL_TAU         (30.0)          /* s */
+
+/* Counter clocks (design.modus: BUCK_PWM_CLK, SOFT_START_CLK, LOAD_PWM_CLK). */
+#define SIM_PWM_CLK_HZ          (240.0e6)
+#define SIM_CPU_CLK_HZ          (180.0e6)
+#define SIM_PWM_BUCK_PERIOD     (800U)          /* 240 MHz / 300 kHz */
+#define SIM_PWM_BUCK_COMPARE    (600U)          /* dutyCycleMax = 75 % */
+#define SIM_SOFT_START_PERIOD   (10000U)        /* 1 MHz clock -> 100 Hz */
+#define SIM_LOAD_PERIOD         (10000U)        /* 10 kHz clock -> 1 Hz */
+#define SIM_LOAD_COMPARE        (3000U)         /* 30 % on time */
+
+/* Reference ramp: number of BUCK1_ramp() calls from zero to the target. */
+#define SIM_RAMP_CALLS          (100U)
+
+/* Onboard loads (KIT_PSC3M5_DP1 transient and variable load circuits). */
+#define SIM_LOAD_TRANSIENT_LOW  (0.2)
+#define SIM_LOAD_TRANSIENT_HIGH (1.8)
+#define SIM_LOAD_VARIABLE_MIN   (0.2)
+
+#endif /* SIM_CONFIG_H */
+/* [] END OF FILE */
@@ -0,0 +1,561 @@
+/*******************************************************************************
+* File Name: telemetry_decode.c
+*
+* Description:
+* Host decoder of the binary telemetry stream (TELEMETRY_BINARY). Splits the
+* byte stream at the zero delimiters, removes the COBS stuffing, checks the
+* length and CRC of each frame and writes the records as CSV. Version 1
+* records (without the current sharing fields) are accepted. Bytes between
+* frames (for example text output before the stream started) are skipped.
+* Scope dump records are written to a separate CSV file when -s is given, and
+* the bytes of the flight recorder fault records to a binary file for
+* flight_decode when -f is given, and the load step records to a separate CSV
+* file when -t is given, and the energy records to a separate CSV file when
+* -e is given. The replies of the command interface (uart_cmd.h)
+* are written to stderr.
+*
+* Usage: telemetry_decode [-c cpu_hz] [-s scope.csv] [-f flight.bin] [-t steps.csv]
+*                         [-e energy.csv] [input.bin [output.csv]]
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "telemetry.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define FRAME_BUF_SIZE          (256U)
+#define DEFAULT_CPU_HZ          (180.0e6)
+
+/* Scaling of the ADC results, see main.c. */
+#define ADC_LSB_V               (3.3 / 4095.0)
+#define VOUT_GAIN               (0.239)
+#define IOUT_GAIN               (0.5)
+#define VIN_GAIN                (0.064)
+
+/* Control period of the load step times, see load_step.h. */
+#define CTRL_PERIOD_US          (1.0e6 / 300000.0)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t frames;            /* Valid records. */
+    uint32_t crc_errors;        /* Frames with a CRC mismatch. */
+    uint32_t length_errors;     /* Frames of the wrong length or bad COBS. */
+    uint32_t lost;              /* Records missing according to the sequence. */
+    uint32_t scope_samples;     /* Samples in scope dump records. */
+    uint32_t flight_bytes;      /* Fault record bytes in flight recorder records. */
+    uint32_t steps;             /* Load step records. */
+    uint64_t skipped_bytes;     /* Bytes in rejected frames. */
+} decode_stats_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint16_t crc_table[256];
+
+/*******************************************************************************
+* Function Name: crc_init / crc16
+********************************************************************************
+* Summary:
+* Table driven CRC-16/CCITT-FALSE, an implementation independent of the
+* bitwise one in telemetry.c.
+*
+*******************************************************************************/
+static void crc_init(void)
+{
+    for (uint32_t i = 0U; i < 256U; i++)
+    {
+        uint16_t c = (uint16_t)(i << 8);
+        for (int bit = 0; bit < 8; bit++)
+        {
+            c = (c & 0x8000U) ? (uint16_t)((c << 1) ^ TELEMETRY_CRC_POLY) : (uint16_t)(c << 1);
+        }
+        crc_table[i] = c;
+    }
+}
+
+static uint16_t crc16(const uint8_t *data, uint32_t size)
+{
+    uint16_t crc = TELEMETRY_CRC_INIT;
+
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        crc = (uint16_t)((crc << 8) ^ crc_table[((crc >> 8) ^ data[i]) & 0xFFU]);
+    }
+    return crc;
+}
+
+/*******************************************************************************
+* Function Name: cobs_decode
+********************************************************************************
+* Summary:
+* Removes the COBS stuffing of one frame (without the delimiter).
+*
+* Return:
+*  Decoded length, or -1 when the frame is not valid COBS.
+*
+*******************************************************************************/
+static int cobs_decode(const uint8_t *src, uint32_t size, uint8_t *dst, uint32_t dst_size)
+{
+    uint32_t in = 0U;
+    uint32_t out = 0U;
+
+    while (in < size)
+    {
+        uint8_t code = src[in++];
+
+        if ((code == 0U) || ((in + code - 1U) > size))
+        {
+            return -1;
+        }
+        for (uint8_t i = 1U; i < code; i++)
+        {
+            if (out >= dst_size)
+            {
+                return -1;
+            }
+            dst[out++] = src[in++];
+        }
+        if ((code != 0xFFU) && (in < size))
+        {
+            if (out >= dst_size)
+            {
+                return -1;
+            }
+            dst[out++] = 0U;
+        }
+    }
+    return (int)out;
+}
+
+static uint16_t get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static double get_avg(const uint8_t *p)
+{
+    return (double)(int32_t)get_u32(p) / (double)(1UL << TELEMETRY_AVG_FRAC_BITS);
+}
+
+/*******************************************************************************
+* Writes the samples of one scope dump record, the index is relative to the
+* trigger sample.
+*******************************************************************************/
+static void write_scope(FILE *out, const uint8_t *rec)
+{
+    uint8_t count = rec[TELEMETRY_SCOPE_OFS_COUNT];
+    int32_t index = (int32_t)get_u16(&rec[TELEMETRY_SCOPE_OFS_INDEX]) -
+                    (int32_t)get_u16(&rec[TELEMETRY_SCOPE_OFS_PRE]);
+
+    for (uint8_t k = 0U; k < count; k++)
+    {
+        const uint8_t *p = &rec[TELEMETRY_SCOPE_OFS_SAMPLES + (k * TELEMETRY_SCOPE_SAMPLE_SIZE)];
+
+        fprintf(out, "%u,%u,%u,%d,%u,%u,%u,%.3f\n",
+                rec[TELEMETRY_SCOPE_OFS_CAPTURE], rec[TELEMETRY_SCOPE_OFS_SOURCE],
+                get_u16(&rec[TELEMETRY_SCOPE_OFS_DECIM]), index + k,
+                get_u16(&p[0]), get_u16(&p[2]), get_u16(&p[4]),
+                get_u16(&p[0]) * ADC_LSB_V / VOUT_GAIN);
+    }
+}
+
+/*******************************************************************************
+* Writes one load step record, deviations in mV and times in us.
+*******************************************************************************/
+static void write_step(FILE *out, const uint8_t *rec)
+{
+    const double mv = ADC_LSB_V / VOUT_GAIN * 1000.0;
+
+    fprintf(out, "%s,%u,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%u\n",
+            (rec[TELEMETRY_STEP_OFS_DIR] == 0U) ? "up" : "down",
+            get_u16(&rec[TELEMETRY_STEP_OFS_COUNT]),
+            (int16_t)get_u16(&rec[TELEMETRY_STEP_OFS_PEAK]) * mv,
+            (int16_t)get_u16(&rec[TELEMETRY_STEP_OFS_UNDER]) * mv,
+            (int16_t)get_u16(&rec[TELEMETRY_STEP_OFS_OVER]) * mv,
+            get_u16(&rec[TELEMETRY_STEP_OFS_RECOVERY]) * CTRL_PERIOD_US,
+            get_u16(&rec[TELEMETRY_STEP_OFS_SETTLING]) * CTRL_PERIOD_US,
+            (int16_t)get_u16(&rec[TELEMETRY_STEP_OFS_PEAK_MEAN]) / 16.0 * mv,
+            (int16_t)get_u16(&rec[TELEMETRY_STEP_OFS_PEAK_WORST]) * mv,
+            get_u16(&rec[TELEMETRY_STEP_OFS_SETTLING_MEAN]) * CTRL_PERIOD_US,
+            get_u16(&rec[TELEMETRY_STEP_OFS_SETTLING_MAX]) * CTRL_PERIOD_US,
+            get_u16(&rec[TELEMETRY_STEP_OFS_UNSETTLED]));
+}
+
+/*******************************************************************************
+* Writes one energy record, powers in W, efficiency in %, energy in Wh,
+* voltages in V and currents in A.
+*******************************************************************************/
+static void write_energy(FILE *out, const uint8_t *rec)
+{
+    fprintf(out, "%u,%u,%.3f,%.3f,%.2f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+            get_u32(&rec[TELEMETRY_ENERGY_OFS_WINDOW]), rec[TELEMETRY_ENERGY_OFS_PHASES],
+            get_u32(&rec[TELEMETRY_ENERGY_OFS_P_OUT]) / 1000.0,
+            get_u32(&rec[TELEMETRY_ENERGY_OFS_P_IN]) / 1000.0,
+            get_u16(&rec[TELEMETRY_ENERGY_OFS_EFFICIENCY]) / 100.0,
+            get_u32(&rec[TELEMETRY_ENERGY_OFS_E_OUT]) / 1000.0,
+            get_u32(&rec[TELEMETRY_ENERGY_OFS_E_IN]) / 1000.0,
+            get_u16(&rec[TELEMETRY_ENERGY_OFS_VOUT_MIN]) / 1000.0,
+            get_u16(&rec[TELEMETRY_ENERGY_OFS_VOUT_MAX]) / 1000.0,
+            get_u16(&rec[TELEMETRY_ENERGY_OFS_VOUT_RMS]) / 1000.0,
+            get_u16(&rec[TELEMETRY_ENERGY_OFS_IOUT_MIN]) / 1000.0,
+            get_u16(&rec[TELEMETRY_ENERGY_OFS_IOUT_MAX]) / 1000.0,
+            get_u16(&rec[TELEMETRY_ENERGY_OFS_IOUT_RMS]) / 1000.0);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+    FILE *in = stdin;
+    FILE *out = stdout;
+    FILE *scope_out = NULL;
+    FILE *flight_out = NULL;
+    FILE *step_out = NULL;
+    FILE *energy_out = NULL;
+    double cpu_hz = DEFAULT_CPU_HZ;
+    uint8_t frame[FRAME_BUF_SIZE];
+    uint8_t rec[FRAME_BUF_SIZE];
+    uint32_t len = 0U;
+    bool overflow = false;
+    bool have_last = false;
+    uint16_t last_seq = 0U;
+    uint32_t last_ts = 0U;
+    uint64_t cycles = 0U;
+    decode_stats_t st = { 0 };
+    int argi = 1;
+    int c;
+
+    while (((argi + 1) < argc) && (argv[argi][0] == '-') && (argv[argi][1] != '\0'))
+    {
+        if (0 == strcmp(argv[argi], "-c"))
+        {
+            cpu_hz = strtod(argv[argi + 1], NULL);
+        }
+        else if (0 == strcmp(argv[argi], "-s"))
+        {
+            scope_out = fopen(argv[argi + 1], "w");
+            if (NULL == scope_out)
+            {
+                fprintf(stderr, "cannot open %s\n", argv[argi + 1]);
+                return 2;
+            }
+            fprintf(scope_out, "capture,source,decimation,index,res,out,compare,vout_v\n");
+        }
+        else if (0 == strcmp(argv[argi], "-f"))
+        {
+            flight_out = fopen(argv[argi + 1], "wb");
+            if (NULL == flight_out)
+            {
+                fprintf(stderr, "cannot open %s\n", argv[argi + 1]);
+                return 2;
+            }
+        }
+        else if (0 == strcmp(argv[argi], "-t"))
+        {
+            step_out = fopen(argv[argi + 1], "w");
+            if (NULL == step_out)
+            {
+                fprintf(stderr, "cannot open %s\n", argv[argi + 1]);
+                return 2;
+            }
+            fprintf(step_out, "dir,count,peak_mv,undershoot_mv,overshoot_mv,recovery_us,settling_us,"
+                              "peak_mean_mv,peak_worst_mv,settling_mean_us,settling_max_us,unsettled\n");
+        }
+        else if (0 == strcmp(argv[argi], "-e"))
+        {
+            energy_out = fopen(argv[argi + 1], "w");
+            if (NULL == energy_out)
+            {
+                fprintf(stderr, "cannot open %s\n", argv[argi + 1]);
+                return 2;
+            }
+            fprintf(energy_out, "window,phases,p_out_w,p_in_w,efficiency_pct,e_out_wh,e_in_wh,vout_min,vout_max,"
+                                "vout_rms,iout_min,iout_max,iout_rms\n");
+        }
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", argv[argi]);
+            return 2;
+        }
+        argi += 2;
+    }
+    if (argi < argc)
+    {
+        in = fopen(argv[argi], "rb");
+        if (NULL == in)
+        {
+            fprintf(stderr, "cannot open %s\n", argv[argi]);
+            return 2;
+        }
+        argi++;
+    }
+    if (argi < argc)
+    {
+        out = fopen(argv[argi], "w");
+        if (NULL == out)
+        {
+            fprintf(stderr, "cannot open %s\n", argv[argi]);
+            return 2;
+        }
+    }
+
+    crc_init();
+    fprintf(out, "seq,time_s,state,vout_res,iout1_res,iout2_res,vin_res,temp_res,"
+                 "iout1_avg,iout2_avg,vin_avg,temp_avg,vout_v,iout1_a,iout2_a,vin_v,share_trim,imbalance_pm\n");
+
+    while (EOF != (c = fgetc(in)))
+    {
+        int n;
+
+        if (c != 0)
+        {
+            if (len < sizeof(frame))
+            {
+                frame[len++] = (uint8_t)c;
+            }
+            else
+            {
+                overflow = true;
+                st.skipped_bytes++;
+            }
+            continue;
+        }
+
+        /* End of frame. */
+        if (len == 0U)
+        {
+            continue;
+        }
+        n = overflow ? -1 : cobs_decode(frame, len, rec, sizeof(rec));
+        if ((n > (int)(TELEMETRY_SCOPE_OFS_SAMPLES + TELEMETRY_CRC_SIZE)) &&
+            (rec[TELEMETRY_SCOPE_OFS_KIND] == TELEMETRY_KIND_SCOPE))
+        {
+            uint32_t size = (uint32_t)n - TELEMETRY_CRC_SIZE;
+
+            if (size != (TELEMETRY_SCOPE_OFS_SAMPLES +
+                         ((uint32_t)rec[TELEMETRY_SCOPE_OFS_COUNT] * TELEMETRY_SCOPE_SAMPLE_SIZE)))
+            {
+                st.length_errors++;
+                st.skipped_bytes += len;
+            }
+            else if (crc16(rec, size) != get_u16(&rec[size]))
+            {
+                st.crc_errors++;
+                st.skipped_bytes += len;
+            }
+            else
+            {
+                st.scope_samples += rec[TELEMETRY_SCOPE_OFS_COUNT];
+                if (NULL != scope_out)
+                {
+                    write_scope(scope_out, rec);
+                }
+            }
+        }
+        else if ((n > (int)(TELEMETRY_FLIGHT_OFS_DATA + TELEMETRY_CRC_SIZE)) &&
+                 (rec[TELEMETRY_FLIGHT_OFS_KIND] == TELEMETRY_KIND_FLIGHT))
+        {
+            uint32_t size = (uint32_t)n - TELEMETRY_CRC_SIZE;
+
+            if (size != (TELEMETRY_FLIGHT_OFS_DATA + (uint32_t)rec[TELEMETRY_FLIGHT_OFS_COUNT]))
+            {
+                st.length_errors++;
+                st.skipped_bytes += len;
+            }
+            else if (crc16(rec, size) != get_u16(&rec[size]))
+            {
+                st.crc_errors++;
+                st.skipped_bytes += len;
+            }
+            else
+            {
+                /* The frames of a record are sent in order, the decoder
+                 * finds the records by their magic. */
+                st.flight_bytes += rec[TELEMETRY_FLIGHT_OFS_COUNT];
+                if (NULL != flight_out)
+                {
+                    fwrite(&rec[TELEMETRY_FLIGHT_OFS_DATA], 1U, rec[TELEMETRY_FLIGHT_OFS_COUNT], flight_out);
+                }
+            }
+        }
+        else if ((n == (int)(TELEMETRY_STEP_SIZE + TELEMETRY_CRC_SIZE)) &&
+                 (rec[TELEMETRY_STEP_OFS_KIND] == TELEMETRY_KIND_STEP))
+        {
+            if (crc16(rec, TELEMETRY_STEP_SIZE) != get_u16(&rec[TELEMETRY_STEP_SIZE]))
+            {
+                st.crc_errors++;
+                st.skipped_bytes += len;
+            }
+            else
+            {
+                st.steps++;
+                if (NULL != step_out)
+                {
+                    write_step(step_out, rec);
+                }
+            }
+        }
+        else if ((n == (int)(TELEMETRY_ENERGY_SIZE + TELEMETRY_CRC_SIZE)) &&
+                 (rec[TELEMETRY_ENERGY_OFS_KIND] == TELEMETRY_KIND_ENERGY))
+        {
+            if (crc16(rec, TELEMETRY_ENERGY_SIZE) != get_u16(&rec[TELEMETRY_ENERGY_SIZE]))
+            {
+                st.crc_errors++;
+                st.skipped_bytes += len;
+            }
+            else if (NULL != energy_out)
+            {
+                write_energy(energy_out, rec);
+            }
+            else
+            {
+                /* Energy records are only written with -e. */
+            }
+        }
+        else if ((n > (int)(TELEMETRY_REPLY_OFS_TEXT + TELEMETRY_CRC_SIZE)) &&
+                 (rec[TELEMETRY_REPLY_OFS_KIND] == TELEMETRY_KIND_REPLY) &&
+                 (crc16(rec, (uint32_t)n - TELEMETRY_CRC_SIZE) == get_u16(&rec[n - (int)TELEMETRY_CRC_SIZE])))
+        {
+            /* Replies of the command interface go to stderr as text. A reply
+             * with a CRC mismatch is not told apart from a status record. */
+            fprintf(stderr, "reply %.*s\n", n - (int)(TELEMETRY_REPLY_OFS_TEXT + TELEMETRY_CRC_SIZE),
+                    (const char *)&rec[TELEMETRY_REPLY_OFS_TEXT]);
+        }
+        else if ((n != (int)(TELEMETRY_RECORD_SIZE + TELEMETRY_CRC_SIZE)) &&
+                 (n != (int)(TELEMETRY_RECORD_SIZE_V1 + TELEMETRY_CRC_SIZE)))
+        {
+            st.length_errors++;
+            st.skipped_bytes += len;
+        }
+        else if ((crc16(rec, (uint32_t)n - TELEMETRY_CRC_SIZE) != get_u16(&rec[n - (int)TELEMETRY_CRC_SIZE])) ||
+                 (rec[TELEMETRY_OFS_VERSION] !=
+                  ((n == (int)(TELEMETRY_RECORD_SIZE + TELEMETRY_CRC_SIZE)) ? TELEMETRY_VERSION : 1U)))
+        {
+            st.crc_errors++;
+            st.skipped_bytes += len;
+        }
+        else
+        {
+            uint16_t seq = get_u16(&rec[TELEMETRY_OFS_SEQ]);
+            uint32_t ts = get_u32(&rec[TELEMETRY_OFS_TIMESTAMP]);
+
+            /* Unwrap the 32-bit cycle counter and count missing records. */
+            if (have_last)
+            {
+                cycles += (uint32_t)(ts - last_ts);
+                st.lost += (uint16_t)(seq - last_seq - 1U);
+            }
+            else
+            {
+                cycles = ts;
+            }
+            have_last = true;
+            last_seq = seq;
+            last_ts = ts;
+            st.frames++;
+
+            fprintf(out, "%u,%.6f,%u,%u,%u,%u,%u,%u,%.4f,%.4f,%.4f,%.4f,%.3f,%.3f,%.3f,%.2f,",
+                    seq, (double)cycles / cpu_hz, rec[TELEMETRY_OFS_STATE],
+                    get_u16(&rec[TELEMETRY_OFS_VOUT]), get_u16(&rec[TELEMETRY_OFS_IOUT1]),
+                    get_u16(&rec[TELEMETRY_OFS_IOUT2]), get_u16(&rec[TELEMETRY_OFS_VIN]),
+                    get_u16(&rec[TELEMETRY_OFS_TEMP]),
+                    get_avg(&rec[TELEMETRY_OFS_IOUT1_AVG]), get_avg(&rec[TELEMETRY_OFS_IOUT2_AVG]),
+                    get_avg(&rec[TELEMETRY_OFS_VIN_AVG]), get_avg(&rec[TELEMETRY_OFS_TEMP_AVG]),
+                    get_u16(&rec[TELEMETRY_OFS_VOUT]) * ADC_LSB_V / VOUT_GAIN,
+                    get_u16(&rec[TELEMETRY_OFS_IOUT1]) * ADC_LSB_V / IOUT_GAIN,
+                    get_u16(&rec[TELEMETRY_OFS_IOUT2]) * ADC_LSB_V / IOUT_GAIN,
+                    get_u16(&rec[TELEMETRY_OFS_VIN]) * ADC_LSB_V / VIN_GAIN);
+            if (rec[TELEMETRY_OFS_VERSION] >= 2U)
+            {
+                fprintf(out, "%d,%d\n", (int16_t)get_u16(&rec[TELEMETRY_OFS_SHARE_TRIM]),
+                        (int16_t)get_u16(&rec[TELEMETRY_OFS_IMBALANCE]));
+            }
+            else
+            {
+                fprintf(out, ",\n");
+            }
+        }
+        len = 0U;
+        overflow = false;
+    }
+    st.skipped_bytes += len;
+
+    fprintf(stderr, "telemetry_decode frames=%u crc_errors=%u length_errors=%u lost=%u skipped_bytes=%llu "
+                    "scope_samples=%u flight_bytes=%u steps=%u\n",
+            st.frames, st.crc_errors, st.length_errors, st.lost, (unsigned long long)st.skipped_bytes,
+            st.scope_samples, st.flight_bytes, st.steps);
+
+    if (in != stdin)
+    {
+        fclose(in);
+    }
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+    if (NULL != scope_out)
+    {
+        fclose(scope_out);
+    }
+    if (NULL != flight_out)
+    {
+        fclose(flight_out);
+    }
+    if (NULL != step_out)
+    {
+        fclose(step_out);
+    }
+    if (NULL != energy_out)
+    {
+        fclose(energy_out);
+    }
+    return (st.frames > 0U) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,299 @@
+/*******************************************************************************
+* File Name: soft_start.c
+*
+* Description:
+* Soft start profiles and the soft start engine.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "uart_tx.h"
+#include "buck_protection.h"
+#include "soft_start.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SOFT_START_POS_END          (1UL << 24)
+#define SOFT_START_SEG_SHIFT        (19U)       /* 24 - log2(SOFT_START_TABLE_POINTS) */
+#define SOFT_START_FRAC_MASK        ((1UL << SOFT_START_SEG_SHIFT) - 1UL)
+
+/* Profile points at x = i / 32, scaled by 32768, evaluated by the compiler.
+ * S-curve: x^2 * (3 - 2x). Inrush: the slope rises linearly over the first
+ * quarter, is constant at 4/3 and falls linearly over the last quarter. */
+#define SS_LINEAR(i)    ((uint16_t)(1024U * (i)))
+#define SS_SCURVE(i)    ((uint16_t)((96U * (i) * (i)) - (2U * (i) * (i) * (i))))
+#define SS_INRUSH(i)    ((uint16_t)(((i) < 8U)  ? ((256U * (i) * (i)) / 3U) :                    \
+                                    ((i) <= 24U) ? ((4096U * ((i) - 4U)) / 3U) :                  \
+                                    (32768U - ((256U * (32U - (i)) * (32U - (i))) / 3U))))
+
+#define SS_TABLE(f)                                                                               \
+    { f(0U),  f(1U),  f(2U),  f(3U),  f(4U),  f(5U),  f(6U),  f(7U),  f(8U),  f(9U),  f(10U),    \
+      f(11U), f(12U), f(13U), f(14U), f(15U), f(16U), f(17U), f(18U), f(19U), f(20U), f(21U),    \
+      f(22U), f(23U), f(24U), f(25U), f(26U), f(27U), f(28U), f(29U), f(30U), f(31U), f(32U) }
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+soft_start_t soft_start[BUCK_CONV_NUM] =
+{
+    {
+        .profile = SOFT_START_PROFILE,
+        .time_ms = SOFT_START_TIME_MS,
+        .active  = false
+    },
+#if (BUCK_CONV_NUM > 1U)
+    {
+        .profile = SOFT_START_PROFILE,
+        .time_ms = SOFT_START_TIME_MS,
+        .active  = false
+    }
+#endif
+};
+
+static CONTROL_RAMCONST uint16_t soft_start_table[SOFT_START_PROFILES][SOFT_START_TABLE_POINTS + 1U] =
+{
+    SS_TABLE(SS_LINEAR),
+    SS_TABLE(SS_SCURVE),
+    SS_TABLE(SS_INRUSH)
+};
+
+static const char *const soft_start_names[SOFT_START_PROFILES] = { "linear", "s-curve", "inrush" };
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: soft_start_set_profile
+*********************************************************************************
+* Summary:
+* Selects the profile and the ramp time of the next start of all converters.
+*
+* Parameters:
+*  profile: SOFT_START_PROFILE_*
+*  time_ms: time from the start to the end of the reference ramp, limited to
+*           SOFT_START_TIME_MIN_MS .. SOFT_START_TIME_MAX_MS
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void soft_start_set_profile(soft_start_profile_t profile, uint32_t time_ms)
+{
+    uint8_t conv;
+
+    for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        soft_start[conv].profile = (profile < SOFT_START_PROFILES) ? profile : SOFT_START_PROFILE_SCURVE;
+        soft_start[conv].time_ms = (time_ms < SOFT_START_TIME_MIN_MS) ? SOFT_START_TIME_MIN_MS :
+                                   ((time_ms > SOFT_START_TIME_MAX_MS) ? SOFT_START_TIME_MAX_MS : time_ms);
+    }
+}
+
+/*******************************************************************************
+* Function name: soft_start_begin
+*********************************************************************************
+* Summary:
+* Prepares a start, called after the start of the converter with the PWM
+* compare values at zero. The control ISR then moves the reference and the
+* compare values.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void soft_start_begin(uint8_t conv)
+{
+    soft_start_t *ss = &soft_start[conv];
+    const buck_conv_hw_t *hw = &buck_conv_hw[conv];
+    uint32_t period = Cy_TCPWM_PWM_GetPeriod0(hw->pwm[0].hw, hw->pwm[0].num);
+    float32_t duty;
+
+    duty = ((float32_t)hw->ctx->targ * SOFT_START_VIN_GAIN) /
+           ((float32_t)VIN_MIN_COUNT * SOFT_START_VOUT_GAIN) * SOFT_START_DUTY_MARGIN;
+    ss->compare_span = (uint32_t)(duty * (float32_t)period);
+    if (ss->compare_span > hw->pwm[0].config->compare0)
+    {
+        ss->compare_span = hw->pwm[0].config->compare0;
+    }
+
+    ss->step        = (SOFT_START_POS_END * SOFT_START_DIVIDER) /
+                      ((ss->time_ms * SOFT_START_CTRL_FREQ_HZ) / 1000U);
+    ss->pos         = 0U;
+    ss->div_count   = SOFT_START_DIVIDER;
+    ss->periods     = 0U;
+    ss->hold_steps  = 0U;
+    ss->reg_periods = 0U;
+    ss->out_max     = 0U;
+    ss->ramp_done   = false;
+    ss->reported    = false;
+    ss->active      = true;
+}
+
+/*******************************************************************************
+* Function name: soft_start_step
+*********************************************************************************
+* Summary:
+* Soft start engine, called from the control ISR after the compensator while a
+* start is in progress. Every SOFT_START_DIVIDER periods, the progress advances
+* unless the peak current reference is above the inrush limit, and the
+* reference and compare values are set from the interpolated profile. At the
+* end of the ramp, the generated ramp function finishes the ramp at the target
+* and clears the ramp state. The engine stops when the output voltage has
+* reached the regulation band.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+CONTROL_RAMFUNC_BEGIN
+void soft_start_step(uint8_t conv)
+{
+    soft_start_t *ss = &soft_start[conv];
+    const buck_conv_hw_t *hw = &buck_conv_hw[conv];
+    mtb_stc_pwrconv_ctx_t *ctx = hw->ctx;
+    const uint16_t *table;
+    uint32_t seg;
+    uint32_t frac;
+    uint32_t y;
+    uint32_t compare;
+    uint32_t phase;
+
+    ss->periods++;
+    if (ctx->out > ss->out_max)
+    {
+        ss->out_max = ctx->out;
+    }
+
+    if (ss->ramp_done)
+    {
+        uint32_t res = ctx->res;
+
+        if ((res + SOFT_START_REG_BAND >= ctx->targ) && (res <= ctx->targ + SOFT_START_REG_BAND))
+        {
+            ss->reg_periods = ss->periods;
+            ss->active = false;
+        }
+        return;
+    }
+
+    if (--ss->div_count != 0U)
+    {
+        return;
+    }
+    ss->div_count = SOFT_START_DIVIDER;
+
+    if (ctx->out > SOFT_START_DAC_COUNTS(SOFT_START_INRUSH_MAX))
+    {
+        ss->hold_steps++;
+        return;
+    }
+
+    ss->pos += ss->step;
+    if (ss->pos >= SOFT_START_POS_END)
+    {
+        ctx->ref = ctx->targ;
+        hw->ramp();
+        for (phase = 0U; phase < BUCK_CONV_PHASES; phase++)
+        {
+            Cy_TCPWM_PWM_SetCompare0Val(hw->pwm[phase].hw, hw->pwm[phase].num, ss->compare_span);
+        }
+        ss->ramp_done = true;
+        return;
+    }
+
+    table = soft_start_table[ss->profile];
+    seg   = ss->pos >> SOFT_START_SEG_SHIFT;
+    frac  = (ss->pos & SOFT_START_FRAC_MASK) >> 8;
+    y     = table[seg] + ((((uint32_t)table[seg + 1U] - table[seg]) * frac) >> (SOFT_START_SEG_SHIFT - 8U));
+
+    ctx->ref = (ctx->targ * y) >> 15;
+    compare = (ss->compare_span * y) >> 15;
+    for (phase = 0U; phase < BUCK_CONV_PHASES; phase++)
+    {
+        Cy_TCPWM_PWM_SetCompare0Val(hw->pwm[phase].hw, hw->pwm[phase].num, compare);
+    }
+}
+CONTROL_RAMFUNC_END
+
+/*******************************************************************************
+* Function name: soft_start_report
+*********************************************************************************
+* Summary:
+* Prints the result of the last start of each converter once regulation has
+* been reached.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void soft_start_report(void)
+{
+    uint8_t conv;
+
+    for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        soft_start_t *ss = &soft_start[conv];
+
+        if (ss->active || ss->reported || (ss->reg_periods == 0U))
+        {
+            continue;
+        }
+        ss->reported = true;
+
+        uart_tx_printf("\r\n%s soft start: %s %lu ms, regulation after %.2f ms, peak inrush %.2f A per phase, held %lu steps\r\n",
+                       buck_conv_hw[conv].name, soft_start_names[ss->profile], (unsigned long)ss->time_ms,
+                       ((float64_t)ss->reg_periods * 1000.0) / (float64_t)SOFT_START_CTRL_FREQ_HZ,
+                       (float64_t)ss->out_max * 3.3 / 1023.0 / 0.960, (unsigned long)ss->hold_steps);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,157 @@
+/*******************************************************************************
+* File Name: soft_start.h
+*
+* Description:
+* Table driven soft start of each converter. The output voltage reference
+* and the maximum duty cycle of its PWMs follow the same normalized profile
+* (linear, S-curve or inrush limited), stepped from the control ISR so that
+* start-up times down to a few milliseconds are possible. The profile holds
+* while the peak current reference exceeds the inrush limit. The time to
+* regulation and the peak inrush current of the last start are measured.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef SOFT_START_H
+#define SOFT_START_H
+#include "cybsp.h"
+#include "buck_conv.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Default profile and time from the start to the end of the reference ramp. */
+#ifndef SOFT_START_PROFILE
+#define SOFT_START_PROFILE          (SOFT_START_PROFILE_SCURVE)
+#endif
+#ifndef SOFT_START_TIME_MS
+#define SOFT_START_TIME_MS          (10U)
+#endif
+#define SOFT_START_TIME_MIN_MS      (2U)
+#define SOFT_START_TIME_MAX_MS      (5000U)
+
+/* Control ISR frequency (SwitchingFreq, control loop divider 1) and number of
+ * control periods per profile step (10 kHz). */
+#define SOFT_START_CTRL_FREQ_HZ     (300000U)
+#define SOFT_START_DIVIDER          (30U)
+
+/* The profile holds while the peak current reference of a phase exceeds this
+ * current, A. Above the 3 A per phase overcurrent protection limit, so that a
+ * loaded start is slowed down rather than stopped. */
+#define SOFT_START_INRUSH_MAX       (3.3f)
+#define SOFT_START_DAC_COUNTS(a)    ((uint32_t)((a) * 1023.0f / 3.3f * 0.960f))
+
+/* The maximum duty cycle ramps to the duty cycle of the target output voltage
+ * at the lowest allowed input voltage plus this margin. Output voltage and
+ * input voltage sense gains (exGain0, exGain1). */
+#define SOFT_START_DUTY_MARGIN      (1.1f)
+#define SOFT_START_VOUT_GAIN        (0.239f)
+#define SOFT_START_VIN_GAIN         (0.064f)
+
+/* Regulation is reached when the output voltage result is within this many
+ * ADC counts (about 1 %) of the target after the end of the ramp. */
+#define SOFT_START_REG_BAND         (15U)
+
+/* Profile table: SOFT_START_TABLE_POINTS + 1 points of the normalized output
+ * voltage at equally spaced times, 32768 is the target. */
+#define SOFT_START_TABLE_POINTS     (32U)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    SOFT_START_PROFILE_LINEAR,      /* Constant slope */
+    SOFT_START_PROFILE_SCURVE,      /* Smoothstep, zero slope at both ends */
+    SOFT_START_PROFILE_INRUSH,      /* Constant slope with ramped slope at both ends: lowest
+                                     * peak capacitor charging current for a smooth start */
+    SOFT_START_PROFILES
+} soft_start_profile_t;
+
+typedef struct
+{
+    soft_start_profile_t profile;   /* Profile of the next start */
+    uint32_t          time_ms;      /* Ramp time of the next start */
+    volatile bool     active;       /* Ramp or regulation measurement running */
+    bool              ramp_done;    /* Reference at the target */
+    bool              reported;     /* Result of the last start printed */
+    uint32_t          pos;          /* Progress, 1 << 24 is the end of the ramp */
+    uint32_t          step;         /* Progress per profile step */
+    uint32_t          div_count;    /* Control periods to the next profile step */
+    uint32_t          compare_span; /* PWM compare value at the end of the ramp */
+    uint32_t          periods;      /* Control periods since the start */
+    uint32_t          hold_steps;   /* Profile steps held by the inrush limit */
+    uint32_t          reg_periods;  /* Control periods to regulation, 0 if not reached */
+    uint32_t          out_max;      /* Highest peak current reference, DAC counts */
+} soft_start_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern soft_start_t soft_start[BUCK_CONV_NUM];
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void soft_start_set_profile(soft_start_profile_t profile, uint32_t time_ms);
+void soft_start_begin(uint8_t conv);
+void soft_start_step(uint8_t conv);
+void soft_start_report(void);
+
+/*******************************************************************************
+* Function Name: soft_start_control
+*********************************************************************************
+* Summary:
+* Called from the post-process callback of the control ISR of a converter.
+* Runs the soft start engine while a start of the converter is in progress.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void soft_start_control(uint8_t conv)
+{
+    if (soft_start[conv].active)
+    {
+        soft_start_step(conv);
+    }
+}
+
+#endif  /* SOFT_START_H */
+/* [] END OF FILE */
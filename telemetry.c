@@ -0,0 +1,267 @@
+/*******************************************************************************
+* File Name: telemetry.c
+*
+* Description:
+* Binary telemetry records of the converter state, output voltage and the
+* protection measurements, sent on the debug UART instead of the text status
+* line when TELEMETRY_BINARY is set.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_protection.h"
+#include "telemetry.h"
+#include "uart_tx.h"
+
+#if (TELEMETRY_AVG_FRAC_BITS != 15U)
+#error "Telemetry averages are sent as PROT_AVG_Q15"
+#endif
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Sequence number of the next record. */
+static uint16_t telemetry_seq = 0U;
+
+/* DWT cycle counter at telemetry_init(), the origin of the timestamps. */
+static uint32_t telemetry_base = 0U;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: put_u16 / put_u32
+*********************************************************************************
+* Summary:
+* Stores a value little endian into the record buffer.
+*
+*******************************************************************************/
+static void put_u16(uint8_t *dst, uint16_t value)
+{
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(uint8_t *dst, uint32_t value)
+{
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+    dst[2] = (uint8_t)(value >> 16);
+    dst[3] = (uint8_t)(value >> 24);
+}
+
+/*******************************************************************************
+* Function name: avg_to_record
+*********************************************************************************
+* Summary:
+* Converts a protection average to the record format (ADC counts with
+* TELEMETRY_AVG_FRAC_BITS fractional bits).
+*
+*******************************************************************************/
+static uint32_t avg_to_record(prot_value_t avg)
+{
+    return (uint32_t)PROT_AVG_Q15(avg);
+}
+
+/*******************************************************************************
+* Function name: telemetry_crc16
+*********************************************************************************
+* Summary:
+* CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF).
+*
+* Parameters:
+*  data: bytes to protect
+*  size: number of bytes
+*
+* Return:
+*  uint16_t: CRC value
+*
+*******************************************************************************/
+uint16_t telemetry_crc16(const uint8_t *data, uint32_t size)
+{
+    uint16_t crc = TELEMETRY_CRC_INIT;
+
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        crc ^= (uint16_t)((uint16_t)data[i] << 8);
+        for (uint32_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = ((crc & 0x8000U) != 0U) ? (uint16_t)((crc << 1) ^ TELEMETRY_CRC_POLY) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/*******************************************************************************
+* Function name: telemetry_cobs_encode
+*********************************************************************************
+* Summary:
+* Encodes a buffer with consistent overhead byte stuffing so that the output
+* contains no zero bytes, and appends the zero frame delimiter.
+*
+* Parameters:
+*  src:  bytes to encode
+*  size: number of bytes, at most 254
+*  dst:  output buffer of at least size + 2 bytes
+*
+* Return:
+*  uint32_t: number of bytes written to dst, including the delimiter
+*
+*******************************************************************************/
+uint32_t telemetry_cobs_encode(const uint8_t *src, uint32_t size, uint8_t *dst)
+{
+    uint32_t code_idx = 0U;
+    uint32_t out = 1U;
+    uint8_t code = 1U;
+
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        if (src[i] == 0U)
+        {
+            dst[code_idx] = code;
+            code_idx = out++;
+            code = 1U;
+        }
+        else
+        {
+            dst[out++] = src[i];
+            code++;
+        }
+    }
+    dst[code_idx] = code;
+    dst[out++] = 0U;
+
+    return out;
+}
+
+/*******************************************************************************
+* Function name: telemetry_init
+*********************************************************************************
+* Summary:
+* Enables the DWT cycle counter used for the record timestamps and takes the
+* origin of the timestamps. The counter is shared with the interrupt profile,
+* the UART rate timing and the command latency, so it is left running.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void telemetry_init(void)
+{
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    telemetry_base = DWT->CYCCNT;
+    telemetry_seq = 0U;
+}
+
+/*******************************************************************************
+* Function name: telemetry_send
+*********************************************************************************
+* Summary:
+* Takes a snapshot of the converter state and measurements, and sends it as
+* one framed record. Called at UART_TX_RATE_HZ, the frame is sent in the
+* background by uart_tx.c.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void telemetry_send(void)
+{
+    uint8_t record[TELEMETRY_RECORD_SIZE + TELEMETRY_CRC_SIZE];
+    uint32_t primask;
+
+    record[TELEMETRY_OFS_VERSION] = (uint8_t)TELEMETRY_VERSION;
+    put_u16(&record[TELEMETRY_OFS_SEQ], telemetry_seq++);
+
+    /* Snapshot of the values written by the ISRs. */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    put_u32(&record[TELEMETRY_OFS_TIMESTAMP], DWT->CYCCNT - telemetry_base);
+    record[TELEMETRY_OFS_STATE] = (uint8_t)buck_conv[BUCK_CONV_PRIMARY].state;
+    put_u16(&record[TELEMETRY_OFS_VOUT], (uint16_t)BUCK1_ctx.res);
+    put_u16(&record[TELEMETRY_OFS_IOUT1], (uint16_t)buck_conv[BUCK_CONV_PRIMARY].iout_res[0]);
+    put_u16(&record[TELEMETRY_OFS_IOUT2], (uint16_t)buck_conv[BUCK_CONV_PRIMARY].iout_res[1]);
+    put_u16(&record[TELEMETRY_OFS_VIN], (uint16_t)buck_conv[BUCK_CONV_PRIMARY].vin_res);
+    put_u16(&record[TELEMETRY_OFS_TEMP], (uint16_t)buck_conv[BUCK_CONV_PRIMARY].temp_res);
+    put_u32(&record[TELEMETRY_OFS_IOUT1_AVG], avg_to_record(buck_conv[BUCK_CONV_PRIMARY].iout_avg[0]));
+    put_u32(&record[TELEMETRY_OFS_IOUT2_AVG], avg_to_record(buck_conv[BUCK_CONV_PRIMARY].iout_avg[1]));
+    put_u32(&record[TELEMETRY_OFS_VIN_AVG], avg_to_record(buck_conv[BUCK_CONV_PRIMARY].vin_avg));
+    put_u32(&record[TELEMETRY_OFS_TEMP_AVG], avg_to_record(buck_conv[BUCK_CONV_PRIMARY].temp_avg));
+    put_u16(&record[TELEMETRY_OFS_SHARE_TRIM], (uint16_t)current_share.trim);
+    put_u16(&record[TELEMETRY_OFS_IMBALANCE], (uint16_t)current_share.imbalance);
+    __set_PRIMASK(primask);
+
+    telemetry_send_record(record, TELEMETRY_RECORD_SIZE);
+}
+
+/*******************************************************************************
+* Function name: telemetry_send_record
+*********************************************************************************
+* Summary:
+* Appends the CRC to a record, frames it and writes it to the transmit buffer
+* of the debug UART.
+*
+* Parameters:
+*  record: record buffer with TELEMETRY_CRC_SIZE spare bytes at the end
+*  size:   record size without the CRC, at most 252 bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void telemetry_send_record(uint8_t *record, uint32_t size)
+{
+    uint8_t frame[256];
+    uint32_t frame_size;
+
+    put_u16(&record[size], telemetry_crc16(record, size));
+    frame_size = telemetry_cobs_encode(record, size + TELEMETRY_CRC_SIZE, frame);
+    uart_tx_write(frame, frame_size);
+}
+
+/* [] END OF FILE */
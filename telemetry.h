@@ -0,0 +1,164 @@
+/*******************************************************************************
+* File Name: telemetry.h
+*
+* Description:
+* Binary telemetry stream on the debug UART. Each record has a fixed layout,
+* is protected by a CRC-16 and framed with consistent overhead byte stuffing
+* (COBS) followed by a zero delimiter byte.
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Telemetry mode: 0 - printf status line (default), 1 - binary records.
+ * Set with TELEMETRY_BINARY in the Makefile. */
+#ifndef TELEMETRY_BINARY
+#define TELEMETRY_BINARY            (0)
+#endif
+
+/* Status record layout, all fields little endian. The first byte identifies
+ * the kind of record. */
+#define TELEMETRY_VERSION           (2U)
+#define TELEMETRY_OFS_VERSION       (0U)    /* uint8:  TELEMETRY_VERSION */
+#define TELEMETRY_OFS_STATE         (1U)    /* uint8:  state of the primary converter */
+#define TELEMETRY_OFS_SEQ           (2U)    /* uint16: record sequence number */
+#define TELEMETRY_OFS_TIMESTAMP     (4U)    /* uint32: DWT cycle counter since telemetry_init() */
+#define TELEMETRY_OFS_VOUT          (8U)    /* uint16: BUCK1_ctx.res */
+#define TELEMETRY_OFS_IOUT1         (10U)   /* uint16: Iout1 ADC result */
+#define TELEMETRY_OFS_IOUT2         (12U)   /* uint16: Iout2 ADC result */
+#define TELEMETRY_OFS_VIN           (14U)   /* uint16: Vin ADC result */
+#define TELEMETRY_OFS_TEMP          (16U)   /* uint16: Temp ADC result */
+#define TELEMETRY_OFS_IOUT1_AVG     (18U)   /* int32:  averages in ADC counts */
+#define TELEMETRY_OFS_IOUT2_AVG     (22U)   /*         with TELEMETRY_AVG_FRAC_BITS */
+#define TELEMETRY_OFS_VIN_AVG       (26U)   /*         fractional bits */
+#define TELEMETRY_OFS_TEMP_AVG      (30U)
+#define TELEMETRY_OFS_SHARE_TRIM    (34U)   /* int16:  current sharing trim, DAC counts */
+#define TELEMETRY_OFS_IMBALANCE     (36U)   /* int16:  phase current imbalance, per mille */
+#define TELEMETRY_RECORD_SIZE       (38U)
+#define TELEMETRY_RECORD_SIZE_V1    (34U)   /* Version 1 records end after TEMP_AVG */
+#define TELEMETRY_AVG_FRAC_BITS     (15U)
+
+/* Scope dump record layout (see scope.h), followed by 'count' samples of
+ * res, out and compare (3 x uint16). */
+#define TELEMETRY_KIND_SCOPE        (0x53U)
+#define TELEMETRY_SCOPE_OFS_KIND    (0U)    /* uint8:  TELEMETRY_KIND_SCOPE */
+#define TELEMETRY_SCOPE_OFS_CAPTURE (1U)    /* uint8:  capture counter */
+#define TELEMETRY_SCOPE_OFS_SOURCE  (2U)    /* uint8:  scope_trigger_t */
+#define TELEMETRY_SCOPE_OFS_COUNT   (3U)    /* uint8:  samples in this record */
+#define TELEMETRY_SCOPE_OFS_INDEX   (4U)    /* uint16: index of the first sample */
+#define TELEMETRY_SCOPE_OFS_PRE     (6U)    /* uint16: samples before the trigger */
+#define TELEMETRY_SCOPE_OFS_DECIM   (8U)    /* uint16: decimation */
+#define TELEMETRY_SCOPE_OFS_SAMPLES (10U)
+#define TELEMETRY_SCOPE_SAMPLE_SIZE (6U)
+
+/* Flight recorder dump record layout (see flight_rec.h), followed by 'count'
+ * bytes of the fault record, starting at 'offset'. */
+#define TELEMETRY_KIND_FLIGHT       (0x46U)
+#define TELEMETRY_FLIGHT_OFS_KIND   (0U)    /* uint8:  TELEMETRY_KIND_FLIGHT */
+#define TELEMETRY_FLIGHT_OFS_SLOT   (1U)    /* uint8:  record slot */
+#define TELEMETRY_FLIGHT_OFS_OFFSET (2U)    /* uint16: offset in the record */
+#define TELEMETRY_FLIGHT_OFS_COUNT  (4U)    /* uint8:  record bytes in this frame */
+#define TELEMETRY_FLIGHT_OFS_DATA   (5U)
+
+/* Load step record layout (see load_step.h), sent for each completed step:
+ * the step and the statistics of its direction. Deviations are ADC counts
+ * from the reference, times are control periods from the edge. */
+#define TELEMETRY_KIND_STEP                 (0x54U)
+#define TELEMETRY_STEP_OFS_KIND             (0U)    /* uint8:  TELEMETRY_KIND_STEP */
+#define TELEMETRY_STEP_OFS_DIR              (1U)    /* uint8:  load_step_dir_t */
+#define TELEMETRY_STEP_OFS_COUNT            (2U)    /* uint16: steps of this direction */
+#define TELEMETRY_STEP_OFS_PEAK             (4U)    /* int16:  peak deviation */
+#define TELEMETRY_STEP_OFS_UNDER            (6U)    /* int16:  undershoot */
+#define TELEMETRY_STEP_OFS_OVER             (8U)    /* int16:  overshoot */
+#define TELEMETRY_STEP_OFS_RECOVERY         (10U)   /* uint16: recovery time */
+#define TELEMETRY_STEP_OFS_SETTLING         (12U)   /* uint16: settling time */
+#define TELEMETRY_STEP_OFS_PEAK_MEAN        (14U)   /* int16:  mean peak, 4 fractional bits */
+#define TELEMETRY_STEP_OFS_PEAK_WORST       (16U)   /* int16:  peak with the largest magnitude */
+#define TELEMETRY_STEP_OFS_SETTLING_MEAN    (18U)   /* uint16: mean settling time */
+#define TELEMETRY_STEP_OFS_SETTLING_MAX     (20U)   /* uint16: longest settling time */
+#define TELEMETRY_STEP_OFS_UNSETTLED        (22U)   /* uint16: steps not settled in the window */
+#define TELEMETRY_STEP_SIZE                 (24U)
+
+/* Energy record (see energy.h), sent for each complete window. */
+#define TELEMETRY_KIND_ENERGY               (0x45U)
+#define TELEMETRY_ENERGY_OFS_KIND           (0U)    /* uint8:  TELEMETRY_KIND_ENERGY */
+#define TELEMETRY_ENERGY_OFS_PHASES         (1U)    /* uint8:  active phases at the end of the window */
+#define TELEMETRY_ENERGY_OFS_WINDOW         (2U)    /* uint32: windows since the reset */
+#define TELEMETRY_ENERGY_OFS_P_OUT          (6U)    /* uint32: output power, mW */
+#define TELEMETRY_ENERGY_OFS_P_IN           (10U)   /* uint32: estimated input power, mW */
+#define TELEMETRY_ENERGY_OFS_EFFICIENCY     (14U)   /* uint16: efficiency, 0.01 % */
+#define TELEMETRY_ENERGY_OFS_E_OUT          (16U)   /* uint32: output energy, mWh */
+#define TELEMETRY_ENERGY_OFS_E_IN           (20U)   /* uint32: estimated input energy, mWh */
+#define TELEMETRY_ENERGY_OFS_VOUT_MIN       (24U)   /* uint16: output voltage, mV */
+#define TELEMETRY_ENERGY_OFS_VOUT_MAX       (26U)
+#define TELEMETRY_ENERGY_OFS_VOUT_RMS       (28U)
+#define TELEMETRY_ENERGY_OFS_IOUT_MIN       (30U)   /* uint16: load current, mA */
+#define TELEMETRY_ENERGY_OFS_IOUT_MAX       (32U)
+#define TELEMETRY_ENERGY_OFS_IOUT_RMS       (34U)
+#define TELEMETRY_ENERGY_SIZE               (36U)
+
+/* Command reply record (see uart_cmd.h), followed by the reply text without
+ * a terminating zero. */
+#define TELEMETRY_KIND_REPLY                (0x52U)
+#define TELEMETRY_REPLY_OFS_KIND            (0U)    /* uint8:  TELEMETRY_KIND_REPLY */
+#define TELEMETRY_REPLY_OFS_TEXT            (1U)
+
+/* CRC-16/CCITT-FALSE over the record, appended little endian. */
+#define TELEMETRY_CRC_INIT          (0xFFFFU)
+#define TELEMETRY_CRC_POLY          (0x1021U)
+#define TELEMETRY_CRC_SIZE          (2U)
+
+/* Encoded frame of a record of up to 252 bytes: COBS adds one byte per 254
+ * bytes, plus the delimiter. */
+#define TELEMETRY_FRAME_SIZE(size)  ((size) + TELEMETRY_CRC_SIZE + 2U)
+#define TELEMETRY_FRAME_MAX         TELEMETRY_FRAME_SIZE(TELEMETRY_RECORD_SIZE)
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void telemetry_init(void);
+void telemetry_send(void);
+uint16_t telemetry_crc16(const uint8_t *data, uint32_t size);
+uint32_t telemetry_cobs_encode(const uint8_t *src, uint32_t size, uint8_t *dst);
+void telemetry_send_record(uint8_t *record, uint32_t size);
+
+#endif  /* TELEMETRY_H */
+/* [] END OF FILE */
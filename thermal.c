@@ -0,0 +1,312 @@
+/*******************************************************************************
+* File Name: thermal.c
+*
+* Description:
+* Predictive thermal derating of the converters.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "buck_sm.h"
+#include "thermal.h"
+#include "uart_tx.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+thermal_t thermal =
+{
+    .enable  = (THERMAL_DERATE != 0),
+    .margin  = THERMAL_MARGIN_C * THERMAL_COUNTS_PER_C,
+    .horizon = THERMAL_HORIZON_S,
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: thermal_release
+*********************************************************************************
+* Summary:
+* Ends the derating of a converter and restores its nominal peak current limit.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void thermal_release(uint8_t conv)
+{
+    thermal_conv_t *t = &thermal.conv[conv];
+
+    t->active = false;
+    t->limit = t->nominal;
+    buck_conv_hw[conv].ctx->ctrl.max = t->nominal;
+}
+
+/*******************************************************************************
+* Function name: thermal_begin
+*********************************************************************************
+* Summary:
+* Called by the state machine before a converter starts. Keeps the output
+* clamp of its compensator as the nominal peak current limit on the first
+* start, restores it and clears the temperature history.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void thermal_begin(uint8_t conv)
+{
+    thermal_conv_t *t = &thermal.conv[conv];
+
+    if (t->nominal <= 0.0f)
+    {
+        t->nominal = buck_conv_hw[conv].ctx->ctrl.max;
+    }
+    thermal_release(conv);
+
+    t->sum = 0U;
+    t->samples = 0U;
+    t->pending = false;
+    t->valid = false;
+    t->slope = 0.0f;
+}
+
+/*******************************************************************************
+* Function name: thermal_process
+*********************************************************************************
+* Summary:
+* Called from the main loop. For each converter with a new temperature mean,
+* updates the slope and the prediction, and starts, adjusts or releases the
+* derating of its peak current limit. The limit is written with the
+* interrupts disabled, and only while the converter still runs from the start
+* the mean belongs to.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void thermal_process(void)
+{
+    const float32_t limit_min = THERMAL_LIMIT_MIN_A * THERMAL_DAC_PER_A;
+    uint8_t conv;
+
+    for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        thermal_conv_t *t = &thermal.conv[conv];
+        const buck_conv_t *c = &buck_conv[conv];
+        float32_t temp;
+        float32_t excess;
+        uint32_t primask;
+
+        if (!t->pending)
+        {
+            continue;
+        }
+        t->pending = false;
+
+        temp = (float32_t)t->mean_sum / (float32_t)THERMAL_SAMPLES;
+        if (t->valid)
+        {
+            t->slope += ((temp - t->temp) - t->slope) * THERMAL_SLOPE_WEIGHT;
+        }
+        t->temp = temp;
+        t->valid = true;
+        t->predicted = temp + (t->slope * thermal.horizon);
+
+        if (!thermal.enable)
+        {
+            continue;
+        }
+
+        excess = t->predicted - ((float32_t)buck_conv_get_limit(conv, BUCK_CONV_LIMIT_TEMP_MAX) - thermal.margin);
+        if (!t->active)
+        {
+            if (excess <= 0.0f)
+            {
+                continue;
+            }
+
+            /* Starts from the present peak current reference, so that the
+             * limit acts with the first step. */
+            t->active = true;
+            t->activations++;
+            t->limit = (float32_t)buck_conv_hw[conv].ctx->out;
+            if ((conv == BUCK_CONV_PRIMARY) && (c->state == Ifx_BUCK_STATE_TEST))
+            {
+                buck_sm_post(BUCK_SM_EV_PULSE_OFF, conv, 0U);
+            }
+        }
+
+        t->limit -= THERMAL_KI * excess;
+        if (t->limit < limit_min)
+        {
+            t->limit = limit_min;
+        }
+
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if (t->valid && ((c->state == Ifx_BUCK_STATE_RUN) || (c->state == Ifx_BUCK_STATE_TEST)))
+        {
+            if (t->limit >= t->nominal)
+            {
+                thermal_release(conv);
+            }
+            else
+            {
+                buck_conv_hw[conv].ctx->ctrl.max = t->limit;
+            }
+        }
+        __set_PRIMASK(primask);
+    }
+}
+
+/*******************************************************************************
+* Function name: thermal_set_enable
+*********************************************************************************
+* Summary:
+* Allows or forbids the derating. When forbidden, the nominal peak current
+* limit of a derated converter is restored at once.
+*
+* Parameters:
+*  enable: true to allow the derating
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void thermal_set_enable(bool enable)
+{
+    uint32_t primask;
+    uint8_t conv;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    thermal.enable = enable;
+    for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        if (!enable && thermal.conv[conv].active)
+        {
+            thermal_release(conv);
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+/*******************************************************************************
+* Function name: thermal_set_config
+*********************************************************************************
+* Summary:
+* Sets the derating setpoint below the temperature limit and the prediction
+* horizon. Values out of range are limited.
+*
+* Parameters:
+*  margin_c:  derating setpoint below the temperature limit, degC
+*  horizon_s: prediction horizon, s
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void thermal_set_config(float32_t margin_c, float32_t horizon_s)
+{
+    margin_c  = (margin_c < 0.0f) ? 0.0f : ((margin_c > THERMAL_MARGIN_C_MAX) ? THERMAL_MARGIN_C_MAX : margin_c);
+    horizon_s = (horizon_s < 0.0f) ? 0.0f : ((horizon_s > THERMAL_HORIZON_S_MAX) ? THERMAL_HORIZON_S_MAX : horizon_s);
+
+    thermal.margin  = margin_c * THERMAL_COUNTS_PER_C;
+    thermal.horizon = horizon_s;
+}
+
+/*******************************************************************************
+* Function name: thermal_limit_a
+*********************************************************************************
+* Summary:
+* Returns the peak current limit per phase of a converter.
+*
+* Parameters:
+*  conv: converter index
+*
+* Return:
+*  float32_t: derated or nominal limit, A
+*
+*******************************************************************************/
+float32_t thermal_limit_a(uint8_t conv)
+{
+    return buck_conv_hw[conv].ctx->ctrl.max / THERMAL_DAC_PER_A;
+}
+
+/*******************************************************************************
+* Function name: thermal_status
+*********************************************************************************
+* Summary:
+* Prints the peak current limit of each derated converter for the status line.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void thermal_status(void)
+{
+    uint8_t conv;
+
+    for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        if (thermal.conv[conv].active)
+        {
+            uart_tx_printf("%s_DERATE=%.2f A  ", buck_conv_hw[conv].name, (float64_t)thermal_limit_a(conv));
+        }
+    }
+}
+
+/* [] END OF FILE */
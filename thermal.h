@@ -0,0 +1,181 @@
+/*******************************************************************************
+* File Name: thermal.h
+*
+* Description:
+* Predictive thermal derating of the converters. The scheduled ADC callback
+* sums the temperature sense of each converter over one second in the RUN and
+* TEST states. The main loop takes the mean of each second, filters its rise
+* from the previous second to a slope and predicts the temperature
+* THERMAL_HORIZON_S ahead. When the prediction reaches the derating setpoint,
+* THERMAL_MARGIN_C below the temperature limit of the averaged protection,
+* the peak current limit of the converter (the output clamp of its
+* compensator) is taken from its present peak current reference and lowered
+* by an integral controller on the predicted excess, not below
+* THERMAL_LIMIT_MIN_A. On the primary converter the transient load of the
+* TEST state is stopped. The limit is raised again as the prediction falls
+* and released at the nominal clamp. The averaged protection still stops the
+* converter when the temperature limit is exceeded, i.e. only when the
+* derating cannot hold the temperature.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef THERMAL_H
+#define THERMAL_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "cybsp.h"
+#include "buck_conv.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Thermal derating: 0 - the temperature limit stops the converter, 1 -
+ * derating in front of it (default). Set with THERMAL_DERATE in the Makefile,
+ * and at run time with thermal_set_enable(). */
+#ifndef THERMAL_DERATE
+#define THERMAL_DERATE (1)
+#endif
+
+/* Scheduled ADC periods of one temperature mean (1 s) */
+#define THERMAL_SAMPLES             (100U)
+
+/* Conversions: temperature sense (0.55 V at 0 degC, 10 mV/degC) in ADC counts
+ * per degC, and CSG DAC counts per A (CurSenseGain 0.960 V/A). */
+#define THERMAL_COUNTS_PER_C        (4095.0f / 3.3f * 0.010f)
+#define THERMAL_COUNTS_AT_0C        (4095.0f / 3.3f * 0.55f)
+#define THERMAL_DAC_PER_A           (1023.0f / 3.3f * 0.960f)
+
+/* Defaults of the runtime settings: derating setpoint below the temperature
+ * limit, prediction horizon and lowest peak current limit per phase. */
+#define THERMAL_MARGIN_C            (5.0f)
+#define THERMAL_HORIZON_S           (20.0f)
+#define THERMAL_LIMIT_MIN_A         (1.0f)
+
+/* Ranges of the runtime settings */
+#define THERMAL_MARGIN_C_MAX        (20.0f)
+#define THERMAL_HORIZON_S_MAX       (60.0f)
+
+/* Integral gain: DAC counts per second per count of predicted excess. The
+ * loop crosses over at about 0.05 rad/s with the 30 s thermal time constant
+ * of the board, well below the 1 s update. */
+#define THERMAL_KI                  (0.05f)
+
+/* Weight of a new rise in the slope filter */
+#define THERMAL_SLOPE_WEIGHT        (0.25f)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t          sum;          /* Temperature sense of the current second, counts */
+    uint32_t          samples;
+    volatile uint32_t mean_sum;     /* Sum of the last complete second */
+    volatile bool     pending;      /* A second completed, for thermal_process() */
+    bool              valid;        /* temp holds a complete second */
+    bool              active;       /* The peak current limit is derated */
+    float32_t         temp;         /* Mean of the last second, counts */
+    float32_t         slope;        /* Filtered rise, counts per second */
+    float32_t         predicted;    /* Temperature at the horizon, counts */
+    float32_t         limit;        /* Derated peak current limit, DAC counts */
+    float32_t         nominal;      /* Compensator output clamp without derating */
+    uint32_t          activations;  /* Derating periods since the reset */
+} thermal_conv_t;
+
+typedef struct
+{
+    bool              enable;       /* Derating allowed */
+    float32_t         margin;       /* Derating setpoint below the temperature limit, counts */
+    float32_t         horizon;      /* Prediction horizon, s */
+    thermal_conv_t    conv[BUCK_CONV_NUM];
+} thermal_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern thermal_t thermal;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void thermal_begin(uint8_t conv);
+void thermal_process(void);
+void thermal_set_enable(bool enable);
+void thermal_set_config(float32_t margin_c, float32_t horizon_s);
+float32_t thermal_limit_a(uint8_t conv);
+void thermal_status(void);
+
+/*******************************************************************************
+* Function Name: thermal_sample
+*********************************************************************************
+* Summary:
+* Called from the scheduled ADC callback of a converter. Adds the temperature
+* sense of the period to the sum of the second in the RUN and TEST states and
+* hands a complete second to the main loop. Integer arithmetic only.
+*
+* Parameters:
+*  conv: converter index
+*  temp: temperature sense, ADC counts
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void thermal_sample(uint8_t conv, uint32_t temp)
+{
+    thermal_conv_t *t = &thermal.conv[conv];
+    Ifx_buck_states state = buck_conv[conv].state;
+
+    if ((state != Ifx_BUCK_STATE_RUN) && (state != Ifx_BUCK_STATE_TEST))
+    {
+        t->sum = 0U;
+        t->samples = 0U;
+        return;
+    }
+
+    t->sum += temp;
+    if (++t->samples >= THERMAL_SAMPLES)
+    {
+        t->mean_sum = t->sum;
+        t->pending = true;
+        t->sum = 0U;
+        t->samples = 0U;
+    }
+}
+
+#endif  /* THERMAL_H */
+/* [] END OF FILE */
@@ -0,0 +1,1076 @@
+/*******************************************************************************
+* File Name: uart_cmd.c
+*
+* Description:
+* Command interface on the debug UART: line reception in the UART interrupt,
+* parsing and execution in the main loop.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "buck_conv.h"
+#include "buck_sm.h"
+#include "autotune.h"
+#include "energy.h"
+#include "load_step.h"
+#include "load_ff.h"
+#include "scope.h"
+#include "setpoint.h"
+#include "telemetry.h"
+#include "thermal.h"
+#include "uart_tx.h"
+#include "uart_cmd.h"
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Executes a command with its checked number of words. Returns NULL or the
+ * reason why the command was rejected. */
+typedef const char *(*uart_cmd_exec_t)(uint32_t argc, char *argv[]);
+
+typedef struct
+{
+    const char      *name;
+    uint8_t          args_min;          /* Words after the command */
+    uint8_t          args_max;
+    uart_cmd_exec_t  exec;
+} uart_cmd_entry_t;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+static const char *uart_cmd_start(uint32_t argc, char *argv[]);
+static const char *uart_cmd_stop(uint32_t argc, char *argv[]);
+static const char *uart_cmd_vout(uint32_t argc, char *argv[]);
+static const char *uart_cmd_pulse(uint32_t argc, char *argv[]);
+static const char *uart_cmd_limit(uint32_t argc, char *argv[]);
+static const char *uart_cmd_stats(uint32_t argc, char *argv[]);
+static const char *uart_cmd_energy(uint32_t argc, char *argv[]);
+static const char *uart_cmd_thermal(uint32_t argc, char *argv[]);
+static const char *uart_cmd_ff(uint32_t argc, char *argv[]);
+static const char *uart_cmd_autotune(uint32_t argc, char *argv[]);
+static const char *uart_cmd_scope(uint32_t argc, char *argv[]);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+uart_cmd_t uart_cmd;
+
+static const uart_cmd_entry_t uart_cmd_table[] =
+{
+    { "start",   0U, 0U, uart_cmd_start },
+    { "stop",    0U, 0U, uart_cmd_stop },
+    { "vout",    0U, 2U, uart_cmd_vout },
+    { "pulse",   1U, 2U, uart_cmd_pulse },
+    { "limit",   0U, 2U, uart_cmd_limit },
+    { "stats",   0U, 0U, uart_cmd_stats },
+    { "energy",  0U, 1U, uart_cmd_energy },
+    { "thermal", 0U, 2U, uart_cmd_thermal },
+    { "ff",      0U, 1U, uart_cmd_ff },
+    { "autotune", 0U, 1U, uart_cmd_autotune },
+    { "scope",   0U, 3U, uart_cmd_scope },
+};
+
+static const char *const uart_cmd_limit_names[BUCK_CONV_LIMITS] =
+{
+    [BUCK_CONV_LIMIT_VIN_MIN]  = "vin_min",
+    [BUCK_CONV_LIMIT_VIN_MAX]  = "vin_max",
+    [BUCK_CONV_LIMIT_IOUT_MAX] = "iout_max",
+    [BUCK_CONV_LIMIT_TEMP_MAX] = "temp_max",
+};
+
+static const char *const uart_cmd_state_names[] = { "IDLE", "RAMP", "RUN", "TEST", "FAULT" };
+
+/* Reply being written, with room for the kind and the CRC of a record. */
+static uint8_t  uart_cmd_record[1U + UART_CMD_REPLY_MAX + TELEMETRY_CRC_SIZE];
+static char    *const uart_cmd_text = (char *)&uart_cmd_record[1];
+static uint32_t uart_cmd_text_len;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: uart_cmd_reply
+*********************************************************************************
+* Summary:
+* Appends text to the reply of the command being executed.
+*
+* Parameters:
+*  format: printf format
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_cmd_reply(const char *format, ...)
+{
+    va_list args;
+    int n;
+
+    va_start(args, format);
+    n = vsnprintf(&uart_cmd_text[uart_cmd_text_len], UART_CMD_REPLY_MAX + 1U - uart_cmd_text_len, format, args);
+    va_end(args);
+    if (n > 0)
+    {
+        uart_cmd_text_len += (uint32_t)n;
+        if (uart_cmd_text_len > UART_CMD_REPLY_MAX)
+        {
+            uart_cmd_text_len = UART_CMD_REPLY_MAX;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_reply_send
+*********************************************************************************
+* Summary:
+* Writes the reply to the debug UART, on a line of its own or as a reply
+* record of the binary telemetry stream.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_cmd_reply_send(void)
+{
+#if TELEMETRY_BINARY
+    uart_cmd_record[TELEMETRY_REPLY_OFS_KIND] = TELEMETRY_KIND_REPLY;
+    telemetry_send_record(uart_cmd_record, TELEMETRY_REPLY_OFS_TEXT + uart_cmd_text_len);
+#else
+    uart_cmd_text[uart_cmd_text_len] = '\0';
+    uart_tx_printf("\r\n%s\r\n", uart_cmd_text);
+#endif
+    uart_cmd_text_len = 0U;
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_number
+*********************************************************************************
+* Summary:
+* Converts a decimal word to a number.
+*
+* Parameters:
+*  text: word
+*  value: number
+*
+* Return:
+*  bool: false when the word is not a number below 2^32
+*
+*******************************************************************************/
+static bool uart_cmd_number(const char *text, uint32_t *value)
+{
+    uint32_t v = 0U;
+
+    if (*text == '\0')
+    {
+        return false;
+    }
+    for (; *text != '\0'; text++)
+    {
+        uint32_t digit = (uint32_t)(*text - '0');
+
+        if ((digit > 9U) || (v > ((UINT32_MAX - digit) / 10U)))
+        {
+            return false;
+        }
+        v = (v * 10U) + digit;
+    }
+    *value = v;
+    return true;
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_split
+*********************************************************************************
+* Summary:
+* Splits a line into words separated by spaces or tabs. The separators are
+* replaced by zeros in place.
+*
+* Parameters:
+*  line: line, zero terminated
+*  argv: start of each word
+*
+* Return:
+*  uint32_t: number of words, UART_CMD_ARGS_MAX + 1 when there are more
+*
+*******************************************************************************/
+static uint32_t uart_cmd_split(char *line, char *argv[])
+{
+    uint32_t argc = 0U;
+    char *p = line;
+
+    for (;;)
+    {
+        while ((*p == ' ') || (*p == '\t'))
+        {
+            *p = '\0';
+            p++;
+        }
+        if (*p == '\0')
+        {
+            return argc;
+        }
+        if (argc == UART_CMD_ARGS_MAX)
+        {
+            return UART_CMD_ARGS_MAX + 1U;
+        }
+        argv[argc] = p;
+        argc++;
+        while ((*p != '\0') && (*p != ' ') && (*p != '\t'))
+        {
+            p++;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_start / uart_cmd_stop
+*********************************************************************************
+* Summary:
+* Posts the start or the stop of the converters to the state machine, which
+* executes it like a button press. A stop also clears a fault.
+*
+* Parameters:
+*  argc: number of words
+*  argv: words
+*
+* Return:
+*  const char *: NULL or the reason of the rejection
+*
+*******************************************************************************/
+static const char *uart_cmd_start(uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    if (buck_conv_any(Ifx_BUCK_STATE_RAMP) || buck_conv_any(Ifx_BUCK_STATE_RUN) ||
+        buck_conv_any(Ifx_BUCK_STATE_TEST) || buck_conv_any(Ifx_BUCK_STATE_FAULT))
+    {
+        return "not idle";
+    }
+    buck_sm_post(BUCK_SM_EV_START, BUCK_CONV_PRIMARY, 0U);
+    uart_cmd_reply("ok start");
+    return NULL;
+}
+
+static const char *uart_cmd_stop(uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    buck_sm_post(BUCK_SM_EV_STOP, BUCK_CONV_PRIMARY, 0U);
+    uart_cmd_reply("ok stop");
+    return NULL;
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_vout
+*********************************************************************************
+* Summary:
+* Replies with the output voltage setpoint and the result of the last change
+* (vout), or sets the setpoint of the converters, optionally with the slew
+* rate of the change (vout <mV> [<mV/ms>]). In RUN and TEST, the reference
+* moves to the new setpoint at the slew rate, in IDLE the next soft start
+* ramps to it. It cannot be changed during the soft start.
+*
+* Parameters:
+*  argc: number of words
+*  argv: words
+*
+* Return:
+*  const char *: NULL or the reason of the rejection
+*
+*******************************************************************************/
+static const char *uart_cmd_vout(uint32_t argc, char *argv[])
+{
+    const setpoint_t *s = &setpoint[BUCK_CONV_PRIMARY];
+    uint32_t mv;
+    uint32_t slew = 0U;
+    uint8_t conv;
+
+    if (argc == 1U)
+    {
+        uart_cmd_reply("ok vout mv=%.0f slew=%lu transitions=%lu transition_ms=%.2f overshoot_mv=%.0f",
+                       (float64_t)((float32_t)buck_conv_hw[BUCK_CONV_PRIMARY].ctx->targ *
+                                   (1000.0f / SETPOINT_COUNTS_PER_V)),
+                       (unsigned long)s->slew, (unsigned long)s->transitions,
+                       (float64_t)setpoint_transition_ms(BUCK_CONV_PRIMARY),
+                       (float64_t)setpoint_overshoot_mv(BUCK_CONV_PRIMARY));
+        return NULL;
+    }
+
+    if (!uart_cmd_number(argv[1], &mv) || (mv < SETPOINT_MV_MIN) || (mv > SETPOINT_MV_MAX))
+    {
+        return "out of range";
+    }
+    if ((argc > 2U) &&
+        (!uart_cmd_number(argv[2], &slew) || (slew < SETPOINT_SLEW_MV_MS_MIN) || (slew > SETPOINT_SLEW_MV_MS_MAX)))
+    {
+        return "slew out of range";
+    }
+    if (buck_conv_any(Ifx_BUCK_STATE_RAMP))
+    {
+        return "ramping";
+    }
+
+    for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        if (!setpoint_set(conv, mv, slew))
+        {
+            return "ramping";
+        }
+    }
+    uart_cmd_reply("ok vout mv=%lu counts=%lu slew=%lu", (unsigned long)mv,
+                   (unsigned long)buck_conv_hw[BUCK_CONV_PRIMARY].ctx->targ,
+                   (unsigned long)((slew == 0U) ? SETPOINT_SLEW_MV_MS : slew));
+    return NULL;
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_pulse
+*********************************************************************************
+* Summary:
+* Starts the transient load of the converters in RUN, stops it in TEST, or
+* sets its duty cycle and frequency, also while it is running.
+*
+* Parameters:
+*  argc: number of words
+*  argv: words
+*
+* Return:
+*  const char *: NULL or the reason of the rejection
+*
+*******************************************************************************/
+static const char *uart_cmd_pulse(uint32_t argc, char *argv[])
+{
+    uint32_t duty;
+    uint32_t hz;
+    uint32_t period;
+    uint32_t primask;
+    bool pulsing;
+
+    if (argc == 2U)
+    {
+        if (0 == strcmp(argv[1], "on"))
+        {
+            if (buck_conv[BUCK_CONV_PRIMARY].state != Ifx_BUCK_STATE_RUN)
+            {
+                return "not running";
+            }
+            buck_sm_post(BUCK_SM_EV_PULSE_ON, BUCK_CONV_PRIMARY, 0U);
+        }
+        else if (0 == strcmp(argv[1], "off"))
+        {
+            if (buck_conv[BUCK_CONV_PRIMARY].state != Ifx_BUCK_STATE_TEST)
+            {
+                return "not pulsing";
+            }
+            buck_sm_post(BUCK_SM_EV_PULSE_OFF, BUCK_CONV_PRIMARY, 0U);
+        }
+        else
+        {
+            return "on or off";
+        }
+        uart_cmd_reply("ok pulse %s", argv[1]);
+        return NULL;
+    }
+
+    if (!uart_cmd_number(argv[1], &duty) || !uart_cmd_number(argv[2], &hz) ||
+        (duty < UART_CMD_PULSE_DUTY_MIN) || (duty > UART_CMD_PULSE_DUTY_MAX) ||
+        (hz < UART_CMD_PULSE_HZ_MIN) || (hz > UART_CMD_PULSE_HZ_MAX))
+    {
+        return "out of range";
+    }
+
+    /* A running counter is stopped while both values change and reloaded,
+     * so that no pulse mixes the old and the new period or compare value. */
+    period = UART_CMD_LOAD_CLK_HZ / hz;
+    primask = __get_PRIMASK();
+    __disable_irq();
+    pulsing = (buck_conv[BUCK_CONV_PRIMARY].state == Ifx_BUCK_STATE_TEST);
+    if (pulsing)
+    {
+        Cy_TCPWM_TriggerStopOrKill_Single(PWM_LOAD_HW, PWM_LOAD_NUM);
+    }
+    Cy_TCPWM_PWM_SetPeriod0(PWM_LOAD_HW, PWM_LOAD_NUM, period);
+    Cy_TCPWM_PWM_SetCompare0Val(PWM_LOAD_HW, PWM_LOAD_NUM, (period * duty) / 100U);
+    if (pulsing)
+    {
+        Cy_TCPWM_TriggerReloadOrIndex_Single(PWM_LOAD_HW, PWM_LOAD_NUM);
+    }
+    __set_PRIMASK(primask);
+    uart_cmd_reply("ok pulse duty=%lu hz=%lu", (unsigned long)duty, (unsigned long)hz);
+    return NULL;
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_limit
+*********************************************************************************
+* Summary:
+* Lists the limits of the averaged protection of the primary converter, or
+* sets a limit of all converters. A limit can only be tightened from its
+* default, see buck_conv_set_limit().
+*
+* Parameters:
+*  argc: number of words
+*  argv: words
+*
+* Return:
+*  const char *: NULL or the reason of the rejection
+*
+*******************************************************************************/
+static const char *uart_cmd_limit(uint32_t argc, char *argv[])
+{
+    uint32_t limit;
+    uint32_t counts;
+    uint8_t conv;
+
+    if (argc == 1U)
+    {
+        uart_cmd_reply("ok limit");
+        for (limit = 0U; limit < (uint32_t)BUCK_CONV_LIMITS; limit++)
+        {
+            uart_cmd_reply(" %s=%u", uart_cmd_limit_names[limit],
+                           buck_conv_get_limit(BUCK_CONV_PRIMARY, (buck_conv_limit_t)limit));
+        }
+        return NULL;
+    }
+    if (argc != 3U)
+    {
+        return "name and counts";
+    }
+
+    for (limit = 0U; limit < (uint32_t)BUCK_CONV_LIMITS; limit++)
+    {
+        if (0 == strcmp(argv[1], uart_cmd_limit_names[limit]))
+        {
+            break;
+        }
+    }
+    if (limit == (uint32_t)BUCK_CONV_LIMITS)
+    {
+        return "unknown limit";
+    }
+    if (!uart_cmd_number(argv[2], &counts) || (counts > UINT16_MAX))
+    {
+        return "out of range";
+    }
+    for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        if (!buck_conv_set_limit(conv, (buck_conv_limit_t)limit, (uint16_t)counts))
+        {
+            return "out of range";
+        }
+    }
+    uart_cmd_reply("ok limit %s=%lu", argv[1], (unsigned long)counts);
+    return NULL;
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_stats
+*********************************************************************************
+* Summary:
+* Replies with the state of each converter, the output voltage and setpoint
+* of the primary converter, the load steps measured in TEST, the counters of
+* the state machine, the commands and the UART, and the last, mean and
+* longest command latency.
+*
+* Parameters:
+*  argc: number of words
+*  argv: words
+*
+* Return:
+*  const char *: NULL
+*
+*******************************************************************************/
+static const char *uart_cmd_stats(uint32_t argc, char *argv[])
+{
+    const mtb_stc_pwrconv_ctx_t *ctx = buck_conv_hw[BUCK_CONV_PRIMARY].ctx;
+    const float32_t us_per_cycle = 1.0e6f / (float32_t)SystemCoreClock;
+    uint32_t commands = uart_cmd.executed + uart_cmd.rejected;
+    uint8_t conv;
+
+    (void)argc;
+    (void)argv;
+
+    uart_cmd_reply("ok stats state=");
+    for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        uart_cmd_reply("%s%s", (conv > 0U) ? "," : "", uart_cmd_state_names[buck_conv[conv].state]);
+    }
+    uart_cmd_reply(" vout_mv=%.0f target_mv=%.0f steps=%lu events=%lu ignored=%lu dropped=%lu fault_overflows=%lu "
+                   "cmds=%lu rejected=%lu lost=%lu latency_us=%.1f/%.1f/%.1f uart_dropped=%lu",
+                   (float64_t)((float32_t)ctx->res * (1000.0f / UART_CMD_COUNTS_PER_V)),
+                   (float64_t)((float32_t)ctx->targ * (1000.0f / UART_CMD_COUNTS_PER_V)),
+                   (unsigned long)(load_step.stats[LOAD_STEP_UP].count + load_step.stats[LOAD_STEP_DOWN].count),
+                   (unsigned long)buck_sm.processed, (unsigned long)buck_sm.ignored,
+                   (unsigned long)atomic_load_explicit(&buck_sm.queue.dropped, memory_order_relaxed),
+                   (unsigned long)buck_sm.fault_overflows,
+                   (unsigned long)uart_cmd.executed, (unsigned long)uart_cmd.rejected,
+                   (unsigned long)(uart_cmd.overflows + uart_cmd.too_long),
+                   (float64_t)((float32_t)uart_cmd.latency_last * us_per_cycle),
+                   (commands == 0U) ? 0.0 : ((float64_t)uart_cmd.latency_sum * (float64_t)us_per_cycle / commands),
+                   (float64_t)((float32_t)uart_cmd.latency_max * us_per_cycle),
+                   (unsigned long)uart_tx.dropped);
+    return NULL;
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_energy
+*********************************************************************************
+* Summary:
+* Replies with the output power, estimated input power and efficiency of the
+* last energy window, the output voltage and load current minimum, RMS and
+* maximum of the window and the energy, or clears the energy accounting
+* (energy reset).
+*
+* Parameters:
+*  argc: number of words
+*  argv: words
+*
+* Return:
+*  const char *: error, NULL on success
+*
+*******************************************************************************/
+static const char *uart_cmd_energy(uint32_t argc, char *argv[])
+{
+    energy_result_t r;
+    uint32_t primask;
+
+    if (argc > 1U)
+    {
+        if (0 != strcmp(argv[1], "reset"))
+        {
+            return "unknown argument";
+        }
+        primask = __get_PRIMASK();
+        __disable_irq();
+        energy_reset();
+        __set_PRIMASK(primask);
+        uart_cmd_reply("ok energy reset");
+        return NULL;
+    }
+
+    energy_result(&r);
+    uart_cmd_reply("ok energy windows=%lu p_out_w=%.3f p_in_w=%.3f efficiency=%.2f e_out_wh=%.4f e_in_wh=%.4f "
+                   "vout_mv=%.0f/%.0f/%.0f iout_ma=%.0f/%.0f/%.0f",
+                   (unsigned long)r.windows, (float64_t)r.p_out, (float64_t)r.p_in,
+                   (float64_t)(r.efficiency * 100.0f), r.e_out, r.e_in,
+                   (float64_t)(r.vout_min * 1000.0f), (float64_t)(r.vout_rms * 1000.0f),
+                   (float64_t)(r.vout_max * 1000.0f), (float64_t)(r.iout_min * 1000.0f),
+                   (float64_t)(r.iout_rms * 1000.0f), (float64_t)(r.iout_max * 1000.0f));
+    return NULL;
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_thermal
+*********************************************************************************
+* Summary:
+* Replies with the settings of the thermal derating and the temperature,
+* slope, prediction and peak current limit of each converter, allows or
+* forbids the derating (thermal on|off), or sets the derating setpoint below
+* the temperature limit and the prediction horizon.
+*
+* Parameters:
+*  argc: number of words
+*  argv: words
+*
+* Return:
+*  const char *: error, NULL on success
+*
+*******************************************************************************/
+static const char *uart_cmd_thermal(uint32_t argc, char *argv[])
+{
+    uint32_t margin;
+    uint32_t horizon;
+    uint8_t conv;
+
+    if (argc == 2U)
+    {
+        if ((0 != strcmp(argv[1], "on")) && (0 != strcmp(argv[1], "off")))
+        {
+            return "on or off";
+        }
+        thermal_set_enable(argv[1][1] == 'n');
+        uart_cmd_reply("ok thermal %s", argv[1]);
+        return NULL;
+    }
+
+    if (argc == 3U)
+    {
+        if (!uart_cmd_number(argv[1], &margin) || !uart_cmd_number(argv[2], &horizon) ||
+            ((float32_t)margin > THERMAL_MARGIN_C_MAX) || ((float32_t)horizon > THERMAL_HORIZON_S_MAX))
+        {
+            return "out of range";
+        }
+        thermal_set_config((float32_t)margin, (float32_t)horizon);
+        uart_cmd_reply("ok thermal margin_c=%lu horizon_s=%lu", (unsigned long)margin, (unsigned long)horizon);
+        return NULL;
+    }
+
+    uart_cmd_reply("ok thermal %s margin_c=%.0f horizon_s=%.0f", thermal.enable ? "on" : "off",
+                   (float64_t)(thermal.margin / THERMAL_COUNTS_PER_C), (float64_t)thermal.horizon);
+    for (conv = 0U; conv < BUCK_CONV_NUM; conv++)
+    {
+        const thermal_conv_t *t = &thermal.conv[conv];
+
+        uart_cmd_reply(" %s temp_c=%.1f slope_c_s=%.3f predicted_c=%.1f limit_a=%.2f%s", buck_conv_hw[conv].name,
+                       (float64_t)((t->temp - THERMAL_COUNTS_AT_0C) / THERMAL_COUNTS_PER_C),
+                       (float64_t)(t->slope / THERMAL_COUNTS_PER_C),
+                       (float64_t)((t->predicted - THERMAL_COUNTS_AT_0C) / THERMAL_COUNTS_PER_C),
+                       (float64_t)thermal_limit_a(conv), t->active ? " derated" : "");
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_execute
+*********************************************************************************
+* Summary:
+* Looks up the command of a line, checks its number of words and executes
+* it. Sends the reply.
+*
+* Parameters:
+*  line: line, zero terminated, changed in place
+*
+* Return:
+*  bool: false for an empty line
+*
+*******************************************************************************/
+static bool uart_cmd_execute(char *line)
+{
+    char *argv[UART_CMD_ARGS_MAX];
+    const uart_cmd_entry_t *cmd = NULL;
+    const char *error;
+    uint32_t argc;
+    uint32_t i;
+
+    argc = uart_cmd_split(line, argv);
+    if (argc == 0U)
+    {
+        return false;
+    }
+
+    for (i = 0U; i < (sizeof(uart_cmd_table) / sizeof(uart_cmd_table[0])); i++)
+    {
+        if (0 == strcmp(argv[0], uart_cmd_table[i].name))
+        {
+            cmd = &uart_cmd_table[i];
+            break;
+        }
+    }
+
+    if (cmd == NULL)
+    {
+        error = "unknown command";
+    }
+    else if ((argc > UART_CMD_ARGS_MAX) || ((argc - 1U) < cmd->args_min) || ((argc - 1U) > cmd->args_max))
+    {
+        error = "arguments";
+    }
+    else
+    {
+        error = cmd->exec(argc, argv);
+    }
+
+    if (error != NULL)
+    {
+        uart_cmd_text_len = 0U;
+        uart_cmd_reply("err %s: %s", argv[0], error);
+        uart_cmd.rejected++;
+    }
+    else
+    {
+        uart_cmd.executed++;
+    }
+    uart_cmd_reply_send();
+    return true;
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_init
+*********************************************************************************
+* Summary:
+* Empties the line slots and enables the receive interrupt of the debug UART.
+* The interrupt itself is installed by uart_tx_init(), which must be called
+* first.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_cmd_init(void)
+{
+    uart_cmd.head = 0U;
+    uart_cmd.tail = 0U;
+    uart_cmd.len = 0U;
+    uart_cmd.skip = false;
+    uart_cmd.overflows = 0U;
+    uart_cmd.too_long = 0U;
+    uart_cmd.executed = 0U;
+    uart_cmd.rejected = 0U;
+    uart_cmd.latency_last = 0U;
+    uart_cmd.latency_max = 0U;
+    uart_cmd.latency_sum = 0U;
+    uart_cmd_text_len = 0U;
+
+    Cy_SCB_UART_ClearRxFifoStatus(DEBUG_UART_HW, CY_SCB_UART_RX_NOT_EMPTY);
+    Cy_SCB_SetRxInterruptMask(DEBUG_UART_HW, CY_SCB_UART_RX_NOT_EMPTY);
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_receive
+*********************************************************************************
+* Summary:
+* Called from the interrupt of the debug UART. Takes the received characters
+* from the UART FIFO into the line slot being filled. A CR or LF completes the
+* line, it is stamped with the cycle counter and handed to the main loop.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_cmd_receive(void)
+{
+    uint8_t data[16];
+    uint32_t count;
+    uint32_t i;
+
+    /* Cleared before the FIFO is read, a character arriving after the last
+     * read sets it again. */
+    Cy_SCB_UART_ClearRxFifoStatus(DEBUG_UART_HW, CY_SCB_UART_RX_NOT_EMPTY);
+
+    do
+    {
+        count = Cy_SCB_UART_GetArray(DEBUG_UART_HW, data, sizeof(data));
+        for (i = 0U; i < count; i++)
+        {
+            uint32_t slot = uart_cmd.head % UART_CMD_LINES;
+            char c = (char)data[i];
+
+            if ((c == '\r') || (c == '\n'))
+            {
+                if (!uart_cmd.skip && (uart_cmd.len > 0U))
+                {
+                    uart_cmd.line[slot][uart_cmd.len] = '\0';
+                    uart_cmd.stamp[slot] = DWT->CYCCNT;
+
+                    /* The line is complete before the main loop sees it. */
+                    __DMB();
+                    uart_cmd.head++;
+                }
+                uart_cmd.len = 0U;
+                uart_cmd.skip = false;
+            }
+            else if (uart_cmd.skip)
+            {
+                /* Rest of a discarded line */
+            }
+            else if ((uart_cmd.head - uart_cmd.tail) >= UART_CMD_LINES)
+            {
+                uart_cmd.overflows++;
+                uart_cmd.skip = true;
+            }
+            else if (uart_cmd.len >= (UART_CMD_LINE_MAX - 1U))
+            {
+                uart_cmd.too_long++;
+                uart_cmd.skip = true;
+            }
+            else
+            {
+                uart_cmd.line[slot][uart_cmd.len] = c;
+                uart_cmd.len++;
+            }
+        }
+    } while (count == sizeof(data));
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_process
+*********************************************************************************
+* Summary:
+* Called in each pass of the main loop. Executes the received lines in order
+* and records the time from the end of each line to the end of its command.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_cmd_process(void)
+{
+    while (uart_cmd.tail != uart_cmd.head)
+    {
+        uint32_t slot = uart_cmd.tail % UART_CMD_LINES;
+        uint32_t latency;
+
+        /* The line is read after the index that published it. */
+        __DMB();
+        if (uart_cmd_execute(uart_cmd.line[slot]))
+        {
+            latency = DWT->CYCCNT - uart_cmd.stamp[slot];
+            uart_cmd.latency_last = latency;
+            uart_cmd.latency_sum += latency;
+            if (latency > uart_cmd.latency_max)
+            {
+                uart_cmd.latency_max = latency;
+            }
+        }
+
+        /* The slot is free for the interrupt once the command is done. */
+        __DMB();
+        uart_cmd.tail++;
+    }
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_ff
+*********************************************************************************
+* Summary:
+* Replies with the state of the load step feedforward (ff), requests it on or
+* off (ff on|off), or sets the load current step it starts from (ff <mA>).
+*
+* Parameters:
+*  argc: number of words
+*  argv: words
+*
+* Return:
+*  const char *: error, NULL on success
+*
+*******************************************************************************/
+static const char *uart_cmd_ff(uint32_t argc, char *argv[])
+{
+    uint32_t step_ma;
+
+    if (argc == 2U)
+    {
+        if ((0 == strcmp(argv[1], "on")) || (0 == strcmp(argv[1], "off")))
+        {
+            load_ff_set_enable(argv[1][1] == 'n');
+            uart_cmd_reply("ok ff %s", argv[1]);
+            return NULL;
+        }
+        if (!uart_cmd_number(argv[1], &step_ma) || (step_ma > (uint32_t)LOAD_FF_STEP_MA_MAX) ||
+            !load_ff_set_step((int32_t)step_ma))
+        {
+            return "out of range";
+        }
+        uart_cmd_reply("ok ff step_ma=%lu", (unsigned long)step_ma);
+        return NULL;
+    }
+
+    uart_cmd_reply("ok ff %s%s step_ma=%.0f edges=%lu", load_ff.enable ? "on" : "off",
+                   (load_ff.active != load_ff.enable) ? " pending" : "", (float64_t)load_ff_step_ma(),
+                   (unsigned long)load_ff.edges);
+    return NULL;
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_autotune
+*********************************************************************************
+* Summary:
+* Replies with the result of the last auto-tuning (autotune), starts the
+* converters with an auto-tuning experiment from IDLE (autotune start), or
+* returns from the tuned sets to the sets of the gain scheduling
+* (autotune off).
+*
+* Parameters:
+*  argc: number of words
+*  argv: words
+*
+* Return:
+*  const char *: error, NULL on success
+*
+*******************************************************************************/
+static const char *uart_cmd_autotune(uint32_t argc, char *argv[])
+{
+    if (argc == 2U)
+    {
+        if (0 == strcmp(argv[1], "start"))
+        {
+            if (buck_conv_any(Ifx_BUCK_STATE_RAMP) || buck_conv_any(Ifx_BUCK_STATE_RUN) ||
+                buck_conv_any(Ifx_BUCK_STATE_TEST) || buck_conv_any(Ifx_BUCK_STATE_FAULT))
+            {
+                return "not idle";
+            }
+            if (!autotune_request())
+            {
+                return "busy";
+            }
+            buck_sm_post(BUCK_SM_EV_START, BUCK_CONV_PRIMARY, 0U);
+        }
+        else if (0 == strcmp(argv[1], "off"))
+        {
+            if (!autotune_discard())
+            {
+                return "busy";
+            }
+        }
+        else
+        {
+            return "start or off";
+        }
+        uart_cmd_reply("ok autotune %s", argv[1]);
+        return NULL;
+    }
+
+    uart_cmd_reply("ok autotune %s%s%s c_uf=%.0f esr_mohm=%.1f delay=%.1f fit=%.3f tuned=%s",
+                   autotune_busy() ? "busy" : autotune_result_name(autotune.result),
+                   (autotune.reason != NULL) ? " " : "", (autotune.reason != NULL) ? autotune.reason : "",
+                   (float64_t)autotune.plant.c_uf, (float64_t)autotune.plant.esr_mohm,
+                   (float64_t)autotune.plant.delay, (float64_t)autotune.plant.fit,
+                   gain_sched.tuned_active ? "on" : "off");
+    return NULL;
+}
+
+/*******************************************************************************
+* Function name: uart_cmd_scope
+*********************************************************************************
+* Summary:
+* Replies with the state of the capture buffer (scope), arms it for one capture
+* on the next entry to TEST, the next fault or at once (scope test|fault|force
+* [<decimation>]), or on a crossing of the output voltage result
+* (scope rising|falling <counts> [<decimation>]), or disarms it (scope off).
+* The completed capture is sent in place of the status and the scope stays
+* idle until it is armed again.
+*
+* Parameters:
+*  argc: number of words
+*  argv: words
+*
+* Return:
+*  const char *: error, NULL on success
+*
+*******************************************************************************/
+static const char *uart_cmd_scope(uint32_t argc, char *argv[])
+{
+    static const char *const trigger_names[] = { "off", "test", "fault", "rising", "falling", "force" };
+    static const char *const state_names[] = { "idle", "done", "armed", "triggered" };
+    scope_config_t cfg = scope_default_config;
+    uint32_t trigger;
+    uint32_t arg = 2U;
+    uint32_t value;
+
+    if (argc == 1U)
+    {
+        uart_cmd_reply("ok scope %s trigger=%s level=%u decimation=%u pre=%u captures=%u",
+                       state_names[scope.state], trigger_names[scope.cfg.trigger], scope.cfg.level,
+                       scope.cfg.decimation, scope.cfg.pre_trigger, scope.capture);
+        return NULL;
+    }
+
+    for (trigger = 0U; trigger < (sizeof(trigger_names) / sizeof(trigger_names[0])); trigger++)
+    {
+        if (0 == strcmp(argv[1], trigger_names[trigger]))
+        {
+            break;
+        }
+    }
+    if (trigger >= (sizeof(trigger_names) / sizeof(trigger_names[0])))
+    {
+        return "unknown trigger";
+    }
+    if (scope.state == SCOPE_STATE_DONE)
+    {
+        return "busy";
+    }
+    if (trigger == (uint32_t)SCOPE_TRIG_NONE)
+    {
+        if (argc > 2U)
+        {
+            return "arguments";
+        }
+        scope.state = SCOPE_STATE_IDLE;
+        uart_cmd_reply("ok scope off");
+        return NULL;
+    }
+
+    cfg.trigger = (scope_trigger_t)trigger;
+    if ((cfg.trigger == SCOPE_TRIG_RISING) || (cfg.trigger == SCOPE_TRIG_FALLING))
+    {
+        if ((argc < 3U) || !uart_cmd_number(argv[2], &value) || (value > 4095U))
+        {
+            return "level out of range";
+        }
+        cfg.level = (uint16_t)value;
+        arg = 3U;
+    }
+    if (argc > (arg + 1U))
+    {
+        return "arguments";
+    }
+    if (argc == (arg + 1U))
+    {
+        if (!uart_cmd_number(argv[arg], &value) || (value == 0U) || (value > UINT16_MAX))
+        {
+            return "decimation out of range";
+        }
+        cfg.decimation = (uint16_t)value;
+    }
+    if (cfg.trigger == SCOPE_TRIG_FORCE)
+    {
+        cfg.pre_trigger = 0U;
+    }
+
+    scope_arm(&cfg);
+    if (cfg.trigger == SCOPE_TRIG_FORCE)
+    {
+        scope_trigger(SCOPE_TRIG_FORCE);
+    }
+    uart_cmd_reply("ok scope %s level=%u decimation=%u", argv[1], cfg.level, cfg.decimation);
+    return NULL;
+}
+
+/* [] END OF FILE */
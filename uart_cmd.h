@@ -0,0 +1,132 @@
+/*******************************************************************************
+* File Name: uart_cmd.h
+*
+* Description:
+* Command interface on the debug UART for automated bench runs and soak
+* tests. The UART interrupt only collects the received characters into a few
+* line slots and stamps each complete line with the cycle counter. The main
+* loop splits the lines into words in place, checks the arguments against
+* their safe ranges, executes the command and replies on the debug UART, in
+* binary mode (TELEMETRY_BINARY) as a telemetry record. Nothing is allocated,
+* and a slow main loop pass only delays the commands. The time from the end
+* of a line to the execution of its command is recorded.
+*
+* Commands, one per line, ended with CR or LF:
+*  start                  start the converters from IDLE
+*  stop                   stop the converters, clears a fault
+*  vout                   output voltage setpoint and its last change
+*  vout <mV> [<mV/ms>]    output voltage setpoint and slew rate
+*  pulse on|off           start or stop the transient load in RUN
+*  pulse <duty %> <Hz>    duty cycle and frequency of the transient load
+*  limit                  list the limits of the averaged protection
+*  limit <name> <counts>  tighten a limit: vin_min, vin_max, iout_max, temp_max
+*  stats                  states, output voltage and counters
+*  energy [reset]         power, efficiency and energy, or clear them
+*  thermal [on|off]       thermal derating state, or allow or forbid it
+*  thermal <degC> <s>     derating setpoint below the limit and horizon
+*  ff [on|off]            load step feedforward state, or request it on or off
+*  ff <mA>                load current step the feedforward starts from
+* The reply is "ok <command> ..." or "err <command>: <reason>".
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef UART_CMD_H
+#define UART_CMD_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Received lines waiting for the main loop and their length, including the
+ * terminating zero. Characters of a longer line and lines arriving while all
+ * slots are full are discarded. */
+#define UART_CMD_LINES              (4U)
+#define UART_CMD_LINE_MAX           (48U)
+
+/* Words of a command line, including the command */
+#define UART_CMD_ARGS_MAX           (4U)
+
+/* Length of a reply */
+#define UART_CMD_REPLY_MAX          (200U)
+
+/* Output voltage sense: ADC counts per V (exGain0) */
+#define UART_CMD_COUNTS_PER_V       (4095.0f * 0.239f / 3.3f)
+
+/* Clock of the PWM_LOAD counter and the range of the transient load pulses.
+ * The on time of the load resistors is limited to half of the period. */
+#define UART_CMD_LOAD_CLK_HZ        (10000U)
+#define UART_CMD_PULSE_HZ_MIN       (1U)
+#define UART_CMD_PULSE_HZ_MAX       (50U)
+#define UART_CMD_PULSE_DUTY_MIN     (5U)
+#define UART_CMD_PULSE_DUTY_MAX     (50U)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    char     line[UART_CMD_LINES][UART_CMD_LINE_MAX];
+    uint32_t stamp[UART_CMD_LINES];         /* Cycle counter at the end of each line */
+    volatile uint32_t head;                 /* Lines received, written by the interrupt */
+    volatile uint32_t tail;                 /* Lines executed, written by the main loop */
+    uint32_t len;                           /* Characters of the line being received */
+    bool     skip;                          /* The line being received is discarded */
+    uint32_t overflows;                     /* Lines discarded, all slots full */
+    uint32_t too_long;                      /* Lines discarded, longer than a slot */
+    uint32_t executed;                      /* Commands executed */
+    uint32_t rejected;                      /* Commands unknown, with invalid arguments or refused */
+    uint32_t latency_last;                  /* End of the line to the command executed, cycles */
+    uint32_t latency_max;
+    uint64_t latency_sum;
+} uart_cmd_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern uart_cmd_t uart_cmd;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void uart_cmd_init(void);
+void uart_cmd_receive(void);
+void uart_cmd_process(void);
+
+#endif  /* UART_CMD_H */
+/* [] END OF FILE */
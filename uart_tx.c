@@ -0,0 +1,384 @@
+/*******************************************************************************
+* File Name: uart_tx.c
+*
+* Description:
+* Double buffered, non-blocking transmit path of the debug UART.
+*
+* Related document: See README.md
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "uart_tx.h"
+#include "uart_cmd.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+uart_tx_t uart_tx;
+
+/* Context of the high-level SCB UART API */
+static cy_stc_scb_uart_context_t *uart_tx_context;
+
+/* Interrupt configuration structure of the debug UART. */
+static const cy_stc_sysint_t uart_tx_intr_config =
+{
+    .intrSrc = DEBUG_UART_IRQ,
+    .intrPriority = UART_TX_INTR_PRIORITY,
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function name: uart_tx_reserve
+*********************************************************************************
+* Summary:
+* Drops the oldest complete messages of the fill buffer until the open
+* message can grow by the requested number of bytes.
+*
+* Parameters:
+*  size: bytes to append
+*
+* Return:
+*  bool: false when the bytes do not fit even into an otherwise empty buffer
+*
+*******************************************************************************/
+static bool uart_tx_reserve(uint32_t size)
+{
+    uint8_t *buf = uart_tx.buf[uart_tx.fill];
+
+    while (((UART_TX_BUF_SIZE - uart_tx.len) < size) && (uart_tx.msgs > 0U))
+    {
+        uint16_t n = uart_tx.msg_end[0];
+        uint8_t i;
+
+        (void)memmove(buf, &buf[n], (size_t)uart_tx.len - n);
+        uart_tx.len  -= n;
+        uart_tx.open -= n;
+        uart_tx.msgs--;
+        for (i = 0U; i < uart_tx.msgs; i++)
+        {
+            uart_tx.msg_end[i] = uart_tx.msg_end[i + 1U] - n;
+        }
+        uart_tx.dropped++;
+        uart_tx.dropped_bytes += n;
+    }
+
+    if ((UART_TX_BUF_SIZE - uart_tx.len) < size)
+    {
+        /* The open message is larger than a buffer, it is dropped as a whole
+         * up to the end of the pass. */
+        uart_tx.dropped++;
+        uart_tx.dropped_bytes += (uint32_t)uart_tx.len - uart_tx.open;
+        uart_tx.len = uart_tx.open;
+        uart_tx.discard = true;
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function name: uart_tx_init
+*********************************************************************************
+* Summary:
+* Empties both buffers, sets the status rate and enables the interrupt of the
+* debug UART, which refills the UART FIFO from the buffer being sent. The
+* UART must be initialized and enabled with the high-level API.
+*
+* Parameters:
+*  context: context of the debug UART
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_init(cy_stc_scb_uart_context_t *context)
+{
+    cy_rslt_t result;
+
+    uart_tx_context = context;
+    uart_tx.fill = 0U;
+    uart_tx.len = 0U;
+    uart_tx.open = 0U;
+    uart_tx.discard = false;
+    uart_tx.msgs = 0U;
+    uart_tx.sent = 0U;
+    uart_tx.dropped = 0U;
+    uart_tx.dropped_bytes = 0U;
+
+    /* The status rate is measured with the cycle counter. */
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    uart_tx_set_rate(UART_TX_RATE_HZ);
+    uart_tx.last = DWT->CYCCNT - uart_tx.period;
+
+    result = Cy_SysInt_Init(&uart_tx_intr_config, uart_tx_intr_handler);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+    NVIC_ClearPendingIRQ(uart_tx_intr_config.intrSrc);
+    NVIC_EnableIRQ(uart_tx_intr_config.intrSrc);
+}
+
+/*******************************************************************************
+* Function name: uart_tx_set_rate
+*********************************************************************************
+* Summary:
+* Sets the number of status updates per second.
+*
+* Parameters:
+*  rate_hz: updates per second, 0 for an update in every pass of the main loop
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_set_rate(uint32_t rate_hz)
+{
+    uart_tx.period = (rate_hz == 0U) ? 0U : (SystemCoreClock / rate_hz);
+}
+
+/*******************************************************************************
+* Function name: uart_tx_due
+*********************************************************************************
+* Summary:
+* Checks whether the next status update is due and restarts the period.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: true when the status is to be written in this pass
+*
+*******************************************************************************/
+bool uart_tx_due(void)
+{
+    uint32_t now = DWT->CYCCNT;
+
+    if ((now - uart_tx.last) < uart_tx.period)
+    {
+        return false;
+    }
+    uart_tx.last = now;
+    return true;
+}
+
+/*******************************************************************************
+* Function name: uart_tx_space
+*********************************************************************************
+* Summary:
+* Returns the free space of the fill buffer. A report that is written in
+* parts checks it before each part, so that it does not drop its own start.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t: free bytes
+*
+*******************************************************************************/
+uint32_t uart_tx_space(void)
+{
+    return uart_tx.discard ? 0U : (UART_TX_BUF_SIZE - uart_tx.len);
+}
+
+/*******************************************************************************
+* Function name: uart_tx_write
+*********************************************************************************
+* Summary:
+* Appends bytes to the message of the current pass.
+*
+* Parameters:
+*  data: bytes
+*  size: number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_write(const void *data, uint32_t size)
+{
+    if (uart_tx.discard || !uart_tx_reserve(size))
+    {
+        return;
+    }
+
+    (void)memcpy(&uart_tx.buf[uart_tx.fill][uart_tx.len], data, size);
+    uart_tx.len += (uint16_t)size;
+}
+
+/*******************************************************************************
+* Function name: uart_tx_printf
+*********************************************************************************
+* Summary:
+* Formats text directly into the fill buffer and appends it to the message
+* of the current pass. The text is formatted a second time only when older
+* messages have to be dropped to make room.
+*
+* Parameters:
+*  format: printf format
+*
+* Return:
+*  int: number of characters, negative on a format error
+*
+*******************************************************************************/
+int uart_tx_printf(const char *format, ...)
+{
+    va_list args;
+    uint32_t space;
+    int n;
+
+    if (uart_tx.discard)
+    {
+        return 0;
+    }
+
+    space = UART_TX_BUF_SIZE - uart_tx.len;
+    va_start(args, format);
+    n = vsnprintf((char *)&uart_tx.buf[uart_tx.fill][uart_tx.len], space, format, args);
+    va_end(args);
+    if (n < 0)
+    {
+        return n;
+    }
+
+    /* vsnprintf() also needs room for the terminating zero. */
+    if ((uint32_t)n >= space)
+    {
+        if (!uart_tx_reserve((uint32_t)n + 1U))
+        {
+            return n;
+        }
+        va_start(args, format);
+        (void)vsnprintf((char *)&uart_tx.buf[uart_tx.fill][uart_tx.len], UART_TX_BUF_SIZE - uart_tx.len,
+                        format, args);
+        va_end(args);
+    }
+
+    uart_tx.len += (uint16_t)n;
+    return n;
+}
+
+/*******************************************************************************
+* Function name: uart_tx_service
+*********************************************************************************
+* Summary:
+* Called at the end of each pass of the main loop. Closes the message of the
+* pass and, once the UART has sent the other buffer, hands the fill buffer
+* to the UART and continues in the other buffer. Does not wait.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_service(void)
+{
+    cy_en_scb_uart_status_t status;
+
+    if (uart_tx.discard)
+    {
+        uart_tx.discard = false;
+    }
+    else if (uart_tx.len > uart_tx.open)
+    {
+        if (uart_tx.msgs < UART_TX_MSG_MAX)
+        {
+            uart_tx.msgs++;
+        }
+        /* Without a free entry the message is merged into the previous one. */
+        uart_tx.msg_end[uart_tx.msgs - 1U] = uart_tx.len;
+    }
+    else
+    {
+        /* Nothing written in this pass. */
+    }
+    uart_tx.open = uart_tx.len;
+
+    if ((uart_tx.len == 0U) ||
+        ((Cy_SCB_UART_GetTransmitStatus(DEBUG_UART_HW, uart_tx_context) & CY_SCB_UART_TRANSMIT_ACTIVE) != 0UL))
+    {
+        return;
+    }
+
+    status = Cy_SCB_UART_Transmit(DEBUG_UART_HW, uart_tx.buf[uart_tx.fill], uart_tx.len, uart_tx_context);
+    if (status != CY_SCB_UART_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    uart_tx.sent += uart_tx.len;
+    uart_tx.fill ^= 1U;
+    uart_tx.len = 0U;
+    uart_tx.open = 0U;
+    uart_tx.msgs = 0U;
+}
+
+/*******************************************************************************
+* Function name: uart_tx_intr_handler
+*********************************************************************************
+* Summary:
+* Interrupt of the debug UART. The received characters are taken by the
+* command interface (uart_cmd.h). The high-level API refills the UART FIFO from
+* the buffer being sent and ends the transfer after its last byte. Without a
+* receive operation of its own, the high-level API may disable the receive
+* interrupt, it is enabled again.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_intr_handler(void)
+{
+    uart_cmd_receive();
+    Cy_SCB_UART_Interrupt(DEBUG_UART_HW, uart_tx_context);
+    Cy_SCB_SetRxInterruptMask(DEBUG_UART_HW, CY_SCB_UART_RX_NOT_EMPTY);
+}
+
+/* [] END OF FILE */
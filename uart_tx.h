@@ -0,0 +1,113 @@
+/*******************************************************************************
+* File Name: uart_tx.h
+*
+* Description:
+* Non-blocking transmit path of the debug UART. The main loop formats the
+* status line, the reports and the telemetry records into one of two buffers
+* while the SCB sends the other one in the background. The buffers change
+* when the transfer of the previous one has completed, so the main loop never
+* waits for the UART. The periodic status is limited to UART_TX_RATE_HZ
+* updates per second. Everything written in one pass of the main loop is one
+* message; when the buffer being filled runs full, its oldest messages are
+* dropped, so the newest status is always sent.
+*
+*******************************************************************************
+* Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#ifndef UART_TX_H
+#define UART_TX_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Status updates per second, text lines or telemetry records. Set with
+ * UART_TX_RATE_HZ in the Makefile, or at run time with uart_tx_set_rate(). */
+#ifndef UART_TX_RATE_HZ
+#define UART_TX_RATE_HZ             (20U)
+#endif
+
+/* Size of each of the two buffers, bytes. A report that is written in one
+ * piece (interrupt profile, frequency response, load steps) must fit. */
+#define UART_TX_BUF_SIZE            (2048U)
+
+/* Complete messages kept per buffer for dropping the oldest */
+#define UART_TX_MSG_MAX             (32U)
+
+/* Priority of the SCB interrupt that refills the UART FIFO, below the
+ * converter interrupts. */
+#define UART_TX_INTR_PRIORITY       (6UL)
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    uint8_t  buf[2][UART_TX_BUF_SIZE];
+    uint8_t  fill;                          /* Buffer written by the main loop */
+    uint16_t len;                           /* Bytes in the fill buffer */
+    uint16_t open;                          /* Start of the message being written */
+    bool     discard;                       /* The open message did not fit */
+    uint8_t  msgs;                          /* Complete messages in the fill buffer */
+    uint16_t msg_end[UART_TX_MSG_MAX];      /* End of each complete message */
+    uint32_t period;                        /* Status period, CPU cycles */
+    uint32_t last;                          /* Cycle counter at the last status */
+    uint32_t sent;                          /* Bytes handed to the UART */
+    uint32_t dropped;                       /* Messages dropped */
+    uint32_t dropped_bytes;
+} uart_tx_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern uart_tx_t uart_tx;
+
+/*******************************************************************************
+* Function prototypes
+*******************************************************************************/
+void uart_tx_init(cy_stc_scb_uart_context_t *context);
+void uart_tx_set_rate(uint32_t rate_hz);
+bool uart_tx_due(void);
+uint32_t uart_tx_space(void);
+void uart_tx_write(const void *data, uint32_t size);
+int uart_tx_printf(const char *format, ...);
+void uart_tx_service(void);
+void uart_tx_intr_handler(void);
+
+#endif  /* UART_TX_H */
+/* [] END OF FILE */